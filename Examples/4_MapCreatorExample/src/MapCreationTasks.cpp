@@ -14,6 +14,7 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <random>
 #include <set>
 #include <unordered_set>
@@ -21,10 +22,18 @@
 using namespace Botcraft;
 using namespace ProtocolCraft;
 
-Status GetAllChestsAround(BehaviourClient& c)
+namespace
 {
-    std::vector<Position> chests_pos;
+    // Keys used in the hot paths, interned once
+    const BlackboardKey<Position> structure_start_key("Structure.start");
+    const BlackboardKey<Position> structure_end_key("Structure.end");
+    const BlackboardKey<std::vector<std::vector<std::vector<short> > > > structure_target_key("Structure.target");
+    const BlackboardKey<std::map<short, std::string> > structure_palette_key("Structure.palette");
+    const BlackboardKey<std::set<std::string> > inventory_block_list_key("Inventory.block_list");
+}
 
+Status GetAllChestsAround(BehaviourClient& c)
+{
     std::shared_ptr<LocalPlayer> local_player = c.GetLocalPlayer();
     std::shared_ptr<World> world = c.GetWorld();
 
@@ -34,35 +43,8 @@ Status GetAllChestsAround(BehaviourClient& c)
         static_cast<int>(std::floor(local_player->GetZ()))
     );
 
-    Position checked_position;
-    {
-        auto all_chunks = world->GetChunks();
-        for (auto it = all_chunks->begin(); it != all_chunks->end(); ++it)
-        {
-            for (int x = 0; x < CHUNK_WIDTH; ++x)
-            {
-                checked_position.x = x;
-                for (int y = 0; y < it->second.GetHeight(); ++y)
-                {
-                    checked_position.y = y + it->second.GetMinY();
-                    for (int z = 0; z < CHUNK_WIDTH; ++z)
-                    {
-                        checked_position.z = z;
-                        const Blockstate* block = it->second.GetBlock(checked_position);
-                        if (block != nullptr && block->GetName() == "minecraft:chest")
-                        {
-                            const Position world_position(
-                                it->first.first * CHUNK_WIDTH + x,
-                                y + world->GetMinY(),
-                                it->first.second * CHUNK_WIDTH + z
-                            );
-                            chests_pos.push_back(world_position);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // All chests in loaded chunks, nearest first
+    const std::vector<Position> chests_pos = world->FindBlocks("minecraft:chest", player_position, std::numeric_limits<int>::max());
 
     c.GetBlackboard().Set("World.ChestsPos", chests_pos);
 
@@ -358,12 +340,12 @@ Status FindNextTask(BehaviourClient& c)
     std::shared_ptr<EntityManager> entity_manager = c.GetEntityManager();
     std::shared_ptr<World> world = c.GetWorld();
 
-    const Position& start = blackboard.Get<Position>("Structure.start");
-    const Position& end = blackboard.Get<Position>("Structure.end");
-    const std::vector<std::vector<std::vector<short> > >& target = blackboard.Get<std::vector<std::vector<std::vector<short> > > >("Structure.target");
-    const std::map<short, std::string>& palette = blackboard.Get<std::map<short, std::string> >("Structure.palette");
+    const Position& start = blackboard.Get(structure_start_key);
+    const Position& end = blackboard.Get(structure_end_key);
+    const std::vector<std::vector<std::vector<short> > >& target = blackboard.Get(structure_target_key);
+    const std::map<short, std::string>& palette = blackboard.Get(structure_palette_key);
 
-    const std::set<std::string>& available = blackboard.Get<std::set<std::string> >("Inventory.block_list");
+    const std::set<std::string>& available = blackboard.Get(inventory_block_list_key);
 
     std::mt19937 random_engine(static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()));
 
@@ -571,10 +553,10 @@ Status CheckCompletion(BehaviourClient& c)
     int wrong_blocks = 0;
     int missing_blocks = 0;
 
-    const Position& start = blackboard.Get<Position>("Structure.start");
-    const Position& end = blackboard.Get<Position>("Structure.end");
-    const std::vector<std::vector<std::vector<short> > >& target = blackboard.Get<std::vector<std::vector<std::vector<short> > > >("Structure.target");
-    const std::map<short, std::string>& palette = blackboard.Get<std::map<short, std::string> >("Structure.palette");
+    const Position& start = blackboard.Get(structure_start_key);
+    const Position& end = blackboard.Get(structure_end_key);
+    const std::vector<std::vector<std::vector<short> > >& target = blackboard.Get(structure_target_key);
+    const std::map<short, std::string>& palette = blackboard.Get(structure_palette_key);
 
     const bool log_details = blackboard.Get<bool>("CheckCompletion.log_details", false);
     const bool log_errors = blackboard.Get<bool>("CheckCompletion.log_errors", false);
@@ -20,37 +20,38 @@ Status HitCloseHostiles(BehaviourClient& c)
     const Vector3<double> player_pos = local_player->GetPosition();
 
     auto now = std::chrono::steady_clock::now();
-    {
-        auto entities = entity_manager->GetEntities();
-        for (const auto& [id, entity] : *entities)
+    entity_manager->QueryRadius(player_pos, 4.0, [&](const std::shared_ptr<Entity>& entity)
         {
-            if (entity->IsMonster() && (entity->GetPosition()- player_pos).SqrNorm() < 16.0)
+            if (!entity->IsMonster())
             {
-                auto time = last_time_hit.find(id);
-                if (time != last_time_hit.end() &&
-                    std::chrono::duration_cast<std::chrono::milliseconds>(now - time->second).count() < 500)
-                {
-                    continue;
-                }
+                return;
+            }
 
-                last_time_hit[id] = now;
+            const int id = entity->GetEntityID();
+            auto time = last_time_hit.find(id);
+            if (time != last_time_hit.end() &&
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - time->second).count() < 500)
+            {
+                return;
+            }
 
-                local_player->LookAt(entity->GetPosition());
+            last_time_hit[id] = now;
 
-                std::shared_ptr<ServerboundInteractPacket> msg = std::make_shared<ServerboundInteractPacket>();
-                msg->SetAction(1);
-                msg->SetEntityId(id);
+            local_player->LookAt(entity->GetPosition());
+
+            std::shared_ptr<ServerboundInteractPacket> msg = std::make_shared<ServerboundInteractPacket>();
+            msg->SetAction(1);
+            msg->SetEntityId(id);
 #if PROTOCOL_VERSION > 722 /* > 1.15.2 */
-                msg->SetUsingSecondaryAction(false);
+            msg->SetUsingSecondaryAction(false);
 #endif
-                std::shared_ptr<ServerboundSwingPacket> msg_swing = std::make_shared<ServerboundSwingPacket>();
-                msg_swing->SetHand(0);
+            std::shared_ptr<ServerboundSwingPacket> msg_swing = std::make_shared<ServerboundSwingPacket>();
+            msg_swing->SetHand(0);
 
-                network_manager->Send(msg);
-                network_manager->Send(msg_swing);
-            }
+            network_manager->Send(msg);
+            network_manager->Send(msg_swing);
         }
-    }
+    );
 
     return Status::Success;
 }
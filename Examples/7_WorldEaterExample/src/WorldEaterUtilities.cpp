@@ -1,3 +1,5 @@
+#include <queue>
+
 #include <botcraft/AI/Tasks/PathfindingTask.hpp>
 
 #include "WorldEaterUtilities.hpp"
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "botcraft/Game/ManagersClient.hpp"
 #include "botcraft/AI/Blackboard.hpp"
 
 namespace Botcraft
 {
+    class SharedBehaviour;
+
     /// @brief A ManagersClient extended with a blackboard that can store any
     /// kind of data and a virtual Yield function.
     /// You should **not** inherit from this class, but from TemplatedBehaviourClient
@@ -19,12 +24,44 @@ namespace Botcraft
 
         Blackboard& GetBlackboard();
 
+        /// @brief Make all the behaviour clients started after this call run their tree as a coroutine
+        /// on a pool of shared threads, instead of each one running its own behaviour thread. Trees are
+        /// stepped by the shared threads every 10 ms, RunBehaviourUntilClosed and BehaviourStep only wait
+        /// for these steps. Useful to run a lot of bots in the same process. Can't be disabled once called
+        /// @param num_threads Number of behaviour threads, 0 to use the number of cores
+        /// @param stack_size Stack size of each tree coroutine. Memory is only committed when used
+        static void UseSharedBehaviourThreads(const size_t num_threads = 0, const size_t stack_size = 1024 * 1024);
+
     public:
         void OnReset() override;
         void OnValueChanged(const std::string& key, const std::any& value) override;
         void OnValueRemoved(const std::string& key) override;
 
+    protected:
+        /// @brief Check if UseSharedBehaviourThreads has been called
+        static bool SharedBehaviourThreadsStarted();
+
+        /// @brief Start running a tree loop as a coroutine on the shared behaviour threads
+        /// @param tree_loop Function running the tree
+        /// @param should_step Function called before each step, the loop is not resumed if it returns false
+        void StartSharedBehaviour(std::function<void()>&& tree_loop, std::function<bool()>&& should_step);
+
+        /// @brief Check if the tree loop is running on the shared behaviour threads
+        bool RunsOnSharedBehaviourThreads() const;
+
+        /// @brief Give control back to the shared behaviour threads until next step. Must be called from the tree loop
+        void SuspendSharedBehaviour();
+
+        /// @brief Block until the shared behaviour threads performed one more step of this client tree loop
+        void WaitSharedBehaviourStep();
+
+        /// @brief Resume the tree loop until it returns, and wait for it
+        void StopSharedBehaviour();
+
     protected:
         Blackboard blackboard;
+
+    private:
+        std::shared_ptr<SharedBehaviour> shared_behaviour;
     };
 } // namespace Botcraft
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <any>
+#include <deque>
 #include <functional>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Botcraft
 {
@@ -42,7 +46,46 @@ namespace Botcraft
         virtual void OnValueRemoved(const std::string& key) = 0;
     };
 
-    /// @brief A map wrapper to store arbitrary data
+    /// @brief Non templated part of BlackboardKey
+    class BlackboardKeyBase
+    {
+    public:
+        /// @brief Intern name, all keys with the same name share the same id
+        explicit BlackboardKeyBase(const std::string& name);
+
+        /// @brief Get the index of this key, unique for each name
+        size_t GetId() const { return entry->second; }
+        /// @brief Get the string name of this key
+        const std::string& GetName() const { return entry->first; }
+
+    private:
+        /// @brief Interned entry, never destroyed so it can be read without lock
+        const std::pair<const std::string, size_t>* entry;
+    };
+
+    /// @brief A typed handle to a blackboard entry. Creating it interns the name once,
+    /// then accessing the value is a direct index in the blackboard.
+    /// Usage example:
+    /// ```cpp
+    /// static const BlackboardKey<Position> start_key("Structure.start");
+    /// const Position& start = blackboard.Get(start_key);
+    /// ```
+    /// Values are shared with the string API, blackboard.Get<Position>("Structure.start") returns the same value
+    /// @tparam T Type of the value stored at this key
+    template<class T>
+    class BlackboardKey : public BlackboardKeyBase
+    {
+    public:
+        explicit BlackboardKey(const std::string& name) : BlackboardKeyBase(name) {}
+
+    private:
+        friend class Blackboard;
+
+        explicit BlackboardKey(const BlackboardKeyBase& key) : BlackboardKeyBase(key) {}
+    };
+
+    /// @brief A map wrapper to store arbitrary data. Keys are interned
+    /// and values are stored in a flat table indexed by key id
     class Blackboard
     {
     public:
@@ -57,14 +100,17 @@ namespace Botcraft
         template<class T>
         const T& Get(const std::string& key)
         {
-            try
-            {
-                return std::any_cast<T&>(blackboard.at(key));
-            }
-            catch (const std::out_of_range& e)
-            {
-                throw std::out_of_range("invalid blackboard key: " + key);
-            }
+            return Get(BlackboardKey<T>(GetKey(key)));
+        }
+
+        /// @brief Get the value at key. The blackboard has to contain key.
+        /// @tparam T Type of the value
+        /// @param key key to retrieve the value from
+        /// @return The stored value
+        template<class T>
+        const T& Get(const BlackboardKey<T>& key)
+        {
+            return GetValue(key);
         }
 
         /// @brief Get the map value at key, casting it to T.
@@ -77,13 +123,24 @@ namespace Botcraft
         template<class T>
         const T& Get(const std::string& key, const T& default_value)
         {
-            auto it = blackboard.find(key);
-            if (it == blackboard.end())
+            return Get(BlackboardKey<T>(GetKey(key)), default_value);
+        }
+
+        /// @brief Get the value at key. If the key is not present, add it with default_value, and returns it.
+        /// @tparam T Type of the value
+        /// @param key key to retrieve the value from
+        /// @param default_value The default value to return if key is not found
+        /// @return The stored value
+        template<class T>
+        const T& Get(const BlackboardKey<T>& key, const T& default_value)
+        {
+            std::any& slot = GetSlot(key.GetId());
+            if (!slot.has_value())
             {
-                it = blackboard.insert(std::pair<std::string, std::any>(key, default_value)).first;
-                NotifyKeyChanged(key, it->second);
+                slot = default_value;
+                NotifyKeyChanged(key.GetName(), slot);
             }
-            return std::any_cast<T&>(it->second);
+            return std::any_cast<T&>(slot);
         }
 
         /// @brief Get a ref to the map value at key, casting it to T&. key must exist in the blackboard.
@@ -101,14 +158,18 @@ namespace Botcraft
         template<class T>
         NotifyOnEndUseRef<T> GetRef(const std::string& key)
         {
-            try
-            {
-                return NotifyOnEndUseRef(std::any_cast<T&>(blackboard.at(key)), [this, key]() { NotifyKeyChanged(key, blackboard.at(key)); });
-            }
-            catch (const std::out_of_range& e)
-            {
-                throw std::out_of_range("invalid blackboard key: " + key);
-            }
+            return GetRef(BlackboardKey<T>(GetKey(key)));
+        }
+
+        /// @brief Get a ref to the value at key. key must exist in the blackboard.
+        /// Observers are notified when the returned object is destroyed
+        /// @tparam T Type of the value
+        /// @param key key to retrieve the value from
+        /// @return The stored value
+        template<class T>
+        NotifyOnEndUseRef<T> GetRef(const BlackboardKey<T>& key)
+        {
+            return NotifyOnEndUseRef<T>(GetValue(key), [this, k = static_cast<const BlackboardKeyBase&>(key)]() { NotifyKeyChanged(k); });
         }
 
         /// @brief Get a ref to the map value at key, casting it to T&.
@@ -128,12 +189,24 @@ namespace Botcraft
         template<class T>
         NotifyOnEndUseRef<T> GetRef(const std::string& key, const T& default_value)
         {
-            auto it = blackboard.find(key);
-            if (it == blackboard.end())
+            return GetRef(BlackboardKey<T>(GetKey(key)), default_value);
+        }
+
+        /// @brief Get a ref to the value at key. If the key is not present, add it with default_value, and returns it.
+        /// Observers are notified when the returned object is destroyed
+        /// @tparam T Type of the value
+        /// @param key key to retrieve the value from
+        /// @param default_value The default value to return if key is not found
+        /// @return The stored value
+        template<class T>
+        NotifyOnEndUseRef<T> GetRef(const BlackboardKey<T>& key, const T& default_value)
+        {
+            std::any& slot = GetSlot(key.GetId());
+            if (!slot.has_value())
             {
-                it = blackboard.insert(std::pair<std::string, std::any>(key, default_value)).first;
+                slot = default_value;
             }
-            return NotifyOnEndUseRef(std::any_cast<T&>(it->second), [this, key]() { NotifyKeyChanged(key, blackboard.at(key)); });
+            return NotifyOnEndUseRef<T>(std::any_cast<T&>(slot), [this, k = static_cast<const BlackboardKeyBase&>(key)]() { NotifyKeyChanged(k); });
         }
 
         /// @brief Set map entry at key to value
@@ -143,8 +216,27 @@ namespace Botcraft
         template<class T>
         void Set(const std::string& key, const T& value)
         {
-            blackboard[key] = value;
-            NotifyKeyChanged(key, blackboard[key]);
+            Set(BlackboardKey<T>(GetKey(key)), value);
+        }
+
+        /// @brief Set entry at key to value
+        /// @tparam T Type of the value
+        /// @param key key to store the value at
+        /// @param value value to store at key
+        template<class T>
+        void Set(const BlackboardKey<T>& key, const T& value)
+        {
+            std::any& slot = GetSlot(key.GetId());
+            // Assign in place if possible to reuse already allocated memory
+            if (T* current = std::any_cast<T>(&slot))
+            {
+                *current = value;
+            }
+            else
+            {
+                slot = value;
+            }
+            NotifyKeyChanged(key.GetName(), slot);
         }
 
         /// @brief Copy a blackboard value
@@ -156,6 +248,10 @@ namespace Botcraft
         /// @param key key we want to remove
         void Erase(const std::string& key);
 
+        /// @brief Remove an entry if present
+        /// @param key key we want to remove
+        void Erase(const BlackboardKeyBase& key);
+
         /// @brief Clear all the entries in the blackboard and load new ones
         /// @param values Values to load into the blackboard after clearing
         void Reset(const std::map<std::string, std::any>& values = {});
@@ -169,13 +265,41 @@ namespace Botcraft
         /// @return True if there is a value in the blackboard at the given key, false otherwise
         bool Contains(const std::string& key) const;
 
+        /// @brief Check if a specific key is present in the blackboard
+        /// @param key Key to find
+        /// @return True if there is a value in the blackboard at the given key, false otherwise
+        bool Contains(const BlackboardKeyBase& key) const;
+
     private:
+        /// @brief Get the key for a name, cached locally to avoid locking the global key table
+        const BlackboardKeyBase& GetKey(const std::string& name) const;
+
+        /// @brief Get the slot at id, growing the table if needed. Empty if no value
+        std::any& GetSlot(const size_t id);
+
+        template<class T>
+        T& GetValue(const BlackboardKey<T>& key)
+        {
+            const size_t id = key.GetId();
+            if (id >= slots.size() || !slots[id].has_value())
+            {
+                throw std::out_of_range("invalid blackboard key: " + key.GetName());
+            }
+            return std::any_cast<T&>(slots[id]);
+        }
+
         void NotifyCleared() const;
         void NotifyKeyRemoved(const std::string& key) const;
         void NotifyKeyChanged(const std::string& key, const std::any& value) const;
+        /// @brief Notify the current value at key, if still present
+        void NotifyKeyChanged(const BlackboardKeyBase& key) const;
 
     private:
-        std::map<std::string, std::any> blackboard;
+        /// @brief Values indexed by key id, empty std::any if not present. A deque so
+        /// growing it for a new key doesn't move the values references point to
+        std::deque<std::any> slots;
         std::vector<BlackboardObserver*> observers;
+        /// @brief Keys already used with the string API
+        mutable std::unordered_map<std::string, BlackboardKeyBase> keys_cache;
     };
 } // namespace Botcraft
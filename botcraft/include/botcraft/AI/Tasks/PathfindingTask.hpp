@@ -6,6 +6,7 @@
 namespace Botcraft
 {
     class BehaviourClient;
+    class World;
 
     /// @brief Not actually a task. Helper function to compute path between start and end. Does not perfom any movement.
     /// @param client Client used to do the pathfinding
@@ -18,6 +19,19 @@ namespace Botcraft
     /// @return A vector of <feet block position, Y position> to go through to reach end +/- min_end_dist. If not possible, will return a path to get as close as possible
     std::vector<std::pair<Position, float>> FindPath(const BehaviourClient& client, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump);
 
+    /// @brief Same as FindPath, but without a client. Does not perform any movement.
+    /// @param world World to search the path in
+    /// @param start Start position
+    /// @param end End position
+    /// @param dist_tolerance Stop the search earlier if you get closer than dist_tolerance from the end position
+    /// @param min_end_dist Desired minimal checkboard distance between the final position and goal
+    /// @param min_end_dist_xz Same as min_end_dist but only considering the XZ plane
+    /// @param allow_jump If true, allow to jump above 1-wide gaps
+    /// @param takes_damage If true, hazardous blocks are avoided
+    /// @param step_height Max height difference that can be walked up without jumping
+    /// @return A vector of <feet block position, Y position> to go through to reach end +/- min_end_dist. If not possible, will return a path to get as close as possible
+    std::vector<std::pair<Position, float>> FindPath(const World& world, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump, const bool takes_damage, const float step_height);
+
     /// @brief Find a path to a block position and navigate to it.
     /// @param client The client performing the action
     /// @param goal The end goal
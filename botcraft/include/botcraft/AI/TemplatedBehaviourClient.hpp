@@ -24,8 +24,9 @@ namespace Botcraft
     {
     private:
         /// @brief Custom internal type used when the tree needs
-        /// to be changed. It does not inherit std::exception to
-        /// prevent tree components from catching it
+        /// to be changed while a node is running. It does not
+        /// inherit std::exception to prevent tree components from
+        /// catching it. Swaps between two ticks don't throw
         class SwapTree
         {
         };
@@ -58,6 +59,8 @@ namespace Botcraft
             {
                 behaviour_thread.join();
             }
+            // Must be done here, the tree loop uses TDerived members
+            StopSharedBehaviour();
         }
 
         /// @brief Save the given tree to replace the current one as soon as possible.
@@ -76,9 +79,9 @@ namespace Botcraft
         /// can be interrupted.
         virtual void Yield() override
         {
-            std::unique_lock<std::mutex> lock(behaviour_mutex);
-            behaviour_cond_var.notify_all();
-            behaviour_cond_var.wait(lock);
+            WaitNextStep();
+            // Leave the running nodes to unwind the stack
+            std::lock_guard<std::mutex> behaviour_guard(behaviour_mutex);
             if (should_be_closed)
             {
                 throw Interrupted();
@@ -89,9 +92,16 @@ namespace Botcraft
             }
         }
 
-        /// @brief Start the behaviour thread loop.
+        /// @brief Start the behaviour thread loop (or the coroutine if UseSharedBehaviourThreads has been called).
         void StartBehaviour()
         {
+            if (SharedBehaviourThreadsStarted())
+            {
+                tree_loop_ready = true;
+                StartSharedBehaviour([this]() { TreeLoop(); }, [this]() { return CanStep(); });
+                return;
+            }
+
             tree_loop_ready = false;
             behaviour_thread = std::thread(&TemplatedBehaviourClient<TDerived>::TreeLoop, this);
 
@@ -106,7 +116,7 @@ namespace Botcraft
         /// disconnected from the server.
         void RunBehaviourUntilClosed()
         {
-            if (!behaviour_thread.joinable())
+            if (!IsBehaviourStarted())
             {
                 StartBehaviour();
             }
@@ -124,14 +134,21 @@ namespace Botcraft
         }
 
         /// @brief Perform one step of the behaviour tree.
-        /// Don't forget to call StartBehaviour before.
+        /// Don't forget to call StartBehaviour before. When running on
+        /// shared behaviour threads, wait for the next step performed by them.
         void BehaviourStep()
         {
-            if (should_be_closed || !network_manager || network_manager->GetConnectionState() != ProtocolCraft::ConnectionState::Play)
+            if (!CanStep())
             {
                 return;
             }
 
+            if (RunsOnSharedBehaviourThreads())
+            {
+                WaitSharedBehaviourStep();
+                return;
+            }
+
             std::unique_lock<std::mutex> lock(behaviour_mutex);
             // Resume tree ticking
             behaviour_cond_var.notify_all();
@@ -149,7 +166,7 @@ namespace Botcraft
         void SyncAction(const int timeout_ms, Args&&... args)
         {
             // Make sure the behaviour thread is running
-            if (!behaviour_thread.joinable())
+            if (!IsBehaviourStarted())
             {
                 StartBehaviour();
             }
@@ -264,14 +281,73 @@ namespace Botcraft
 #endif
 
     private:
+        bool IsBehaviourStarted() const
+        {
+            return behaviour_thread.joinable() || RunsOnSharedBehaviourThreads();
+        }
+
+        bool CanStep() const
+        {
+            return !should_be_closed && network_manager && network_manager->GetConnectionState() == ProtocolCraft::ConnectionState::Play;
+        }
+
+        /// @brief Give control back to the thread calling BehaviourStep
+        /// (or to the shared behaviour threads) until the next step
+        void WaitNextStep()
+        {
+            if (RunsOnSharedBehaviourThreads())
+            {
+                SuspendSharedBehaviour();
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(behaviour_mutex);
+            behaviour_cond_var.notify_all();
+            behaviour_cond_var.wait(lock);
+        }
+
+        /// @brief Replace the current tree with the one given to SetBehaviourTree
+        void SwapTreeNow()
+        {
+            std::map<std::string, std::any> blackboard_values;
+            { // lock scope
+                std::lock_guard<std::mutex> behaviour_guard(behaviour_mutex);
+                tree = new_tree;
+                new_tree = nullptr;
+                swap_tree = false;
+                blackboard_values = std::move(new_blackboard);
+                new_blackboard.clear();
+            }
+            OnTreeChanged(tree.get());
+            blackboard.Reset(blackboard_values);
+        }
+
         void TreeLoop()
         {
-            Logger::GetInstance().RegisterThread("Behaviour - " + GetNetworkManager()->GetMyName());
+            // Shared threads are registered once for all the trees they run
+            if (!RunsOnSharedBehaviourThreads())
+            {
+                Logger::GetInstance().RegisterThread("Behaviour - " + GetNetworkManager()->GetMyName());
+            }
             tree_loop_ready = true;
             while (true)
             {
                 try
                 {
+                    bool swap_requested = false;
+                    { // lock scope
+                        std::lock_guard<std::mutex> behaviour_guard(behaviour_mutex);
+                        if (should_be_closed)
+                        {
+                            return;
+                        }
+                        swap_requested = swap_tree;
+                    }
+                    // Swap between two ticks, no need to unwind anything
+                    if (swap_requested)
+                    {
+                        SwapTreeNow();
+                    }
                     if (tree)
                     {
 #if USE_GUI
@@ -279,16 +355,12 @@ namespace Botcraft
 #endif
                         tree->Tick(static_cast<TDerived&>(*this));
                     }
-                    Yield();
+                    WaitNextStep();
                 }
                 // We need to update the tree with the new one
                 catch (const SwapTree&)
                 {
-                    tree = new_tree;
-                    new_tree = nullptr;
-                    swap_tree = false;
-                    OnTreeChanged(tree.get());
-                    blackboard.Reset(new_blackboard);
+                    SwapTreeNow();
                     continue;
                 }
                 // We need to stop the behaviour thread
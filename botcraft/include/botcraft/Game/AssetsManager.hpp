@@ -4,6 +4,7 @@
 #include "botcraft/Game/World/Blockstate.hpp"
 #include "botcraft/Game/Inventory/Item.hpp"
 
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -38,7 +39,12 @@ namespace Botcraft
         /// @brief Get all blockstates that match a given name
         /// @param name Name of the blockstate
         /// @return A vector of all blockstates matching the given name
-        std::vector<const Blockstate*> GetBlockstates(const std::string& name) const;
+        const std::vector<const Blockstate*>& GetBlockstates(const std::string& name) const;
+
+        /// @brief Get the ids of all blockstates that match a given name
+        /// @param name Name of the blockstate
+        /// @return A vector of all blockstate ids matching the given name, empty if not found
+        const std::vector<BlockstateId>& GetBlockstateIds(const std::string& name) const;
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
         const std::unordered_map<unsigned char, std::unique_ptr<Biome> >& Biomes() const;
@@ -66,8 +72,18 @@ namespace Botcraft
 #endif
         void LoadBiomesFile();
         void LoadItemsFile();
+        /// @brief Build the name -> blockstates and name -> item lookup tables
+        void BuildNameIndices();
 #if USE_GUI
         void LoadTextures();
+#endif
+#if !USE_GUI
+        /// @brief Load blocks, biomes and items from the binary cache written by WriteCache,
+        /// if it exists and the source assets didn't change since then
+        /// @return True if loaded from cache, false if the assets must be loaded from files
+        bool LoadCache();
+        /// @brief Write all blocks, biomes and items in a binary cache file next to the assets
+        void WriteCache() const;
 #endif
         void ClearCaches();
 
@@ -89,6 +105,17 @@ namespace Botcraft
         std::unordered_map<int, std::unique_ptr<Biome> > biomes;
 #endif
         std::unordered_map<ItemId, std::unique_ptr<Item>> items;
+
+        /// @brief Entries of a block name in blockstates_by_name
+        struct BlockstatesByName
+        {
+            std::vector<const Blockstate*> blockstates;
+            std::vector<BlockstateId> ids;
+        };
+        std::unordered_map<std::string, BlockstatesByName> blockstates_by_name;
+        /// @brief Blockstate returned by GetBlockstate(name) for each name
+        std::unordered_map<std::string, const Blockstate*> blockstate_by_name;
+        std::unordered_map<std::string, const Item*> items_by_name;
 #if USE_GUI
         std::unique_ptr<Renderer::Atlas> atlas;
 #endif
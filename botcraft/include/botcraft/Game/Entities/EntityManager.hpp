@@ -1,16 +1,19 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <shared_mutex>
 #include <unordered_map>
 
 #include "protocolCraft/Handler.hpp"
 
+#include "botcraft/Game/Entities/entities/Entity.hpp"
+
 #include "botcraft/Utilities/ScopeLockedWrapper.hpp"
 
 namespace Botcraft
 {
-    class Entity;
+    class EntityGrid;
     class LocalPlayer;
     class NetworkManager;
 
@@ -18,6 +21,7 @@ namespace Botcraft
     {
     public:
         EntityManager(const std::shared_ptr<NetworkManager>& network_manager);
+        ~EntityManager();
 
         std::shared_ptr<LocalPlayer> GetLocalPlayer();
 
@@ -30,6 +34,34 @@ namespace Botcraft
         /// as soon as you don't need it.
         Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock> GetEntities() const;
 
+        /// @brief Call a function for each entity in a sphere. Entities positions are the last ones received from the
+        /// server, the local player is not included. **ALL ENTITIES UPDATE ARE BLOCKED DURING THE CALLS**, don't do
+        /// anything long or call other EntityManager functions in callback
+        /// @param center Center of the sphere
+        /// @param radius Radius of the sphere
+        /// @param callback Function called for each entity
+        /// @param type If not EntityType::None, only entities of this type are visited
+        void QueryRadius(const Vector3<double>& center, const double radius,
+            const std::function<void(const std::shared_ptr<Entity>&)>& callback, const EntityType type = EntityType::None) const;
+
+        /// @brief Call a function for each entity with its position inside an AABB. Entities positions are the last ones received
+        /// from the server, the local player is not included. **ALL ENTITIES UPDATE ARE BLOCKED DURING THE CALLS**, don't do
+        /// anything long or call other EntityManager functions in callback
+        /// @param aabb Box to search in
+        /// @param callback Function called for each entity
+        /// @param type If not EntityType::None, only entities of this type are visited
+        void QueryAABB(const AABB& aabb, const std::function<void(const std::shared_ptr<Entity>&)>& callback, const EntityType type = EntityType::None) const;
+
+        /// @brief Get the nearest entity of a position. Entities positions are the last ones received
+        /// from the server, the local player is not included
+        /// @param position Position to search around
+        /// @param max_distance Max distance between position and the returned entity
+        /// @param type If not EntityType::None, only entities of this type are considered
+        /// @param filter If set, entities for which it returns false are skipped. Called while all entities update are blocked
+        /// @return The nearest entity, nullptr if none was found
+        std::shared_ptr<Entity> Nearest(const Vector3<double>& position, const double max_distance, const EntityType type = EntityType::None,
+            const std::function<bool(const Entity&)>& filter = nullptr) const;
+
     protected:
         virtual void Handle(ProtocolCraft::ClientboundLoginPacket& packet) override;
         virtual void Handle(ProtocolCraft::ClientboundAddEntityPacket& packet) override;
@@ -73,8 +105,24 @@ namespace Botcraft
 #endif
 
 
+    private:
+        /// @brief Add or replace an entity. entity_manager_mutex must be locked
+        /// @param id Id of the entity
+        /// @param entity Entity to add
+        void SetEntityImpl(const int id, const std::shared_ptr<Entity>& entity);
+
+        /// @brief Remove an entity. entity_manager_mutex must be locked
+        /// @param id Id of the entity to remove
+        void RemoveEntityImpl(const int id);
+
+        /// @brief Update the position of an entity in the spatial grid. Thread-safe
+        /// @param entity Entity which moved
+        void OnEntityMoved(const std::shared_ptr<Entity>& entity);
+
     private:
         std::unordered_map<int, std::shared_ptr<Entity> > entities;
+        /// @brief Same entities as entities, except local player, indexed by type and position
+        std::unique_ptr<EntityGrid> entity_grid;
         // The current player is stored independently
         std::shared_ptr<LocalPlayer> local_player;
 
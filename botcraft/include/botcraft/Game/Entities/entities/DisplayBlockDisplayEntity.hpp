@@ -9,7 +9,7 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = DisplayEntity::metadata_count + DisplayEntity::hierarchy_metadata_count;
 
     public:
@@ -13,7 +13,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 15;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 
     public:
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <any>
+#include <array>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
 #include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "protocolCraft/Types/Chat/Chat.hpp"
@@ -58,7 +62,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 6;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = 0;
 
     public:
@@ -257,6 +261,47 @@ namespace Botcraft
         virtual double GetWidthImpl() const;
         virtual double GetHeightImpl() const;
 
+        /// @brief Get the position of a metadata in a metadata_names array. Meant to be evaluated at compile time
+        /// @param names metadata_names of the class
+        /// @param name Name of the metadata
+        /// @return Index of name in names
+        template<size_t N>
+        static constexpr int GetMetadataIndex(const std::array<std::string_view, N>& names, const std::string_view name)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (names[i] == name)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            throw std::invalid_argument("Unknown metadata name");
+        }
+
+        /// @brief Metadata values addressed by their protocol index. Like std::map,
+        /// operator[] adds missing values so each class in the hierarchy can initialize
+        /// its own metadata in its constructor
+        class MetadataStorage
+        {
+        public:
+            std::any& operator[](const size_t index)
+            {
+                if (index >= values.size())
+                {
+                    values.resize(index + 1);
+                }
+                return values[index];
+            }
+
+            const std::any& at(const size_t index) const
+            {
+                return values.at(index);
+            }
+
+        private:
+            std::vector<std::any> values;
+        };
+
     protected:
         mutable std::shared_mutex entity_mutex;
 
@@ -273,7 +318,7 @@ namespace Botcraft
         std::map<EquipmentSlot, ProtocolCraft::Slot> equipments;
         std::vector<EntityEffect> effects;
 
-        std::map<std::string, std::any> metadata;
+        MetadataStorage metadata;
 
 #if USE_GUI
         //All the faces of this model
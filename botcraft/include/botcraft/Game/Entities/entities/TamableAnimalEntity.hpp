@@ -8,7 +8,7 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 2;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
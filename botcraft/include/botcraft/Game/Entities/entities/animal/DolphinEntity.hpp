@@ -21,7 +21,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 2;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #if PROTOCOL_VERSION < 768 /* < 1.21.2 */
         static constexpr int hierarchy_metadata_count = WaterAnimalEntity::metadata_count + WaterAnimalEntity::hierarchy_metadata_count;
 #else
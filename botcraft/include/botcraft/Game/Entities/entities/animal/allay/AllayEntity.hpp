@@ -12,7 +12,7 @@ namespace Botcraft
         static constexpr int metadata_count = 0;
 #else
         static constexpr int metadata_count = 2;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #endif
         static constexpr int hierarchy_metadata_count = PathfinderMobEntity::metadata_count + PathfinderMobEntity::hierarchy_metadata_count;
 
@@ -12,7 +12,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 2;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = AbstractHorseEntity::metadata_count + AbstractHorseEntity::hierarchy_metadata_count;
 
     public:
@@ -10,7 +10,7 @@ namespace Botcraft
     protected:
 
         static constexpr int metadata_count = 5;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
         static constexpr int hierarchy_metadata_count = TamableAnimalEntity::metadata_count + TamableAnimalEntity::hierarchy_metadata_count;
 
     public:
@@ -20,7 +20,7 @@ namespace Botcraft
         static constexpr int metadata_count = 0;
 #else
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #endif
 #if PROTOCOL_VERSION < 767 /* < 1.21 */
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
@@ -9,7 +9,7 @@ namespace Botcraft
     protected:
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #else
         static constexpr int metadata_count = 0;
 #endif
@@ -13,7 +13,7 @@ namespace Botcraft
         static constexpr int metadata_count = 0;
 #endif
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #endif
         static constexpr int hierarchy_metadata_count = AbstractSkeletonEntity::metadata_count + AbstractSkeletonEntity::hierarchy_metadata_count;
 
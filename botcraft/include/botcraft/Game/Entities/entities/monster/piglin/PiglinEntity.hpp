@@ -21,7 +21,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 4;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #if PROTOCOL_VERSION > 736 /* > 1.16.1 */
         static constexpr int hierarchy_metadata_count = AbstractPiglinEntity::metadata_count + AbstractPiglinEntity::hierarchy_metadata_count;
 #else
@@ -26,7 +26,7 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 1;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
         static constexpr int hierarchy_metadata_count = ProjectileEntity::metadata_count + ProjectileEntity::hierarchy_metadata_count;
 #else
@@ -29,7 +29,7 @@ namespace Botcraft
         static constexpr int metadata_count = 0;
 #endif
 #if PROTOCOL_VERSION < 768 /* < 1.21.2 */
-        static const std::array<std::string, metadata_count> metadata_names;
+        static const std::array<std::string_view, metadata_count> metadata_names;
 #endif
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
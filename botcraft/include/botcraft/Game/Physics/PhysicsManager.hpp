@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include <thread>
+#include <vector>
 
 #include "protocolCraft/Handler.hpp"
 
@@ -27,6 +28,21 @@ namespace Botcraft
     }
 #endif
 
+    /// @brief Metrics of the ticks run by the shared physics threads
+    struct PhysicsTickStats
+    {
+        /// @brief Number of ticks run
+        size_t ticks = 0;
+        /// @brief Number of ticks that ended after the start of the next one
+        size_t overruns = 0;
+        /// @brief Number of ticks not run at all because the threads were too late
+        size_t skipped_ticks = 0;
+        /// @brief Max delay between the time a tick should have started and its actual start
+        double max_lateness_ms = 0.0;
+        /// @brief Mean delay between the time a tick should have started and its actual start
+        double mean_lateness_ms = 0.0;
+    };
+
     class PhysicsManager : public ProtocolCraft::Handler
     {
     public:
@@ -52,6 +68,16 @@ namespace Botcraft
 
         double GetMsPerTick() const;
 
+        /// @brief Make all the PhysicsManager started after this call run their ticks on a pool
+        /// of shared threads, instead of each one sleeping in its own physics thread. Ticks are
+        /// aligned, so all the clients with the same tick rate are processed together.
+        /// Useful to run a lot of bots in the same process. Can't be disabled once called
+        /// @param num_threads Number of physics threads, 0 to use the number of cores
+        static void UseSharedTickScheduler(const size_t num_threads = 0);
+
+        /// @brief Get metrics about the ticks run by the shared physics threads
+        static PhysicsTickStats GetSharedTickStats();
+
     protected:
         virtual void Handle(ProtocolCraft::ClientboundLoginPacket& packet) override;
         virtual void Handle(ProtocolCraft::ClientboundPlayerPositionPacket& packet) override;
@@ -64,6 +90,8 @@ namespace Botcraft
 
     private:
         void Physics();
+        /// @brief Everything done once per tick: teleport confirmation, PhysicsTick and tick end packet
+        void Tick();
 
         /// @brief Follow minecraft physics related flow in LocalPlayer tick function
         void PhysicsTick();
@@ -113,9 +141,13 @@ namespace Botcraft
         int ticks_since_last_position_sent;
 
         std::thread thread_physics; // Thread running to compute position and send it to the server every tick
+        std::optional<size_t> shared_tick_id; // Set instead of thread_physics when running on the shared physics threads
 
         const Item* elytra_item;
 
+        /// @brief Filled by CollideBoundingBox, only used during a tick
+        mutable std::vector<AABB> colliders_buffer;
+
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
         std::atomic<double> ms_per_tick = 50.0;
 #else
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    class Blockstate;
+    class ChunkIndex;
+    struct Section;
+
+    /// @brief Block properties used by pathfinding, see BlockCursor::GetNavigationColumn
+    enum class NavigationProperty
+    {
+        Solid,
+        Hazardous,
+        Climbable,
+        /// @brief Fluid or waterlogged, and not solid
+        Fluid,
+        /// @brief Solid, with a top different from a full block
+        PartialHeight,
+        /// @brief Jumping is not possible with feet inside
+        NoJump,
+        NUM_NAVIGATION_PROPERTIES
+    };
+
+    /// @brief Pathfinding properties of a vertical range of blocks, bit i being the i-th block from the bottom
+    struct NavigationColumn
+    {
+        /// @brief Bits for each NavigationProperty
+        std::array<unsigned int, static_cast<size_t>(NavigationProperty::NUM_NAVIGATION_PROPERTIES)> properties = {};
+        /// @brief Bit i is set if the block is in a loaded chunk. Blocks in unloaded chunks have no property
+        unsigned int loaded = 0;
+
+        bool Has(const NavigationProperty property, const int i) const
+        {
+            return (properties[static_cast<size_t>(property)] >> i) & 1u;
+        }
+
+        bool IsLoaded(const int i) const
+        {
+            return (loaded >> i) & 1u;
+        }
+    };
+
+    /// @brief Cached read access to the blocks of a World, for code doing a lot of
+    /// queries in the same area (pathfinding, collisions...). Chunks are looked up
+    /// once and kept in a 3x3 neighbourhood around the last queried one, and the
+    /// last section read is remembered, so ±1 offsets queries are mostly a few
+    /// comparisons away from the block data.
+    /// Chunks are pinned as they were when first accessed: block changes are still
+    /// visible, but not chunks loaded/unloaded (or new sections) after that.
+    /// Blocks freeing is delayed while a cursor is alive, so it must be short-lived.
+    /// **Must be used and destroyed by the thread that created it**
+    class BlockCursor
+    {
+    public:
+        ~BlockCursor();
+
+        BlockCursor(const BlockCursor&) = delete;
+        BlockCursor& operator=(const BlockCursor&) = delete;
+
+        /// @brief Get the blockstate at a given position
+        /// @param pos Position of the block
+        /// @return A const pointer to the blockstate at position, nullptr if not loaded
+        const Blockstate* GetBlock(const Position& pos);
+
+        /// @brief Get the pathfinding properties of a column of blocks, reading a whole section column at once
+        /// @param bottom Position of the lowest block
+        /// @param height Number of blocks, at most 32
+        /// @return Properties of the blocks from bottom to bottom + (0, height - 1, 0)
+        NavigationColumn GetNavigationColumn(const Position& bottom, const int height);
+
+        /// @brief Get the Y of the top of a solid block, quantised to 1/64 of a block
+        /// @param pos Position of the block
+        /// @return Top of the block colliders, pos.y if the block is not solid
+        float GetNavigationHeight(const Position& pos);
+
+        /// @brief Get a value identifying the current navigation properties of a chunk
+        /// @param chunk_x Chunk X
+        /// @param chunk_z Chunk Z
+        /// @return A value that changes each time a navigation property of a block of the chunk changes, 0 if not loaded
+        unsigned long long int GetChunkNavigationVersion(const int chunk_x, const int chunk_z);
+
+    private:
+        /// @brief Use World::GetBlockCursor to create a cursor
+        BlockCursor(const ChunkIndex& chunk_index_);
+
+        struct CachedChunk
+        {
+            /// @brief False if this chunk still has to be searched in the index
+            bool looked_up = false;
+            bool loaded = false;
+            const std::shared_ptr<const Section>* sections = nullptr;
+            int num_sections = 0;
+            int min_y = 0;
+        };
+
+        /// @brief Get a chunk, moving the cached neighbourhood if it's not in it
+        /// @param chunk_x Chunk X
+        /// @param chunk_z Chunk Z
+        /// @return Cached chunk, looked up in the index if required
+        const CachedChunk& GetChunk(const int chunk_x, const int chunk_z);
+
+        /// @brief Set last section to the one containing a position
+        /// @param pos Position of a block
+        /// @return False if the chunk is not loaded
+        bool MoveToSection(const Position& pos);
+
+        friend class World;
+
+    private:
+        const ChunkIndex& chunk_index;
+        const Blockstate* air;
+
+        /// @brief Coordinates of the chunk in the middle of neighbourhood
+        int center_x;
+        int center_z;
+        /// @brief 3x3 chunks around center, index is (dx + 1) * 3 + (dz + 1)
+        std::array<CachedChunk, 9> neighbourhood;
+
+        /// @brief Last section read, only valid if has_last_section is true
+        bool has_last_section;
+        int last_chunk_x;
+        int last_chunk_z;
+        /// @brief World Y coordinate of the first block of last section
+        int last_section_min_y;
+        /// @brief nullptr if last section is empty (air) or outside of the world
+        const Section* last_section;
+    };
+} // Botcraft
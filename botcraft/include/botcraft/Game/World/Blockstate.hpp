@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "protocolCraft/BinaryReadWrite.hpp"
 #include "protocolCraft/Utilities/Json.hpp"
 
 #include "botcraft/Game/Enums.hpp"
@@ -20,6 +21,18 @@ namespace Botcraft
     }
 #endif
 
+    /// @brief Contiguous colliders stored in a Blockstate, can be iterated without any copy
+    struct ColliderRange
+    {
+        const AABB* first;
+        const AABB* last;
+
+        const AABB* begin() const { return first; }
+        const AABB* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
     struct BestTool
     {
         ToolType tool_type;
@@ -107,6 +120,26 @@ namespace Botcraft
         /// @param model_ The model of this blockstate
         Blockstate(const BlockstateProperties& properties, const Model& model_);
 
+#if !USE_GUI
+        /// @brief Create a blockstate from data written by WriteCache. Models must have been loaded with ReadModelsCache first
+        /// @param iter Read iterator in the cache data
+        /// @param length Remaining size of the cache data
+        Blockstate(ProtocolCraft::ReadIterator& iter, size_t& length);
+
+        /// @brief Write all the data required to recreate this blockstate without reading any json file
+        /// @param container Container to append the data to
+        void WriteCache(ProtocolCraft::WriteContainer& container) const;
+
+        /// @brief Write the colliders of all the models shared by the blockstates
+        /// @param container Container to append the data to
+        static void WriteModelsCache(ProtocolCraft::WriteContainer& container);
+
+        /// @brief Load the models shared by the blockstates from data written by WriteModelsCache
+        /// @param iter Read iterator in the cache data
+        /// @param length Remaining size of the cache data
+        static void ReadModelsCache(ProtocolCraft::ReadIterator& iter, size_t& length);
+#endif
+
         BlockstateId GetId() const;
         const Model& GetModel(const unsigned short index) const;
         unsigned char GetModelId(const Position& pos) const;
@@ -122,6 +155,17 @@ namespace Botcraft
         const std::string& GetVariableValue(const std::string& variable) const;
         Vector3<double> GetHorizontalOffsetAtPos(const Position& pos) const;
         std::set<AABB> GetCollidersAtPos(const Position& pos) const;
+        /// @brief Get the colliders of the model used at a given position, relative to the block origin
+        /// and without horizontal offset. Add GetHorizontalOffsetAtPos(pos) to get them in world space.
+        /// Doesn't allocate
+        /// @param pos Position of the block, only used to pick the model if there are several
+        /// @return A range of colliders, valid as long as this blockstate
+        ColliderRange GetLocalColliders(const Position& pos) const;
+        /// @brief Append the colliders of this block placed at pos to a vector, in world space.
+        /// Doesn't allocate if output has enough capacity
+        /// @param pos Position of the block
+        /// @param output Vector the colliders are appended to
+        void AppendCollidersAtPos(const Position& pos, std::vector<AABB>& output) const;
         /// @brief Get the closest point on this blockstate placed at block_pos from a reference pos
         /// @param block_pos Block position
         /// @param pos Reference position to find the closest point from
@@ -187,6 +231,8 @@ namespace Botcraft
     private:
         void LoadProperties(const BlockstateProperties& properties);
         void LoadWeightedModels(const std::deque<std::pair<Model, int>>& models_to_load);
+        /// @brief Fill models_colliders from models_indices
+        void LoadModelsColliders();
         bool GetBoolFromCondition(const ProtocolCraft::Json::Value& condition) const;
         /// @brief Check if a given string condition match this blockstate variables
         /// @param condition String to check, example: "layers=1"
@@ -252,6 +298,11 @@ namespace Botcraft
         std::vector<int> models_weights;
         int weights_sum;
 
+        /// @brief Colliders of all models, copied from them in a flat array so physics doesn't have to go through the sets
+        std::vector<AABB> models_colliders;
+        /// @brief Colliders of model i are [models_colliders_start[i], models_colliders_start[i+1]) in models_colliders
+        std::vector<unsigned short> models_colliders_start;
+
         std::vector<BestTool> best_tools;
 
         std::map<const std::string*, const std::string*, string_ptr_compare> variables; // map is smaller in RAM than unordered_map
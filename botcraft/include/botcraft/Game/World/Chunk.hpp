@@ -4,6 +4,7 @@
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 #include "botcraft/Game/Enums.hpp"
@@ -21,6 +22,10 @@ namespace Botcraft
     static constexpr int CHUNK_WIDTH = 16;
     static constexpr int SECTION_HEIGHT = 16;
 
+    /// @brief Identify who loaded a chunk of a shared world. Either a thread, or
+    /// a connection (see NetworkManager::GetConnectionId) for chunks loaded from packets
+    using ChunkLoaderId = std::variant<std::thread::id, size_t>;
+
     class Chunk
     {
     public:
@@ -30,6 +35,8 @@ namespace Botcraft
         Chunk(const int min_y_, const unsigned int height_, const size_t dim_index, const bool has_sky_light_);
 #endif
         Chunk(const Chunk& c);
+        Chunk(Chunk&& c) = default;
+        Chunk& operator=(Chunk&& c) = default;
 
         static Position BlockCoordsToChunkCoords(const Position& pos);
 
@@ -64,17 +71,40 @@ namespace Botcraft
         void SetBlock(const Position& pos, const Blockstate* block);
         void SetBlock(const Position& pos, const BlockstateId id);
 
+        /// @brief Find all the blocks with some given ids in a range of height, using the block index of this chunk.
+        /// Sections without data are not indexed, so air blocks in them won't be found
+        /// @param ids Ids of the blocks to search for
+        /// @param min_y Min Y of the searched blocks
+        /// @param max_y Max Y of the searched blocks
+        /// @param output Vector the positions (in chunk coordinates) of the found blocks are appended to
+        void FindBlocks(const std::vector<BlockstateId>& ids, const int min_y, const int max_y, std::vector<Position>& output) const;
+
         unsigned char GetBlockLight(const Position& pos) const;
         void SetBlockLight(const Position& pos, const unsigned char v);
 
         unsigned char GetSkyLight(const Position& pos) const;
         void SetSkyLight(const Position& pos, const unsigned char v);
 
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+        /// @brief Set all the light values of a section at once
+        /// @param section_y Index of the section in this chunk
+        /// @param data Light values, packed 4 bits per block. If empty, all values are set to 0
+        /// @param sky If true, sky light is set, block light otherwise
+        void LoadSectionLight(const int section_y, const std::vector<char>& data, const bool sky);
+#endif
+
         size_t GetDimensionIndex() const;
         bool GetHasSkyLight() const;
 
         bool HasSection(const int y) const;
         void AddSection(const int y);
+        /// @brief Get all the sections of this chunk
+        /// @return Sections, from bottom to top, nullptr for sections without data
+        const std::vector<std::shared_ptr<Section> >& GetSections() const;
+
+        /// @brief Get the heap memory used to store blocks and lights of this chunk
+        /// @return Size in bytes
+        size_t GetSectionsMemorySize() const;
 
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
         const Biome* GetBiome(const int x, const int z) const;
@@ -91,16 +121,32 @@ namespace Botcraft
 #endif
         void UpdateNeighbour(Chunk* const neighbour, const Orientation direction);
 
-        /// @brief Add a thread to the loaders list
-        /// @param thread_id Id of the thread
-        void AddLoader(const std::thread::id& thread_id);
-        /// @brief Remove a thread from the loaders list
-        /// @param thread_id Id of the thread
+        /// @brief Add a loader to the loaders list
+        /// @param loader_id Id of the loader
+        void AddLoader(const ChunkLoaderId& loader_id);
+        /// @brief Remove a loader from the loaders list
+        /// @param loader_id Id of the loader
         /// @return Number of remaining loaders
-        size_t RemoveLoader(const std::thread::id& thread_id);
+        size_t RemoveLoader(const ChunkLoaderId& loader_id);
+        /// @brief Get all the loaders of this chunk
+        /// @return Ids of the loaders
+        const std::unordered_set<ChunkLoaderId>& GetLoaders() const;
 
     private:
         bool IsInsideChunk(const Position& pos, const bool ignore_gui_borders) const;
+
+        void SetBlockImpl(const Position& pos, const BlockstateId id, const bool update_index);
+
+        /// @brief Rebuild the block index of a section from its current blocks
+        /// @param section_y Index of the section in this chunk
+        void IndexSection(const int section_y);
+
+        /// @brief Update the block index of a section after one of its blocks changed
+        /// @param section_y Index of the section in this chunk
+        /// @param index Index of the block in the section, (y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x
+        /// @param previous_id Stored id of the block before the change
+        /// @param new_id Stored id of the block after the change
+        void UpdateBlockIndex(const int section_y, const unsigned short index, const unsigned short previous_id, const unsigned short new_id);
 #if PROTOCOL_VERSION > 756 /* > 1.17.1 */
         void LoadSectionBiomeData(const int section_y, ProtocolCraft::ReadIterator& iter, size_t& length);
 #endif
@@ -110,6 +156,20 @@ namespace Botcraft
 
         std::unordered_map<Position, ProtocolCraft::NBT::Value> block_entities_data;
 
+        /// @brief All blocks of a section with the same stored id
+        struct BlockIndexEntry
+        {
+            unsigned short id;
+            unsigned short count;
+            /// @brief If false, there were too many blocks to store their
+            /// positions, and they must be found by scanning the section
+            bool positions_stored;
+            /// @brief Sorted indices of the blocks in the section
+            std::vector<unsigned short> positions;
+        };
+        /// @brief For each section, the entries of all the ids it contains, sorted by id
+        std::vector<std::vector<BlockIndexEntry> > block_index;
+
         size_t dimension_index;
         bool has_sky_light;
 
@@ -123,6 +183,6 @@ namespace Botcraft
 #if USE_GUI
         bool modified_since_last_rendered;
 #endif
-        std::unordered_set<std::thread::id> loaded_from;
+        std::unordered_set<ChunkLoaderId> loaded_from;
     };
 } // Botcraft
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Utilities/ScopeLockedWrapper.hpp"
+
+namespace Botcraft
+{
+    /// @brief A set of loaded chunks, protected by its own mutex.
+    /// Chunks are stored in an open-addressing hash table (linear probing)
+    class TerrainShard
+    {
+    public:
+        using value_type = std::pair<const std::pair<int, int>, Chunk>;
+
+        TerrainShard();
+        ~TerrainShard();
+
+        TerrainShard(const TerrainShard&) = delete;
+        TerrainShard& operator=(const TerrainShard&) = delete;
+
+        /// @brief Get the mutex protecting this shard
+        std::shared_mutex& GetMutex() const;
+
+        /// @brief Number of chunks in this shard. Not thread-safe
+        size_t Size() const;
+
+        /// @brief Find a chunk. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @return Pointer to the chunk, nullptr if not in this shard. Invalidated by Insert and Erase
+        Chunk* Find(const int x, const int z);
+        const Chunk* Find(const int x, const int z) const;
+
+        /// @brief Insert a chunk if not already there. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @param chunk Chunk to insert
+        /// @return Pointer to the chunk at x, z and true if it has been inserted
+        std::pair<Chunk*, bool> Insert(const int x, const int z, Chunk&& chunk);
+
+        /// @brief Remove a chunk. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @return True if a chunk has been removed
+        bool Erase(const int x, const int z);
+
+        /// @brief Number of slots in the table, to iterate with GetSlot. Not thread-safe
+        size_t GetCapacity() const;
+
+        /// @brief Get the content of a slot. Not thread-safe
+        /// @param index Slot index, must be < GetCapacity()
+        /// @return Chunk stored in this slot, nullptr if empty
+        const value_type* GetSlot(const size_t index) const;
+        value_type* GetSlot(const size_t index);
+
+    private:
+        /// @brief Find the slot containing x, z
+        /// @return Slot index, or slots.size() if not found
+        size_t FindSlot(const int x, const int z) const;
+        void Rehash(const size_t new_capacity);
+
+        static size_t Hash(const int x, const int z);
+
+    private:
+        std::vector<std::optional<value_type> > slots;
+        size_t num_chunks;
+        mutable std::shared_mutex mutex;
+    };
+
+    /// @brief All loaded chunks, split in shards. All chunks of the same region
+    /// (a square of region_width * region_width chunks) are in the same shard.
+    /// Each shard has its own lock, so an update in one region doesn't block
+    /// the others
+    class Terrain
+    {
+    public:
+        static constexpr int region_width = 32;
+        static constexpr size_t num_shards = 64;
+
+        /// @brief Index of the shard storing a chunk
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        static size_t GetShardIndex(const int x, const int z);
+
+        TerrainShard& GetShard(const int x, const int z);
+        const TerrainShard& GetShard(const int x, const int z) const;
+        TerrainShard& GetShard(const size_t index);
+        const TerrainShard& GetShard(const size_t index) const;
+
+    private:
+        std::array<TerrainShard, num_shards> shards;
+    };
+
+    /// @brief Read-only view of all the loaded chunks. Shards are locked one at a time
+    /// while iterating, only updates in the shard currently visited are blocked.
+    /// Can be used as a pointer to itself, for compatibility with previous ScopeLockedWrapper
+    /// API (view->size(), for (... : *view))
+    class TerrainView
+    {
+    public:
+        class Iterator
+        {
+        public:
+            Iterator(const Terrain* terrain_, const size_t shard_index_);
+
+            const TerrainShard::value_type& operator*() const;
+            const TerrainShard::value_type* operator->() const;
+            Iterator& operator++();
+            bool operator==(const Iterator& other) const;
+            bool operator!=(const Iterator& other) const;
+
+        private:
+            /// @brief Move to the next chunk, starting at current slot, locking the next shard if required
+            void Advance();
+
+        private:
+            const Terrain* terrain;
+            size_t shard_index;
+            size_t slot_index;
+            std::shared_lock<std::shared_mutex> lock;
+        };
+
+        TerrainView(const Terrain& terrain_);
+
+        Iterator begin() const;
+        Iterator end() const;
+
+        /// @brief Get the number of loaded chunks. As shards are locked one at a
+        /// time, this may not be consistent if chunks are loaded in parallel
+        size_t size() const;
+
+        /// @brief Get a chunk, its shard is locked while the returned object is alive
+        /// @param coords Chunk coordinates
+        /// @return A locked pointer to the chunk. Throw std::out_of_range if not loaded
+        Utilities::ScopeLockedWrapper<const Chunk, std::shared_mutex, std::shared_lock> at(const std::pair<int, int>& coords) const;
+
+        const TerrainView* operator->() const;
+        /// @brief Return a copy so it's still valid when used as range-for expression
+        TerrainView operator*() const;
+
+    private:
+        const Terrain* terrain;
+    };
+} // Botcraft
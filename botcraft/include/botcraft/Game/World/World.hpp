@@ -1,16 +1,20 @@
 #pragma once
 
 #include <atomic>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "botcraft/Game/Enums.hpp"
+#include "botcraft/Game/World/BlockCursor.hpp"
 #include "botcraft/Game/World/Blockstate.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/Terrain.hpp"
 #include "botcraft/Game/Vector3.hpp"
-#include "botcraft/Utilities/ScopeLockedWrapper.hpp"
 
 #include "protocolCraft/Handler.hpp"
 
@@ -32,6 +36,9 @@ namespace std
 namespace Botcraft
 {
     class Biome;
+    class BlockChangeLog;
+    class ChunkIndex;
+    class NavigationGraph;
 
     class World : public ProtocolCraft::Handler
     {
@@ -82,24 +89,24 @@ namespace Botcraft
         /// @param z Z chunk coordinate
         /// @param dim Dimension in which the chunk is added
         /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void LoadChunk(const int x, const int z, const Dimension dim, const std::thread::id& loader_id = std::this_thread::get_id());
+        void LoadChunk(const int x, const int z, const Dimension dim, const ChunkLoaderId& loader_id = std::this_thread::get_id());
 #else
         /// @brief Add a chunk at given coordinates. If already exists in another dimension, will be erased first. Thread-safe
         /// @param x X chunk coordinate
         /// @param z Z chunk coordinate
         /// @param dim Dimension in which the chunk is added
         /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void LoadChunk(const int x, const int z, const std::string& dim, const std::thread::id& loader_id = std::this_thread::get_id());
+        void LoadChunk(const int x, const int z, const std::string& dim, const ChunkLoaderId& loader_id = std::this_thread::get_id());
 #endif
         /// @brief Remove a chunk at given coordinates. Thread-safe
         /// @param x X chunk coordinate
         /// @param z Z chunk coordinate
         /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void UnloadChunk(const int x, const int z, const std::thread::id& loader_id = std::this_thread::get_id());
+        void UnloadChunk(const int x, const int z, const ChunkLoaderId& loader_id = std::this_thread::get_id());
 
         /// @brief Remove all chunks from memory
         /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void UnloadAllChunks(const std::thread::id& loader_id = std::this_thread::get_id());
+        void UnloadAllChunks(const ChunkLoaderId& loader_id = std::this_thread::get_id());
 
 
         /// @brief Set block at given pos. Does nothing if pos is not loaded. Thread-safe
@@ -117,22 +124,68 @@ namespace Botcraft
         /// @return A vector of const pointer to the blockstate at each position, nullptr if not loaded
         std::vector<const Blockstate*> GetBlocks(const std::vector<Position>& pos) const;
 
+        /// @brief Get a cursor to efficiently read a lot of blocks in the same area. Thread-safe,
+        /// but the returned cursor must only be used by the calling thread
+        /// @return A BlockCursor reading this world's blocks
+        BlockCursor GetBlockCursor() const;
+
         /// @brief Get all colliders that could collide with a given AABB. Thread-safe
         /// @param aabb AABB of the blocks to search for
         /// @param movement Optional movement vector that will be added to the AABB
         /// @return A vector of solid colliders
         std::vector<AABB> GetColliders(const AABB& aabb, const Vector3<double>& movement = Vector3<double>(0.0)) const;
 
+        /// @brief Same as GetColliders, but fill a caller-provided vector. Doesn't allocate
+        /// if output already has enough capacity, so reusing the same vector is allocation-free. Thread-safe
+        /// @param aabb AABB of the blocks to search for
+        /// @param movement Movement vector that will be added to the AABB
+        /// @param output Vector cleared and filled with the solid colliders
+        void GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output) const;
+
+        /// @brief Find blocks with a given name around a position, using the block index of the loaded chunks. Thread-safe
+        /// @param name Name of the blocks to search for (e.g. "minecraft:chest")
+        /// @param center Center of the search
+        /// @param radius Max (euclidean) distance between center and a returned block
+        /// @param max_results Max number of blocks returned, only the nearest ones are kept
+        /// @return Positions of the blocks, nearest first
+        std::vector<Position> FindBlocks(const std::string& name, const Position& center, const int radius,
+            const size_t max_results = std::numeric_limits<size_t>::max()) const;
+        /// @brief Find blocks with given ids around a position, using the block index of the loaded chunks. Thread-safe
+        /// @param ids Ids of the blocks to search for
+        /// @param center Center of the search
+        /// @param radius Max (euclidean) distance between center and a returned block
+        /// @param max_results Max number of blocks returned, only the nearest ones are kept
+        /// @return Positions of the blocks, nearest first
+        std::vector<Position> FindBlocks(const std::vector<BlockstateId>& ids, const Position& center, const int radius,
+            const size_t max_results = std::numeric_limits<size_t>::max()) const;
+
+        /// @brief Find a coarse route between two positions through the loaded chunks. Much faster than FindPath
+        /// on long distances, but with simplified movement rules, so each part of the route should be refined with
+        /// FindPath. Chunks navigation data is cached and updated when blocks change. Thread-safe
+        /// @param start Feet position at the start
+        /// @param end Feet position to reach
+        /// @return Standing positions from start to end, consecutive positions being in the same or in adjacent chunks.
+        /// Empty if start or end are too far from a standing position, or if no route was found
+        std::vector<Position> FindRoute(const Position& start, const Position& end) const;
+
+        /// @brief Get the blocks changed since a previous call, to update data derived from the world
+        /// instead of recomputing it. Only the last few thousands changes are kept. Thread-safe
+        /// @param since In: value set by the previous call, 0 on the first call (no change is returned). Out: value for the next call
+        /// @param blocks Cleared and filled with the positions of the blocks set since the previous call
+        /// @param chunks Cleared and filled with the coordinates of the chunks loaded or unloaded since the previous call
+        /// @return False if some changes are too old to be known, in which case everything must be considered as changed
+        bool GetChanges(unsigned long long int& since, std::vector<Position>& blocks, std::vector<std::pair<int, int>>& chunks) const;
+
         /// @brief Get the flow of fluid at a given position
         /// @param pos Block position
         /// @return A Vector3 of fluid flow
         Vector3<double> GetFlow(const Position& pos);
 
-        /// @brief Get a read-only locked version of all the loaded chunks
-        /// @return Basically an object you can use as a std::unordered_map<std::pair<int, int>, Chunk>*.
-        /// **ALL WORLD UPDATE WILL BE BLOCKED WHILE THIS OBJECT IS ALIVE**, make sure it goes out of scope
-        /// as soon as you don't need it.
-        Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock> GetChunks() const;
+        /// @brief Get a read-only view of all the loaded chunks
+        /// @return An object you can iterate on like a std::unordered_map<std::pair<int, int>, Chunk>.
+        /// Terrain shards are locked one at a time while iterating, **UPDATES IN THE SHARD BEING ITERATED ARE
+        /// BLOCKED**, make sure iterators go out of scope as soon as you don't need them.
+        TerrainView GetChunks() const;
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
         /// @brief Set biome of given block column. Does nothing if not loaded. Thread-safe
@@ -289,11 +342,29 @@ namespace Botcraft
 
     private:
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-        void LoadChunkImpl(const int x, const int z, const Dimension dim, const std::thread::id& loader_id);
+        void LoadChunkImpl(const int x, const int z, const Dimension dim, const ChunkLoaderId& loader_id);
+#else
+        void LoadChunkImpl(const int x, const int z, const std::string& dim, const ChunkLoaderId& loader_id);
+#endif
+        void UnloadChunkImpl(const int x, const int z, const ChunkLoaderId& loader_id);
+
+        /// @brief Create an empty chunk in a given dimension. world_mutex must be locked
+        /// @param dim Dimension of the chunk
+        /// @return The created chunk
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+        Chunk CreateChunkImpl(const Dimension dim);
 #else
-        void LoadChunkImpl(const int x, const int z, const std::string& dim, const std::thread::id& loader_id);
+        Chunk CreateChunkImpl(const std::string& dim);
+#endif
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        /// @brief Replace the chunk at x, z with an already loaded one. Loaders of the
+        /// previous chunk are kept if it is in the same dimension. Chunk shard must be locked
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @param chunk Loaded chunk. Is swapped with the previous chunk so it can be freed after releasing the lock
+        /// @param loader_id Id of the thread loading this chunk
+        void PublishChunkImpl(const int x, const int z, Chunk& chunk, const ChunkLoaderId& loader_id);
 #endif
-        void UnloadChunkImpl(const int x, const int z, const std::thread::id& loader_id);
 
         void SetBlockImpl(const Position& pos, const BlockstateId id);
         const Blockstate* GetBlockImpl(const Position& pos) const;
@@ -326,12 +397,24 @@ namespace Botcraft
         /// @param chunk_z Chunk Z
         void UpdateChunk(const int chunk_x, const int chunk_z);
 
-        /// @brief Get a pointer to a chunk. Not thread-safe
+        /// @brief Get a pointer to a chunk. Chunk shard must be locked
         /// @param x Chunk X
         /// @param z Chunk Z
         /// @return Pointer to the chunk, or nullptr if not loaded
         Chunk* GetChunk(const int x, const int z);
 
+#if USE_GUI
+        using TerrainWriteLock = std::vector<std::unique_lock<std::shared_mutex> >;
+#else
+        using TerrainWriteLock = std::unique_lock<std::shared_mutex>;
+#endif
+        /// @brief Lock the shard of a chunk for writing. With GUI enabled, the
+        /// shards of its neighbours are locked too as their borders are updated
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @return The lock(s), shards are unlocked when destroyed
+        TerrainWriteLock LockChunkForWrite(const int x, const int z);
+
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
         void LoadDataInChunk(const int x, const int z, const std::vector<unsigned char>& data,
             const int primary_bit_mask, const bool ground_up_continuous);
@@ -355,12 +438,10 @@ namespace Botcraft
         void LoadBiomesInChunk(const int x, const int z, const std::vector<int>& biomes);
 #endif
 
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 719 /* < 1.16 */
-        void UpdateChunkLight(const int x, const int z, const Dimension dim, const int light_mask, const int empty_light_mask, const std::vector<std::vector<char> >& data, const bool sky);
-#elif PROTOCOL_VERSION > 718 /* > 1.15.2 */ && PROTOCOL_VERSION < 755 /* < 1.17 */
-        void UpdateChunkLight(const int x, const int z, const std::string& dim, const int light_mask, const int empty_light_mask, const std::vector<std::vector<char> >& data, const bool sky);
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 755 /* < 1.17 */
+        static void UpdateChunkLight(Chunk& chunk, const int light_mask, const int empty_light_mask, const std::vector<std::vector<char> >& data, const bool sky);
 #elif PROTOCOL_VERSION > 754 /* > 1.16.5 */
-        void UpdateChunkLight(const int x, const int z, const std::string& dim,
+        static void UpdateChunkLight(Chunk& chunk,
             const std::vector<unsigned long long int>& light_mask, const std::vector<unsigned long long int>& empty_light_mask,
             const std::vector<std::vector<char> >& data, const bool sky);
 #endif
@@ -372,8 +453,18 @@ namespace Botcraft
 #endif
 
     private:
-        std::unordered_map<std::pair<int, int>, Chunk> terrain;
+        /// @brief Loaded chunks, each shard has its own mutex. When
+        /// both are required, world_mutex must be locked first
+        Terrain terrain;
+        /// @brief Protect dimensions data (current dimension, height...)
         mutable std::shared_mutex world_mutex;
+        /// @brief Blocks of terrain, readable without locking world_mutex.
+        /// Must be updated each time sections of a chunk are added/removed
+        std::unique_ptr<ChunkIndex> chunk_index;
+        /// @brief Coarse navigation data of the chunks, used by FindRoute
+        std::unique_ptr<NavigationGraph> navigation_graph;
+        /// @brief Last block changes, see GetChanges
+        std::unique_ptr<BlockChangeLog> change_log;
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 757 /* < 1.18 */
         std::unordered_map<std::pair<int, int>, ProtocolCraft::ClientboundLightUpdatePacket> delayed_light_updates;
@@ -389,6 +480,9 @@ namespace Botcraft
         std::unordered_map<std::string, size_t> dimension_index_map;
         std::unordered_map<size_t, std::string> index_dimension_map;
 #endif
+        /// @brief Protect dimension_index_map and index_dimension_map, as chunks
+        /// can be created in multiple shards at the same time
+        mutable std::mutex dimension_index_mutex;
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
         std::atomic<int> world_interaction_sequence_id;
@@ -3,8 +3,9 @@
 #include "protocolCraft/Handler.hpp"
 #include "protocolCraft/enums.hpp"
 
+#include "botcraft/Network/PacketBufferPool.hpp"
+
 #include <vector>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -15,11 +16,18 @@
 #if PROTOCOL_VERSION > 760 /* > 1.19.2 */
 #include <atomic>
 #endif
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+#include <deque>
+#include <future>
+#endif
 
 namespace Botcraft
 {
     class TCP_Com;
     class Authentifier;
+    class Compressor;
+    class Decompressor;
+    class NetworkStrand;
 
     class NetworkManager : public ProtocolCraft::Handler
     {
@@ -40,12 +48,53 @@ namespace Botcraft
         void SendChatMessage(const std::string& message);
         void SendChatCommand(const std::string& command);
 
+        /// @brief Get the id of the thread processing the packets of this connection
+        /// @return The processing thread id, a default id if packets are processed on shared threads
         std::thread::id GetProcessingThreadId() const;
 
+        /// @brief Get a unique id for this connection
+        size_t GetConnectionId() const;
+
+        /// @brief Get the id of the connection whose packets are currently handled by the calling thread
+        /// @return The connection id, 0 if this thread is not processing packets
+        static size_t GetCurrentConnectionId();
+
+        /// @brief Make all the NetworkManager created after this call share a pool of threads,
+        /// instead of each one running its own network and processing threads. Packets of each
+        /// connection are still processed one at a time, in the order they are received.
+        /// Useful to run a lot of bots in the same process. Can't be disabled once called
+        /// @param num_threads Number of network threads and of processing threads, 0 to use the number of cores
+        static void UseSharedThreads(const size_t num_threads = 0);
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        /// @brief Set the number of threads used to decompress and parse the packets of a chunk batch.
+        /// Packets are still dispatched to the handlers in order on the processing thread.
+        /// Takes effect at the start of the next chunk batch
+        /// @param num_threads Number of decoding threads, 0 (default) to decode everything on the processing thread
+        void SetChunkBatchDecodingThreads(const size_t num_threads);
+#endif
+
     private:
         void WaitForNewPackets();
-        void ProcessPacket(const std::vector<unsigned char>& bytes);
-        void OnNewRawData(const std::vector<unsigned char>& bytes);
+        /// @brief Process all received packets until packets_to_process is empty
+        /// @param packets Vector swapped with packets_to_process, so both keep their capacity
+        void ProcessPackets(std::vector<PacketBuffer>& packets);
+        /// @brief Process packets on the shared threads, always running on processing_strand
+        void ProcessPacketsOnStrand();
+        void DispatchPacket(const std::shared_ptr<ProtocolCraft::Packet>& packet);
+        void OnNewRawData(const unsigned char* data, const size_t length);
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        /// @brief Send a packet to the decoding threads
+        /// @param bytes Raw packet data
+        void SubmitDecoding(const PacketBuffer& bytes);
+        /// @brief Dispatch decoded packets, in the order they were submitted
+        /// @param max_pending Wait for packets to be decoded until no more than max_pending are left
+        void DispatchDecodedPackets(const size_t max_pending);
+        void StartDecodingThreads(const size_t num_threads);
+        void StopDecodingThreads();
+        void DecodePackets();
+#endif
 
 
         virtual void Handle(ProtocolCraft::ClientboundLoginCompressionPacket& packet) override;
@@ -90,14 +139,32 @@ namespace Botcraft
         std::shared_ptr<Authentifier> authentifier;
         ProtocolCraft::ConnectionState state;
 
-        std::thread m_thread_process;//Thread running to process incoming packets without blocking com
+        size_t connection_id;
 
-        std::queue<std::vector<unsigned char> > packets_to_process;
+        std::thread m_thread_process;//Thread running to process incoming packets without blocking com
+        /// @brief Used instead of m_thread_process when processing packets on the shared threads
+        std::shared_ptr<NetworkStrand> processing_strand;
+        /// @brief True if ProcessPacketsOnStrand is queued or running, protected by mutex_process
+        bool processing_scheduled;
+        /// @brief Set to false when stopping, so no more processing is queued. Protected by mutex_process
+        bool processing_running;
+
+        /// @brief Buffers for raw and decompressed packets. Declared before
+        /// anything holding a PacketBuffer so it's destroyed after them
+        PacketBufferPool buffer_pool;
+        /// @brief Raw packets received, swapped with an empty vector by the processing thread
+        std::vector<PacketBuffer> packets_to_process;
+        /// @brief Swapped with packets_to_process, only used on processing_strand
+        std::vector<PacketBuffer> strand_packets;
         std::mutex mutex_process;
         std::condition_variable process_condition;
         int compression;
 
         std::mutex mutex_send;
+        /// @brief Compression state, protected by mutex_send
+        std::shared_ptr<Compressor> compressor;
+        /// @brief Decompression state, only used by the processing thread
+        std::shared_ptr<Decompressor> decompressor;
 
         std::string name;
 
@@ -111,6 +178,25 @@ namespace Botcraft
 
 #if PROTOCOL_VERSION > 763 /* > 1.20.1 */
         std::chrono::steady_clock::time_point chunk_batch_start_time;
+        bool in_chunk_batch;
+
+        struct PendingPacket
+        {
+            PacketBuffer bytes;
+            /// @brief Connection state used to parse this packet
+            ProtocolCraft::ConnectionState state;
+            std::future<std::shared_ptr<ProtocolCraft::Packet> > packet;
+        };
+
+        std::atomic<size_t> chunk_batch_decoding_threads;
+        std::vector<std::thread> decoding_threads;
+        /// @brief Decoding jobs, called with the decoding thread decompressor (nullptr if compression is not available)
+        std::deque<std::packaged_task<std::shared_ptr<ProtocolCraft::Packet>(Decompressor*)> > decoding_jobs;
+        std::mutex decoding_mutex;
+        std::condition_variable decoding_condition;
+        bool decoding_running;
+        /// @brief Packets sent to the decoding threads, not dispatched yet. Only used by the processing thread
+        std::deque<PendingPacket> pending_packets;
 #endif
 
     };
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Botcraft
+{
+    class PacketBufferPool;
+
+    /// @brief Storage of a PacketBuffer, owned by its pool
+    struct PacketBufferNode
+    {
+        std::vector<unsigned char> bytes;
+        std::atomic<int> ref_count;
+        PacketBufferPool* pool;
+    };
+
+    /// @brief Ref-counted handle on a byte buffer coming from a PacketBufferPool.
+    /// Copying a handle doesn't copy the data. The buffer goes back to
+    /// its pool (keeping its capacity) when the last handle is destroyed
+    class PacketBuffer
+    {
+    public:
+        /// @brief Create an empty handle, not pointing to any buffer
+        PacketBuffer();
+        PacketBuffer(const PacketBuffer& other);
+        PacketBuffer(PacketBuffer&& other) noexcept;
+        ~PacketBuffer();
+
+        PacketBuffer& operator=(const PacketBuffer& other);
+        PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+
+        /// @brief Check if this handle points to a buffer
+        explicit operator bool() const;
+
+        /// @brief Get the buffer bytes. Must not be called on an empty handle
+        std::vector<unsigned char>& operator*() const;
+        std::vector<unsigned char>* operator->() const;
+
+    private:
+        explicit PacketBuffer(PacketBufferNode* node_);
+
+        /// @brief Give up this handle reference, giving the buffer back if it was the last one
+        void Release();
+
+        friend class PacketBufferPool;
+
+    private:
+        PacketBufferNode* node;
+    };
+
+    /// @brief Pool of reusable byte buffers, used to move packets from the
+    /// socket to the parser without allocating in steady state.
+    /// Thread-safe. Must outlive all the buffers it gave.
+    class PacketBufferPool
+    {
+    public:
+        PacketBufferPool();
+        ~PacketBufferPool();
+
+        PacketBufferPool(const PacketBufferPool&) = delete;
+        PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+        /// @brief Get a buffer from the pool, allocating it if none is available
+        /// @param size Size of the returned buffer. Content is unspecified
+        /// @return A handle on the buffer
+        PacketBuffer Acquire(const size_t size);
+
+    private:
+        /// @brief Called when the last handle on node is destroyed
+        void Release(PacketBufferNode* node);
+
+        friend class PacketBuffer;
+
+    private:
+        std::mutex mutex;
+        std::vector<PacketBufferNode*> free_nodes;
+    };
+} // Botcraft
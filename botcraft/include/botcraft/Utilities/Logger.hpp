@@ -3,7 +3,11 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -30,12 +34,9 @@ constexpr const char* file_name(const char* path)
     if (level < logger.GetLogLevel())                                       \
         break;                                                              \
     std::ostringstream logger_ostringstream;                                \
-    logger_ostringstream << logger.GetDate().rdbuf()                        \
-    << ' ' << Botcraft::Logger::level_strings[static_cast<size_t>(level)]   \
-    << " [" << logger.GetThreadName(std::this_thread::get_id())             \
-    << "(" << std::this_thread::get_id() << ")] "                           \
-    << file_name(__FILE__) << '(' << __LINE__ << "): " << osstream << '\n'; \
-    logger.Log(logger_ostringstream.str());                                 \
+    logger_ostringstream << osstream;                                       \
+    logger.Log(level, file_name(__FILE__), __LINE__,                        \
+        logger_ostringstream.str());                                        \
 } while(0)
 
 #define LOG_TRACE(osstream)   LOG(osstream, Botcraft::LogLevel::Trace)
@@ -47,6 +48,12 @@ constexpr const char* file_name(const char* path)
 
 namespace Botcraft
 {
+    namespace Utilities
+    {
+        template<class T>
+        class MPSCRingBuffer;
+    }
+
     enum class LogLevel
     {
         Trace,
@@ -60,6 +67,23 @@ namespace Botcraft
     };
     std::ostream& operator<<(std::ostream& os, const LogLevel v);
 
+    /// @brief A message waiting to be written by the logger thread
+    struct LogEntry
+    {
+        std::chrono::system_clock::time_point time;
+        LogLevel level = LogLevel::Info;
+        /// @brief Source file name, nullptr if message is already formatted
+        const char* file = nullptr;
+        int line = 0;
+        /// @brief "[name(id)]" of the thread that logged this entry
+        std::shared_ptr<const std::string> thread;
+        std::string message;
+    };
+
+    /// @brief Logs are pushed to a lock-free queue and formatted/written by a
+    /// background thread, so logging threads never wait for each other or for IO.
+    /// If the queue stays full for too long, messages below Error are dropped
+    /// and a warning is written instead
     class Logger
     {
     private:
@@ -82,13 +106,34 @@ namespace Botcraft
         ~Logger();
 
         static Logger& GetInstance();
+
+        /// @brief Queue a message to be written, formatted with date, level, thread and location.
+        /// Fatal messages are written before returning
+        /// @param level Level of the message
+        /// @param file Source file name, must be a string literal
+        /// @param line Source line
+        /// @param message Message to log
+        void Log(const LogLevel level, const char* file, const int line, std::string&& message);
+
+        /// @brief Queue an already formatted message to be written as is
+        /// @param s Message to log
         void Log(const std::string& s);
+
+        /// @brief Write all messages queued so far before returning
+        void Flush();
+
         void SetFilename(const std::string& s);
         void SetLogLevel(const LogLevel l);
         LogLevel GetLogLevel() const;
+
+        /// @brief Set the function called with each formatted message. Called from the logger thread
+        /// @param f Function to call, nullptr to write to stdout
         void SetLogFunc(const std::function<void(const std::string&)>& f);
         std::stringstream GetDate() const;
 
+        /// @brief Get the number of messages dropped because the queue was full
+        size_t GetNumDroppedMessages() const;
+
         /// @brief Register the current thread in the map. It will be automatically removed on thread exit.
         /// @param name Thread name
         void RegisterThread(const std::string& name);
@@ -108,15 +153,50 @@ namespace Botcraft
         void UnregisterThread(const std::thread::id id);
 
     private:
+        /// @brief Get "[name(id)]" for the current thread, cached until a thread name changes
+        std::shared_ptr<const std::string> GetCurrentThreadPrefix();
+
+        void Push(LogEntry&& entry);
+
+        void WriterLoop();
+
+        /// @brief Write all queued entries. mutex must be locked
+        /// @return False if the queue was empty
+        bool ProcessQueue();
+
+        /// @brief Format an entry and append it to output. mutex must be locked
+        void Format(const LogEntry& entry, std::string& output);
+
+        /// @brief Send formatted messages to log_func and file. mutex must be locked
+        void Output(const std::string& s);
+
+    private:
+        static constexpr size_t queue_capacity = 16384;
+
+        /// @brief Protects everything on the writing side, only its owner can pop from queue
         std::mutex mutex;
         std::string filename;
+        std::ofstream file;
         std::atomic<LogLevel> log_level;
         std::function<void(const std::string&)> log_func;
+        std::chrono::steady_clock::time_point last_time_flushed;
+
+        std::unique_ptr<Utilities::MPSCRingBuffer<LogEntry> > queue;
+        std::atomic<size_t> num_dropped;
+        size_t num_dropped_reported;
+
+        std::thread writer_thread;
+        std::condition_variable writer_cv;
+        std::atomic<bool> writer_waiting;
+        std::atomic<bool> running;
 
-        std::chrono::steady_clock::time_point last_time_logged;
-        std::string file_buffer;
+        /// @brief Cached date prefix, to only format it once per second
+        std::time_t cached_date_time;
+        std::string cached_date;
 
         std::mutex thread_mutex;
         std::unordered_map<std::thread::id, std::string> thread_names;
+        /// @brief Incremented each time thread_names changes, to invalidate per-thread caches
+        std::atomic<size_t> thread_names_version;
     };
 }
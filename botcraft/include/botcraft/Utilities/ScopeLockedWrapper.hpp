@@ -17,6 +17,8 @@ namespace Botcraft::Utilities
     {
     public:
         ScopeLockedWrapper(T& val, Mutex& mutex) : v(val), lock(mutex) { }
+        /// @brief Take ownership of an already acquired (movable) lock
+        ScopeLockedWrapper(T& val, Lock<Mutex>&& lock_) : v(val), lock(std::move(lock_)) { }
 
         T* operator->() const { return &v; }
         T& operator*() const { return v; }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+#include "botcraft/Game/World/World.hpp"
+
+namespace Botcraft
+{
+    class BlockCursor;
+
+    /// @brief Path planner keeping its search from one call to the next (Lifelong Planning A*).
+    /// The explored graph, with the moves found from each node, is kept between calls. Blocks
+    /// changed in the world since the previous call are read from World::GetChanges, only the
+    /// nodes that could see them are expanded again, and the search tree is repaired from there
+    /// instead of being recomputed. Moves are the same as FindPath. Not thread-safe
+    class IncrementalPathfinder
+    {
+    public:
+        /// @param allow_jump_ If true, allow to jump above 1-wide gaps
+        /// @param takes_damage_ If true, avoid dangerous paths
+        /// @param step_height_ Max height the player can step on without jumping
+        IncrementalPathfinder(const bool allow_jump_, const bool takes_damage_, const float step_height_);
+        ~IncrementalPathfinder();
+
+        /// @brief Find the shortest path between two positions, reusing the previous search
+        /// @param world World to search in, must be the same for all calls
+        /// @param start Feet position at the start
+        /// @param end Feet position to reach
+        /// @return Positions (and feet height) from the one after start to end, same as FindPath.
+        /// Empty if end can't be reached, or not within the search budget
+        std::vector<std::pair<Position, float>> FindPath(const World& world, const Position& start, const Position& end);
+
+        /// @brief Read the blocks changed since the previous call and update the explored graph accordingly
+        /// @param world World to search in, must be the same for all calls
+        /// @return True if the current search tree has to be repaired, i.e. next FindPath could return a different path
+        bool Update(const World& world);
+
+        /// @brief Get the number of nodes read from the world (new or changed nodes) since the last FindPath started
+        size_t GetNumExpansions() const;
+
+        /// @brief Get the number of nodes of the explored graph
+        size_t GetNumNodes() const;
+
+    private:
+        static constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+        struct Node
+        {
+            std::pair<Position, float> pos; // <Block in which the feet are, feet height>
+            float g; // distance from start, as of last expansion
+            float rhs; // distance from start, computed from the predecessors
+            float heuristic; // distance to end
+            uint32_t heap_index; // invalid_index if not in the open set
+            uint32_t first_out; // first edge going out of this node
+            uint32_t first_in; // first edge coming in this node
+            uint32_t next_in_column; // next node with the same x and z
+            bool expanded;
+            bool dirty;
+        };
+
+        struct Edge
+        {
+            uint32_t from;
+            uint32_t to;
+            float cost;
+            uint32_t next_out;
+            uint32_t next_in;
+        };
+
+        struct NodeHash
+        {
+            size_t operator()(const std::pair<Position, float>& pos) const;
+        };
+
+        /// @brief Forget everything and start a new search
+        void Clear(const Position& end);
+
+        /// @brief Forget the costs of the current search but keep the explored graph, and set a new start
+        void ResetSearch(BlockCursor& cursor, const Position& start);
+
+        /// @brief Read the moves from a node and update its edges
+        void Expand(BlockCursor& cursor, const uint32_t node);
+        /// @brief Mark the expanded nodes that read a given block as dirty
+        void MarkDirty(const Position& block);
+        /// @brief Expand again all the dirty nodes
+        void ExpandDirty(BlockCursor& cursor);
+
+        uint32_t GetOrCreate(const std::pair<Position, float>& pos);
+        void AddEdge(const uint32_t from, const uint32_t to, const float cost);
+        void RemoveOutEdges(const uint32_t node);
+
+        /// @brief Compute rhs of a node and update its place in the open set
+        void UpdateNode(const uint32_t node);
+        /// @brief Check if the goal is up to date, i.e. no node of the open set can change the path to it
+        bool IsSearchDone() const;
+        /// @brief Process the open set until the goal is up to date
+        /// @return False if the search budget was exceeded
+        bool ComputeShortestPath(BlockCursor& cursor);
+        /// @brief Follow the best predecessors from the goal to the start
+        std::vector<std::pair<Position, float>> ExtractPath() const;
+
+        bool IsKeyLess(const uint32_t a, const uint32_t b) const;
+        void HeapPush(const uint32_t node);
+        void HeapRemove(const uint32_t node);
+        void HeapUpdate(const uint32_t node);
+        void SiftUp(uint32_t heap_pos);
+        void SiftDown(uint32_t heap_pos);
+
+    private:
+        const bool allow_jump;
+        const bool takes_damage;
+        const float step_height;
+        int min_y;
+
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+        std::vector<uint32_t> free_edges;
+        std::unordered_map<std::pair<Position, float>, uint32_t, NodeHash> nodes_map;
+        /// @brief First node of each x, z column
+        std::unordered_map<std::pair<int, int>, uint32_t> columns;
+        /// @brief Node indices, sorted as a min binary heap on the LPA* key
+        std::vector<uint32_t> heap;
+
+        /// @brief Virtual node reached with a 0 cost edge from all the nodes at end
+        uint32_t goal;
+        uint32_t start;
+        Position end;
+
+        /// @brief See World::GetChanges
+        unsigned long long int changes_since;
+        std::vector<Position> changed_blocks;
+        std::vector<std::pair<int, int>> changed_chunks;
+        std::vector<uint32_t> dirty_nodes;
+        /// @brief Targets of the edges of a node before its expansion
+        std::vector<uint32_t> previous_targets;
+
+        size_t num_expansions;
+    };
+} // Botcraft
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    /// @brief A path computed in the background by the PathPlanningService. The path is
+    /// published in consecutive segments as soon as they are computed, so the beginning
+    /// of the path can be followed while the rest is still being searched
+    class PathPlanningJob
+    {
+    public:
+        PathPlanningJob();
+
+        /// @brief Ask the search to stop. Segments already published can still be read
+        void Cancel();
+
+        /// @brief Check if Cancel has been called
+        bool IsCancelled() const;
+
+        /// @brief Check if the search is over and all its segments have been read
+        bool IsDone() const;
+
+        /// @brief Get the next segment of the path
+        /// @param segment Filled with the <feet block position, Y position> of the segment, same as FindPath
+        /// @return False if no new segment is available (yet)
+        bool PopSegment(std::vector<std::pair<Position, float>>& segment);
+
+        /// @brief Publish the next segment of the path. Called by the search function
+        /// @param segment Positions following the ones of the previous segment
+        void PushSegment(std::vector<std::pair<Position, float>>&& segment);
+
+    private:
+        friend class PathPlanningService;
+
+        /// @brief Called when the search function returned
+        void Finish();
+
+    private:
+        mutable std::mutex mutex;
+        std::deque<std::vector<std::pair<Position, float>>> segments;
+        bool finished;
+
+        std::atomic<bool> cancelled;
+    };
+
+    /// @brief Threads shared by all the clients to compute paths in the background,
+    /// so a behaviour can keep yielding (or moving) while a long search runs
+    class PathPlanningService
+    {
+    public:
+        static PathPlanningService& GetInstance();
+
+        PathPlanningService(const PathPlanningService&) = delete;
+        PathPlanningService& operator=(const PathPlanningService&) = delete;
+
+        /// @brief Start the threads. Does nothing if already started
+        /// @param num_threads Number of threads, 0 to use the number of cores
+        void Start(const size_t num_threads);
+
+        /// @brief Check if the threads are running
+        bool IsStarted() const;
+
+        /// @brief Queue a search. If Start hasn't been called yet, the threads are started with the default number of threads
+        /// @param search Function running the search. Should publish the path with PushSegment, and return early if the job is cancelled
+        /// @return A handle to poll the job. Cancelled jobs not started yet are skipped
+        std::shared_ptr<PathPlanningJob> Submit(std::function<void(PathPlanningJob&)>&& search);
+
+    private:
+        PathPlanningService();
+        ~PathPlanningService();
+
+        void Run();
+
+    private:
+        std::mutex mutex;
+        std::condition_variable jobs_cv;
+        std::deque<std::pair<std::shared_ptr<PathPlanningJob>, std::function<void(PathPlanningJob&)>>> jobs;
+        std::atomic<bool> started;
+        bool should_run;
+
+        std::vector<std::thread> threads;
+    };
+} // Botcraft
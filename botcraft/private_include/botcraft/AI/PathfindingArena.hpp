@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    /// @brief Memory used by FindPath A* searches. Nodes are stored in a flat
+    /// open-addressing table, with cost, parent and position in the open set
+    /// in the same record. The open set is an indexed binary heap supporting
+    /// decrease-key. Reset is O(1) and keeps all the buffers, so once an arena
+    /// has grown to the size of a typical search it doesn't allocate anymore.
+    /// Not thread-safe, use one arena per thread (see GetThreadLocal)
+    class PathfindingArena
+    {
+    public:
+        static constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+        struct Node
+        {
+            std::pair<Position, float> pos; // <Block in which the feet are, feet height>
+            float cost; // distance from start
+            float score; // distance from start + heuristic to goal
+            uint32_t parent;
+            uint32_t heap_index; // invalid_index if not in the open set
+        };
+
+        PathfindingArena();
+
+        /// @brief Get the arena of the calling thread
+        static PathfindingArena& GetThreadLocal();
+
+        /// @brief Forget all nodes from the previous search, in O(1)
+        void Reset();
+
+        /// @brief Get the index of a node, creating it with an infinite cost if it doesn't exist
+        /// @param pos <Block in which the feet are, feet height>
+        /// @return Index of the node, stable until next Reset
+        uint32_t GetOrCreate(const std::pair<Position, float>& pos);
+
+        /// @brief Update a node if the given cost is better than the one already known, and (re)insert it in the open set
+        /// @param index Node index
+        /// @param cost New distance from start
+        /// @param heuristic Estimated distance to goal
+        /// @param parent Index of the node we come from
+        /// @return True if the node was updated
+        bool Relax(const uint32_t index, const float cost, const float heuristic, const uint32_t parent);
+
+        /// @brief Remove the node with the lowest score from the open set
+        /// @return Index of the removed node
+        uint32_t PopOpen();
+
+        bool IsOpenEmpty() const { return heap.empty(); }
+        size_t GetNumNodes() const { return nodes.size(); }
+        const Node& GetNode(const uint32_t index) const { return nodes[index]; }
+
+    private:
+        struct Slot
+        {
+            uint32_t generation;
+            uint32_t node;
+        };
+
+        static size_t Hash(const std::pair<Position, float>& pos);
+        void Rehash(const size_t num_slots);
+        void SiftUp(uint32_t heap_pos);
+        void SiftDown(uint32_t heap_pos);
+
+    private:
+        std::vector<Node> nodes;
+        /// @brief A slot is used only if its generation is the current one
+        std::vector<Slot> slots;
+        size_t mask;
+        uint32_t generation;
+        /// @brief Node indices, sorted as a min binary heap on score
+        std::vector<uint32_t> heap;
+    };
+} // Botcraft
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    class BlockCursor;
+
+    /// @brief Moves that can be made from a position, filled by GetPathfindingMoves.
+    /// Fixed size so it can live on the stack without allocating
+    struct PathfindingMoves
+    {
+        /// @brief More than the number of moves that can be found from one position
+        static constexpr size_t max_moves = 64;
+
+        void Add(const std::pair<Position, float>& pos, const float cost)
+        {
+            moves[size] = { pos, cost };
+            size += 1;
+        }
+
+        /// @brief <<Block in which the feet are, feet height>, cost of the move>
+        std::array<std::pair<std::pair<Position, float>, float>, max_moves> moves;
+        size_t size = 0;
+    };
+
+    /// @brief Get the feet height of a pathfinding node in a given block
+    /// @param cursor Cursor used to read the blocks
+    /// @param pos Block in which the feet are
+    /// @param takes_damage If false, hazardous blocks are treated as any other block
+    /// @return Top of the block if it's solid, its bottom otherwise
+    float GetPathfindingHeight(BlockCursor& cursor, const Position& pos, const bool takes_damage);
+
+    /// @brief Get all the moves FindPath considers from a position. Only the blocks
+    /// with |dx| + |dz| <= 2 (and dx == 0 or dz == 0) and dy <= 2 are read
+    /// @param cursor Cursor used to read the blocks
+    /// @param from <Block in which the feet are, feet height>
+    /// @param min_y Min Y of the world
+    /// @param allow_jump If true, allow to jump above 1-wide gaps
+    /// @param takes_damage If true, avoid dangerous paths
+    /// @param step_height Max height the player can step on without jumping
+    /// @param moves Cleared and filled with the moves found, in the order FindPath adds them
+    void GetPathfindingMoves(BlockCursor& cursor, const std::pair<Position, float>& from, const int min_y, const bool allow_jump, const bool takes_damage, const float step_height, PathfindingMoves& moves);
+} // Botcraft
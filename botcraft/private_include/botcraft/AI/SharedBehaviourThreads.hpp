@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "botcraft/Utilities/Coroutine.hpp"
+
+namespace Botcraft
+{
+    /// @brief A behaviour tree loop running as a coroutine on the shared behaviour threads
+    class SharedBehaviour
+    {
+    public:
+        SharedBehaviour(std::function<void()>&& loop, std::function<bool()>&& should_step_, const size_t stack_size, const size_t worker_index_);
+
+        /// @brief Block until the shared threads performed one more step of this behaviour
+        void WaitNextStep();
+
+    private:
+        friend class SharedBehaviourThreads;
+
+        Utilities::Coroutine coroutine;
+        std::function<bool()> should_step;
+        const size_t worker_index;
+
+        std::mutex mutex;
+        std::condition_variable step_cv;
+        size_t num_steps;
+        bool finished;
+
+        /// @brief Set when the loop must be resumed until it returns
+        std::atomic<bool> closing;
+    };
+
+    /// @brief Threads running all the behaviour trees as coroutines, instead of each
+    /// client having its own behaviour thread. Each tree is always resumed by the same
+    /// thread, and stepped every 10 ms like in RunBehaviourUntilClosed
+    class SharedBehaviourThreads
+    {
+    public:
+        static SharedBehaviourThreads& GetInstance();
+
+        SharedBehaviourThreads(const SharedBehaviourThreads&) = delete;
+        SharedBehaviourThreads& operator=(const SharedBehaviourThreads&) = delete;
+
+        /// @brief Start the threads. Does nothing if already started
+        /// @param num_threads Number of threads, 0 to use the number of cores
+        /// @param stack_size_ Stack size of each behaviour coroutine
+        void Start(const size_t num_threads, const size_t stack_size_);
+
+        /// @brief Check if the shared threads are running
+        bool IsStarted() const;
+
+        /// @brief Add a new behaviour loop
+        /// @param loop Function running the tree, will be resumed at each step
+        /// @param should_step Function called before each step, if it returns false the loop isn't resumed
+        /// @return A handle to the behaviour
+        std::shared_ptr<SharedBehaviour> Add(std::function<void()>&& loop, std::function<bool()>&& should_step);
+
+        /// @brief Resume the loop until it returns and wait for it. Must not be called from a behaviour
+        /// @param behaviour Handle returned by Add
+        void Stop(const std::shared_ptr<SharedBehaviour>& behaviour);
+
+    private:
+        SharedBehaviourThreads();
+        ~SharedBehaviourThreads();
+
+        struct Worker
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            /// @brief Behaviours added since the last step, waiting to be picked up by the worker thread
+            std::vector<std::shared_ptr<SharedBehaviour> > pending;
+            bool wake_up = false;
+            std::thread thread;
+        };
+
+        void Run(Worker& worker);
+
+    private:
+        std::mutex mutex;
+        std::atomic<bool> started;
+        std::atomic<bool> should_run;
+        size_t stack_size;
+
+        std::vector<std::unique_ptr<Worker> > workers;
+        std::atomic<size_t> next_worker;
+    };
+} // Botcraft
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "botcraft/Game/Entities/entities/Entity.hpp"
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    /// @brief Entities split by type, then stored in a uniform grid of vertical
+    /// columns of cell_size * cell_size blocks. Positions used are the ones given
+    /// to Insert/Move, not the current position of the entities. Not thread-safe
+    class EntityGrid
+    {
+    public:
+        struct Item
+        {
+            int id;
+            Vector3<double> position;
+            std::shared_ptr<Entity> entity;
+        };
+
+        static constexpr double cell_size = 16.0;
+
+        /// @brief Add an entity, replacing any previous one with the same id
+        /// @param id Id of the entity
+        /// @param entity Entity to add
+        /// @param position Position of the entity
+        void Insert(const int id, const std::shared_ptr<Entity>& entity, const Vector3<double>& position);
+
+        /// @brief Remove an entity. Does nothing if it's not in the grid
+        /// @param id Id of the entity
+        void Remove(const int id);
+
+        /// @brief Update the position of an entity. Does nothing if it's not in the grid
+        /// @param id Id of the entity
+        /// @param position New position
+        void Move(const int id, const Vector3<double>& position);
+
+        void Clear();
+
+        /// @brief Call a function for each entity with its position inside a box
+        /// @param min Min corner of the box
+        /// @param max Max corner of the box
+        /// @param type Type of the entities, EntityType::None for all types
+        /// @param f Function called with each const Item&
+        template<class F>
+        void ForEachInBox(const Vector3<double>& min, const Vector3<double>& max, const EntityType type, F&& f) const
+        {
+            const long long int min_x = ToCell(min.x);
+            const long long int max_x = ToCell(max.x);
+            const long long int min_z = ToCell(min.z);
+            const long long int max_z = ToCell(max.z);
+            const long long int num_cells = (max_x - min_x + 1) * (max_z - min_z + 1);
+
+            const auto visit = [&](const std::vector<Item>& items)
+            {
+                for (const Item& item : items)
+                {
+                    if (item.position.x >= min.x && item.position.x <= max.x &&
+                        item.position.y >= min.y && item.position.y <= max.y &&
+                        item.position.z >= min.z && item.position.z <= max.z)
+                    {
+                        f(item);
+                    }
+                }
+            };
+
+            ForEachBucket(type, [&](const Bucket& bucket)
+                {
+                    // Big boxes, it's faster to check all occupied cells
+                    if (num_cells > static_cast<long long int>(bucket.cells.size()))
+                    {
+                        for (const auto& [key, items] : bucket.cells)
+                        {
+                            visit(items);
+                        }
+                        return;
+                    }
+                    for (long long int x = min_x; x <= max_x; ++x)
+                    {
+                        for (long long int z = min_z; z <= max_z; ++z)
+                        {
+                            const auto it = bucket.cells.find(GetCellKey(x, z));
+                            if (it != bucket.cells.end())
+                            {
+                                visit(it->second);
+                            }
+                        }
+                    }
+                }
+            );
+        }
+
+        /// @brief Find the nearest entity accepted by a filter, searching cells in rings around position
+        /// @param position Position to search around
+        /// @param max_distance Max distance between position and the entity
+        /// @param type Type of the entities, EntityType::None for all types
+        /// @param filter Function called with const Item&, returning false if the entity must be skipped
+        /// @return The nearest item, nullptr if none was found
+        template<class F>
+        const Item* Nearest(const Vector3<double>& position, const double max_distance, const EntityType type, F&& filter) const
+        {
+            const Item* best = nullptr;
+            double best_sqr_distance = max_distance * max_distance;
+
+            const auto visit = [&](const std::vector<Item>& items)
+            {
+                for (const Item& item : items)
+                {
+                    const double sqr_distance = (item.position - position).SqrNorm();
+                    if ((best == nullptr ? sqr_distance <= best_sqr_distance : sqr_distance < best_sqr_distance) && filter(item))
+                    {
+                        best = &item;
+                        best_sqr_distance = sqr_distance;
+                    }
+                }
+            };
+
+            size_t num_occupied_cells = 0;
+            ForEachBucket(type, [&](const Bucket& bucket) { num_occupied_cells += bucket.cells.size(); });
+
+            const long long int center_x = ToCell(position.x);
+            const long long int center_z = ToCell(position.z);
+            for (long long int ring = 0; ; ++ring)
+            {
+                // Cells in this ring are at least (ring - 1) cells away from position
+                const double ring_distance = std::max(0.0, (ring - 1) * cell_size);
+                if (ring_distance * ring_distance > best_sqr_distance)
+                {
+                    break;
+                }
+
+                // Ring is getting too big, it's faster to check all occupied cells
+                if (static_cast<size_t>((2 * ring + 1) * (2 * ring + 1)) > num_occupied_cells)
+                {
+                    ForEachBucket(type, [&](const Bucket& bucket)
+                        {
+                            for (const auto& [key, items] : bucket.cells)
+                            {
+                                visit(items);
+                            }
+                        }
+                    );
+                    break;
+                }
+
+                ForEachBucket(type, [&](const Bucket& bucket)
+                    {
+                        const auto visit_cell = [&](const long long int x, const long long int z)
+                        {
+                            const auto it = bucket.cells.find(GetCellKey(x, z));
+                            if (it != bucket.cells.end())
+                            {
+                                visit(it->second);
+                            }
+                        };
+                        if (ring == 0)
+                        {
+                            visit_cell(center_x, center_z);
+                            return;
+                        }
+                        for (long long int i = -ring; i <= ring; ++i)
+                        {
+                            visit_cell(center_x + i, center_z - ring);
+                            visit_cell(center_x + i, center_z + ring);
+                        }
+                        for (long long int i = -ring + 1; i < ring; ++i)
+                        {
+                            visit_cell(center_x - ring, center_z + i);
+                            visit_cell(center_x + ring, center_z + i);
+                        }
+                    }
+                );
+            }
+
+            return best;
+        }
+
+    private:
+        using CellKey = std::uint64_t;
+
+        struct Bucket
+        {
+            std::unordered_map<CellKey, std::vector<Item> > cells;
+        };
+
+        struct Location
+        {
+            EntityType type;
+            CellKey cell;
+            size_t index;
+        };
+
+        /// @brief Get the cell coordinate of a block coordinate, clamped so the number of cells in a box doesn't overflow
+        static long long int ToCell(const double v)
+        {
+            constexpr double max_cell = static_cast<double>(1 << 24);
+            return static_cast<long long int>(std::clamp(std::floor(v / cell_size), -max_cell, max_cell));
+        }
+
+        static CellKey GetCellKey(const long long int x, const long long int z)
+        {
+            return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<CellKey>(static_cast<std::uint32_t>(z));
+        }
+
+        template<class F>
+        void ForEachBucket(const EntityType type, F&& f) const
+        {
+            if (type != EntityType::None)
+            {
+                const auto it = buckets.find(type);
+                if (it != buckets.end())
+                {
+                    f(it->second);
+                }
+                return;
+            }
+            for (const auto& [t, bucket] : buckets)
+            {
+                f(bucket);
+            }
+        }
+
+        /// @brief Remove the item at location from its cell
+        /// @return The removed item
+        Item Extract(const Location& location);
+
+    private:
+        std::unordered_map<EntityType, Bucket> buckets;
+        std::unordered_map<int, Location> locations;
+    };
+} // Botcraft
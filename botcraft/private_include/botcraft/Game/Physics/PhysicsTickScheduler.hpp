@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "botcraft/Game/Physics/PhysicsManager.hpp"
+
+namespace Botcraft
+{
+    /// @brief Run the ticks of all registered clients on a fixed pool of threads,
+    /// instead of each client sleeping in its own physics thread. Clients with the
+    /// same tick rate are aligned on the same tick grid, so the threads wake up once
+    /// per tick for all of them
+    class PhysicsTickScheduler
+    {
+    public:
+        static PhysicsTickScheduler& GetInstance();
+
+        PhysicsTickScheduler(const PhysicsTickScheduler&) = delete;
+        PhysicsTickScheduler& operator=(const PhysicsTickScheduler&) = delete;
+
+        /// @brief Start the threads. Does nothing if already started
+        /// @param num_threads Number of threads running the ticks, 0 to use the number of cores
+        void Start(const size_t num_threads);
+
+        /// @brief Check if the scheduler threads are running
+        bool IsStarted() const;
+
+        /// @brief Add a client to the scheduler. Ticks of the same client never run concurrently
+        /// @param tick Function called every tick
+        /// @param get_ms_per_tick Function returning the current tick duration, called after each tick
+        /// @return An id to give to Unregister
+        size_t Register(const std::function<void()>& tick, const std::function<double()>& get_ms_per_tick);
+
+        /// @brief Remove a client from the scheduler. If its tick is currently running,
+        /// wait for it to finish. Must not be called from inside the tick function
+        /// @param id Id returned by Register
+        void Unregister(const size_t id);
+
+        /// @brief Get the metrics of all the ticks run since the start (or the last ResetStats)
+        PhysicsTickStats GetStats() const;
+
+        void ResetStats();
+
+    private:
+        PhysicsTickScheduler();
+        ~PhysicsTickScheduler();
+
+        void Run();
+
+        /// @brief Get the first point of the tick grid at or after a given time
+        std::chrono::steady_clock::time_point AlignOnGrid(const std::chrono::steady_clock::time_point& t, const std::chrono::steady_clock::duration& period) const;
+
+    private:
+        struct Client
+        {
+            std::function<void()> tick;
+            std::function<double()> get_ms_per_tick;
+            bool running = false;
+            bool removed = false;
+        };
+
+        struct ScheduledTick
+        {
+            std::chrono::steady_clock::time_point deadline;
+            size_t id;
+
+            bool operator>(const ScheduledTick& other) const
+            {
+                return deadline > other.deadline;
+            }
+        };
+
+        mutable std::mutex mutex;
+        std::condition_variable ticks_cv;
+        std::condition_variable unregister_cv;
+        std::atomic<bool> started;
+        bool should_run;
+
+        /// @brief All the grids start here, so clients with the same tick duration tick together
+        const std::chrono::steady_clock::time_point epoch;
+        size_t next_id;
+        std::unordered_map<size_t, Client> clients;
+        std::priority_queue<ScheduledTick, std::vector<ScheduledTick>, std::greater<ScheduledTick> > scheduled_ticks;
+
+        PhysicsTickStats stats;
+        double sum_lateness_ms;
+
+        std::vector<std::thread> threads;
+    };
+} // Botcraft
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    /// @brief Ring buffer of the last block and chunk changes of a world, so
+    /// data derived from the blocks can be updated instead of recomputed. Thread-safe
+    class BlockChangeLog
+    {
+    public:
+        BlockChangeLog();
+        ~BlockChangeLog();
+
+        /// @brief Record a block change
+        /// @param pos Position of the block
+        void AddBlock(const Position& pos);
+
+        /// @brief Record a change of all the blocks of a chunk (loaded, unloaded...)
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        void AddChunk(const int x, const int z);
+
+        /// @brief Get the changes since a previous call
+        /// @param since In: value set by the previous call, 0 on the first call (no change returned). Out: value for the next call
+        /// @param blocks Cleared and filled with the changed block positions
+        /// @param chunks Cleared and filled with the changed chunk coordinates
+        /// @return False if some of the changes are too old to be known, in which case everything must be considered as changed
+        bool Get(unsigned long long int& since, std::vector<Position>& blocks, std::vector<std::pair<int, int>>& chunks) const;
+
+    private:
+        struct Entry
+        {
+            /// @brief Block position, or chunk coordinates in x and z
+            Position pos;
+            bool is_chunk;
+        };
+
+        static constexpr size_t capacity = 1 << 14;
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        /// @brief Number of changes recorded since the creation of this log. Starts
+        /// at 1 so 0 can be used as "no previous call"
+        unsigned long long int num_changes;
+    };
+} // Botcraft
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Botcraft
+{
+    class Chunk;
+    struct Section;
+
+    /// @brief Read-only view of the blocks of all loaded chunks, that can be
+    /// used without lock inside an Utilities::EpochReadGuard. Buckets are
+    /// copied on write and old ones are freed through Utilities::EpochManager.
+    /// Different chunks can be updated concurrently.
+    class ChunkIndex
+    {
+    public:
+        /// @brief Blocks of one chunk. Never modified once published
+        struct Entry
+        {
+            int x;
+            int z;
+            int min_y;
+            std::vector<std::shared_ptr<const Section> > sections;
+        };
+
+        ChunkIndex();
+        ~ChunkIndex();
+
+        /// @brief Find the entry of a chunk. Must be called inside an
+        /// Utilities::EpochReadGuard, returned pointer is valid until its end
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @return The chunk entry, or nullptr if not loaded
+        const Entry* Find(const int x, const int z) const;
+
+        /// @brief Update the entry of a chunk if its sections changed. Thread-safe
+        /// as long as chunk is not modified during the call
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @param chunk Current chunk at x, z, nullptr if it has been unloaded
+        void Update(const int x, const int z, const Chunk* chunk);
+
+    private:
+        struct Bucket
+        {
+            std::vector<std::shared_ptr<const Entry> > entries;
+        };
+
+        static size_t GetBucketIndex(const int x, const int z);
+
+    private:
+        static constexpr size_t num_buckets = 4096;
+        static constexpr size_t num_bucket_mutexes = 64;
+
+        /// @brief Buckets read by lock-free readers
+        std::unique_ptr<std::atomic<const Bucket*>[]> buckets;
+        /// @brief Ownership of the published buckets, only used by the writer
+        std::unique_ptr<std::shared_ptr<const Bucket>[]> owned_buckets;
+        /// @brief Protect owned_buckets, bucket i uses mutex i % num_bucket_mutexes
+        std::unique_ptr<std::mutex[]> bucket_mutexes;
+    };
+} // Botcraft
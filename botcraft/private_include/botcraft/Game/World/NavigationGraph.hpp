@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+#include "botcraft/Game/World/World.hpp"
+
+namespace Botcraft
+{
+    class BlockCursor;
+
+    /// @brief Coarse graph of the loaded chunks, used to plan long trips (HPA*-like).
+    /// Each chunk is a cluster: standing positions on its borders are grouped in gates,
+    /// and gates of the same chunk are linked with their walking distance inside the chunk.
+    /// Gates of neighbour chunks are linked if one can step from one to the other.
+    /// Standing positions are derived from the sections navigation properties with
+    /// simplified movement rules (walk up/down 1 block, drop up to 3 blocks, climb stacked
+    /// climbable or fluid positions, hazardous blocks avoided), so a route is only a guide
+    /// that should be refined with FindPath.
+    /// Chunk graphs are built lazily, and rebuilt when a navigation property of one of
+    /// their blocks changes. Thread-safe, but searches in the same graph are serialized
+    class NavigationGraph
+    {
+    public:
+        NavigationGraph();
+        ~NavigationGraph();
+
+        /// @brief Find a coarse route between two positions
+        /// @param cursor Cursor used to read the blocks
+        /// @param min_y Min Y of the world
+        /// @param height Height of the world
+        /// @param start Feet position at the start
+        /// @param end Feet position to reach
+        /// @return Standing positions from start to end, consecutive positions being in the same or in adjacent chunks.
+        /// Empty if start or end are too far from a standing position, or if no route was found
+        std::vector<Position> FindRoute(BlockCursor& cursor, const int min_y, const int height, const Position& start, const Position& end);
+
+    private:
+        struct Gate
+        {
+            /// @brief Side of the chunk, 0: -X, 1: +X, 2: -Z, 3: +Z
+            unsigned char face;
+            /// @brief Node used as the gate position
+            uint32_t node;
+            /// @brief Range of the gate nodes in ChunkGraph::gate_nodes, sorted along the face
+            uint32_t first_node;
+            uint32_t last_node;
+            /// @brief Gates of the same chunk reachable from this one, with the walking distance
+            std::vector<std::pair<uint32_t, float>> links;
+        };
+
+        struct ChunkGraph
+        {
+            int x;
+            int z;
+            /// @brief Chunk version this graph was built from, see BlockCursor::GetChunkNavigationVersion
+            unsigned long long int version;
+            int min_y;
+            int height;
+            /// @brief Id of the last search that used this graph
+            unsigned long long int last_used;
+
+            /// @brief Feet Y of the standing positions (nodes), column by column, ascending in each column
+            std::vector<short> nodes_y;
+            /// @brief Column (z * CHUNK_WIDTH + x) of each node
+            std::vector<unsigned char> nodes_column;
+            /// @brief Index of the first node of each column, plus the total number of nodes
+            std::array<uint32_t, CHUNK_WIDTH * CHUNK_WIDTH + 1> column_start;
+
+            std::vector<Gate> gates;
+            std::vector<uint32_t> gate_nodes;
+        };
+
+        /// @brief Get the graph of a chunk, building it if it's not up to date
+        /// @return nullptr if the chunk is not loaded
+        const ChunkGraph* GetChunkGraph(BlockCursor& cursor, const int chunk_x, const int chunk_z, const int min_y, const int height);
+
+        static void Build(ChunkGraph& graph, BlockCursor& cursor);
+        static void BuildGates(ChunkGraph& graph);
+
+        /// @brief Compute walking distances from (or to) a node inside a chunk
+        /// @param graph Chunk graph
+        /// @param node Start node
+        /// @param reverse If true, compute the distances from all nodes to node instead
+        /// @param distances Filled with the distance of each node, negative if not reachable
+        static void ComputeDistances(const ChunkGraph& graph, const uint32_t node, const bool reverse, std::vector<int>& distances);
+
+        /// @brief Check if a standing position can be reached from a gate to the facing gate of the next chunk
+        static bool AreGatesLinked(const ChunkGraph& from_graph, const Gate& from, const ChunkGraph& to_graph, const Gate& to);
+
+        /// @brief Get the node of a column closest to a given height
+        /// @return Index of the node, or max uint32_t if none is close enough
+        static uint32_t FindNode(const ChunkGraph& graph, const int x, const int y, const int z);
+
+        static Position GetNodePosition(const ChunkGraph& graph, const uint32_t node);
+
+    private:
+        std::mutex mutex;
+        std::unordered_map<std::pair<int, int>, ChunkGraph> chunks;
+        unsigned long long int search_id;
+    };
+} // Botcraft
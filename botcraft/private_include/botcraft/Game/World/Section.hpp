@@ -1,20 +1,121 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
+#include "botcraft/Game/World/SectionNavigation.hpp"
+
 namespace Botcraft
 {
     class Blockstate;
 
+    /// @brief Blocks and lights of a 16x16x16 part of a chunk (18x18x16 for blocks when using GUI,
+    /// as we also store the neighbour blocks).
+    /// Blocks are stored in a paletted container mirroring the network format: a single
+    /// value, bit-packed indices in a section-local palette, or bit-packed global ids once
+    /// the local palette gets too big. Entries never span across multiple longs.
+    /// Blocks can be read without lock while a (single) writer modifies them: storage
+    /// is only grown by replacing it as a whole, old storage being freed through
+    /// Utilities::EpochManager. Lights have no such guarantee.
     struct Section
     {
-        Section(const bool has_sky_light);
+        Section();
+        Section(const Section& s);
+        ~Section();
+
+        Section& operator=(const Section& s) = delete;
 
         static size_t CoordsToBlockIndex(const int x, const int y, const int z);
         static size_t CoordsToLightIndex(const int x, const int y, const int z);
 
-        std::vector<unsigned short> data_blocks;
+        /// @brief Get the stored block id at a given index. Can be called concurrently
+        /// with SetBlock/LoadBlocks if inside an Utilities::EpochReadGuard
+        /// @param index Block index, as returned by CoordsToBlockIndex
+        /// @return Stored block id
+        unsigned short GetBlock(const size_t index) const;
+
+        /// @brief Set the stored block id at a given index, growing the palette if required
+        /// @param index Block index, as returned by CoordsToBlockIndex
+        /// @param id Stored block id
+        void SetBlock(const size_t index, const unsigned short id);
+
+        /// @brief Get the stored ids of all the blocks of this section, without GUI borders
+        /// @param output Array of CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT ids, filled in (y, z, x) order
+        void GetBlocks(unsigned short* output) const;
+
+        /// @brief Replace all the blocks of this section with already packed data.
+        /// Data layout must match CoordsToBlockIndex (so no GUI borders)
+        /// @param bits Bits per entry in data, 0 for a single value section
+        /// @param section_palette Palette used by data, empty if data contains global ids
+        /// @param data Packed data, with entries not spanning across multiple longs
+        /// @return False if the data couldn't be used as is, true otherwise
+        bool LoadBlocks(const unsigned char bits, const std::vector<int>& section_palette, const std::vector<unsigned long long int>& data);
+
+        unsigned char GetBlockLight(const int x, const int y, const int z) const;
+        void SetBlockLight(const int x, const int y, const int z, const unsigned char v);
+
+        unsigned char GetSkyLight(const int x, const int y, const int z) const;
+        void SetSkyLight(const int x, const int y, const int z, const unsigned char v);
+
+        /// @brief Replace all block light values
+        /// @param data Light values, packed 4 bits per block, empty to set all values to 0
+        void LoadBlockLight(const std::vector<char>& data);
+        /// @brief Replace all sky light values
+        /// @param data Light values, packed 4 bits per block, empty to set all values to 0
+        void LoadSkyLight(const std::vector<char>& data);
+
+        /// @brief Get the pathfinding properties of the blocks, kept up to date by Chunk
+        SectionNavigation& GetNavigation();
+        const SectionNavigation& GetNavigation() const;
+
+        /// @brief Get the heap memory used by this section
+        /// @return Size in bytes
+        size_t GetMemorySize() const;
+
+    private:
+        /// @brief Packed blocks. Bits per entry and palette capacity never change once
+        /// published, so readers can safely access it while entries are updated
+        struct BlockStorage
+        {
+            BlockStorage(const unsigned char bits, const bool global_ids_);
+            BlockStorage(const BlockStorage& s);
+
+            unsigned int ReadEntry(const size_t index) const;
+            void WriteEntry(const size_t index, const unsigned int value);
+
+            /// @brief Number of bits per entry in data, 0 if palette is a single value
+            const unsigned char bits_per_block;
+            /// @brief If true, data contains global ids and palette is empty
+            const bool global_ids;
+            /// @brief Section-local palette, with a fixed capacity of 2^bits_per_block
+            std::unique_ptr<unsigned short[]> palette;
+            /// @brief Number of values in palette, only used by the writer
+            size_t palette_size;
+            std::unique_ptr<std::atomic<unsigned long long int>[]> data;
+        };
+
+        /// @brief Change the number of bits used per entry, keeping current blocks
+        /// @param new_bits New number of bits per entry
+        /// @param to_global If true, palette will be cleared and data will contain global ids
+        /// @return The new storage
+        BlockStorage* Repack(const unsigned char new_bits, const bool to_global);
+
+        /// @brief Replace current block storage, retiring the previous one
+        /// @param storage New storage, ownership is transfered to this section
+        void PublishBlocks(BlockStorage* storage);
+
+    private:
+        /// @brief nullptr if the section only contains air
+        std::atomic<BlockStorage*> blocks;
+
+        /// @brief Light values, 4 bits per block. Arrays are only allocated
+        /// when a value different from the uniform one is set
         std::vector<unsigned char> block_light;
         std::vector<unsigned char> sky_light;
+        unsigned char uniform_block_light;
+        unsigned char uniform_sky_light;
+
+        SectionNavigation navigation;
     };
 } // Botcraft
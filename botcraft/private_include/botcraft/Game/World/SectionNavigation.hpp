@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "botcraft/Game/World/BlockCursor.hpp"
+
+namespace Botcraft
+{
+    /// @brief Pathfinding properties of the blocks of a section, derived from the blocks
+    /// and kept up to date with them. There is one bit per block for each NavigationProperty,
+    /// blocks being ordered by column ((z * CHUNK_WIDTH + x) * SECTION_HEIGHT + y) so the
+    /// 16 blocks of a column are contiguous bits of the same word.
+    /// A property with the same value for all blocks has no mask (most properties
+    /// of most sections). Can be read without lock inside an Utilities::EpochReadGuard
+    /// while a (single) writer modifies it, replaced masks being freed through Utilities::EpochManager.
+    class SectionNavigation
+    {
+    public:
+        /// @brief Pathfinding properties of a type of block
+        struct BlockProperties
+        {
+            /// @brief Bit i is set if the block has NavigationProperty i
+            unsigned char properties;
+            /// @brief Top of the colliders, in 1/height_resolution block, only relevant for PartialHeight blocks
+            unsigned char height;
+        };
+
+        static constexpr int height_resolution = 64;
+
+        SectionNavigation();
+        SectionNavigation(const SectionNavigation& other);
+        ~SectionNavigation();
+
+        SectionNavigation& operator=(const SectionNavigation& other) = delete;
+
+        /// @brief Get the properties of a type of block. Same for all positions,
+        /// all the random variants of a block are assumed to have the same shape
+        /// @param stored_id Block id, as stored in Section
+        /// @return Properties of the block
+        static const BlockProperties& GetBlockProperties(const unsigned short stored_id);
+
+        /// @brief Get one property of all the blocks of a column
+        /// @param property Property to get
+        /// @param x X coordinate in section
+        /// @param z Z coordinate in section
+        /// @return Bit y is set if block (x, y, z) has the property
+        unsigned int GetColumn(const NavigationProperty property, const int x, const int z) const;
+
+        /// @brief Update the properties of a block
+        /// @param x X coordinate in section
+        /// @param y Y coordinate in section
+        /// @param z Z coordinate in section
+        /// @param stored_id New block id, as stored in Section
+        void SetBlock(const int x, const int y, const int z, const unsigned short stored_id);
+
+        /// @brief Recompute all the properties
+        /// @param blocks CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT ids, in (y, z, x) order as returned by Section::GetBlocks
+        void Load(const unsigned short* blocks);
+
+        /// @brief Get the version of the properties. Versions come from a global counter,
+        /// so two different sections or two states of the same section never share one
+        /// @return A value that changes each time a property of a block changes
+        unsigned long long int GetVersion() const;
+
+        /// @brief Get the heap memory used by the masks
+        /// @return Size in bytes
+        size_t GetMemorySize() const;
+
+    private:
+        static constexpr size_t num_properties = static_cast<size_t>(NavigationProperty::NUM_NAVIGATION_PROPERTIES);
+        static constexpr size_t words_per_mask = 64;
+
+        struct Mask
+        {
+            std::array<std::atomic<unsigned long long int>, words_per_mask> words;
+        };
+
+        /// @brief Replace the mask of a property, retiring the previous one
+        /// @param property Property index
+        /// @param mask New mask, ownership is transfered to this object, nullptr if the property is uniform
+        void PublishMask(const size_t property, Mask* mask);
+
+        /// @brief Give a new version to this section
+        void UpdateVersion();
+
+    private:
+        /// @brief nullptr if the property has the same value for all blocks
+        std::array<std::atomic<Mask*>, num_properties> masks;
+        /// @brief Bit i is the value of property i for all blocks, only used if masks[i] is nullptr
+        std::atomic<unsigned char> uniform_properties;
+        std::atomic<unsigned long long int> version;
+    };
+} // Botcraft
@@ -2,6 +2,7 @@
 
 #ifdef USE_ENCRYPTION
 
+#include <cstddef>
 #include <vector>
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include <string>
@@ -50,6 +51,10 @@ namespace Botcraft
 #endif
         std::vector<unsigned char> Encrypt(const std::vector<unsigned char>& in);
         std::vector<unsigned char> Decrypt(const std::vector<unsigned char>& in);
+        /// @brief Decrypt data without copying it. AES/CFB8 output has the same size as its input
+        /// @param data Data to decrypt, replaced by the decrypted bytes
+        /// @param size Number of bytes in data
+        void DecryptInPlace(unsigned char* data, const size_t size);
 
     private:
         EVP_CIPHER_CTX* encryption_context;
@@ -1,11 +1,74 @@
 #pragma once
 
+#ifdef USE_COMPRESSION
+
+#include <cstddef>
 #include <vector>
 
+#ifdef USE_LIBDEFLATE
+struct libdeflate_compressor;
+struct libdeflate_decompressor;
+#else
+typedef struct z_stream_s z_stream;
+#endif
+
 namespace Botcraft
 {
-#ifdef USE_COMPRESSION
     std::vector<unsigned char> Compress(const std::vector<unsigned char>& raw);
     std::vector<unsigned char> Decompress(const std::vector<unsigned char>& compressed, const int start = 0);
+
+    /// @brief Compression state kept from one packet to the next, so
+    /// compressing doesn't initialize a new stream each time.
+    /// Not thread-safe
+    class Compressor
+    {
+    public:
+        Compressor();
+        ~Compressor();
+
+        Compressor(const Compressor&) = delete;
+        Compressor& operator=(const Compressor&) = delete;
+
+        /// @brief Compress data, using zlib format
+        /// @param raw Pointer to the data to compress
+        /// @param size Size of the data to compress
+        /// @param output Buffer the compressed data are appended to
+        void Compress(const unsigned char* raw, const size_t size, std::vector<unsigned char>& output);
+
+    private:
+#ifdef USE_LIBDEFLATE
+        libdeflate_compressor* compressor;
+#else
+        z_stream* stream;
+#endif
+    };
+
+    /// @brief Decompression state kept from one packet to the next, so
+    /// decompressing doesn't initialize a new stream each time.
+    /// Not thread-safe
+    class Decompressor
+    {
+    public:
+        Decompressor();
+        ~Decompressor();
+
+        Decompressor(const Decompressor&) = delete;
+        Decompressor& operator=(const Decompressor&) = delete;
+
+        /// @brief Decompress zlib data into an already allocated buffer
+        /// @param compressed Pointer to the compressed data
+        /// @param compressed_size Size of the compressed data
+        /// @param output Pointer to the output buffer
+        /// @param output_size Expected size of the decompressed data, throws if it doesn't match
+        void Decompress(const unsigned char* compressed, const size_t compressed_size, unsigned char* output, const size_t output_size);
+
+    private:
+#ifdef USE_LIBDEFLATE
+        libdeflate_decompressor* decompressor;
+#else
+        z_stream* stream;
 #endif
+    };
 } // Botcraft
+
+#endif
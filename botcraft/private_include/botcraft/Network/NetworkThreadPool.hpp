@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+#include <asio/strand.hpp>
+
+namespace Botcraft
+{
+    /// @brief Tasks executed in order, one at a time, on the shared processing threads
+    class NetworkStrand
+    {
+    public:
+        explicit NetworkStrand(asio::io_context& io_context);
+
+        /// @brief Queue a task, it will run after all the ones previously posted on this strand
+        /// @param task Task to run
+        void Post(std::function<void()>&& task);
+
+    private:
+        asio::strand<asio::io_context::executor_type> strand;
+    };
+
+    /// @brief Threads shared by all the connections, instead of each
+    /// connection having its own network and processing threads
+    class NetworkThreadPool
+    {
+    public:
+        static NetworkThreadPool& GetInstance();
+
+        NetworkThreadPool(const NetworkThreadPool&) = delete;
+        NetworkThreadPool& operator=(const NetworkThreadPool&) = delete;
+
+        /// @brief Start the threads. Does nothing if already started
+        /// @param num_threads Number of network threads and of processing threads, 0 to use the number of cores
+        void Start(const size_t num_threads);
+
+        /// @brief Check if the shared threads are running
+        bool IsStarted() const;
+
+        /// @brief Get the io_context a new connection should use. Each io_context
+        /// is run by a single thread, so handlers of a connection never run concurrently
+        /// @return One of the io_contexts, chosen round-robin
+        asio::io_context& GetIOContext();
+
+        /// @brief Create a new strand running on the processing threads
+        std::shared_ptr<NetworkStrand> MakeProcessingStrand();
+
+    private:
+        NetworkThreadPool();
+        ~NetworkThreadPool();
+
+    private:
+        std::mutex mutex;
+        std::atomic<bool> started;
+
+        std::vector<std::unique_ptr<asio::io_context> > io_contexts;
+        std::atomic<size_t> next_io_context;
+        asio::io_context processing_context;
+
+        std::vector<asio::executor_work_guard<asio::io_context::executor_type> > work_guards;
+        std::vector<std::thread> threads;
+    };
+} // Botcraft
@@ -2,23 +2,31 @@
 
 #include <atomic>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <thread>
 #include <mutex>
+#include <vector>
 #include <asio/error_code.hpp>
 #include <asio/ip/tcp.hpp>
 #include <asio/io_context.hpp>
 
 namespace Botcraft
 {
-#ifdef USE_ENCRYPTION
     class AESEncrypter;
-#endif
 
     class TCP_Com
     {
     public:
+        /// @brief Connect to a server
+        /// @param address Server address, with or without port
+        /// @param callback Function called on the network thread for each received packet, with its
+        /// data (without the size prefix) and size. Data is only valid during the call
+        /// @param shared_io_context If not nullptr, io_context (run by a single thread) used instead
+        /// of creating a new one with its own thread. Must outlive this object
         TCP_Com(const std::string& address,
-            std::function<void(const std::vector<unsigned char>&)> callback);
+            std::function<void(const unsigned char*, const size_t)> callback,
+            asio::io_context* shared_io_context = nullptr);
         ~TCP_Com();
 
         bool IsInitialized() const;
@@ -39,6 +47,9 @@ namespace Botcraft
 
         void handle_read(const asio::error_code& error, std::size_t bytes_transferred);
 
+        /// @brief Make room at the end of input_buffer and start reading into it
+        void start_read();
+
         void do_write(const std::vector<unsigned char>& bytes);
 
         void handle_write(const asio::error_code& error);
@@ -49,25 +60,33 @@ namespace Botcraft
 
 
     private:
+        /// @brief Only used if no shared io_context was given
+        std::unique_ptr<asio::io_context> owned_io_context;
         // io_context must be declared before socket
-        asio::io_context io_context;
+        asio::io_context& io_context;
         asio::ip::tcp::socket socket;
 
+        /// @brief Thread running owned_io_context
         std::thread thread_com;
-
-        std::array<unsigned char, 512> read_packet;
-        std::vector<unsigned char> input_packet;
+        /// @brief Number of handlers referencing this object queued in io_context
+        std::atomic<size_t> pending_handlers;
+
+        /// @brief Received data. Bytes in [input_start, input_end) are not framed yet,
+        /// framed packets are passed to the callback directly from this buffer. Consumed
+        /// bytes are only discarded when more room is needed for the next read
+        std::vector<unsigned char> input_buffer;
+        size_t input_start;
+        size_t input_end;
         std::deque<std::vector<unsigned char> > output_packet;
 
-        std::function<void(const std::vector<unsigned char>&)> NewPacketCallback;
+        std::function<void(const unsigned char*, const size_t)> NewPacketCallback;
         std::mutex mutex_output;
 
         std::string ip;
         unsigned short port;
 
-#ifdef USE_ENCRYPTION
+        /// @brief Not under USE_ENCRYPTION so this class layout doesn't depend on it
         std::shared_ptr<AESEncrypter> encrypter;
-#endif
 
         std::atomic<bool> initialized;
     };
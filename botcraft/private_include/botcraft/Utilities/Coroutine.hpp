@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+
+namespace Botcraft::Utilities
+{
+    /// @brief Stackful coroutine, running a function on its own stack. The function
+    /// can give control back to the caller of Resume at any depth with Suspend,
+    /// and continues from there on next Resume.
+    /// Not thread-safe, a coroutine should always be resumed from the same thread
+    class Coroutine
+    {
+    public:
+        /// @brief Create a coroutine, the function doesn't start before the first Resume
+        /// @param function Function to run
+        /// @param stack_size Size of the stack. Memory is only committed when used
+        Coroutine(std::function<void()>&& function, const size_t stack_size);
+        /// @brief Free the stack. If the function is not finished, objects on its stack are not destroyed
+        ~Coroutine();
+
+        Coroutine(const Coroutine&) = delete;
+        Coroutine& operator=(const Coroutine&) = delete;
+
+        /// @brief Run the function until it calls Suspend or returns. If the function
+        /// threw an exception, it's rethrown here
+        void Resume();
+
+        /// @brief Give control back to the caller of Resume. Must be called from inside a coroutine
+        static void Suspend();
+
+        /// @brief Check if the calling code is running inside a coroutine
+        static bool IsInsideCoroutine();
+
+        /// @brief Check if the function returned
+        bool IsFinished() const;
+
+    private:
+        /// @brief Platform specific data
+        struct Context;
+        Context* context;
+
+        std::function<void()> function;
+        bool finished;
+        std::exception_ptr exception;
+    };
+} // Botcraft::Utilities
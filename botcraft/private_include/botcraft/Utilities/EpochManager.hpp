@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Botcraft::Utilities
+{
+    /// @brief Epoch-based memory reclamation. Readers access shared
+    /// objects without lock inside an EpochReadGuard, writers retire
+    /// objects they replaced and they are freed once no reader that
+    /// could have seen them is still running.
+    class EpochManager
+    {
+    public:
+        static EpochManager& GetInstance();
+
+        EpochManager(const EpochManager&) = delete;
+        EpochManager& operator=(const EpochManager&) = delete;
+
+        /// @brief Enter a read-side critical section. Can be nested
+        void EnterRead();
+        /// @brief Exit a read-side critical section
+        void ExitRead();
+
+        /// @brief Free an object once all readers that could have accessed it are done.
+        /// Must only be called after the object has been made unreachable for new readers
+        /// @param object Object to free
+        void Retire(std::shared_ptr<const void>&& object);
+
+    private:
+        EpochManager();
+        ~EpochManager();
+
+        size_t AcquireSlot();
+        void ReleaseSlot(const size_t index);
+
+        /// @brief Free all retired objects no reader can access anymore
+        void Collect();
+
+        friend struct ThreadEpochSlot;
+
+    private:
+        static constexpr size_t max_threads = 4096;
+        static constexpr size_t collect_threshold = 64;
+
+        struct alignas(64) ReaderSlot
+        {
+            /// @brief Epoch at which the thread started reading, 0 if not reading
+            std::atomic<unsigned long long int> epoch;
+        };
+
+        std::atomic<unsigned long long int> global_epoch;
+        std::array<ReaderSlot, max_threads> slots;
+        /// @brief Number of slots ever used, only those need to be checked
+        std::atomic<size_t> num_used_slots;
+        std::vector<size_t> free_slots;
+        std::mutex slots_mutex;
+
+        std::vector<std::pair<unsigned long long int, std::shared_ptr<const void> > > retired;
+        std::mutex retired_mutex;
+    };
+
+    /// @brief RAII wrapper around EpochManager EnterRead/ExitRead
+    class EpochReadGuard
+    {
+    public:
+        EpochReadGuard();
+        ~EpochReadGuard();
+
+        EpochReadGuard(const EpochReadGuard&) = delete;
+        EpochReadGuard& operator=(const EpochReadGuard&) = delete;
+    };
+}
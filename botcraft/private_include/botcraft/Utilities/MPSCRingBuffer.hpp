@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Botcraft::Utilities
+{
+    /// @brief Bounded lock-free queue with multiple producers and a single consumer.
+    /// Each cell has a sequence number telling if it's ready to be written or read,
+    /// so producers only contend on one atomic increment (Dmitry Vyukov's bounded queue).
+    /// Pushing never blocks, it fails if the queue is full
+    template<class T>
+    class MPSCRingBuffer
+    {
+    public:
+        /// @param capacity Number of cells, rounded up to the next power of two
+        MPSCRingBuffer(const size_t capacity)
+        {
+            size_t size = 1;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            mask = size - 1;
+            cells = std::make_unique<Cell[]>(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            enqueue_pos.store(0, std::memory_order_relaxed);
+            dequeue_pos = 0;
+        }
+
+        MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+        MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+
+        /// @brief Add a value at the end of the queue. Can be called from any thread
+        /// @param value Value to add, left untouched if the queue is full
+        /// @return False if the queue is full
+        bool TryPush(T&& value)
+        {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            while (true)
+            {
+                cell = &cells[pos & mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    // Cell is free, try to claim it
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // Cell still contains a value from the previous lap
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed this cell
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Get the value at the front of the queue. Must not be called from multiple threads at the same time
+        /// @param output Popped value
+        /// @return False if the queue is empty
+        bool TryPop(T& output)
+        {
+            Cell& cell = cells[dequeue_pos & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(dequeue_pos + 1) < 0)
+            {
+                return false;
+            }
+
+            output = std::move(cell.value);
+            // Mark the cell as free for the next lap
+            cell.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+            dequeue_pos += 1;
+            return true;
+        }
+
+        /// @brief Get the number of values successfully pushed so far, including the ones still being written
+        size_t GetNumPushed() const
+        {
+            return enqueue_pos.load(std::memory_order_acquire);
+        }
+
+        /// @brief Get the number of values popped so far. Same threading constraint as TryPop
+        size_t GetNumPopped() const
+        {
+            return dequeue_pos;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+
+        /// @brief Producers and consumer positions on separate cache lines
+        alignas(64) std::atomic<size_t> enqueue_pos;
+        alignas(64) size_t dequeue_pos;
+    };
+}
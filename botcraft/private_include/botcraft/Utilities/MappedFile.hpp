@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Botcraft::Utilities
+{
+    /// @brief Read-only memory mapping of a whole file.
+    /// Pages are loaded by the OS when accessed instead of being copied in a buffer
+    class MappedFile
+    {
+    public:
+        /// @brief Map a file in memory
+        /// @param path Path of the file
+        MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @brief Check if the file was successfully mapped
+        bool IsValid() const;
+
+        /// @brief Get the file content, nullptr if not valid
+        const unsigned char* GetData() const;
+
+        /// @brief Get the file size in bytes
+        size_t GetSize() const;
+
+    private:
+        const unsigned char* data;
+        size_t size;
+#if _WIN32
+        void* file;
+        void* mapping;
+#endif
+    };
+} // Botcraft::Utilities
@@ -1,4 +1,5 @@
 #include "botcraft/AI/BehaviourClient.hpp"
+#include "botcraft/AI/SharedBehaviourThreads.hpp"
 #if USE_GUI
 #include "botcraft/Renderer/RenderingManager.hpp"
 #endif
@@ -21,6 +22,44 @@ namespace Botcraft
         return blackboard;
     }
 
+    void BehaviourClient::UseSharedBehaviourThreads(const size_t num_threads, const size_t stack_size)
+    {
+        SharedBehaviourThreads::GetInstance().Start(num_threads, stack_size);
+    }
+
+    bool BehaviourClient::SharedBehaviourThreadsStarted()
+    {
+        return SharedBehaviourThreads::GetInstance().IsStarted();
+    }
+
+    void BehaviourClient::StartSharedBehaviour(std::function<void()>&& tree_loop, std::function<bool()>&& should_step)
+    {
+        shared_behaviour = SharedBehaviourThreads::GetInstance().Add(std::move(tree_loop), std::move(should_step));
+    }
+
+    bool BehaviourClient::RunsOnSharedBehaviourThreads() const
+    {
+        return shared_behaviour != nullptr;
+    }
+
+    void BehaviourClient::SuspendSharedBehaviour()
+    {
+        Utilities::Coroutine::Suspend();
+    }
+
+    void BehaviourClient::WaitSharedBehaviourStep()
+    {
+        shared_behaviour->WaitNextStep();
+    }
+
+    void BehaviourClient::StopSharedBehaviour()
+    {
+        if (shared_behaviour != nullptr)
+        {
+            SharedBehaviourThreads::GetInstance().Stop(shared_behaviour);
+        }
+    }
+
     void BehaviourClient::OnReset()
     {
 #if USE_GUI
@@ -1,7 +1,50 @@
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "botcraft/AI/Blackboard.hpp"
 
 namespace Botcraft
 {
+    namespace
+    {
+        /// @brief Global name -> id table shared by all blackboards. Entries are never
+        /// removed, and unordered_map nodes are stable, so pointers to them stay valid
+        class BlackboardKeyRegistry
+        {
+        public:
+            static BlackboardKeyRegistry& GetInstance()
+            {
+                static BlackboardKeyRegistry instance;
+                return instance;
+            }
+
+            const std::pair<const std::string, size_t>* Intern(const std::string& name)
+            {
+                { // lock scope
+                    std::shared_lock<std::shared_mutex> lock(mutex);
+                    auto it = keys.find(name);
+                    if (it != keys.end())
+                    {
+                        return &(*it);
+                    }
+                }
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                // If another thread added name in the meantime, try_emplace returns the existing entry
+                return &(*keys.try_emplace(name, keys.size()).first);
+            }
+
+        private:
+            std::shared_mutex mutex;
+            std::unordered_map<std::string, size_t> keys;
+        };
+    }
+
+    BlackboardKeyBase::BlackboardKeyBase(const std::string& name) : entry(BlackboardKeyRegistry::GetInstance().Intern(name))
+    {
+
+    }
+
     Blackboard::Blackboard()
     {
 
@@ -14,25 +57,40 @@ namespace Botcraft
 
     void Blackboard::Copy(const std::string& src, const std::string& dst)
     {
-        const std::any& source = blackboard.at(src);
-        blackboard[dst] = source;
-        NotifyKeyChanged(dst, source);
+        const BlackboardKeyBase& src_key = GetKey(src);
+        if (!Contains(src_key))
+        {
+            throw std::out_of_range("invalid blackboard key: " + src);
+        }
+        const BlackboardKeyBase& dst_key = GetKey(dst);
+        std::any& destination = GetSlot(dst_key.GetId());
+        destination = slots[src_key.GetId()];
+        NotifyKeyChanged(dst_key.GetName(), destination);
     }
 
     void Blackboard::Erase(const std::string& key)
     {
-        blackboard.erase(key);
-        NotifyKeyRemoved(key);
+        Erase(GetKey(key));
+    }
+
+    void Blackboard::Erase(const BlackboardKeyBase& key)
+    {
+        if (key.GetId() < slots.size())
+        {
+            slots[key.GetId()].reset();
+        }
+        NotifyKeyRemoved(key.GetName());
     }
 
     void Blackboard::Reset(const std::map<std::string, std::any>& values)
     {
-        blackboard.clear();
+        slots.clear();
         NotifyCleared();
         for (const auto& [k, v] : values)
         {
-            blackboard[k] = v;
-            NotifyKeyChanged(k, v);
+            const BlackboardKeyBase& key = GetKey(k);
+            GetSlot(key.GetId()) = v;
+            NotifyKeyChanged(key.GetName(), v);
         }
     }
 
@@ -58,7 +116,31 @@ namespace Botcraft
 
     bool Blackboard::Contains(const std::string& key) const
     {
-        return blackboard.find(key) != blackboard.end();
+        return Contains(GetKey(key));
+    }
+
+    bool Blackboard::Contains(const BlackboardKeyBase& key) const
+    {
+        return key.GetId() < slots.size() && slots[key.GetId()].has_value();
+    }
+
+    const BlackboardKeyBase& Blackboard::GetKey(const std::string& name) const
+    {
+        auto it = keys_cache.find(name);
+        if (it == keys_cache.end())
+        {
+            it = keys_cache.try_emplace(name, name).first;
+        }
+        return it->second;
+    }
+
+    std::any& Blackboard::GetSlot(const size_t id)
+    {
+        if (id >= slots.size())
+        {
+            slots.resize(id + 1);
+        }
+        return slots[id];
     }
 
     void Blackboard::NotifyCleared() const
@@ -83,6 +165,15 @@ namespace Botcraft
         }
     }
 
+    void Blackboard::NotifyKeyChanged(const BlackboardKeyBase& key) const
+    {
+        if (observers.empty() || !Contains(key))
+        {
+            return;
+        }
+        NotifyKeyChanged(key.GetName(), slots[key.GetId()]);
+    }
+
     void Blackboard::NotifyKeyChanged(const std::string& key, const std::any& value) const
     {
         for (auto o : observers)
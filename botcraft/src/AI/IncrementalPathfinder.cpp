@@ -0,0 +1,509 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "botcraft/AI/IncrementalPathfinder.hpp"
+#include "botcraft/AI/PathfindingMoves.hpp"
+#include "botcraft/Game/World/BlockCursor.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Max number of nodes read from the world for one FindPath, same as FindPath
+        constexpr size_t budget_expansions = 15000;
+        /// @brief Max number of nodes processed for one FindPath. Processing an already expanded node doesn't read the world, so it's cheaper
+        constexpr size_t budget_processed = 16 * budget_expansions;
+        /// @brief The explored graph is forgotten when it grows above this size
+        constexpr size_t max_nodes = 1 << 17;
+
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+    }
+
+    IncrementalPathfinder::IncrementalPathfinder(const bool allow_jump_, const bool takes_damage_, const float step_height_) :
+        allow_jump(allow_jump_), takes_damage(takes_damage_), step_height(step_height_)
+    {
+        min_y = 0;
+        goal = invalid_index;
+        start = invalid_index;
+        changes_since = 0;
+        num_expansions = 0;
+    }
+
+    IncrementalPathfinder::~IncrementalPathfinder()
+    {
+
+    }
+
+    std::vector<std::pair<Position, float>> IncrementalPathfinder::FindPath(const World& world, const Position& start_pos, const Position& end_pos)
+    {
+        num_expansions = 0;
+        if (goal == invalid_index || end_pos != end || nodes.size() > max_nodes)
+        {
+            Clear(end_pos);
+        }
+        // Bring the explored graph up to date with the world
+        Update(world);
+
+        min_y = world.GetMinY();
+        BlockCursor cursor = world.GetBlockCursor();
+
+        // If we moved along the previous path, the repaired search from the
+        // previous start is still valid as long as it goes through the new start
+        if (start != invalid_index && nodes[start].pos.first != start_pos)
+        {
+            if (!ComputeShortestPath(cursor))
+            {
+                return {};
+            }
+            const std::vector<std::pair<Position, float>> path = ExtractPath();
+            for (size_t i = 0; i < path.size(); ++i)
+            {
+                if (path[i].first == start_pos)
+                {
+                    return std::vector<std::pair<Position, float>>(path.begin() + i + 1, path.end());
+                }
+            }
+            // Otherwise restart the search from the new start, the moves already read are still reused
+            ResetSearch(cursor, start_pos);
+        }
+        else if (start == invalid_index)
+        {
+            ResetSearch(cursor, start_pos);
+        }
+
+        if (!ComputeShortestPath(cursor))
+        {
+            return {};
+        }
+        return ExtractPath();
+    }
+
+    bool IncrementalPathfinder::Update(const World& world)
+    {
+        if (goal == invalid_index)
+        {
+            return false;
+        }
+
+        if (!world.GetChanges(changes_since, changed_blocks, changed_chunks))
+        {
+            // Too many changes, start again from scratch
+            const bool had_start = start != invalid_index;
+            Clear(end);
+            changes_since = 0;
+            world.GetChanges(changes_since, changed_blocks, changed_chunks);
+            return had_start;
+        }
+
+        for (const Position& block : changed_blocks)
+        {
+            MarkDirty(block);
+        }
+        for (const auto& [chunk_x, chunk_z] : changed_chunks)
+        {
+            // Moves are read up to 2 blocks away
+            for (const auto& [column, first_node] : columns)
+            {
+                if (column.first < chunk_x * CHUNK_WIDTH - 2 || column.first > (chunk_x + 1) * CHUNK_WIDTH + 1 ||
+                    column.second < chunk_z * CHUNK_WIDTH - 2 || column.second > (chunk_z + 1) * CHUNK_WIDTH + 1)
+                {
+                    continue;
+                }
+                for (uint32_t n = first_node; n != invalid_index; n = nodes[n].next_in_column)
+                {
+                    if (nodes[n].expanded && !nodes[n].dirty)
+                    {
+                        nodes[n].dirty = true;
+                        dirty_nodes.push_back(n);
+                    }
+                }
+            }
+        }
+
+        if (dirty_nodes.empty())
+        {
+            return false;
+        }
+
+        min_y = world.GetMinY();
+        BlockCursor cursor = world.GetBlockCursor();
+        ExpandDirty(cursor);
+
+        return start != invalid_index && !IsSearchDone();
+    }
+
+    size_t IncrementalPathfinder::GetNumExpansions() const
+    {
+        return num_expansions;
+    }
+
+    size_t IncrementalPathfinder::GetNumNodes() const
+    {
+        // Virtual goal node is not counted
+        return nodes.empty() ? 0 : nodes.size() - 1;
+    }
+
+    size_t IncrementalPathfinder::NodeHash::operator()(const std::pair<Position, float>& pos) const
+    {
+        uint32_t height_bits;
+        std::memcpy(&height_bits, &pos.second, sizeof(float));
+        uint64_t value = static_cast<uint64_t>(static_cast<uint32_t>(pos.first.x)) * 0x9E3779B97F4A7C15ull;
+        value ^= static_cast<uint64_t>(static_cast<uint32_t>(pos.first.y)) * 0xC2B2AE3D27D4EB4Full;
+        value ^= static_cast<uint64_t>(static_cast<uint32_t>(pos.first.z)) * 0x165667B19E3779F9ull;
+        value ^= static_cast<uint64_t>(height_bits) * 0x27D4EB2F165667C5ull;
+        value ^= value >> 31;
+        return static_cast<size_t>(value);
+    }
+
+    void IncrementalPathfinder::Clear(const Position& end_pos)
+    {
+        nodes.clear();
+        edges.clear();
+        free_edges.clear();
+        nodes_map.clear();
+        columns.clear();
+        heap.clear();
+        dirty_nodes.clear();
+
+        end = end_pos;
+        start = invalid_index;
+        changes_since = 0;
+
+        // Virtual goal node, it's never expanded and not in nodes_map
+        goal = 0;
+        nodes.push_back(Node{ { end, 0.0f }, infinity, infinity, 0.0f, invalid_index, invalid_index, invalid_index, invalid_index, false, false });
+    }
+
+    void IncrementalPathfinder::ResetSearch(BlockCursor& cursor, const Position& start_pos)
+    {
+        heap.clear();
+        for (Node& n : nodes)
+        {
+            n.g = infinity;
+            n.rhs = infinity;
+            n.heap_index = invalid_index;
+        }
+        start = GetOrCreate({ start_pos, GetPathfindingHeight(cursor, start_pos, takes_damage) });
+        nodes[start].rhs = 0.0f;
+        HeapPush(start);
+    }
+
+    void IncrementalPathfinder::Expand(BlockCursor& cursor, const uint32_t node)
+    {
+        previous_targets.clear();
+        RemoveOutEdges(node);
+
+        PathfindingMoves moves;
+        GetPathfindingMoves(cursor, nodes[node].pos, min_y, allow_jump, takes_damage, step_height, moves);
+        for (size_t i = 0; i < moves.size; ++i)
+        {
+            AddEdge(node, GetOrCreate(moves.moves[i].first), moves.moves[i].second);
+        }
+        if (nodes[node].pos.first == end)
+        {
+            AddEdge(node, goal, 0.0f);
+        }
+        nodes[node].expanded = true;
+        num_expansions += 1;
+    }
+
+    void IncrementalPathfinder::MarkDirty(const Position& block)
+    {
+        // Columns from which GetPathfindingMoves reads this block
+        const std::array<std::pair<int, int>, 9> offsets = { {
+            { 0, 0 }, { 1, 0 }, { -1, 0 }, { 2, 0 }, { -2, 0 }, { 0, 1 }, { 0, -1 }, { 0, 2 }, { 0, -2 }
+        } };
+        for (const auto& [dx, dz] : offsets)
+        {
+            const auto it = columns.find({ block.x + dx, block.z + dz });
+            if (it == columns.end())
+            {
+                continue;
+            }
+            for (uint32_t n = it->second; n != invalid_index; n = nodes[n].next_in_column)
+            {
+                // Blocks are read up to 2 above the feet, and arbitrarily far below when looking for a landing climbable
+                if (nodes[n].expanded && !nodes[n].dirty && nodes[n].pos.first.y >= block.y - 2)
+                {
+                    nodes[n].dirty = true;
+                    dirty_nodes.push_back(n);
+                }
+            }
+        }
+    }
+
+    void IncrementalPathfinder::ExpandDirty(BlockCursor& cursor)
+    {
+        for (const uint32_t n : dirty_nodes)
+        {
+            nodes[n].dirty = false;
+            Expand(cursor, n);
+            // Nodes that lost or gained an edge
+            for (const uint32_t target : previous_targets)
+            {
+                UpdateNode(target);
+            }
+            for (uint32_t e = nodes[n].first_out; e != invalid_index; e = edges[e].next_out)
+            {
+                UpdateNode(edges[e].to);
+            }
+        }
+        dirty_nodes.clear();
+    }
+
+    uint32_t IncrementalPathfinder::GetOrCreate(const std::pair<Position, float>& pos)
+    {
+        // Make sure -0.0f and 0.0f are the same node
+        const std::pair<Position, float> key = { pos.first, pos.second + 0.0f };
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        const auto [it, inserted] = nodes_map.try_emplace(key, index);
+        if (!inserted)
+        {
+            return it->second;
+        }
+
+        const float heuristic = static_cast<float>(std::abs(key.first.x - end.x) + std::abs(key.first.y - end.y) + std::abs(key.first.z - end.z));
+        nodes.push_back(Node{ key, infinity, infinity, heuristic, invalid_index, invalid_index, invalid_index, invalid_index, false, false });
+
+        const auto [column, new_column] = columns.try_emplace({ key.first.x, key.first.z }, index);
+        if (!new_column)
+        {
+            nodes[index].next_in_column = column->second;
+            column->second = index;
+        }
+        return index;
+    }
+
+    void IncrementalPathfinder::AddEdge(const uint32_t from, const uint32_t to, const float cost)
+    {
+        uint32_t index;
+        if (free_edges.empty())
+        {
+            index = static_cast<uint32_t>(edges.size());
+            edges.emplace_back();
+        }
+        else
+        {
+            index = free_edges.back();
+            free_edges.pop_back();
+        }
+        edges[index] = Edge{ from, to, cost, nodes[from].first_out, nodes[to].first_in };
+        nodes[from].first_out = index;
+        nodes[to].first_in = index;
+    }
+
+    void IncrementalPathfinder::RemoveOutEdges(const uint32_t node)
+    {
+        for (uint32_t e = nodes[node].first_out; e != invalid_index; e = edges[e].next_out)
+        {
+            // Unlink from the target incoming edges
+            uint32_t* link = &nodes[edges[e].to].first_in;
+            while (*link != e)
+            {
+                link = &edges[*link].next_in;
+            }
+            *link = edges[e].next_in;
+
+            previous_targets.push_back(edges[e].to);
+            free_edges.push_back(e);
+        }
+        nodes[node].first_out = invalid_index;
+    }
+
+    void IncrementalPathfinder::UpdateNode(const uint32_t node)
+    {
+        Node& n = nodes[node];
+        if (node != start)
+        {
+            float rhs = infinity;
+            for (uint32_t e = n.first_in; e != invalid_index; e = edges[e].next_in)
+            {
+                rhs = std::min(rhs, nodes[edges[e].from].g + edges[e].cost);
+            }
+            n.rhs = rhs;
+        }
+
+        if (n.g != n.rhs)
+        {
+            if (n.heap_index == invalid_index)
+            {
+                HeapPush(node);
+            }
+            else
+            {
+                HeapUpdate(node);
+            }
+        }
+        else if (n.heap_index != invalid_index)
+        {
+            HeapRemove(node);
+        }
+    }
+
+    bool IncrementalPathfinder::IsSearchDone() const
+    {
+        return heap.empty() || (!IsKeyLess(heap.front(), goal) && nodes[goal].g == nodes[goal].rhs);
+    }
+
+    bool IncrementalPathfinder::ComputeShortestPath(BlockCursor& cursor)
+    {
+        size_t num_processed = 0;
+        while (!IsSearchDone())
+        {
+            if (num_expansions >= budget_expansions || num_processed >= budget_processed)
+            {
+                return false;
+            }
+            num_processed += 1;
+
+            const uint32_t node = heap.front();
+            HeapRemove(node);
+            // Goal is virtual, it has no move
+            if (node != goal && !nodes[node].expanded)
+            {
+                Expand(cursor, node);
+            }
+
+            if (nodes[node].g > nodes[node].rhs)
+            {
+                // Overconsistent, a shorter path has been found
+                nodes[node].g = nodes[node].rhs;
+            }
+            else
+            {
+                // Underconsistent, the path to this node got longer
+                nodes[node].g = infinity;
+                UpdateNode(node);
+            }
+            for (uint32_t e = nodes[node].first_out; e != invalid_index; e = edges[e].next_out)
+            {
+                UpdateNode(edges[e].to);
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::pair<Position, float>> IncrementalPathfinder::ExtractPath() const
+    {
+        std::vector<std::pair<Position, float>> output;
+        if (start == invalid_index || nodes[goal].g == infinity)
+        {
+            return output;
+        }
+
+        uint32_t current = goal;
+        size_t num_steps = 0;
+        while (current != start)
+        {
+            uint32_t best = invalid_index;
+            float best_cost = infinity;
+            for (uint32_t e = nodes[current].first_in; e != invalid_index; e = edges[e].next_in)
+            {
+                const float cost = nodes[edges[e].from].g + edges[e].cost;
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best = edges[e].from;
+                }
+            }
+            // Should not happen once the goal is consistent
+            num_steps += 1;
+            if (best == invalid_index || num_steps > nodes.size())
+            {
+                return {};
+            }
+            if (current != goal)
+            {
+                output.push_back(nodes[current].pos);
+            }
+            current = best;
+        }
+        std::reverse(output.begin(), output.end());
+        return output;
+    }
+
+    bool IncrementalPathfinder::IsKeyLess(const uint32_t a, const uint32_t b) const
+    {
+        const float min_a = std::min(nodes[a].g, nodes[a].rhs);
+        const float min_b = std::min(nodes[b].g, nodes[b].rhs);
+        const float key_a = min_a + nodes[a].heuristic;
+        const float key_b = min_b + nodes[b].heuristic;
+        return key_a < key_b || (key_a == key_b && min_a < min_b);
+    }
+
+    void IncrementalPathfinder::HeapPush(const uint32_t node)
+    {
+        nodes[node].heap_index = static_cast<uint32_t>(heap.size());
+        heap.push_back(node);
+        SiftUp(nodes[node].heap_index);
+    }
+
+    void IncrementalPathfinder::HeapRemove(const uint32_t node)
+    {
+        const uint32_t heap_pos = nodes[node].heap_index;
+        nodes[node].heap_index = invalid_index;
+        const uint32_t last = heap.back();
+        heap.pop_back();
+        if (heap_pos < heap.size())
+        {
+            heap[heap_pos] = last;
+            nodes[last].heap_index = heap_pos;
+            HeapUpdate(last);
+        }
+    }
+
+    void IncrementalPathfinder::HeapUpdate(const uint32_t node)
+    {
+        // Key can go both ways
+        SiftUp(nodes[node].heap_index);
+        SiftDown(nodes[node].heap_index);
+    }
+
+    void IncrementalPathfinder::SiftUp(uint32_t heap_pos)
+    {
+        const uint32_t node = heap[heap_pos];
+        while (heap_pos > 0)
+        {
+            const uint32_t parent_pos = (heap_pos - 1) / 2;
+            const uint32_t parent = heap[parent_pos];
+            if (!IsKeyLess(node, parent))
+            {
+                break;
+            }
+            heap[heap_pos] = parent;
+            nodes[parent].heap_index = heap_pos;
+            heap_pos = parent_pos;
+        }
+        heap[heap_pos] = node;
+        nodes[node].heap_index = heap_pos;
+    }
+
+    void IncrementalPathfinder::SiftDown(uint32_t heap_pos)
+    {
+        const uint32_t size = static_cast<uint32_t>(heap.size());
+        const uint32_t node = heap[heap_pos];
+        while (true)
+        {
+            uint32_t child_pos = 2 * heap_pos + 1;
+            if (child_pos >= size)
+            {
+                break;
+            }
+            if (child_pos + 1 < size && IsKeyLess(heap[child_pos + 1], heap[child_pos]))
+            {
+                child_pos += 1;
+            }
+            const uint32_t child = heap[child_pos];
+            if (!IsKeyLess(child, node))
+            {
+                break;
+            }
+            heap[heap_pos] = child;
+            nodes[child].heap_index = heap_pos;
+            heap_pos = child_pos;
+        }
+        heap[heap_pos] = node;
+        nodes[node].heap_index = heap_pos;
+    }
+} // Botcraft
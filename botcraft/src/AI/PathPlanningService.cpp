@@ -0,0 +1,165 @@
+#include <algorithm>
+
+#include "botcraft/AI/PathPlanningService.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    PathPlanningJob::PathPlanningJob()
+    {
+        finished = false;
+        cancelled = false;
+    }
+
+    void PathPlanningJob::Cancel()
+    {
+        cancelled = true;
+    }
+
+    bool PathPlanningJob::IsCancelled() const
+    {
+        return cancelled;
+    }
+
+    bool PathPlanningJob::IsDone() const
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        return finished && segments.empty();
+    }
+
+    bool PathPlanningJob::PopSegment(std::vector<std::pair<Position, float>>& segment)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (segments.empty())
+        {
+            return false;
+        }
+        segment = std::move(segments.front());
+        segments.pop_front();
+        return true;
+    }
+
+    void PathPlanningJob::PushSegment(std::vector<std::pair<Position, float>>&& segment)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        segments.push_back(std::move(segment));
+    }
+
+    void PathPlanningJob::Finish()
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        finished = true;
+    }
+
+
+    PathPlanningService& PathPlanningService::GetInstance()
+    {
+        static PathPlanningService instance;
+        return instance;
+    }
+
+    PathPlanningService::PathPlanningService()
+    {
+        started = false;
+        should_run = true;
+    }
+
+    PathPlanningService::~PathPlanningService()
+    {
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            should_run = false;
+        }
+        jobs_cv.notify_all();
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    void PathPlanningService::Start(const size_t num_threads)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (started)
+        {
+            return;
+        }
+
+        const size_t thread_count = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        LOG_INFO("Starting " << thread_count << " path planning threads");
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([this, i]()
+                {
+                    Logger::GetInstance().RegisterThread("PathPlanning - " + std::to_string(i));
+                    Run();
+                }
+            );
+        }
+
+        started = true;
+    }
+
+    bool PathPlanningService::IsStarted() const
+    {
+        return started;
+    }
+
+    std::shared_ptr<PathPlanningJob> PathPlanningService::Submit(std::function<void(PathPlanningJob&)>&& search)
+    {
+        if (!started)
+        {
+            Start(0);
+        }
+
+        std::shared_ptr<PathPlanningJob> job = std::make_shared<PathPlanningJob>();
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            jobs.emplace_back(job, std::move(search));
+        }
+        jobs_cv.notify_one();
+
+        return job;
+    }
+
+    void PathPlanningService::Run()
+    {
+        while (true)
+        {
+            std::shared_ptr<PathPlanningJob> job;
+            std::function<void(PathPlanningJob&)> search;
+            { // lock scope
+                std::unique_lock<std::mutex> lock(mutex);
+                jobs_cv.wait(lock, [&]() { return !jobs.empty() || !should_run; });
+                if (!should_run)
+                {
+                    return;
+                }
+                job = std::move(jobs.front().first);
+                search = std::move(jobs.front().second);
+                jobs.pop_front();
+            }
+
+            if (!job->IsCancelled())
+            {
+                try
+                {
+                    search(*job);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Exception caught during path planning:\n" << e.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("Unknown exception caught during path planning");
+                }
+            }
+            job->Finish();
+        }
+    }
+} // Botcraft
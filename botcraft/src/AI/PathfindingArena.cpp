@@ -0,0 +1,188 @@
+#include <cstring>
+
+#include "botcraft/AI/PathfindingArena.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Enough for most searches, the table grows if needed
+        constexpr size_t initial_num_slots = 1 << 14;
+    }
+
+    PathfindingArena::PathfindingArena()
+    {
+        // Generation 0 is used for free slots
+        generation = 1;
+        Rehash(initial_num_slots);
+    }
+
+    PathfindingArena& PathfindingArena::GetThreadLocal()
+    {
+        thread_local PathfindingArena arena;
+        return arena;
+    }
+
+    void PathfindingArena::Reset()
+    {
+        nodes.clear();
+        heap.clear();
+        generation += 1;
+        // Generation wrapped around, old slots could be seen as used
+        if (generation == 0)
+        {
+            for (Slot& s : slots)
+            {
+                s.generation = 0;
+            }
+            generation = 1;
+        }
+    }
+
+    uint32_t PathfindingArena::GetOrCreate(const std::pair<Position, float>& pos)
+    {
+        // Keep load factor under 0.5
+        if (2 * (nodes.size() + 1) > slots.size())
+        {
+            Rehash(2 * slots.size());
+        }
+
+        // Make sure -0.0f and 0.0f end up in the same slot
+        const std::pair<Position, float> key = { pos.first, pos.second + 0.0f };
+        size_t i = Hash(key) & mask;
+        while (slots[i].generation == generation)
+        {
+            if (nodes[slots[i].node].pos == key)
+            {
+                return slots[i].node;
+            }
+            i = (i + 1) & mask;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        slots[i].generation = generation;
+        slots[i].node = index;
+        nodes.push_back(Node{ key, std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), invalid_index, invalid_index });
+        return index;
+    }
+
+    bool PathfindingArena::Relax(const uint32_t index, const float cost, const float heuristic, const uint32_t parent)
+    {
+        Node& node = nodes[index];
+        if (cost >= node.cost)
+        {
+            return false;
+        }
+
+        node.cost = cost;
+        node.score = cost + heuristic;
+        node.parent = parent;
+        if (node.heap_index == invalid_index)
+        {
+            // New node, or node already explored but reached with a better path
+            node.heap_index = static_cast<uint32_t>(heap.size());
+            heap.push_back(index);
+        }
+        // Score can only decrease
+        SiftUp(node.heap_index);
+        return true;
+    }
+
+    uint32_t PathfindingArena::PopOpen()
+    {
+        const uint32_t output = heap.front();
+        nodes[output].heap_index = invalid_index;
+        if (heap.size() > 1)
+        {
+            heap.front() = heap.back();
+            nodes[heap.front()].heap_index = 0;
+            heap.pop_back();
+            SiftDown(0);
+        }
+        else
+        {
+            heap.pop_back();
+        }
+        return output;
+    }
+
+    size_t PathfindingArena::Hash(const std::pair<Position, float>& pos)
+    {
+        uint32_t height_bits;
+        std::memcpy(&height_bits, &pos.second, sizeof(float));
+        uint64_t value = static_cast<uint64_t>(static_cast<uint32_t>(pos.first.x)) * 0x9E3779B97F4A7C15ull;
+        value ^= static_cast<uint64_t>(static_cast<uint32_t>(pos.first.y)) * 0xC2B2AE3D27D4EB4Full;
+        value ^= static_cast<uint64_t>(static_cast<uint32_t>(pos.first.z)) * 0x165667B19E3779F9ull;
+        value ^= static_cast<uint64_t>(height_bits) * 0x27D4EB2F165667C5ull;
+        // Final mix so low bits depend on all coordinates
+        value ^= value >> 31;
+        value *= 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 29;
+        return static_cast<size_t>(value);
+    }
+
+    void PathfindingArena::Rehash(const size_t num_slots)
+    {
+        slots.assign(num_slots, Slot{ 0, 0 });
+        mask = num_slots - 1;
+        for (uint32_t index = 0; index < nodes.size(); ++index)
+        {
+            size_t i = Hash(nodes[index].pos) & mask;
+            while (slots[i].generation == generation)
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i].generation = generation;
+            slots[i].node = index;
+        }
+    }
+
+    void PathfindingArena::SiftUp(uint32_t heap_pos)
+    {
+        const uint32_t index = heap[heap_pos];
+        const float score = nodes[index].score;
+        while (heap_pos > 0)
+        {
+            const uint32_t parent_pos = (heap_pos - 1) / 2;
+            const uint32_t parent_index = heap[parent_pos];
+            if (nodes[parent_index].score <= score)
+            {
+                break;
+            }
+            heap[heap_pos] = parent_index;
+            nodes[parent_index].heap_index = heap_pos;
+            heap_pos = parent_pos;
+        }
+        heap[heap_pos] = index;
+        nodes[index].heap_index = heap_pos;
+    }
+
+    void PathfindingArena::SiftDown(uint32_t heap_pos)
+    {
+        const uint32_t size = static_cast<uint32_t>(heap.size());
+        const uint32_t index = heap[heap_pos];
+        const float score = nodes[index].score;
+        while (true)
+        {
+            uint32_t child_pos = 2 * heap_pos + 1;
+            if (child_pos >= size)
+            {
+                break;
+            }
+            if (child_pos + 1 < size && nodes[heap[child_pos + 1]].score < nodes[heap[child_pos]].score)
+            {
+                child_pos += 1;
+            }
+            const uint32_t child_index = heap[child_pos];
+            if (nodes[child_index].score >= score)
+            {
+                break;
+            }
+            heap[heap_pos] = child_index;
+            nodes[child_index].heap_index = heap_pos;
+            heap_pos = child_pos;
+        }
+        heap[heap_pos] = index;
+        nodes[index].heap_index = heap_pos;
+    }
+} // Botcraft
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+
+#include "botcraft/AI/SharedBehaviourThreads.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Same interval as RunBehaviourUntilClosed
+        constexpr std::chrono::milliseconds step_interval(10);
+    }
+
+    SharedBehaviour::SharedBehaviour(std::function<void()>&& loop, std::function<bool()>&& should_step_, const size_t stack_size, const size_t worker_index_) :
+        coroutine(std::move(loop), stack_size), should_step(std::move(should_step_)), worker_index(worker_index_)
+    {
+        num_steps = 0;
+        finished = false;
+        closing = false;
+    }
+
+    void SharedBehaviour::WaitNextStep()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const size_t current_step = num_steps;
+        step_cv.wait(lock, [&]() { return num_steps != current_step || finished; });
+    }
+
+
+    SharedBehaviourThreads& SharedBehaviourThreads::GetInstance()
+    {
+        static SharedBehaviourThreads instance;
+        return instance;
+    }
+
+    SharedBehaviourThreads::SharedBehaviourThreads()
+    {
+        started = false;
+        should_run = true;
+        stack_size = 0;
+        next_worker = 0;
+    }
+
+    SharedBehaviourThreads::~SharedBehaviourThreads()
+    {
+        should_run = false;
+        for (std::unique_ptr<Worker>& w : workers)
+        {
+            { // lock scope
+                std::scoped_lock<std::mutex> lock(w->mutex);
+                w->wake_up = true;
+            }
+            w->cv.notify_all();
+        }
+        for (std::unique_ptr<Worker>& w : workers)
+        {
+            if (w->thread.joinable())
+            {
+                w->thread.join();
+            }
+        }
+    }
+
+    void SharedBehaviourThreads::Start(const size_t num_threads, const size_t stack_size_)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (started)
+        {
+            return;
+        }
+
+        const size_t thread_count = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        LOG_INFO("Starting " << thread_count << " shared behaviour threads");
+
+        stack_size = stack_size_;
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+            Worker* worker = workers.back().get();
+            worker->thread = std::thread([this, worker, i]()
+                {
+                    Logger::GetInstance().RegisterThread("SharedBehaviour - " + std::to_string(i));
+                    Run(*worker);
+                }
+            );
+        }
+
+        started = true;
+    }
+
+    bool SharedBehaviourThreads::IsStarted() const
+    {
+        return started;
+    }
+
+    std::shared_ptr<SharedBehaviour> SharedBehaviourThreads::Add(std::function<void()>&& loop, std::function<bool()>&& should_step)
+    {
+        const size_t worker_index = next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+        std::shared_ptr<SharedBehaviour> behaviour = std::make_shared<SharedBehaviour>(std::move(loop), std::move(should_step), stack_size, worker_index);
+
+        Worker& worker = *workers[worker_index];
+        std::scoped_lock<std::mutex> lock(worker.mutex);
+        worker.pending.push_back(behaviour);
+
+        return behaviour;
+    }
+
+    void SharedBehaviourThreads::Stop(const std::shared_ptr<SharedBehaviour>& behaviour)
+    {
+        behaviour->closing = true;
+
+        Worker& worker = *workers[behaviour->worker_index];
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(worker.mutex);
+            worker.wake_up = true;
+        }
+        worker.cv.notify_all();
+
+        std::unique_lock<std::mutex> lock(behaviour->mutex);
+        behaviour->step_cv.wait(lock, [&]() { return behaviour->finished || !should_run; });
+    }
+
+    void SharedBehaviourThreads::Run(Worker& worker)
+    {
+        // Only accessed by this thread, so no lock needed when stepping
+        std::vector<std::shared_ptr<SharedBehaviour> > behaviours;
+        std::chrono::steady_clock::time_point next_step = std::chrono::steady_clock::now();
+        while (true)
+        {
+            { // lock scope
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                worker.cv.wait_until(lock, next_step, [&]() { return worker.wake_up || !should_run; });
+                if (!should_run)
+                {
+                    return;
+                }
+                worker.wake_up = false;
+                behaviours.insert(behaviours.end(), worker.pending.begin(), worker.pending.end());
+                worker.pending.clear();
+            }
+
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            const bool step_time = now >= next_step;
+            if (step_time)
+            {
+                next_step += step_interval;
+                // Don't try to catch up if we are late
+                if (next_step < now)
+                {
+                    next_step = now + step_interval;
+                }
+            }
+
+            for (const std::shared_ptr<SharedBehaviour>& b : behaviours)
+            {
+                // Out of step time, we were just woken up to stop some behaviours
+                const bool closing = b->closing;
+                if (!step_time && !closing)
+                {
+                    continue;
+                }
+
+                if (closing || b->should_step())
+                {
+                    try
+                    {
+                        b->coroutine.Resume();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_ERROR("Exception caught in shared behaviour:\n" << e.what());
+                    }
+                    catch (...)
+                    {
+                        LOG_ERROR("Unknown exception caught in shared behaviour");
+                    }
+                }
+
+                { // lock scope
+                    std::scoped_lock<std::mutex> lock(b->mutex);
+                    b->num_steps += 1;
+                    b->finished = b->coroutine.IsFinished();
+                }
+                b->step_cv.notify_all();
+            }
+
+            behaviours.erase(std::remove_if(behaviours.begin(), behaviours.end(),
+                [](const std::shared_ptr<SharedBehaviour>& b) { return b->finished; }), behaviours.end());
+        }
+    }
+} // Botcraft
@@ -1,5 +1,9 @@
 #include "botcraft/AI/BehaviourClient.hpp"
 #include "botcraft/AI/Blackboard.hpp"
+#include "botcraft/AI/IncrementalPathfinder.hpp"
+#include "botcraft/AI/PathPlanningService.hpp"
+#include "botcraft/AI/PathfindingArena.hpp"
+#include "botcraft/AI/PathfindingMoves.hpp"
 #include "botcraft/AI/Tasks/PathfindingTask.hpp"
 #include "botcraft/Game/Entities/EntityManager.hpp"
 #include "botcraft/Game/Entities/LocalPlayer.hpp"
@@ -16,43 +20,45 @@ namespace Botcraft
     {
     public:
         PathfindingBlockstate() = default;
-        PathfindingBlockstate(const Blockstate* block, const Position& pos, const bool take_damage) : block(block)
+        /// @brief Build from precomputed navigation properties
+        /// @param column Properties of the column containing the block
+        /// @param i Index of the block in column
+        /// @param pos Position of the block
+        /// @param take_damage If false, hazardous blocks are treated as any other block
+        /// @param cursor Cursor used to get the height of partial solid blocks
+        PathfindingBlockstate(const NavigationColumn& column, const int i, const Position& pos, const bool take_damage, BlockCursor& cursor)
         {
             height = pos.y;
-            if (block == nullptr)
+            if (!column.IsLoaded(i))
             {
                 empty = true;
                 return;
             }
             empty = false;
 
-            if (take_damage && block->IsHazardous())
+            if (take_damage && column.Has(NavigationProperty::Hazardous, i))
             {
                 hazardous = true;
                 return;
             }
 
-            if (block->IsFluidOrWaterlogged() && !block->IsSolid())
+            if (column.Has(NavigationProperty::Fluid, i))
             {
                 climbable = true;
                 fluid = true;
                 return;
             }
 
-            if (block->IsClimbable())
+            if (column.Has(NavigationProperty::Climbable, i))
             {
                 climbable = true;
                 return;
             }
 
-            if (block->IsSolid())
+            if (column.Has(NavigationProperty::Solid, i))
             {
                 solid = true;
-                const auto& colliders = block->GetCollidersAtPos(pos);
-                for (const auto& c : colliders)
-                {
-                    height = std::max(static_cast<float>(c.GetMax().y), height);
-                }
+                height = column.Has(NavigationProperty::PartialHeight, i) ? cursor.GetNavigationHeight(pos) : pos.y + 1.0f;
             }
             else
             {
@@ -60,7 +66,6 @@ namespace Botcraft
             }
         }
 
-        const Blockstate* GetBlockstate() const { return block; }
         bool IsEmpty() const { return empty; }
         bool IsSolid() const { return solid; }
         bool IsHazardous() const { return hazardous; }
@@ -69,7 +74,6 @@ namespace Botcraft
         float GetHeight() const { return height; }
 
     private:
-        const Blockstate* block = nullptr;
         bool empty = true;
         bool solid = false;
         bool hazardous = false;
@@ -78,854 +82,639 @@ namespace Botcraft
         float height = 0.0f;
     };
 
-    struct PosFloatPairHash
+    float GetPathfindingHeight(BlockCursor& cursor, const Position& pos, const bool takes_damage)
     {
-    public:
-        size_t operator()(const std::pair<Position, float>& p) const
-        {
-            size_t value = std::hash<Position>()(p.first);
-            value ^= std::hash<float>()(p.second) + 0x9e3779b9 + (value << 6) + (value >> 2);
-            return value;
-        }
-    };
+        return PathfindingBlockstate(cursor.GetNavigationColumn(pos, 1), 0, pos, takes_damage, cursor).GetHeight();
+    }
 
-    std::vector<std::pair<Position, float>> FindPath(const BehaviourClient& client, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump)
+    void GetPathfindingMoves(BlockCursor& cursor, const std::pair<Position, float>& from, const int min_y, const bool allow_jump, const bool takes_damage, const float step_height, PathfindingMoves& moves)
     {
-        struct PathNode
+        const std::array<Position, 4> neighbour_offsets = { Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1) };
+        moves.size = 0;
+
+        // Get the state around the player in the given location
+        std::array<PathfindingBlockstate, 6> vertical_surroundings;
+
+        // Assuming the player is standing on 3 (feeet on 2 and head on 1)
+        // 0
+        // 1
+        // 2
+        // 3
+        // 4
+        // 5
+        // All the properties of a column are read at once, with bit 0 being 5
+        const NavigationColumn vertical_column = cursor.GetNavigationColumn(from.first + Position(0, -3, 0), 6);
+        vertical_surroundings[0] = PathfindingBlockstate(vertical_column, 5, from.first + Position(0, 2, 0), takes_damage, cursor);
+        vertical_surroundings[1] = PathfindingBlockstate(vertical_column, 4, from.first + Position(0, 1, 0), takes_damage, cursor);
+        // Current feet block
+        vertical_surroundings[2] = PathfindingBlockstate(vertical_column, 3, from.first, takes_damage, cursor);
+        const bool can_jump =
+            vertical_column.IsLoaded(3) &&
+            !vertical_column.Has(NavigationProperty::NoJump, 3);
+
+        // if 2 is solid or hazardous, no down pathfinding is possible,
+        // so we can skip a few checks
+        if (!vertical_surroundings[2].IsSolid() && !vertical_surroundings[2].IsHazardous())
         {
-            std::pair<Position, float> pos; // <Block in which the feet are, feet height>
-            float score; // distance from start + heuristic to goal
+            // if 3 is solid or hazardous, no down pathfinding is possible,
+            // so we can skip a few checks
+            vertical_surroundings[3] = PathfindingBlockstate(vertical_column, 2, from.first + Position(0, -1, 0), takes_damage, cursor);
 
-            PathNode(const std::pair<Position, float>& p, const float s)
+            // If we can move down, we need 4 and 5
+            if (!vertical_surroundings[3].IsSolid() && !vertical_surroundings[3].IsHazardous())
             {
-                pos = p;
-                score = s;
+                vertical_surroundings[4] = PathfindingBlockstate(vertical_column, 1, from.first + Position(0, -2, 0), takes_damage, cursor);
+                vertical_surroundings[5] = PathfindingBlockstate(vertical_column, 0, from.first + Position(0, -3, 0), takes_damage, cursor);
             }
+        }
 
-            bool operator>(const PathNode& rhs) const
-            {
-                return score > rhs.score;
-            }
 
-            static float Heuristic(const Position& a, const Position& b)
-            {
-                return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z));
-            }
-        };
+        // Check all vertical cases that would allow the bot to pass
+        // -
+        // x
+        // ^
+        // ?
+        // ?
+        // ?
+        if (vertical_surroundings[2].IsClimbable()
+            && !vertical_surroundings[1].IsSolid()
+            && !vertical_surroundings[1].IsHazardous()
+            && !vertical_surroundings[0].IsSolid()
+            && !vertical_surroundings[0].IsHazardous()
+            )
+        {
+            const float move_cost = 1.0f;
+            const std::pair<Position, float> new_pos = {
+                from.first + Position(0, 1, 0),
+                from.first.y + 1.0f
+            };
+            moves.Add(new_pos, move_cost);
+        }
 
-        constexpr int budget_visit = 15000;
+        // -
+        // ^
+        // x
+        // o
+        // ?
+        // ?
+        if (can_jump
+            && vertical_surroundings[1].IsClimbable()
+            && !vertical_surroundings[0].IsSolid()
+            && !vertical_surroundings[0].IsHazardous()
+            && (vertical_surroundings[2].IsSolid() || // we stand on top of 2
+                vertical_surroundings[3].IsSolid()) // if not, it means we stand on 3. Height difference check is not necessary, as the feet are in 2, we know 3 is at least 1 tall
+            )
+        {
+            const float move_cost = 1.5f;
+            const std::pair<Position, float> new_pos = {
+                from.first + Position(0, 1, 0),
+                from.first.y + 1.0f
+            };
+            moves.Add(new_pos, move_cost);
+        }
 
-        const std::array<Position, 4> neighbour_offsets = { Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1) };
-        std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode> > nodes_to_explore;
-        std::unordered_map<std::pair<Position, float>, std::pair<Position, float>, PosFloatPairHash> came_from;
-        std::unordered_map<std::pair<Position, float>, float, PosFloatPairHash> cost;
+        // ?
+        // x
+        //
+        // -
+        // ?
+        // ?
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            )
+        {
+            const float move_cost = 1.0f;
+            const std::pair<Position, float> new_pos = {
+                from.first + Position(0, -1, 0),
+                from.first.y - 1.0f
+            };
+            moves.Add(new_pos, move_cost);
+        }
 
-        const bool takes_damage = !client.GetLocalPlayer()->GetInvulnerable();
-        std::shared_ptr<World> world = client.GetWorld();
-        const Blockstate* block = world->GetBlock(start);
-        nodes_to_explore.emplace(PathNode({ start, PathfindingBlockstate(block, start, takes_damage).GetHeight() }, 0.0f));
-        came_from[nodes_to_explore.top().pos] = nodes_to_explore.top().pos;
-        cost[nodes_to_explore.top().pos] = 0.0f;
+        // ?
+        // x
+        //
+        // -
+        //
+        // o
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            && vertical_surroundings[4].IsEmpty()
+            && !vertical_surroundings[5].IsEmpty()
+            && !vertical_surroundings[5].IsHazardous()
+            )
+        {
+            const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > from.first.y - 2;
+            const float move_cost = 3.0f - 1.0f * above_block;
+            const std::pair<Position, float> new_pos = {
+                from.first + Position(0, -3 + 1 * above_block, 0),
+                above_block ? std::max(from.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
+            };
+            moves.Add(new_pos, move_cost);
+        }
 
-        int count_visit = 0;
-        // We found one location matching all the criterion, but
-        // continue the search to see if we can find a better one
-        bool suitable_location_found = false;
-        // We found a path to the desired goal
-        bool end_reached = false;
 
-        bool end_is_inside_solid = false;
-        block = world->GetBlock(end);
-        end_is_inside_solid = block != nullptr && block->IsSolid();
-#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
-        const float step_height = static_cast<float>(client.GetLocalPlayer()->GetAttributeStepHeightValue());
-#else
-        const float step_height = 0.6f;
-#endif
 
-        while (!nodes_to_explore.empty())
+        // ?
+        // x
+        // ^
+        //
+        //
+        // o
+        if (vertical_surroundings[2].IsClimbable()
+            && vertical_surroundings[3].IsEmpty()
+            && vertical_surroundings[4].IsEmpty()
+            && !vertical_surroundings[5].IsEmpty()
+            && !vertical_surroundings[5].IsHazardous()
+            )
         {
-            count_visit++;
-            PathNode current_node = nodes_to_explore.top();
-            nodes_to_explore.pop();
+            const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > from.first.y - 2;
+            const float move_cost = 3.0f - 1.0f * above_block;
+            const std::pair<Position, float> new_pos = {
+                from.first + Position(0, -3 + 1 * above_block, 0),
+                above_block ? std::max(from.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
+            };
+            moves.Add(new_pos, move_cost);
+        }
 
-            end_reached |= current_node.pos.first == end;
-            suitable_location_found |=
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) <= dist_tolerance &&
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist &&
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist_xz;
 
-            if (// If we exceeded the search budget
-                count_visit > budget_visit ||
-                // Or if we found a suitable location in the process and already reached the goal/can't reach it anyway
-                (suitable_location_found && (end_reached || end_is_inside_solid)))
+        // ?
+        // x
+        //
+        // -
+        //
+        //
+        // Special case here, we can drop down
+        // if there is a climbable at the bottom
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            && vertical_surroundings[4].IsEmpty()
+            && vertical_surroundings[5].IsEmpty()
+            )
+        {
+            for (int y = -4; from.first.y + y >= min_y; --y)
             {
-                break;
-            }
+                const Position pos = from.first + Position(0, y, 0);
+                const NavigationColumn landing_column = cursor.GetNavigationColumn(pos, 1);
 
-            // Get the state around the player in the given location
-            std::array<PathfindingBlockstate, 6> vertical_surroundings;
-
-            // Assuming the player is standing on 3 (feeet on 2 and head on 1)
-            // 0
-            // 1
-            // 2
-            // 3
-            // 4
-            // 5
-            Position pos = current_node.pos.first + Position(0, 2, 0);
-            block = world->GetBlock(pos);
-            vertical_surroundings[0] = PathfindingBlockstate(block, pos, takes_damage);
-            pos = current_node.pos.first + Position(0, 1, 0);
-            block = world->GetBlock(pos);
-            vertical_surroundings[1] = PathfindingBlockstate(block, pos, takes_damage);
-            // Current feet block
-            pos = current_node.pos.first;
-            block = world->GetBlock(pos);
-            vertical_surroundings[2] = PathfindingBlockstate(block, pos, takes_damage);
-            const bool can_jump =
-                vertical_surroundings[2].GetBlockstate() != nullptr &&
-                vertical_surroundings[2].GetBlockstate()->CanJumpWhenFeetInside();
-
-            // if 2 is solid or hazardous, no down pathfinding is possible,
-            // so we can skip a few checks
-            if (!vertical_surroundings[2].IsSolid() && !vertical_surroundings[2].IsHazardous())
-            {
-                // if 3 is solid or hazardous, no down pathfinding is possible,
-                // so we can skip a few checks
-                pos = current_node.pos.first + Position(0, -1, 0);
-                block = world->GetBlock(pos);
-                vertical_surroundings[3] = PathfindingBlockstate(block, pos, takes_damage);
-
-                // If we can move down, we need 4 and 5
-                if (!vertical_surroundings[3].IsSolid() && !vertical_surroundings[3].IsHazardous())
+                if (landing_column.Has(NavigationProperty::Solid, 0) && !landing_column.Has(NavigationProperty::Climbable, 0))
                 {
-                    pos = current_node.pos.first + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    vertical_surroundings[4] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = current_node.pos.first + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    vertical_surroundings[5] = PathfindingBlockstate(block, pos, takes_damage);
+                    break;
+                }
+
+                const PathfindingBlockstate landing_block(landing_column, 0, pos, takes_damage, cursor);
+                if (landing_block.IsClimbable())
+                {
+                    const float move_cost = std::abs(y);
+                    const std::pair<Position, float> new_pos = {
+                        from.first + Position(0, y + 1, 0),
+                        from.first.y + y + 1.0f
+                    };
+                    moves.Add(new_pos, move_cost);
+
+                    break;
                 }
             }
+        }
 
 
-            // Check all vertical cases that would allow the bot to pass
-            // -
-            // x
-            // ^
-            // ?
-            // ?
-            // ?
-            if (vertical_surroundings[2].IsClimbable()
-                && !vertical_surroundings[1].IsSolid()
-                && !vertical_surroundings[1].IsHazardous()
-                && !vertical_surroundings[0].IsSolid()
-                && !vertical_surroundings[0].IsHazardous()
+        // For each neighbour, check if it's reachable
+        // and add it to the search list if it is
+        for (int i = 0; i < neighbour_offsets.size(); ++i)
+        {
+            const Position next_location = from.first + neighbour_offsets[i];
+            const Position next_next_location = next_location + neighbour_offsets[i];
+
+            // Get the state around the player in the given direction
+            std::array<PathfindingBlockstate, 12> horizontal_surroundings;
+
+            // Assuming the player is standing on v3 (feeet on v2 and head on v1)
+            // v0   0   6 --> ?  ?  ?
+            // v1   1   7 --> x  ?  ?
+            // v2   2   8 --> x  ?  ?
+            // v3   3   9 --> ?  ?  ?
+            // v4   4  10 --> ?  ?  ?
+            // v5   5  11 --> ?  ?  ?
+
+            // if 1 is solid and tall, no horizontal pathfinding is possible,
+            // so we can skip a lot of checks
+            const NavigationColumn next_column = cursor.GetNavigationColumn(next_location + Position(0, -3, 0), 6);
+            horizontal_surroundings[0] = PathfindingBlockstate(next_column, 5, next_location + Position(0, 2, 0), takes_damage, cursor);
+            horizontal_surroundings[1] = PathfindingBlockstate(next_column, 4, next_location + Position(0, 1, 0), takes_damage, cursor);
+            const bool horizontal_movement =
+                (!horizontal_surroundings[1].IsSolid() || // 1 is not solid
+                    (horizontal_surroundings[1].GetHeight() - from.second < 1.25f && // or 1 is solid and small
+                        !horizontal_surroundings[0].IsSolid() && !horizontal_surroundings[0].IsHazardous())  // and 0 does not prevent standing
+                ) && !horizontal_surroundings[1].IsHazardous();
+
+            // If we can move horizontally, get the full column
+            if (horizontal_movement)
+            {
+                horizontal_surroundings[2] = PathfindingBlockstate(next_column, 3, next_location, takes_damage, cursor);
+                horizontal_surroundings[3] = PathfindingBlockstate(next_column, 2, next_location + Position(0, -1, 0), takes_damage, cursor);
+                horizontal_surroundings[4] = PathfindingBlockstate(next_column, 1, next_location + Position(0, -2, 0), takes_damage, cursor);
+                horizontal_surroundings[5] = PathfindingBlockstate(next_column, 0, next_location + Position(0, -3, 0), takes_damage, cursor);
+            }
+
+            // We can't make large jumps if our feet are in an incompatible block
+            // If we can jump, then we need the third column
+            if (allow_jump && can_jump)
+            {
+                const NavigationColumn next_next_column = cursor.GetNavigationColumn(next_next_location + Position(0, -3, 0), 6);
+                horizontal_surroundings[6] = PathfindingBlockstate(next_next_column, 5, next_next_location + Position(0, 2, 0), takes_damage, cursor);
+                horizontal_surroundings[7] = PathfindingBlockstate(next_next_column, 4, next_next_location + Position(0, 1, 0), takes_damage, cursor);
+                horizontal_surroundings[8] = PathfindingBlockstate(next_next_column, 3, next_next_location, takes_damage, cursor);
+                horizontal_surroundings[9] = PathfindingBlockstate(next_next_column, 2, next_next_location + Position(0, -1, 0), takes_damage, cursor);
+                horizontal_surroundings[10] = PathfindingBlockstate(next_next_column, 1, next_next_location + Position(0, -2, 0), takes_damage, cursor);
+                horizontal_surroundings[11] = PathfindingBlockstate(next_next_column, 0, next_next_location + Position(0, -3, 0), takes_damage, cursor);
+            }
+
+            // Now that we know the surroundings, we can check all
+            // horizontal cases that would allow the bot to pass
+
+            /************ HORIZONTAL **************/
+
+            // ?  ?  ?
+            // x  -  ?
+            // x  -  ?
+            //--- o  ?
+            //    ?  ?
+            //    ?  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && !horizontal_surroundings[2].IsSolid()
+                && !horizontal_surroundings[2].IsHazardous()
+                && !horizontal_surroundings[3].IsEmpty()
+                && !horizontal_surroundings[3].IsHazardous()
+                && (!horizontal_surroundings[3].IsFluid()   // We can't go from above a fluid to above
+                    || !vertical_surroundings[3].IsFluid()  // another one to avoid "walking on water"
+                    || horizontal_surroundings[2].IsFluid() // except if one or both "leg level" blocks
+                    || vertical_surroundings[2].IsFluid())  // are also fluids
                 )
             {
-                const float new_cost = cost[current_node.pos] + 1.0f;
+                const bool above_block = horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[3].IsClimbable() || horizontal_surroundings[3].GetHeight() + 1e-3f > from.first.y;
+                const float move_cost = 2.0f - 1.0f * above_block;
                 const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, 1, 0),
-                    current_node.pos.first.y + 1.0f
+                    next_location + Position(0, 1 - 1 * above_block, 0),
+                    above_block ? std::max(static_cast<float>(next_location.y), horizontal_surroundings[3].GetHeight()) : std::max(horizontal_surroundings[3].GetHeight(), horizontal_surroundings[4].GetHeight())
                 };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
+                moves.Add(new_pos, move_cost);
             }
 
-            // -
-            // ^
-            // x
-            // o
-            // ?
-            // ?
+
+            // -  -  ?
+            // x  o  ?
+            // x  ?  ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
             if (can_jump
-                && vertical_surroundings[1].IsClimbable()
                 && !vertical_surroundings[0].IsSolid()
                 && !vertical_surroundings[0].IsHazardous()
-                && (vertical_surroundings[2].IsSolid() || // we stand on top of 2
-                    vertical_surroundings[3].IsSolid()) // if not, it means we stand on 3. Height difference check is not necessary, as the feet are in 2, we know 3 is at least 1 tall
+                && vertical_surroundings[1].IsEmpty()
+                && (vertical_surroundings[2].IsSolid() || !vertical_surroundings[3].IsClimbable())
+                && !horizontal_surroundings[0].IsSolid()
+                && !horizontal_surroundings[0].IsHazardous()
+                && !horizontal_surroundings[1].IsEmpty()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[1].GetHeight() - from.second < 1.25f
                 )
             {
-                const float new_cost = cost[current_node.pos] + 1.5f;
+                const float move_cost = 2.5f;
                 const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, 1, 0),
-                    current_node.pos.first.y + 1.0f
+                    next_location + Position(0, 1, 0),
+                    std::max(horizontal_surroundings[1].GetHeight(), horizontal_surroundings[2].GetHeight()) // for the carpet on wall trick
                 };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
+                moves.Add(new_pos, move_cost);
             }
 
-            // ?
-            // x
-            //
-            // -
-            // ?
-            // ?
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
+            // -  -  ?
+            // x  -  ?
+            // x  o  ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if ((can_jump || horizontal_surroundings[2].GetHeight() - from.second < step_height)
+                && !vertical_surroundings[0].IsSolid()
+                && !vertical_surroundings[0].IsHazardous()
+                && vertical_surroundings[1].IsEmpty()
+                && (vertical_surroundings[2].IsSolid() || (vertical_surroundings[2].IsEmpty() && vertical_surroundings[3].IsSolid()))
+                && !horizontal_surroundings[0].IsSolid()
+                && !horizontal_surroundings[0].IsHazardous()
+                && !horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && !horizontal_surroundings[2].IsEmpty()
+                && !horizontal_surroundings[2].IsHazardous()
+                && horizontal_surroundings[2].GetHeight() - from.second < 1.25f
                 )
             {
-                const float new_cost = cost[current_node.pos] + 1.0f;
+                const bool above_block = horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[2].GetHeight() + 1e-3f > from.first.y + 1;
+                const float move_cost = 1.0f + 1.0f * above_block + 0.5f * (horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].GetHeight() - vertical_surroundings[2].GetHeight() > 0.5);
                 const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -1, 0),
-                    current_node.pos.first.y - 1.0f
+                    next_location + Position(0, 1 * above_block, 0),
+                    above_block ? std::max(from.first.y + 1.0f, horizontal_surroundings[2].GetHeight()) : std::max(horizontal_surroundings[2].GetHeight(), horizontal_surroundings[3].GetHeight())
                 };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(new_pos, new_cost + PathNode::Heuristic(new_pos.first, end)));
-                    came_from[new_pos] = current_node.pos;
-                }
+                moves.Add(new_pos, move_cost);
             }
 
-            // ?
-            // x
-            //
-            // -
-            //
-            // o
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
-                && vertical_surroundings[4].IsEmpty()
-                && !vertical_surroundings[5].IsEmpty()
-                && !vertical_surroundings[5].IsHazardous()
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //    o  ?
+            //    ?  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && !horizontal_surroundings[4].IsEmpty()
+                && !horizontal_surroundings[4].IsHazardous()
                 )
             {
-                const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                const float new_cost = cost[current_node.pos] + 3.0f - 1.0f * above_block;
+                const bool above_block = horizontal_surroundings[4].IsClimbable() || horizontal_surroundings[4].GetHeight() + 1e-3f > from.first.y - 1;
+                const float move_cost = 3.5f - 1.0f * above_block;
                 const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -3 + 1 * above_block, 0),
-                    above_block ? std::max(current_node.pos.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
+                    next_location + Position(0, -2 + 1 * above_block, 0),
+                    above_block ? std::max(from.first.y - 1.0f, horizontal_surroundings[4].GetHeight()) : std::max(horizontal_surroundings[4].GetHeight(), horizontal_surroundings[5].GetHeight())
                 };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
+                moves.Add(new_pos, move_cost);
             }
 
-
-
-            // ?
-            // x
-            // ^
-            //
-            //
-            // o
-            if (vertical_surroundings[2].IsClimbable()
-                && vertical_surroundings[3].IsEmpty()
-                && vertical_surroundings[4].IsEmpty()
-                && !vertical_surroundings[5].IsEmpty()
-                && !vertical_surroundings[5].IsHazardous()
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //       ?
+            //    o  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && horizontal_surroundings[4].IsEmpty()
+                && !horizontal_surroundings[5].IsEmpty()
+                && !horizontal_surroundings[5].IsHazardous()
                 )
             {
-                const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                const float new_cost = cost[current_node.pos] + 3.0f - 1.0f * above_block;
+                const bool above_block = horizontal_surroundings[5].IsClimbable() || horizontal_surroundings[5].GetHeight() + 1e-3f > from.first.y - 2;
+                const float move_cost = 4.5f - 1.0f * above_block;
                 const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -3 + 1 * above_block, 0),
-                    above_block ? std::max(current_node.pos.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
+                    next_location + Position(0, -3 + 1 * above_block, 0),
+                    above_block ? std::max(from.first.y - 2.0f, horizontal_surroundings[5].GetHeight()) : horizontal_surroundings[5].GetHeight() // no carpet on wall check here as we don't have the block below
                 };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
+                moves.Add(new_pos, move_cost);
             }
 
-
-            // ?
-            // x
-            //
-            // -
-            //
-            //
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //       ?
+            //       ?
             // Special case here, we can drop down
             // if there is a climbable at the bottom
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
-                && vertical_surroundings[4].IsEmpty()
-                && vertical_surroundings[5].IsEmpty()
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && horizontal_surroundings[4].IsEmpty()
+                && horizontal_surroundings[5].IsEmpty()
                 )
             {
-                for (int y = -4; current_node.pos.first.y + y >= world->GetMinY(); --y)
+                for (int y = -4; next_location.y + y >= min_y; --y)
                 {
-                    pos = current_node.pos.first + Position(0, y, 0);
-                    block = world->GetBlock(pos);
+                    const Position pos = next_location + Position(0, y, 0);
+                    const NavigationColumn landing_column = cursor.GetNavigationColumn(pos, 1);
 
-                    if (block != nullptr && block->IsSolid() && !block->IsClimbable())
+                    if (landing_column.Has(NavigationProperty::Solid, 0) && !landing_column.Has(NavigationProperty::Climbable, 0))
                     {
                         break;
                     }
 
-                    const PathfindingBlockstate landing_block(block, pos, takes_damage);
+                    const PathfindingBlockstate landing_block(landing_column, 0, pos, takes_damage, cursor);
                     if (landing_block.IsClimbable())
                     {
-                        const float new_cost = cost[current_node.pos] + std::abs(y);
+                        const float move_cost = std::abs(y) + 1.5f;
                         const std::pair<Position, float> new_pos = {
-                            current_node.pos.first + Position(0, y + 1, 0),
-                            current_node.pos.first.y + y + 1.0f
+                            next_location + Position(0, y + 1, 0),
+                            next_location.y + y + 1.0f
                         };
-                        auto it = cost.find(new_pos);
-                        // If we don't already know this node with a better path, add it
-                        if (it == cost.end() ||
-                            new_cost < it->second)
-                        {
-                            cost[new_pos] = new_cost;
-                            nodes_to_explore.emplace(PathNode(
-                                new_pos,
-                                new_cost + PathNode::Heuristic(new_pos.first, end))
-                            );
-                            came_from[new_pos] = current_node.pos;
-                        }
+                        moves.Add(new_pos, move_cost);
 
                         break;
                     }
                 }
             }
 
-
-            // For each neighbour, check if it's reachable
-            // and add it to the search list if it is
-            for (int i = 0; i < neighbour_offsets.size(); ++i)
+            // If we can't make jumps, don't bother explore the rest
+            // of the cases
+            if (!allow_jump
+                || !can_jump
+                || vertical_surroundings[0].IsSolid()       // Block above
+                || vertical_surroundings[0].IsHazardous()   // Block above
+                || !vertical_surroundings[1].IsEmpty()      // Block above
+                || vertical_surroundings[3].IsFluid()       // "Walking" on fluid
+                || vertical_surroundings[3].IsEmpty()       // Feet on nothing (inside climbable)
+                || horizontal_surroundings[0].IsSolid()     // Block above next column
+                || horizontal_surroundings[0].IsHazardous() // Hazard above next column
+                || !horizontal_surroundings[1].IsEmpty()    // Non empty block in next column, can't jump through it
+                || !horizontal_surroundings[2].IsEmpty()    // Non empty block in next column, can't jump through it
+                || horizontal_surroundings[6].IsSolid()     // Block above nextnext column
+                || horizontal_surroundings[6].IsHazardous() // Hazard above nextnext column
+                )
             {
-                const Position next_location = current_node.pos.first + neighbour_offsets[i];
-                const Position next_next_location = next_location + neighbour_offsets[i];
-
-                // Get the state around the player in the given direction
-                std::array<PathfindingBlockstate, 12> horizontal_surroundings;
-
-                // Assuming the player is standing on v3 (feeet on v2 and head on v1)
-                // v0   0   6 --> ?  ?  ?
-                // v1   1   7 --> x  ?  ?
-                // v2   2   8 --> x  ?  ?
-                // v3   3   9 --> ?  ?  ?
-                // v4   4  10 --> ?  ?  ?
-                // v5   5  11 --> ?  ?  ?
-
-                // if 1 is solid and tall, no horizontal pathfinding is possible,
-                // so we can skip a lot of checks
-                pos = next_location + Position(0, 2, 0);
-                block = world->GetBlock(pos);
-                horizontal_surroundings[0] = PathfindingBlockstate(block, pos, takes_damage);
-                pos = next_location + Position(0, 1, 0);
-                block = world->GetBlock(pos);
-                horizontal_surroundings[1] = PathfindingBlockstate(block, pos, takes_damage);
-                const bool horizontal_movement =
-                    (!horizontal_surroundings[1].IsSolid() || // 1 is not solid
-                        (horizontal_surroundings[1].GetHeight() - current_node.pos.second < 1.25f && // or 1 is solid and small
-                            !horizontal_surroundings[0].IsSolid() && !horizontal_surroundings[0].IsHazardous())  // and 0 does not prevent standing
-                    ) && !horizontal_surroundings[1].IsHazardous();
-
-                // If we can move horizontally, get the full column
-                if (horizontal_movement)
-                {
-                    pos = next_location;
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[2] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[3] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[4] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[5] = PathfindingBlockstate(block, pos, takes_damage);
-                }
-
-                // We can't make large jumps if our feet are in an incompatible block
-                // If we can jump, then we need the third column
-                if (allow_jump && can_jump)
-                {
-                    pos = next_next_location + Position(0, 2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[6] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, 1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[7] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location;
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[8] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[9] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[10] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[11] = PathfindingBlockstate(block, pos, takes_damage);
-                }
-
-                // Now that we know the surroundings, we can check all
-                // horizontal cases that would allow the bot to pass
-
-                /************ HORIZONTAL **************/
-
-                // ?  ?  ?
-                // x  -  ?
-                // x  -  ?
-                //--- o  ?
-                //    ?  ?
-                //    ?  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && !horizontal_surroundings[2].IsSolid()
-                    && !horizontal_surroundings[2].IsHazardous()
-                    && !horizontal_surroundings[3].IsEmpty()
-                    && !horizontal_surroundings[3].IsHazardous()
-                    && (!horizontal_surroundings[3].IsFluid()   // We can't go from above a fluid to above
-                        || !vertical_surroundings[3].IsFluid()  // another one to avoid "walking on water"
-                        || horizontal_surroundings[2].IsFluid() // except if one or both "leg level" blocks
-                        || vertical_surroundings[2].IsFluid())  // are also fluids
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[3].IsClimbable() || horizontal_surroundings[3].GetHeight() + 1e-3f > current_node.pos.first.y;
-                    const float new_cost = cost[current_node.pos] + 2.0f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1 - 1 * above_block, 0),
-                        above_block ? std::max(static_cast<float>(next_location.y), horizontal_surroundings[3].GetHeight()) : std::max(horizontal_surroundings[3].GetHeight(), horizontal_surroundings[4].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
+                continue;
+            }
 
-                // -  -  ?
-                // x  o  ?
-                // x  ?  ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (can_jump
-                    && !vertical_surroundings[0].IsSolid()
-                    && !vertical_surroundings[0].IsHazardous()
-                    && vertical_surroundings[1].IsEmpty()
-                    && (vertical_surroundings[2].IsSolid() || !vertical_surroundings[3].IsClimbable())
-                    && !horizontal_surroundings[0].IsSolid()
-                    && !horizontal_surroundings[0].IsHazardous()
-                    && !horizontal_surroundings[1].IsEmpty()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[1].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const float new_cost = cost[current_node.pos] + 2.5f;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1, 0),
-                        std::max(horizontal_surroundings[1].GetHeight(), horizontal_surroundings[2].GetHeight()) // for the carpet on wall trick
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            /************ BIG JUMP **************/
+            // -  -  -
+            // x     o
+            // x     ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (!horizontal_surroundings[7].IsEmpty()
+                && !horizontal_surroundings[7].IsHazardous()
+                && horizontal_surroundings[7].GetHeight() - from.second < 1.25f
+                )
+            {
+                // 5 > 4.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
+                // but if horizontal_surroundings[3] is hazardous we can jump over it
+                const float move_cost = 5.0f;
+                const std::pair<Position, float> new_pos = {
+                    next_next_location + Position(0, 1, 0),
+                    std::max(horizontal_surroundings[7].GetHeight(), horizontal_surroundings[8].GetHeight()), // for the carpet on wall trick
+                };
+                moves.Add(new_pos, move_cost);
+            }
 
-                // -  -  ?
-                // x  -  ?
-                // x  o  ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if ((can_jump || horizontal_surroundings[2].GetHeight() - current_node.pos.second < step_height)
-                    && !vertical_surroundings[0].IsSolid()
-                    && !vertical_surroundings[0].IsHazardous()
-                    && vertical_surroundings[1].IsEmpty()
-                    && (vertical_surroundings[2].IsSolid() || (vertical_surroundings[2].IsEmpty() && vertical_surroundings[3].IsSolid()))
-                    && !horizontal_surroundings[0].IsSolid()
-                    && !horizontal_surroundings[0].IsHazardous()
-                    && !horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && !horizontal_surroundings[2].IsEmpty()
-                    && !horizontal_surroundings[2].IsHazardous()
-                    && horizontal_surroundings[2].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[2].GetHeight() + 1e-3f > current_node.pos.first.y + 1;
-                    const float new_cost = cost[current_node.pos] + 1.0f + 1.0f * above_block + 0.5f * (horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].GetHeight() - vertical_surroundings[2].GetHeight() > 0.5);
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y + 1.0f, horizontal_surroundings[2].GetHeight()) : std::max(horizontal_surroundings[2].GetHeight(), horizontal_surroundings[3].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            // -  -  -
+            // x
+            // x     o
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && !horizontal_surroundings[8].IsEmpty()
+                && !horizontal_surroundings[8].IsHazardous()
+                && horizontal_surroundings[8].GetHeight() - from.second < 1.25f
+                )
+            {
+                const bool above_block = horizontal_surroundings[8].IsClimbable() || horizontal_surroundings[8].GetHeight() + 1e-3f > from.first.y + 1;
+                // 4 > 3.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
+                // but if horizontal_surroundings[3] is hazardous we can jump over it
+                const float move_cost = 3.0f + 1.0f * above_block;
+                const std::pair<Position, float> new_pos = {
+                    next_next_location + Position(0, above_block * 1, 0),
+                    above_block ? std::max(from.first.y + 1.0f, horizontal_surroundings[8].GetHeight()) : std::max(horizontal_surroundings[8].GetHeight(), horizontal_surroundings[9].GetHeight())
+                };
+                moves.Add(new_pos, move_cost);
+            }
 
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //    o  ?
-                //    ?  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && !horizontal_surroundings[4].IsEmpty()
-                    && !horizontal_surroundings[4].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[4].IsClimbable() || horizontal_surroundings[4].GetHeight() + 1e-3f > current_node.pos.first.y - 1;
-                    const float new_cost = cost[current_node.pos] + 3.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, -2 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 1.0f, horizontal_surroundings[4].GetHeight()) : std::max(horizontal_surroundings[4].GetHeight(), horizontal_surroundings[5].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            // -  -  -
+            // x
+            // x
+            //--- ?  o
+            //    ?  ?
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && !horizontal_surroundings[9].IsEmpty()
+                && !horizontal_surroundings[9].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[9].IsClimbable() || horizontal_surroundings[9].GetHeight() + 1e-3f > from.first.y;
+                const float move_cost = 3.5f - 1.0f * above_block;
+                const std::pair<Position, float> new_pos = {
+                    next_next_location + Position(0,  -1 + 1 * above_block, 0),
+                    above_block ? std::max(static_cast<float>(from.first.y), horizontal_surroundings[9].GetHeight()) : std::max(horizontal_surroundings[9].GetHeight(), horizontal_surroundings[10].GetHeight())
+                };
+                moves.Add(new_pos, move_cost);
+            }
 
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //       ?
-                //    o  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && horizontal_surroundings[4].IsEmpty()
-                    && !horizontal_surroundings[5].IsEmpty()
-                    && !horizontal_surroundings[5].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[5].IsClimbable() || horizontal_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                    const float new_cost = cost[current_node.pos] + 4.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, -3 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 2.0f, horizontal_surroundings[5].GetHeight()) : horizontal_surroundings[5].GetHeight() // no carpet on wall check here as we don't have the block below
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            // -  -  -
+            // x
+            // x
+            //--- ?
+            //    ?  o
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && horizontal_surroundings[9].IsEmpty()
+                && !horizontal_surroundings[10].IsEmpty()
+                && !horizontal_surroundings[10].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[10].IsClimbable() || horizontal_surroundings[10].GetHeight() + 1e-3f > from.first.y - 1;
+                const float move_cost = 4.5f - 1.0f * above_block;
+                const std::pair<Position, float> new_pos = {
+                    next_next_location + Position(0, -2 + 1 * above_block, 0),
+                    above_block ? std::max(from.first.y - 1.0f, horizontal_surroundings[10].GetHeight()) : std::max(horizontal_surroundings[10].GetHeight(), horizontal_surroundings[11].GetHeight())
+                };
+                moves.Add(new_pos, move_cost);
+            }
 
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //       ?
-                //       ?
-                // Special case here, we can drop down
-                // if there is a climbable at the bottom
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && horizontal_surroundings[4].IsEmpty()
-                    && horizontal_surroundings[5].IsEmpty()
-                    )
-                {
-                    for (int y = -4; next_location.y + y >= world->GetMinY(); --y)
-                    {
-                        pos = next_location + Position(0, y, 0);
-                        block = world->GetBlock(pos);
+            // -  -  -
+            // x
+            // x
+            //--- ?
+            //    ?
+            //    ?  o
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && horizontal_surroundings[9].IsEmpty()
+                && horizontal_surroundings[10].IsEmpty()
+                && !horizontal_surroundings[11].IsEmpty()
+                && !horizontal_surroundings[11].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[11].IsClimbable() || horizontal_surroundings[11].GetHeight() + 1e-3f > from.first.y - 2;
+                const float move_cost = 6.5f - 1.0f * above_block;
+                const std::pair<Position, float> new_pos = {
+                    next_next_location + Position(0, -3 + 1 * above_block, 0),
+                    above_block ? std::max(from.first.y - 2.0f, horizontal_surroundings[11].GetHeight()) : horizontal_surroundings[1].GetHeight()
+                };
+                moves.Add(new_pos, move_cost);
+            }
+        } // neighbour loop
+    }
 
-                        if (block != nullptr && block->IsSolid() && !block->IsClimbable())
-                        {
-                            break;
-                        }
+    std::vector<std::pair<Position, float>> FindPath(const BehaviourClient& client, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump)
+    {
+        const bool takes_damage = !client.GetLocalPlayer()->GetInvulnerable();
+#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
+        const float step_height = static_cast<float>(client.GetLocalPlayer()->GetAttributeStepHeightValue());
+#else
+        const float step_height = 0.6f;
+#endif
+        return FindPath(*client.GetWorld(), start, end, dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump, takes_damage, step_height);
+    }
 
-                        const PathfindingBlockstate landing_block(block, pos, takes_damage);
-                        if (landing_block.IsClimbable())
-                        {
-                            const float new_cost = cost[current_node.pos] + std::abs(y) + 1.5f;
-                            const std::pair<Position, float> new_pos = {
-                                next_location + Position(0, y + 1, 0),
-                                next_location.y + y + 1.0f
-                            };
-                            auto it = cost.find(new_pos);
-                            // If we don't already know this node with a better path, add it
-                            if (it == cost.end() ||
-                                new_cost < it->second)
-                            {
-                                cost[new_pos] = new_cost;
-                                nodes_to_explore.emplace(PathNode(
-                                    new_pos,
-                                    new_cost + PathNode::Heuristic(new_pos.first, end))
-                                );
-                                came_from[new_pos] = current_node.pos;
-                            }
+    std::vector<std::pair<Position, float>> FindPath(const World& world, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump, const bool takes_damage, const float step_height)
+    {
+        constexpr int budget_visit = 15000;
 
-                            break;
-                        }
-                    }
-                }
+        const int min_y = world.GetMinY();
+        // Nodes and open set are reused from one search to the next
+        PathfindingArena& arena = PathfindingArena::GetThreadLocal();
+        arena.Reset();
+
+        // All blocks are read through the same cursor, so chunks are looked up only once
+        BlockCursor cursor = world.GetBlockCursor();
+        const uint32_t start_index = arena.GetOrCreate({ start, GetPathfindingHeight(cursor, start, takes_damage) });
+        arena.Relax(start_index, 0.0f, 0.0f, start_index);
+
+        PathfindingArena::Node current_node;
+        PathfindingMoves moves;
+        uint32_t current_index = start_index;
+        // If we don't already know this node with a better path, add it
+        const auto add_node = [&](const std::pair<Position, float>& new_pos, const float new_cost)
+        {
+            arena.Relax(
+                arena.GetOrCreate(new_pos),
+                new_cost,
+                static_cast<float>(std::abs(new_pos.first.x - end.x) + std::abs(new_pos.first.y - end.y) + std::abs(new_pos.first.z - end.z)),
+                current_index
+            );
+        };
 
-                // If we can't make jumps, don't bother explore the rest
-                // of the cases
-                if (!allow_jump
-                    || !can_jump
-                    || vertical_surroundings[0].IsSolid()       // Block above
-                    || vertical_surroundings[0].IsHazardous()   // Block above
-                    || !vertical_surroundings[1].IsEmpty()      // Block above
-                    || vertical_surroundings[3].IsFluid()       // "Walking" on fluid
-                    || vertical_surroundings[3].IsEmpty()       // Feet on nothing (inside climbable)
-                    || horizontal_surroundings[0].IsSolid()     // Block above next column
-                    || horizontal_surroundings[0].IsHazardous() // Hazard above next column
-                    || !horizontal_surroundings[1].IsEmpty()    // Non empty block in next column, can't jump through it
-                    || !horizontal_surroundings[2].IsEmpty()    // Non empty block in next column, can't jump through it
-                    || horizontal_surroundings[6].IsSolid()     // Block above nextnext column
-                    || horizontal_surroundings[6].IsHazardous() // Hazard above nextnext column
-                    )
-                {
-                    continue;
-                }
+        int count_visit = 0;
+        // We found one location matching all the criterion, but
+        // continue the search to see if we can find a better one
+        bool suitable_location_found = false;
+        // We found a path to the desired goal
+        bool end_reached = false;
 
-                /************ BIG JUMP **************/
-                // -  -  -
-                // x     o
-                // x     ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (!horizontal_surroundings[7].IsEmpty()
-                    && !horizontal_surroundings[7].IsHazardous()
-                    && horizontal_surroundings[7].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    // 5 > 4.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
-                    // but if horizontal_surroundings[3] is hazardous we can jump over it
-                    const float new_cost = cost[current_node.pos] + 5.0f;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, 1, 0),
-                        std::max(horizontal_surroundings[7].GetHeight(), horizontal_surroundings[8].GetHeight()), // for the carpet on wall trick
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+        const bool end_is_inside_solid = cursor.GetNavigationColumn(end, 1).Has(NavigationProperty::Solid, 0);
 
-                // -  -  -
-                // x
-                // x     o
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && !horizontal_surroundings[8].IsEmpty()
-                    && !horizontal_surroundings[8].IsHazardous()
-                    && horizontal_surroundings[8].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[8].IsClimbable() || horizontal_surroundings[8].GetHeight() + 1e-3f > current_node.pos.first.y + 1;
-                    // 4 > 3.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
-                    // but if horizontal_surroundings[3] is hazardous we can jump over it
-                    const float new_cost = cost[current_node.pos] + 3.0f + 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, above_block * 1, 0),
-                        above_block ? std::max(current_node.pos.first.y + 1.0f, horizontal_surroundings[8].GetHeight()) : std::max(horizontal_surroundings[8].GetHeight(), horizontal_surroundings[9].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+        while (!arena.IsOpenEmpty())
+        {
+            count_visit++;
+            current_index = arena.PopOpen();
+            // Copy as the arena can grow while adding neighbours
+            current_node = arena.GetNode(current_index);
 
-                // -  -  -
-                // x
-                // x
-                //--- ?  o
-                //    ?  ?
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && !horizontal_surroundings[9].IsEmpty()
-                    && !horizontal_surroundings[9].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[9].IsClimbable() || horizontal_surroundings[9].GetHeight() + 1e-3f > current_node.pos.first.y;
-                    const float new_cost = cost[current_node.pos] + 3.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0,  -1 + 1 * above_block, 0),
-                        above_block ? std::max(static_cast<float>(current_node.pos.first.y), horizontal_surroundings[9].GetHeight()) : std::max(horizontal_surroundings[9].GetHeight(), horizontal_surroundings[10].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            end_reached |= current_node.pos.first == end;
+            suitable_location_found |=
+                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) <= dist_tolerance &&
+                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist &&
+                std::abs(end.x - current_node.pos.first.x) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist_xz;
 
-                // -  -  -
-                // x
-                // x
-                //--- ?
-                //    ?  o
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && horizontal_surroundings[9].IsEmpty()
-                    && !horizontal_surroundings[10].IsEmpty()
-                    && !horizontal_surroundings[10].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[10].IsClimbable() || horizontal_surroundings[10].GetHeight() + 1e-3f > current_node.pos.first.y - 1;
-                    const float new_cost = cost[current_node.pos] + 4.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, -2 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 1.0f, horizontal_surroundings[10].GetHeight()) : std::max(horizontal_surroundings[10].GetHeight(), horizontal_surroundings[11].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
+            if (// If we exceeded the search budget
+                count_visit > budget_visit ||
+                // Or if we found a suitable location in the process and already reached the goal/can't reach it anyway
+                (suitable_location_found && (end_reached || end_is_inside_solid)))
+            {
+                break;
+            }
 
-                // -  -  -
-                // x
-                // x
-                //--- ?
-                //    ?
-                //    ?  o
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && horizontal_surroundings[9].IsEmpty()
-                    && horizontal_surroundings[10].IsEmpty()
-                    && !horizontal_surroundings[11].IsEmpty()
-                    && !horizontal_surroundings[11].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[11].IsClimbable() || horizontal_surroundings[11].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                    const float new_cost = cost[current_node.pos] + 6.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, -3 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 2.0f, horizontal_surroundings[11].GetHeight()) : horizontal_surroundings[1].GetHeight()
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-            } // neighbour loop
+            GetPathfindingMoves(cursor, current_node.pos, min_y, allow_jump, takes_damage, step_height, moves);
+            for (size_t i = 0; i < moves.size; ++i)
+            {
+                add_node(moves.moves[i].first, current_node.cost + moves.moves[i].second);
+            }
         }
 
-        auto it_end_path = came_from.begin();
+        uint32_t end_path_index = start_index;
 
         // We search for the node respecting
         // the criteria AND the closest to
@@ -934,12 +723,12 @@ namespace Botcraft
         // take the one the closest to the end
         int best_dist = std::numeric_limits<int>::max();
         int best_dist_start = std::numeric_limits<int>::max();
-        for (auto it = came_from.begin(); it != came_from.end(); ++it)
+        for (uint32_t i = 0; i < arena.GetNumNodes(); ++i)
         {
-            const Position diff = it->first.first - end;
+            const Position diff = arena.GetNode(i).pos.first - end;
             const int d_xz = std::abs(diff.x) + std::abs(diff.z);
             const int d = d_xz + std::abs(diff.y);
-            const Position diff_start = it->first.first - start;
+            const Position diff_start = arena.GetNode(i).pos.first - start;
             const int d_start = std::abs(diff_start.x) + std::abs(diff_start.y) + std::abs(diff_start.z);
             if (d <= dist_tolerance && d >= min_end_dist && d_xz >= min_end_dist_xz &&
                 (d_start < best_dist_start || (d_start == best_dist_start && d < best_dist))
@@ -947,7 +736,7 @@ namespace Botcraft
             {
                 best_dist = d;
                 best_dist_start = d_start;
-                it_end_path = it;
+                end_path_index = i;
             }
         }
 
@@ -956,31 +745,38 @@ namespace Botcraft
         // Take closest node to the goal in this case
         if (best_dist == std::numeric_limits<int>::max())
         {
-            for (auto it = came_from.begin(); it != came_from.end(); ++it)
+            for (uint32_t i = 0; i < arena.GetNumNodes(); ++i)
             {
-                const Position diff = it->first.first - end;
+                const Position diff = arena.GetNode(i).pos.first - end;
                 const int d_xz = std::abs(diff.x) + std::abs(diff.z);
                 const int d = d_xz + std::abs(diff.y);
-                const Position diff_start = it->first.first - start;
+                const Position diff_start = arena.GetNode(i).pos.first - start;
                 const int d_start = std::abs(diff_start.x) + std::abs(diff_start.y) + std::abs(diff_start.z);
                 if (d < best_dist || (d == best_dist && d_start < best_dist_start))
                 {
                     best_dist = d;
                     best_dist_start = d_start;
-                    it_end_path = it;
+                    end_path_index = i;
                 }
             }
         }
 
-        std::deque<std::pair<Position, float>> output_deque;
-        output_deque.push_front(it_end_path->first);
-        while (it_end_path->second.first != start)
+        // Count the nodes first so the output is allocated only once
+        size_t path_length = 1;
+        for (uint32_t i = end_path_index; arena.GetNode(arena.GetNode(i).parent).pos.first != start; i = arena.GetNode(i).parent)
         {
-            it_end_path = came_from.find(it_end_path->second);
-            output_deque.push_front(it_end_path->first);
+            path_length += 1;
         }
 
-        return std::vector<std::pair<Position, float>>(output_deque.begin(), output_deque.end());
+        std::vector<std::pair<Position, float>> output(path_length);
+        uint32_t index = end_path_index;
+        for (size_t i = path_length; i > 0; --i)
+        {
+            output[i - 1] = arena.GetNode(index).pos;
+            index = arena.GetNode(index).parent;
+        }
+
+        return output;
     }
 
 #if PROTOCOL_VERSION < 767 /* < 1.21 */
@@ -1289,6 +1085,67 @@ namespace Botcraft
             }, client, 20.0 * ms_per_tick);
     }
 
+    namespace
+    {
+        /// @brief Goals further than that are reached following a coarse route, FindPath only going to the next waypoint
+        constexpr int route_min_dist = 64;
+        /// @brief Max distance of the waypoint used as FindPath goal
+        constexpr int route_leg_dist = 32;
+
+        /// @brief Find paths to the successive waypoints of a route, each leg is published as soon as it's found
+        void PlanRoute(PathPlanningJob& job, const World& world, const Position& start, const Position& goal, const bool allow_jump, const bool takes_damage, const float step_height)
+        {
+            const std::vector<Position> route = world.FindRoute(start, goal);
+            Position leg_start = start;
+            size_t waypoint = 0;
+            while (!job.IsCancelled() && waypoint + 1 < route.size())
+            {
+                // Close enough, the end will be searched without the route
+                if (waypoint > 0 && std::abs(goal.x - leg_start.x) + std::abs(goal.z - leg_start.z) <= route_min_dist)
+                {
+                    break;
+                }
+                // Furthest waypoint close enough to be reached with FindPath
+                size_t next_waypoint = waypoint + 1;
+                while (next_waypoint + 1 < route.size() &&
+                    std::abs(route[next_waypoint + 1].x - leg_start.x) + std::abs(route[next_waypoint + 1].z - leg_start.z) <= route_leg_dist)
+                {
+                    next_waypoint += 1;
+                }
+                std::vector<std::pair<Position, float>> leg = FindPath(world, leg_start, route[next_waypoint], 0, 0, 0, allow_jump, takes_damage, step_height);
+                if (leg.size() == 0 || leg.back().first == leg_start)
+                {
+                    break;
+                }
+                const bool waypoint_reached = leg.back().first == route[next_waypoint];
+                leg_start = leg.back().first;
+                job.PushSegment(std::move(leg));
+                // Blocked, a new route will be searched from there
+                if (!waypoint_reached)
+                {
+                    break;
+                }
+                waypoint = next_waypoint;
+            }
+        }
+
+        /// @brief Yield until the next segment of a path planning job is available
+        /// @return False if the job is over without any other segment, in which case segment is empty
+        bool WaitPathSegment(BehaviourClient& client, PathPlanningJob& job, std::vector<std::pair<Position, float>>& segment)
+        {
+            while (!job.PopSegment(segment))
+            {
+                if (job.IsDone())
+                {
+                    segment.clear();
+                    return false;
+                }
+                client.Yield();
+            }
+            return true;
+        }
+    }
+
     Status GoToImpl(BehaviourClient& client, const Vector3<double>& goal, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump, const bool sprint, float speed_factor)
     {
         if (min_end_dist > dist_tolerance)
@@ -1344,6 +1201,38 @@ namespace Botcraft
         }
 
         std::shared_ptr<World> world = client.GetWorld();
+        const bool takes_damage = !local_player->GetInvulnerable();
+#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
+        const float step_height = static_cast<float>(local_player->GetAttributeStepHeightValue());
+#else
+        const float step_height = 0.6f;
+#endif
+        // Search is kept between iterations, so when blocks change it's only repaired.
+        // Only used by one planning job at a time, as we always wait for them to be over
+        std::shared_ptr<IncrementalPathfinder> planner = std::make_shared<IncrementalPathfinder>(allow_jump, takes_damage, step_height);
+        // Searches run on the path planning threads, so we can keep yielding during long ones
+        std::shared_ptr<PathPlanningJob> job;
+        // Stop the current search if we leave before it's over
+        struct JobCanceller
+        {
+            std::shared_ptr<PathPlanningJob>& job;
+            ~JobCanceller()
+            {
+                if (job != nullptr)
+                {
+                    job->Cancel();
+                }
+            }
+        } job_canceller{ job };
+        const auto submit_find_path = [&](const Position& start, const Position& end, const int tolerance, const int end_dist, const int end_dist_xz)
+        {
+            job = PathPlanningService::GetInstance().Submit([world, start, end, tolerance, end_dist, end_dist_xz, allow_jump, takes_damage, step_height](PathPlanningJob& j)
+                {
+                    j.PushSegment(FindPath(*world, start, end, tolerance, end_dist, end_dist_xz, allow_jump, takes_damage, step_height));
+                }
+            );
+        };
+
         Position current_position;
         do
         {
@@ -1369,6 +1258,9 @@ namespace Botcraft
 
             std::vector<std::pair<Position, float>> path;
             const bool is_goal_loaded = world->IsLoaded(goal_block);
+            bool following_route = false;
+            // Path from planner, that can tell when it's outdated
+            bool incremental_path = false;
 
             const int current_diff_xz = std::abs(goal_block.x - current_position.x) + std::abs(goal_block.z - current_position.z);
             const int current_diff = current_diff_xz + std::abs(goal_block.y - current_position.y);
@@ -1378,12 +1270,13 @@ namespace Botcraft
                 LOG_INFO('[' << client.GetNetworkManager()->GetMyName() << "] Current goal position " << goal_block << " is either air or not loaded, trying to get closer to load the chunk");
                 Vector3<double> goal_direction(goal_block.x - current_position.x, goal_block.y - current_position.y, goal_block.z - current_position.z);
                 goal_direction.Normalize();
-                path = FindPath(client, current_position,
+                submit_find_path(current_position,
                     current_position + Position(
                         static_cast<int>(goal_direction.x * 32.0),
                         static_cast<int>(goal_direction.y * 32.0),
                         static_cast<int>(goal_direction.z * 32.0)
-                    ), dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump);
+                    ), dist_tolerance, min_end_dist, min_end_dist_xz);
+                WaitPathSegment(client, *job, path);
             }
             else
             {
@@ -1392,7 +1285,36 @@ namespace Botcraft
                     AdjustPosSpeed(client, goal);
                     return Status::Success;
                 }
-                path = FindPath(client, current_position, goal_block, dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump);
+                if (current_diff_xz > route_min_dist)
+                {
+                    job = PathPlanningService::GetInstance().Submit([world, current_position, goal_block, allow_jump, takes_damage, step_height](PathPlanningJob& j)
+                        {
+                            PlanRoute(j, *world, current_position, goal_block, allow_jump, takes_damage, step_height);
+                        }
+                    );
+                    // Start walking as soon as the first leg is found, the next ones are searched meanwhile
+                    following_route = WaitPathSegment(client, *job, path);
+                }
+                // Close goal, or the route can't be followed
+                if (!following_route)
+                {
+                    // Exact goal, use the planner, unless it can't reach it
+                    if (dist_tolerance == 0)
+                    {
+                        job = PathPlanningService::GetInstance().Submit([world, planner, current_position, goal_block](PathPlanningJob& j)
+                            {
+                                j.PushSegment(planner->FindPath(*world, current_position, goal_block));
+                            }
+                        );
+                        WaitPathSegment(client, *job, path);
+                    }
+                    incremental_path = path.size() > 0;
+                    if (!incremental_path)
+                    {
+                        submit_find_path(current_position, goal_block, dist_tolerance, min_end_dist, min_end_dist_xz);
+                        WaitPathSegment(client, *job, path);
+                    }
+                }
             }
 
             if (path.size() == 0 || path.back().first == current_position)
@@ -1421,44 +1343,65 @@ namespace Botcraft
                 }
             }
             // To avoid going back and forth two positions that are at the same distance of an unreachable goal
-            else if (current_diff >= min_end_dist && current_diff_xz >= min_end_dist_xz && std::abs(goal_block.x - path.back().first.x) + std::abs(goal_block.y - path.back().first.y) + std::abs(goal_block.z - path.back().first.z) >= current_diff)
+            // (a route can go away from the goal to get around obstacles)
+            else if (!following_route && current_diff >= min_end_dist && current_diff_xz >= min_end_dist_xz && std::abs(goal_block.x - path.back().first.x) + std::abs(goal_block.y - path.back().first.y) + std::abs(goal_block.z - path.back().first.z) >= current_diff)
             {
                 LOG_WARNING("Pathfinding cannot find a better position than " << current_position << " (asked " << goal_block << "). Staying there.");
                 return Status::Failure;
             }
 
-            for (int i = 0; i < path.size(); ++i)
+            bool replan = false;
+            while (true)
             {
-                // Basic verification to check we won't try to walk on air.
-                // If so, it means some blocks have changed, better to
-                // recompute a new path
-                const Blockstate* next_target = world->GetBlock(path[i].first);
-                const Blockstate* below = world->GetBlock(path[i].first + Position(0, -1, 0));
-                if ((next_target == nullptr || (!next_target->IsClimbable() && !next_target->IsFluid())) &&
-                    (below == nullptr || below->IsAir()))
+                for (int i = 0; i < path.size(); ++i)
                 {
-                    break;
-                }
+                    // Blocks changed in the explored area, the path may not be valid (or the best one) anymore
+                    if (incremental_path && planner->Update(*world))
+                    {
+                        replan = true;
+                        break;
+                    }
 
-                // If something went wrong, break and
-                // replan the whole path to the goal
-                if (!Move(client, local_player, Vector3<double>(path[i].first.x + 0.5, path[i].second, path[i].first.z + 0.5), speed_factor, sprint))
-                {
-                    break;
+                    // Basic verification to check we won't try to walk on air.
+                    // If so, it means some blocks have changed, better to
+                    // recompute a new path
+                    const Blockstate* next_target = world->GetBlock(path[i].first);
+                    const Blockstate* below = world->GetBlock(path[i].first + Position(0, -1, 0));
+                    if ((next_target == nullptr || (!next_target->IsClimbable() && !next_target->IsFluid())) &&
+                        (below == nullptr || below->IsAir()))
+                    {
+                        replan = true;
+                        break;
+                    }
+
+                    // If something went wrong, break and
+                    // replan the whole path to the goal
+                    if (!Move(client, local_player, Vector3<double>(path[i].first.x + 0.5, path[i].second, path[i].first.z + 0.5), speed_factor, sprint))
+                    {
+                        replan = true;
+                        break;
+                    }
+                    // Otherwise just update current position for
+                    // next move
+                    else
+                    {
+                        const Vector3<double> local_player_pos = local_player->GetPosition();
+                        // Get the position, we add 0.25 to Y in case we are at X.97 instead of X+1
+                        current_position = Position(
+                            static_cast<int>(std::floor(local_player_pos.x)),
+                            static_cast<int>(std::floor(local_player_pos.y + 0.25)),
+                            static_cast<int>(std::floor(local_player_pos.z))
+                        );
+                    }
                 }
-                // Otherwise just update current position for
-                // next move
-                else
+                // Continue with the next leg of the route, it has been searched while walking this one
+                if (replan || !following_route || !WaitPathSegment(client, *job, path))
                 {
-                    const Vector3<double> local_player_pos = local_player->GetPosition();
-                    // Get the position, we add 0.25 to Y in case we are at X.97 instead of X+1
-                    current_position = Position(
-                        static_cast<int>(std::floor(local_player_pos.x)),
-                        static_cast<int>(std::floor(local_player_pos.y + 0.25)),
-                        static_cast<int>(std::floor(local_player_pos.z))
-                    );
+                    break;
                 }
             }
+            // Next legs start from where we were supposed to be, they are searched again anyway
+            job->Cancel();
         } while (current_position != goal_block);
 
         AdjustPosSpeed(client, goal);
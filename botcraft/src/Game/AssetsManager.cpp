@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <optional>
+#include <random>
 #include <set>
+#include <tuple>
 
 #include "botcraft/Game/AssetsManager.hpp"
 #include "botcraft/Game/World/Biome.hpp"
@@ -10,14 +15,88 @@
 
 #if USE_GUI
 #include "botcraft/Renderer/Atlas.hpp"
+#else
+#include "botcraft/Utilities/MappedFile.hpp"
 #endif
 
+#include "protocolCraft/BinaryReadWrite.hpp"
 #include "protocolCraft/Utilities/Json.hpp"
 
 using namespace ProtocolCraft;
 
 namespace Botcraft
 {
+#if !USE_GUI
+    namespace
+    {
+        /// @brief "BCAC" in ASCII
+        constexpr unsigned int cache_magic = 0x42434143;
+        /// @brief Must be incremented each time the cache layout changes
+        constexpr unsigned int cache_format_version = 1;
+
+        std::string GetCachePath()
+        {
+            return ASSETS_PATH + std::string("/assets_cache.bin");
+        }
+
+        /// @brief Compute a hash of the path, size and modification time of all the files read when loading the assets
+        /// @return The hash, or nothing if something went wrong
+        std::optional<unsigned long long> ComputeAssetsFingerprint()
+        {
+            std::vector<std::tuple<std::string, unsigned long long, long long> > files;
+            try
+            {
+                const std::filesystem::path root = ASSETS_PATH;
+                for (const char* folder : { "custom", "minecraft/blockstates", "minecraft/models" })
+                {
+                    const std::filesystem::path folder_path = root / folder;
+                    if (!std::filesystem::is_directory(folder_path))
+                    {
+                        continue;
+                    }
+                    for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(folder_path))
+                    {
+                        if (!entry.is_regular_file())
+                        {
+                            continue;
+                        }
+                        files.emplace_back(
+                            std::filesystem::relative(entry.path(), root).generic_string(),
+                            static_cast<unsigned long long>(entry.file_size()),
+                            static_cast<long long>(entry.last_write_time().time_since_epoch().count())
+                        );
+                    }
+                }
+            }
+            catch (const std::filesystem::filesystem_error& e)
+            {
+                LOG_WARNING("Error listing assets files, assets cache disabled\n" << e.what());
+                return std::nullopt;
+            }
+            // Iteration order is not guaranteed
+            std::sort(files.begin(), files.end());
+
+            // FNV-1a
+            unsigned long long hash = 14695981039346656037ULL;
+            const auto hash_bytes = [&hash](const void* data, const size_t size)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+                }
+            };
+            for (const auto& [path, size, time] : files)
+            {
+                hash_bytes(path.data(), path.size() + 1);
+                hash_bytes(&size, sizeof(size));
+                hash_bytes(&time, sizeof(time));
+            }
+            return hash;
+        }
+    }
+#endif
+
     AssetsManager& AssetsManager::getInstance()
     {
         static AssetsManager instance;
@@ -33,14 +112,30 @@ namespace Botcraft
             LOG_FATAL("Minecraft assets folder expected at " << std::filesystem::absolute(expected_mc_path) << " but not found");
             throw std::runtime_error("Minecraft assets not found");
         }
-        LOG_INFO("Loading blocks from file...");
-        LoadBlocksFile();
-        LOG_INFO("Done!");
-        LOG_INFO("Loading biomes from file...");
-        LoadBiomesFile();
-        LOG_INFO("Done!");
-        LOG_INFO("Loading items from file...");
-        LoadItemsFile();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#if USE_GUI
+        // Cache doesn't store faces and textures
+        const bool loaded_from_cache = false;
+#else
+        const bool loaded_from_cache = LoadCache();
+#endif
+        if (!loaded_from_cache)
+        {
+            LOG_INFO("Loading blocks from file...");
+            LoadBlocksFile();
+            LOG_INFO("Done!");
+            LOG_INFO("Loading biomes from file...");
+            LoadBiomesFile();
+            LOG_INFO("Done!");
+            LOG_INFO("Loading items from file...");
+            LoadItemsFile();
+            LOG_INFO("Done!");
+#if !USE_GUI
+            WriteCache();
+#endif
+        }
+        LOG_INFO("Building name indices...");
+        BuildNameIndices();
         LOG_INFO("Done!");
 #if USE_GUI
         LOG_INFO("Loading textures...");
@@ -54,6 +149,7 @@ namespace Botcraft
         LOG_INFO("Clearing cache from memory...");
         ClearCaches();
         LOG_INFO("Done!");
+        LOG_INFO("Assets loaded in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms" << (loaded_from_cache ? " (from cache)" : ""));
     }
 
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
@@ -108,52 +204,38 @@ namespace Botcraft
 
     const Blockstate* AssetsManager::GetBlockstate(const std::string& name) const
     {
-#if PROTOCOL_VERSION < 347 /* < 1.13 */
-        for (const auto& [id, m] : blockstates)
+        auto it = blockstate_by_name.find(name);
+        if (it != blockstate_by_name.end())
         {
-            const Blockstate* block = m.at(0).get();
-            if (block->GetName() == name)
-            {
-                return block;
-            }
+            return it->second;
         }
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
         return blockstates.at(-1).at(0).get();
 #else
-        for (const auto& block : flattened_blockstates)
-        {
-            if (block->GetName() == name)
-            {
-                return block;
-            }
-        }
         return blockstates.at(-1).get();
 #endif
     }
 
-    std::vector<const Blockstate*> AssetsManager::GetBlockstates(const std::string& name) const
+    const std::vector<const Blockstate*>& AssetsManager::GetBlockstates(const std::string& name) const
     {
-        std::vector<const Blockstate*> output;
-#if PROTOCOL_VERSION < 347 /* < 1.13 */
-        for (const auto& [id, m] : blockstates)
+        auto it = blockstates_by_name.find(name);
+        if (it != blockstates_by_name.end())
         {
-            for (const auto& [id2, block] : m)
-            {
-                if (block->GetName() == name)
-                {
-                    output.push_back(block.get());
-                }
-            }
+            return it->second.blockstates;
         }
-#else
-        for (const auto& block : flattened_blockstates)
+        static const std::vector<const Blockstate*> empty;
+        return empty;
+    }
+
+    const std::vector<BlockstateId>& AssetsManager::GetBlockstateIds(const std::string& name) const
+    {
+        auto it = blockstates_by_name.find(name);
+        if (it != blockstates_by_name.end())
         {
-            if (block->GetName() == name)
-            {
-                output.push_back(block);
-            }
+            return it->second.ids;
         }
-#endif
-        return output;
+        static const std::vector<BlockstateId> empty;
+        return empty;
     }
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
@@ -209,24 +291,20 @@ namespace Botcraft
 
     const Item* AssetsManager::GetItem(const std::string& item_name) const
     {
-        for (const auto& p : items)
+        auto it = items_by_name.find(item_name);
+        if (it != items_by_name.end())
         {
-            if (p.second->GetName() == item_name)
-            {
-                return p.second.get();
-            }
+            return it->second;
         }
         return nullptr;
     }
 
     ItemId AssetsManager::GetItemID(const std::string& item_name) const
     {
-        for (const auto& p : items)
+        auto it = items_by_name.find(item_name);
+        if (it != items_by_name.end())
         {
-            if (p.second->GetName() == item_name)
-            {
-                return p.first;
-            }
+            return it->second->GetId();
         }
 
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
@@ -1066,6 +1144,63 @@ namespace Botcraft
         }
     }
 
+    void AssetsManager::BuildNameIndices()
+    {
+        // Blockstates are added in id order, so GetBlockstate(name) still returns the lowest id
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        std::vector<std::pair<BlockstateId, const Blockstate*> > sorted_blockstates;
+        for (const auto& [id, m] : blockstates)
+        {
+            if (id < 0)
+            {
+                continue;
+            }
+            for (const auto& [metadata, block] : m)
+            {
+                sorted_blockstates.push_back({ { id, metadata }, block.get() });
+            }
+        }
+        std::sort(sorted_blockstates.begin(), sorted_blockstates.end(),
+            [](const std::pair<BlockstateId, const Blockstate*>& a, const std::pair<BlockstateId, const Blockstate*>& b) { return a.first < b.first; });
+        for (const auto& [id, block] : sorted_blockstates)
+        {
+            BlockstatesByName& entry = blockstates_by_name[block->GetName()];
+            entry.blockstates.push_back(block);
+            entry.ids.push_back(id);
+            if (id.second == 0)
+            {
+                blockstate_by_name.insert({ block->GetName(), block });
+            }
+        }
+#else
+        for (size_t i = 0; i < flattened_blockstates.size(); ++i)
+        {
+            const Blockstate* block = flattened_blockstates[i];
+            if (block == nullptr)
+            {
+                continue;
+            }
+            BlockstatesByName& entry = blockstates_by_name[block->GetName()];
+            entry.blockstates.push_back(block);
+            entry.ids.push_back(static_cast<BlockstateId>(i));
+            blockstate_by_name.insert({ block->GetName(), block });
+        }
+#endif
+
+        // Sorted by id too, to return the same item as before if several share the same name
+        std::vector<const Item*> sorted_items;
+        sorted_items.reserve(items.size());
+        for (const auto& [id, item] : items)
+        {
+            sorted_items.push_back(item.get());
+        }
+        std::sort(sorted_items.begin(), sorted_items.end(), [](const Item* a, const Item* b) { return a->GetId() < b->GetId(); });
+        for (const Item* item : sorted_items)
+        {
+            items_by_name.insert({ item->GetName(), item });
+        }
+    }
+
 #if USE_GUI
     void AssetsManager::LoadTextures()
     {
@@ -1120,6 +1255,198 @@ namespace Botcraft
     }
 #endif
 
+#if !USE_GUI
+    bool AssetsManager::LoadCache()
+    {
+        const std::optional<unsigned long long> fingerprint = ComputeAssetsFingerprint();
+        if (!fingerprint.has_value())
+        {
+            return false;
+        }
+
+        const Utilities::MappedFile file(GetCachePath());
+        if (!file.IsValid())
+        {
+            return false;
+        }
+
+        ReadIterator iter = file.GetData();
+        size_t length = file.GetSize();
+        try
+        {
+            if (ReadData<unsigned int>(iter, length) != cache_magic ||
+                ReadData<unsigned int>(iter, length) != cache_format_version ||
+                ReadData<int>(iter, length) != PROTOCOL_VERSION)
+            {
+                LOG_INFO("Assets cache format is outdated, ignoring it");
+                return false;
+            }
+            if (ReadData<unsigned long long>(iter, length) != fingerprint.value())
+            {
+                LOG_INFO("Assets have changed since the cache was written, ignoring it");
+                return false;
+            }
+
+            LOG_INFO("Loading assets from cache...");
+            Blockstate::ReadModelsCache(iter, length);
+
+            const int num_blockstates = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_blockstates; ++i)
+            {
+                const int id = ReadData<int>(iter, length);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+                const unsigned char metadata = ReadData<unsigned char>(iter, length);
+                blockstates[id][metadata] = std::make_unique<Blockstate>(iter, length);
+#else
+                blockstates[id] = std::make_unique<Blockstate>(iter, length);
+#endif
+            }
+
+            const int num_biomes = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_biomes; ++i)
+            {
+                const int id = ReadData<int>(iter, length);
+                const std::string name = ReadData<std::string>(iter, length);
+                const float temperature = ReadData<float>(iter, length);
+                const float rainfall = ReadData<float>(iter, length);
+                const BiomeType biome_type = static_cast<BiomeType>(ReadData<int>(iter, length));
+                biomes[id] = std::make_unique<Biome>(name, temperature, rainfall, biome_type);
+            }
+
+            const int num_items = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_items; ++i)
+            {
+                ItemProperties props;
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+                props.id.first = ReadData<int>(iter, length);
+                props.id.second = ReadData<unsigned char>(iter, length);
+#else
+                props.id = ReadData<int>(iter, length);
+#endif
+                props.name = ReadData<std::string>(iter, length);
+                props.stack_size = ReadData<unsigned char>(iter, length);
+                props.durability = ReadData<int>(iter, length);
+                items[props.id] = std::make_unique<Item>(props);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Error reading assets cache, loading from files instead\n" << e.what());
+            blockstates.clear();
+            biomes.clear();
+            items.clear();
+            return false;
+        }
+
+#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
+        FlattenBlocks();
+#endif
+        LOG_INFO("Done!");
+        return true;
+    }
+
+    void AssetsManager::WriteCache() const
+    {
+        const std::optional<unsigned long long> fingerprint = ComputeAssetsFingerprint();
+        if (!fingerprint.has_value())
+        {
+            return;
+        }
+
+        WriteContainer container;
+        WriteData<unsigned int>(cache_magic, container);
+        WriteData<unsigned int>(cache_format_version, container);
+        WriteData<int>(PROTOCOL_VERSION, container);
+        WriteData<unsigned long long>(fingerprint.value(), container);
+
+        Blockstate::WriteModelsCache(container);
+
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        size_t num_blockstates = 0;
+        for (const auto& [id, m] : blockstates)
+        {
+            num_blockstates += m.size();
+        }
+        WriteData<VarInt>(static_cast<int>(num_blockstates), container);
+        for (const auto& [id, m] : blockstates)
+        {
+            for (const auto& [metadata, block] : m)
+            {
+                WriteData<int>(id, container);
+                WriteData<unsigned char>(metadata, container);
+                block->WriteCache(container);
+            }
+        }
+#else
+        WriteData<VarInt>(static_cast<int>(blockstates.size()), container);
+        for (const auto& [id, block] : blockstates)
+        {
+            WriteData<int>(id, container);
+            block->WriteCache(container);
+        }
+#endif
+
+        WriteData<VarInt>(static_cast<int>(biomes.size()), container);
+        for (const auto& [id, biome] : biomes)
+        {
+            WriteData<int>(id, container);
+            WriteData<std::string>(biome->GetName(), container);
+            WriteData<float>(biome->GetTemperature(), container);
+            WriteData<float>(biome->GetRainfall(), container);
+            WriteData<int>(static_cast<int>(biome->GetBiomeType()), container);
+        }
+
+        WriteData<VarInt>(static_cast<int>(items.size()), container);
+        for (const auto& [id, item] : items)
+        {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+            WriteData<int>(id.first, container);
+            WriteData<unsigned char>(id.second, container);
+#else
+            WriteData<int>(id, container);
+#endif
+            WriteData<std::string>(item->GetName(), container);
+            WriteData<unsigned char>(item->GetStackSize(), container);
+            WriteData<int>(item->GetMaxDurability(), container);
+        }
+
+        // Write in a temporary file first so a partially written cache is never read.
+        // Its name is unique as other processes may be writing the cache at the same time
+        const std::string cache_path = GetCachePath();
+        std::mt19937 rnd(std::random_device{}() ^ static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count()));
+        const std::string tmp_path = cache_path + "." + std::to_string(rnd()) + ".tmp";
+        try
+        {
+            bool written = false;
+            { // file scope
+                std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                {
+                    LOG_WARNING("Can't write assets cache at " << tmp_path);
+                    return;
+                }
+                file.write(reinterpret_cast<const char*>(container.data()), container.size());
+                written = file.good();
+            }
+            if (!written)
+            {
+                LOG_WARNING("Error writing assets cache at " << tmp_path);
+                std::filesystem::remove(tmp_path);
+                return;
+            }
+            std::filesystem::rename(tmp_path, cache_path);
+        }
+        catch (const std::filesystem::filesystem_error& e)
+        {
+            LOG_WARNING("Error writing assets cache at " << cache_path << '\n' << e.what());
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+        LOG_INFO("Assets cache written at " << cache_path << " (" << container.size() / 1024 << " KB)");
+    }
+#endif
+
     void AssetsManager::ClearCaches()
     {
         Blockstate::ClearCache();
@@ -0,0 +1,84 @@
+#include "botcraft/Game/Entities/EntityGrid.hpp"
+
+namespace Botcraft
+{
+    void EntityGrid::Insert(const int id, const std::shared_ptr<Entity>& entity, const Vector3<double>& position)
+    {
+        Remove(id);
+
+        const EntityType type = entity->GetType();
+        const CellKey cell = GetCellKey(ToCell(position.x), ToCell(position.z));
+        std::vector<Item>& items = buckets[type].cells[cell];
+        locations[id] = Location{ type, cell, items.size() };
+        items.push_back(Item{ id, position, entity });
+    }
+
+    void EntityGrid::Remove(const int id)
+    {
+        const auto it = locations.find(id);
+        if (it == locations.end())
+        {
+            return;
+        }
+        Extract(it->second);
+        locations.erase(it);
+    }
+
+    void EntityGrid::Move(const int id, const Vector3<double>& position)
+    {
+        const auto it = locations.find(id);
+        if (it == locations.end())
+        {
+            return;
+        }
+
+        Location& location = it->second;
+        const CellKey cell = GetCellKey(ToCell(position.x), ToCell(position.z));
+        // Most moves stay in the same cell
+        if (cell == location.cell)
+        {
+            buckets[location.type].cells[cell][location.index].position = position;
+            return;
+        }
+
+        Item item = Extract(location);
+        item.position = position;
+        std::vector<Item>& items = buckets[location.type].cells[cell];
+        location.cell = cell;
+        location.index = items.size();
+        items.push_back(std::move(item));
+    }
+
+    void EntityGrid::Clear()
+    {
+        buckets.clear();
+        locations.clear();
+    }
+
+    EntityGrid::Item EntityGrid::Extract(const Location& location)
+    {
+        Bucket& bucket = buckets[location.type];
+        const auto cell_it = bucket.cells.find(location.cell);
+        std::vector<Item>& items = cell_it->second;
+
+        Item output = std::move(items[location.index]);
+        // Swap with the last one to keep items contiguous
+        if (location.index != items.size() - 1)
+        {
+            items[location.index] = std::move(items.back());
+            locations[items[location.index].id].index = location.index;
+        }
+        items.pop_back();
+
+        if (items.empty())
+        {
+            bucket.cells.erase(cell_it);
+            if (bucket.cells.empty())
+            {
+                buckets.erase(location.type);
+            }
+        }
+
+        return output;
+    }
+} // Botcraft
@@ -1,3 +1,4 @@
+#include "botcraft/Game/Entities/EntityGrid.hpp"
 #include "botcraft/Game/Entities/EntityManager.hpp"
 #include "botcraft/Game/Entities/entities/Entity.hpp"
 #include "botcraft/Game/Entities/entities/UnknownEntity.hpp"
@@ -11,6 +12,12 @@ namespace Botcraft
     EntityManager::EntityManager(const std::shared_ptr<NetworkManager>& network_manager) : network_manager(network_manager)
     {
         local_player = nullptr;
+        entity_grid = std::make_unique<EntityGrid>();
+    }
+
+    EntityManager::~EntityManager()
+    {
+
     }
 
     std::shared_ptr<LocalPlayer> EntityManager::GetLocalPlayer()
@@ -32,8 +39,9 @@ namespace Botcraft
             return;
         }
 
+        const int id = entity->GetEntityID();
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[entity->GetEntityID()] = entity;
+        SetEntityImpl(id, entity);
     }
 
     Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock> EntityManager::GetEntities() const
@@ -41,6 +49,43 @@ namespace Botcraft
         return Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock>(entities, entity_manager_mutex);
     }
 
+    void EntityManager::QueryRadius(const Vector3<double>& center, const double radius,
+        const std::function<void(const std::shared_ptr<Entity>&)>& callback, const EntityType type) const
+    {
+        const double sqr_radius = radius * radius;
+        std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+        entity_grid->ForEachInBox(center - Vector3<double>(radius), center + Vector3<double>(radius), type, [&](const EntityGrid::Item& item)
+            {
+                if ((item.position - center).SqrNorm() <= sqr_radius)
+                {
+                    callback(item.entity);
+                }
+            }
+        );
+    }
+
+    void EntityManager::QueryAABB(const AABB& aabb, const std::function<void(const std::shared_ptr<Entity>&)>& callback, const EntityType type) const
+    {
+        std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+        entity_grid->ForEachInBox(aabb.GetMin(), aabb.GetMax(), type, [&](const EntityGrid::Item& item)
+            {
+                callback(item.entity);
+            }
+        );
+    }
+
+    std::shared_ptr<Entity> EntityManager::Nearest(const Vector3<double>& position, const double max_distance, const EntityType type,
+        const std::function<bool(const Entity&)>& filter) const
+    {
+        std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+        const EntityGrid::Item* nearest = entity_grid->Nearest(position, max_distance, type, [&](const EntityGrid::Item& item)
+            {
+                return filter == nullptr || filter(*item.entity);
+            }
+        );
+        return nearest == nullptr ? nullptr : nearest->entity;
+    }
+
 
     void EntityManager::Handle(ProtocolCraft::ClientboundLoginPacket& packet)
     {
@@ -52,7 +97,7 @@ namespace Botcraft
         local_player->SetGameMode(static_cast<GameType>(packet.GetCommonPlayerSpawnInfo().GetGameType()));
 #endif
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[packet.GetPlayerId()] = local_player;
+        SetEntityImpl(packet.GetPlayerId(), local_player);
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
@@ -64,7 +109,7 @@ namespace Botcraft
         {
             std::shared_ptr<Entity> entity = std::make_shared<UnknownEntity>();
             entity->SetEntityID(packet.GetEntityId());
-            entities[packet.GetEntityId()] = entity;
+            SetEntityImpl(packet.GetEntityId(), entity);
         }
     }
 #endif
@@ -91,6 +136,7 @@ namespace Botcraft
                 (packet.GetZA() / 128.0f + entity_position.z * 32.0f) / 32.0f
             ));
             entity->SetOnGround(packet.GetOnGround());
+            OnEntityMoved(entity);
         }
     }
 
@@ -118,6 +164,7 @@ namespace Botcraft
             entity->SetYaw(360.0f * packet.GetYRot() / 256.0f);
             entity->SetPitch(360.0f * packet.GetXRot() / 256.0f);
             entity->SetOnGround(packet.GetOnGround());
+            OnEntityMoved(entity);
         }
     }
 
@@ -159,7 +206,7 @@ namespace Botcraft
         entity->SetUUID(packet.GetUuid());
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[packet.GetEntityId()] = entity;
+        SetEntityImpl(packet.GetEntityId(), entity);
     }
 
 #if PROTOCOL_VERSION < 759 /* < 1.19 */
@@ -176,7 +223,7 @@ namespace Botcraft
         entity->SetUUID(packet.GetUuid());
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[packet.GetEntityId()] = entity;
+        SetEntityImpl(packet.GetEntityId(), entity);
     }
 #endif
 
@@ -191,7 +238,7 @@ namespace Botcraft
         entity->SetZ(packet.GetZ());
         // What do we do with the xp value?
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[packet.GetEntityId()] = entity;
+        SetEntityImpl(packet.GetEntityId(), entity);
     }
 #endif
 
@@ -206,7 +253,7 @@ namespace Botcraft
         entity->SetZ(packet.GetZ());
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[packet.GetEntityId()] = entity;
+        SetEntityImpl(packet.GetEntityId(), entity);
     }
 #endif
 
@@ -221,7 +268,8 @@ namespace Botcraft
             if (it == entities.end())
             {
                 entity = Entity::CreateEntity(EntityType::Player);
-                entities[packet.GetEntityId()] = entity;
+                entity->SetEntityID(packet.GetEntityId());
+                SetEntityImpl(packet.GetEntityId(), entity);
             }
             else
             {
@@ -238,6 +286,7 @@ namespace Botcraft
         entity->SetYaw(360.0f * packet.GetYRot() / 256.0f);
         entity->SetPitch(360.0f * packet.GetXRot() / 256.0f);
         entity->SetUUID(packet.GetPlayerId());
+        OnEntityMoved(entity);
     }
 #endif
 
@@ -281,6 +330,7 @@ namespace Botcraft
             entity->SetPitch(packet.GetRelatives() & (1 << 4) ? entity->GetPitch() + packet.GetChange().GetXRot() : packet.GetChange().GetXRot());
 #endif
             entity->SetOnGround(packet.GetOnGround());
+            OnEntityMoved(entity);
         }
     }
 
@@ -295,7 +345,7 @@ namespace Botcraft
     void EntityManager::Handle(ProtocolCraft::ClientboundRemoveEntityPacket& packet)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities.erase(packet.GetEntityId());
+        RemoveEntityImpl(packet.GetEntityId());
     }
 #else
     void EntityManager::Handle(ProtocolCraft::ClientboundRemoveEntitiesPacket& packet)
@@ -303,7 +353,7 @@ namespace Botcraft
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         for (int i = 0; i < packet.GetEntityIds().size(); ++i)
         {
-            entities.erase(packet.GetEntityIds()[i]);
+            RemoveEntityImpl(packet.GetEntityIds()[i]);
         }
     }
 #endif
@@ -531,6 +581,7 @@ namespace Botcraft
             entity->SetYaw(packet.GetValues().GetYRot());
             entity->SetPitch(packet.GetValues().GetXRot());
             entity->SetOnGround(packet.GetOnGround());
+            OnEntityMoved(entity);
         }
     }
 
@@ -558,6 +609,36 @@ namespace Botcraft
         entity->SetPosition(step.GetPosition());
         entity->SetYaw(360.0f * step.GetYRot() / 256.0f);
         entity->SetPitch(360.0f * step.GetXRot() / 256.0f);
+        OnEntityMoved(entity);
     }
 #endif
+
+    void EntityManager::SetEntityImpl(const int id, const std::shared_ptr<Entity>& entity)
+    {
+        entities[id] = entity;
+        // Local player position is updated by physics, not by the server, so it's not in the grid.
+        // Its mutex must not be locked here either, as physics locks it before entity_manager_mutex
+        if (entity == local_player)
+        {
+            entity_grid->Remove(id);
+        }
+        else
+        {
+            entity_grid->Insert(id, entity, entity->GetPosition());
+        }
+    }
+
+    void EntityManager::RemoveEntityImpl(const int id)
+    {
+        entities.erase(id);
+        entity_grid->Remove(id);
+    }
+
+    void EntityManager::OnEntityMoved(const std::shared_ptr<Entity>& entity)
+    {
+        const int id = entity->GetEntityID();
+        const Vector3<double> position = entity->GetPosition();
+        std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
+        entity_grid->Move(id, position);
+    }
 }
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AgeableMobEntity::metadata_count> AgeableMobEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AgeableMobEntity::metadata_count> AgeableMobEntity::metadata_names{ {
         "data_baby_id",
     } };
 
@@ -44,21 +44,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AgeableMobEntity::GetDataBabyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_baby_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AgeableMobEntity::SetDataBabyId(const bool data_baby_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_baby_id"] = data_baby_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        metadata[index] = data_baby_id;
     }
 
 }
@@ -8,13 +8,13 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AreaEffectCloudEntity::metadata_count> AreaEffectCloudEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AreaEffectCloudEntity::metadata_count> AreaEffectCloudEntity::metadata_names{ {
         "data_radius",
+#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
         "data_color",
+#endif
         "data_waiting",
-#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
         "data_particle",
-#endif
 #if PROTOCOL_VERSION < 341 /* < 1.13 */
         "data_particle_argument1",
         "data_particle_argument2",
@@ -102,10 +102,9 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            const std::string& metadata_name = metadata_names[index - hierarchy_metadata_count];
-            metadata[metadata_name] = value;
+            metadata[index] = value;
 #if USE_GUI
-            if (metadata_name == "data_radius")
+            if (index == hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_radius"))
             {
                 OnSizeUpdated();
             }
@@ -123,39 +122,45 @@ namespace Botcraft
     int AreaEffectCloudEntity::GetDataColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_color"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_color");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
     bool AreaEffectCloudEntity::GetDataWaiting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_waiting"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_waiting");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     std::shared_ptr<ProtocolCraft::Particle> AreaEffectCloudEntity::GetDataParticle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::shared_ptr<ProtocolCraft::Particle>>(metadata.at("data_particle"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle");
+        return std::any_cast<std::shared_ptr<ProtocolCraft::Particle>>(metadata.at(index));
     }
 #else
     std::optional<int> AreaEffectCloudEntity::GetDataParticle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_particle"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle");
+        return std::any_cast<std::optional<int>>(metadata.at(index));
     }
 
     int AreaEffectCloudEntity::GetDataParticleArgument1() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_particle_argument1"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle_argument1");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int AreaEffectCloudEntity::GetDataParticleArgument2() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_particle_argument2"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle_argument2");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -163,7 +168,8 @@ namespace Botcraft
     void AreaEffectCloudEntity::SetDataRadius(const float data_radius)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_radius"] = data_radius;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_radius");
+        metadata[index] = data_radius;
 #if USE_GUI
         OnSizeUpdated();
 #endif
@@ -173,51 +179,59 @@ namespace Botcraft
     void AreaEffectCloudEntity::SetDataColor(const int data_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_color"] = data_color;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_color");
+        metadata[index] = data_color;
     }
 #endif
 
     void AreaEffectCloudEntity::SetDataWaiting(const bool data_waiting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_waiting"] = data_waiting;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_waiting");
+        metadata[index] = data_waiting;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void AreaEffectCloudEntity::SetDataParticle(const ProtocolCraft::Particle& data_particle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle"] = data_particle;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle");
+        metadata[index] = data_particle;
     }
 #else
     void AreaEffectCloudEntity::SetDataParticle(const std::optional<int>& data_particle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle"] = data_particle;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle");
+        metadata[index] = data_particle;
     }
 
     void AreaEffectCloudEntity::SetDataParticleArgument1(const int data_particle_argument1)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle_argument1"] = data_particle_argument1;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle_argument1");
+        metadata[index] = data_particle_argument1;
     }
 
     void AreaEffectCloudEntity::SetDataParticleArgument2(const int data_particle_argument2)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle_argument2"] = data_particle_argument2;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_particle_argument2");
+        metadata[index] = data_particle_argument2;
     }
 #endif
 
 
     float AreaEffectCloudEntity::GetDataRadiusImpl() const
     {
-        return std::any_cast<float>(metadata.at("data_radius"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_radius");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     double AreaEffectCloudEntity::GetWidthImpl() const
     {
-        return std::any_cast<float>(metadata.at("data_radius")) * 2.0;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_radius");
+        return std::any_cast<float>(metadata.at(index)) * 2.0;
     }
 
     double AreaEffectCloudEntity::GetHeightImpl() const
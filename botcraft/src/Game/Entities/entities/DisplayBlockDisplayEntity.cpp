@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayBlockDisplayEntity::metadata_count> DisplayBlockDisplayEntity::metadata_names{ {
+    constexpr std::array<std::string_view, DisplayBlockDisplayEntity::metadata_count> DisplayBlockDisplayEntity::metadata_names{ {
         "data_block_state_id",
     } };
 
@@ -63,7 +63,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -71,14 +71,16 @@ namespace Botcraft
     int DisplayBlockDisplayEntity::GetDataBlockStateId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_block_state_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_block_state_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void DisplayBlockDisplayEntity::SetDataBlockStateId(const int data_block_state_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_block_state_id"] = data_block_state_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_block_state_id");
+        metadata[index] = data_block_state_id;
     }
 
     double DisplayBlockDisplayEntity::GetWidthImpl() const
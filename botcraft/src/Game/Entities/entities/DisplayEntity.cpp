@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayEntity::metadata_count> DisplayEntity::metadata_names{ {
+    constexpr std::array<std::string_view, DisplayEntity::metadata_count> DisplayEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 764 /* < 1.20.2 */
         "data_interpolation_start_delta_ticks_id",
         "data_interpolation_duration_id",
@@ -103,7 +103,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -112,104 +112,121 @@ namespace Botcraft
     int DisplayEntity::GetDataInterpolationStartDeltaTicksId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_interpolation_start_delta_ticks_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interpolation_start_delta_ticks_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int DisplayEntity::GetDataInterpolationDurationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_interpolation_duration_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interpolation_duration_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #else
     int DisplayEntity::GetDataTransformationInterpolationStartDeltaTicksId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_transformation_interpolation_start_delta_ticks_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_transformation_interpolation_start_delta_ticks_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int DisplayEntity::GetDataTransformationInterpolationDurationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_transformation_interpolation_duration_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_transformation_interpolation_duration_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int DisplayEntity::GetDataPosRotInterpolationDurationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_pos_rot_interpolation_duration_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pos_rot_interpolation_duration_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
     Vector3<float> DisplayEntity::GetDataTranslationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_translation_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_translation_id");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> DisplayEntity::GetDataScaleId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_scale_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_scale_id");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     std::array<float, 4> DisplayEntity::GetDataLeftRotationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::array<float, 4>>(metadata.at("data_left_rotation_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_rotation_id");
+        return std::any_cast<std::array<float, 4>>(metadata.at(index));
     }
 
     std::array<float, 4> DisplayEntity::GetDataRightRotationId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::array<float, 4>>(metadata.at("data_right_rotation_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_rotation_id");
+        return std::any_cast<std::array<float, 4>>(metadata.at(index));
     }
 
     char DisplayEntity::GetDataBillboardRenderConstraintsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_billboard_render_constraints_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_billboard_render_constraints_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     int DisplayEntity::GetDataBrightnessOverrideId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_brightness_override_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_brightness_override_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     float DisplayEntity::GetDataViewRangeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_view_range_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_view_range_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     float DisplayEntity::GetDataShadowRadiusId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_shadow_radius_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shadow_radius_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     float DisplayEntity::GetDataShadowStrengthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_shadow_strength_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shadow_strength_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     float DisplayEntity::GetDataWidthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_width_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_width_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     float DisplayEntity::GetDataHeightId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_height_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_height_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     int DisplayEntity::GetDataGlowColorOverrideId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_glow_color_override_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_glow_color_override_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
@@ -217,104 +234,121 @@ namespace Botcraft
     void DisplayEntity::SetDataInterpolationStartDeltaTicksId(const int data_interpolation_start_delta_ticks_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_interpolation_start_delta_ticks_id"] = data_interpolation_start_delta_ticks_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interpolation_start_delta_ticks_id");
+        metadata[index] = data_interpolation_start_delta_ticks_id;
     }
 
     void DisplayEntity::SetDataInterpolationDurationId(const int data_interpolation_duration_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_interpolation_duration_id"] = data_interpolation_duration_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interpolation_duration_id");
+        metadata[index] = data_interpolation_duration_id;
     }
 #else
     void DisplayEntity::SetDataTransformationInterpolationStartDeltaTicksId(const int data_transformation_interpolation_start_delta_ticks_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_transformation_interpolation_start_delta_ticks_id"] = data_transformation_interpolation_start_delta_ticks_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_transformation_interpolation_start_delta_ticks_id");
+        metadata[index] = data_transformation_interpolation_start_delta_ticks_id;
     }
 
     void DisplayEntity::SetDataTransformationInterpolationDurationId(const int data_transformation_interpolation_duration_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_transformation_interpolation_duration_id"] = data_transformation_interpolation_duration_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_transformation_interpolation_duration_id");
+        metadata[index] = data_transformation_interpolation_duration_id;
     }
 
     void DisplayEntity::SetDataPosRotInterpolationDurationId(const int data_pos_rot_interpolation_duration_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_pos_rot_interpolation_duration_id"] = data_pos_rot_interpolation_duration_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pos_rot_interpolation_duration_id");
+        metadata[index] = data_pos_rot_interpolation_duration_id;
     }
 #endif
 
     void DisplayEntity::SetDataTranslationId(const Vector3<float> data_translation_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_translation_id"] = data_translation_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_translation_id");
+        metadata[index] = data_translation_id;
     }
 
     void DisplayEntity::SetDataScaleId(const Vector3<float> data_scale_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_scale_id"] = data_scale_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_scale_id");
+        metadata[index] = data_scale_id;
     }
 
     void DisplayEntity::SetDataLeftRotationId(const std::array<float, 4> data_left_rotation_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_left_rotation_id"] = data_left_rotation_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_rotation_id");
+        metadata[index] = data_left_rotation_id;
     }
 
     void DisplayEntity::SetDataRightRotationId(const std::array<float, 4> data_right_rotation_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_right_rotation_id"] = data_right_rotation_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_rotation_id");
+        metadata[index] = data_right_rotation_id;
     }
 
     void DisplayEntity::SetDataBillboardRenderConstraintsId(const char data_billboard_render_constraints_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_billboard_render_constraints_id"] = data_billboard_render_constraints_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_billboard_render_constraints_id");
+        metadata[index] = data_billboard_render_constraints_id;
     }
 
     void DisplayEntity::SetDataBrightnessOverrideId(const int data_brightness_override_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_brightness_override_id"] = data_brightness_override_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_brightness_override_id");
+        metadata[index] = data_brightness_override_id;
     }
 
     void DisplayEntity::SetDataViewRangeId(const float data_view_range_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_view_range_id"] = data_view_range_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_view_range_id");
+        metadata[index] = data_view_range_id;
     }
 
     void DisplayEntity::SetDataShadowRadiusId(const float data_shadow_radius_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shadow_radius_id"] = data_shadow_radius_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shadow_radius_id");
+        metadata[index] = data_shadow_radius_id;
     }
 
     void DisplayEntity::SetDataShadowStrengthId(const float data_shadow_strength_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shadow_strength_id"] = data_shadow_strength_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shadow_strength_id");
+        metadata[index] = data_shadow_strength_id;
     }
 
     void DisplayEntity::SetDataWidthId(const float data_width_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_width_id"] = data_width_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_width_id");
+        metadata[index] = data_width_id;
     }
 
     void DisplayEntity::SetDataHeightId(const float data_height_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_height_id"] = data_height_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_height_id");
+        metadata[index] = data_height_id;
     }
 
     void DisplayEntity::SetDataGlowColorOverrideId(const int data_glow_color_override_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_glow_color_override_id"] = data_glow_color_override_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_glow_color_override_id");
+        metadata[index] = data_glow_color_override_id;
     }
 }
 #endif
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayItemDisplayEntity::metadata_count> DisplayItemDisplayEntity::metadata_names{ {
+    constexpr std::array<std::string_view, DisplayItemDisplayEntity::metadata_count> DisplayItemDisplayEntity::metadata_names{ {
         "data_item_stack_id",
         "data_item_display_id",
     } };
@@ -66,7 +66,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -74,26 +74,30 @@ namespace Botcraft
     ProtocolCraft::Slot DisplayItemDisplayEntity::GetDataItemStackId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item_stack_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_stack_id");
+        return std::any_cast<ProtocolCraft::Slot>(metadata.at(index));
     }
 
     char DisplayItemDisplayEntity::GetDataItemDisplayId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_item_display_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_display_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void DisplayItemDisplayEntity::SetDataItemStackId(const ProtocolCraft::Slot& data_item_stack_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack_id"] = data_item_stack_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_stack_id");
+        metadata[index] = data_item_stack_id;
     }
 
     void DisplayItemDisplayEntity::SetDataItemDisplayId(const char data_item_display_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_display_id"] = data_item_display_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_display_id");
+        metadata[index] = data_item_display_id;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayTextDisplayEntity::metadata_count> DisplayTextDisplayEntity::metadata_names{ {
+    constexpr std::array<std::string_view, DisplayTextDisplayEntity::metadata_count> DisplayTextDisplayEntity::metadata_names{ {
         "data_text_id",
         "data_line_width_id",
         "data_background_color_id",
@@ -75,7 +75,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -83,62 +83,72 @@ namespace Botcraft
     ProtocolCraft::Chat DisplayTextDisplayEntity::GetDataTextId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Chat>(metadata.at("data_text_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_text_id");
+        return std::any_cast<ProtocolCraft::Chat>(metadata.at(index));
     }
 
     int DisplayTextDisplayEntity::GetDataLineWidthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_line_width_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_line_width_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int DisplayTextDisplayEntity::GetDataBackgroundColorId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_background_color_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_background_color_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     char DisplayTextDisplayEntity::GetDataTextOpacityId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_text_opacity_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_text_opacity_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     char DisplayTextDisplayEntity::GetDataStyleFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_style_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_style_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void DisplayTextDisplayEntity::SetDataTextId(const ProtocolCraft::Chat& data_text_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_text_id"] = data_text_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_text_id");
+        metadata[index] = data_text_id;
     }
 
     void DisplayTextDisplayEntity::SetDataLineWidthId(const int data_line_width_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_line_width_id"] = data_line_width_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_line_width_id");
+        metadata[index] = data_line_width_id;
     }
 
     void DisplayTextDisplayEntity::SetDataBackgroundColorId(const int data_background_color_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_background_color_id"] = data_background_color_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_background_color_id");
+        metadata[index] = data_background_color_id;
     }
 
     void DisplayTextDisplayEntity::SetDataTextOpacityId(const char data_text_opacity_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_text_opacity_id"] = data_text_opacity_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_text_opacity_id");
+        metadata[index] = data_text_opacity_id;
     }
 
     void DisplayTextDisplayEntity::SetDataStyleFlagsId(const char data_style_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_style_flags_id"] = data_style_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_style_flags_id");
+        metadata[index] = data_style_flags_id;
     }
 
 
@@ -267,7 +267,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, Entity::metadata_count> Entity::metadata_names{ {
+    constexpr std::array<std::string_view, Entity::metadata_count> Entity::metadata_names{ {
         "data_shared_flags_id",
         "data_air_supply_id",
         "data_custom_name",
@@ -357,7 +357,7 @@ namespace Botcraft
             return;
         }
 
-        ProtocolCraft::ReadIterator iter = data.begin();
+        ProtocolCraft::ReadIterator iter = data.data();
         size_t length = data.size();
 
         while (true)
@@ -682,10 +682,9 @@ namespace Botcraft
     {
         assert(index >= 0 && index < metadata_count);
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        const std::string& metadata_name = metadata_names[index];
-        metadata[metadata_name] = value;
+        metadata[index] = value;
 #if USE_GUI && PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        if (metadata_name == "data_pose")
+        if (index == GetMetadataIndex(metadata_names, "data_pose"))
         {
             OnSizeUpdated();
         }
@@ -708,39 +707,45 @@ namespace Botcraft
     int Entity::GetDataAirSupplyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_air_supply_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_air_supply_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     std::optional<ProtocolCraft::Chat> Entity::GetDataCustomName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::Chat>>(metadata.at("data_custom_name"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name");
+        return std::any_cast<std::optional<ProtocolCraft::Chat>>(metadata.at(index));
     }
 #else
     std::string Entity::GetDataCustomName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_custom_name"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name");
+        return std::any_cast<std::string>(metadata.at(index));
     }
 #endif
 
     bool Entity::GetDataCustomNameVisible() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_custom_name_visible"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name_visible");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool Entity::GetDataSilent() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_silent"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_silent");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool Entity::GetDataNoGravity() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_no_gravity"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_no_gravity");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -755,7 +760,8 @@ namespace Botcraft
     int Entity::GetDataTicksFrozen() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_ticks_frozen"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_ticks_frozen");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -775,39 +781,45 @@ namespace Botcraft
     void Entity::SetDataAirSupplyId(const int data_air_supply_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_air_supply_id"] = data_air_supply_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_air_supply_id");
+        metadata[index] = data_air_supply_id;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void Entity::SetDataCustomName(const std::optional<ProtocolCraft::Chat>& data_custom_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name"] = data_custom_name;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name");
+        metadata[index] = data_custom_name;
     }
 #else
     void Entity::SetDataCustomName(const std::string& data_custom_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name"] = data_custom_name;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name");
+        metadata[index] = data_custom_name;
     }
 #endif
 
     void Entity::SetDataCustomNameVisible(const bool data_custom_name_visible)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name_visible"] = data_custom_name_visible;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_custom_name_visible");
+        metadata[index] = data_custom_name_visible;
     }
 
     void Entity::SetDataSilent(const bool data_silent)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_silent"] = data_silent;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_silent");
+        metadata[index] = data_silent;
     }
 
     void Entity::SetDataNoGravity(const bool data_no_gravity)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_no_gravity"] = data_no_gravity;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_no_gravity");
+        metadata[index] = data_no_gravity;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -822,7 +834,8 @@ namespace Botcraft
     void Entity::SetDataTicksFrozen(const int data_ticks_frozen)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_ticks_frozen"] = data_ticks_frozen;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_ticks_frozen");
+        metadata[index] = data_ticks_frozen;
     }
 #endif
 
@@ -2036,7 +2049,8 @@ namespace Botcraft
 
     char Entity::GetDataSharedFlagsIdImpl() const
     {
-        return std::any_cast<char>(metadata.at("data_shared_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shared_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     bool Entity::GetDataSharedFlagsIdImpl(const EntitySharedFlagsId id) const
@@ -2046,7 +2060,8 @@ namespace Botcraft
 
     void Entity::SetDataSharedFlagsIdImpl(const char data_shared_flags_id)
     {
-        metadata["data_shared_flags_id"] = data_shared_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shared_flags_id");
+        metadata[index] = data_shared_flags_id;
     }
 
     void Entity::SetDataSharedFlagsIdImpl(const EntitySharedFlagsId id, const bool b)
@@ -2063,12 +2078,14 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     Pose Entity::GetDataPoseImpl() const
     {
-        return std::any_cast<Pose>(metadata.at("data_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pose");
+        return std::any_cast<Pose>(metadata.at(index));
     }
 
     void Entity::SetDataPoseImpl(const Pose data_pose)
     {
-        metadata["data_pose"] = data_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pose");
+        metadata[index] = data_pose;
 #if USE_GUI
         OnSizeUpdated();
 #endif
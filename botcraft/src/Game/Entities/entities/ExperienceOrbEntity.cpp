@@ -7,7 +7,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 769 /* > 1.21.4 */
-    const std::array<std::string, ExperienceOrbEntity::metadata_count> ExperienceOrbEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ExperienceOrbEntity::metadata_count> ExperienceOrbEntity::metadata_names{ {
         "data_value",
     } };
 #endif
@@ -68,21 +68,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ExperienceOrbEntity::GetDataValue() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_value"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_value");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void ExperienceOrbEntity::SetDataValue(const int data_value)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_value"] = data_value;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_value");
+        metadata[index] = data_value;
     }
 #endif
 
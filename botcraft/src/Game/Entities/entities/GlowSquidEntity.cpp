@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, GlowSquidEntity::metadata_count> GlowSquidEntity::metadata_names{ {
+    constexpr std::array<std::string_view, GlowSquidEntity::metadata_count> GlowSquidEntity::metadata_names{ {
         "data_dark_ticks_remaining",
     } };
 
@@ -62,21 +62,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int GlowSquidEntity::GetDataDarkTicksRemaining() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_dark_ticks_remaining"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dark_ticks_remaining");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void GlowSquidEntity::SetDataDarkTicksRemaining(const int data_dark_ticks_remaining)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dark_ticks_remaining"] = data_dark_ticks_remaining;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dark_ticks_remaining");
+        metadata[index] = data_dark_ticks_remaining;
     }
 
 
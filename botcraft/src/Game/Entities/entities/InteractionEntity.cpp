@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, InteractionEntity::metadata_count> InteractionEntity::metadata_names{ {
+    constexpr std::array<std::string_view, InteractionEntity::metadata_count> InteractionEntity::metadata_names{ {
         "data_width_id",
         "data_height_id",
         "data_response_id",
@@ -69,7 +69,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -77,38 +77,44 @@ namespace Botcraft
     float InteractionEntity::GetDataWidthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_width_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_width_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     float InteractionEntity::GetDataHeightId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_height_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_height_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
     bool InteractionEntity::GetDataResponseId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_response_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_response_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void InteractionEntity::SetDataWidthId(const float data_width_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_width_id"] = data_width_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_width_id");
+        metadata[index] = data_width_id;
     }
 
     void InteractionEntity::SetDataHeightId(const float data_height_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_height_id"] = data_height_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_height_id");
+        metadata[index] = data_height_id;
     }
 
     void InteractionEntity::SetDataResponseId(const bool data_response_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_response_id"] = data_response_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_response_id");
+        metadata[index] = data_response_id;
     }
 
 
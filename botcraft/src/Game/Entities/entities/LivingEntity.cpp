@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, LivingEntity::metadata_count> LivingEntity::metadata_names{ {
+    constexpr std::array<std::string_view, LivingEntity::metadata_count> LivingEntity::metadata_names{ {
         "data_living_entity_flags",
         "data_health_id",
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
@@ -148,7 +148,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -161,40 +161,46 @@ namespace Botcraft
     float LivingEntity::GetDataHealthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_health_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_health_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     int LivingEntity::GetDataEffectColorId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_effect_color_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_color_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #else
     std::vector<ProtocolCraft::Particle> LivingEntity::GetDataEffectParticles() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::vector<ProtocolCraft::Particle>>(metadata.at("data_effect_particle"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_particles");
+        return std::any_cast<std::vector<ProtocolCraft::Particle>>(metadata.at(index));
     }
 #endif
 
     bool LivingEntity::GetDataEffectAmbienceId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_effect_ambience_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_ambience_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int LivingEntity::GetDataArrowCountId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_arrow_count_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_arrow_count_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     int LivingEntity::GetDataStingerCountId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_stinger_count_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stinger_count_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -210,46 +216,53 @@ namespace Botcraft
     void LivingEntity::SetDataLivingEntityFlags(const char data_living_entity_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_living_entity_flags"] = data_living_entity_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_living_entity_flags");
+        metadata[index] = data_living_entity_flags;
     }
 
     void LivingEntity::SetDataHealthId(const float data_health_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_health_id"] = data_health_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_health_id");
+        metadata[index] = data_health_id;
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     void LivingEntity::SetDataEffectColorId(const int data_effect_color_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_effect_color_id"] = data_effect_color_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_color_id");
+        metadata[index] = data_effect_color_id;
     }
 #else
     void LivingEntity::SetDataEffectParticles(const std::vector<ProtocolCraft::Particle>& data_effect_particles)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_effect_particles"] = data_effect_particles;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_particles");
+        metadata[index] = data_effect_particles;
     }
 #endif
 
     void LivingEntity::SetDataEffectAmbienceId(const bool data_effect_ambience_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_effect_ambience_id"] = data_effect_ambience_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_effect_ambience_id");
+        metadata[index] = data_effect_ambience_id;
     }
 
     void LivingEntity::SetDataArrowCountId(const int data_arrow_count_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_arrow_count_id"] = data_arrow_count_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_arrow_count_id");
+        metadata[index] = data_arrow_count_id;
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     void LivingEntity::SetDataStingerCountId(const int data_stinger_count_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_stinger_count_id"] = data_stinger_count_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stinger_count_id");
+        metadata[index] = data_stinger_count_id;
     }
 #endif
 
@@ -257,7 +270,8 @@ namespace Botcraft
     void LivingEntity::SetSleepingPosId(const std::optional<Position>& sleeping_pos_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["sleeping_pos_id"] = sleeping_pos_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "sleeping_pos_id");
+        metadata[index] = sleeping_pos_id;
     }
 #endif
 
@@ -482,13 +496,15 @@ namespace Botcraft
 
     char LivingEntity::GetDataLivingEntityFlagsImpl() const
     {
-        return std::any_cast<char>(metadata.at("data_living_entity_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_living_entity_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     std::optional<Position> LivingEntity::GetSleepingPosIdImpl() const
     {
-        return std::any_cast<std::optional<Position>>(metadata.at("sleeping_pos_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "sleeping_pos_id");
+        return std::any_cast<std::optional<Position>>(metadata.at(index));
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, MobEntity::metadata_count> MobEntity::metadata_names{ {
+    constexpr std::array<std::string_view, MobEntity::metadata_count> MobEntity::metadata_names{ {
         "data_mob_flags_id",
     } };
 
@@ -55,21 +55,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char MobEntity::GetDataMobFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_mob_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_mob_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void MobEntity::SetDataMobFlagsId(const char data_mob_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_mob_flags_id"] = data_mob_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_mob_flags_id");
+        metadata[index] = data_mob_flags_id;
     }
 
 
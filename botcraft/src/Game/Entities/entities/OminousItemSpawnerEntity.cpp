@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, OminousItemSpawnerEntity::metadata_count> OminousItemSpawnerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, OminousItemSpawnerEntity::metadata_count> OminousItemSpawnerEntity::metadata_names{ {
         "data_item",
     } };
 
@@ -62,21 +62,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot OminousItemSpawnerEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<const ProtocolCraft::Slot&>(metadata.at("data_item"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        return std::any_cast<const ProtocolCraft::Slot&>(metadata.at(index));
     }
 
 
     void OminousItemSpawnerEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        metadata[index] = data_item;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, TamableAnimalEntity::metadata_count> TamableAnimalEntity::metadata_names{ {
+    constexpr std::array<std::string_view, TamableAnimalEntity::metadata_count> TamableAnimalEntity::metadata_names{ {
         "data_flags_id",
         "data_owneruuid_id",
     } };
@@ -47,33 +47,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char TamableAnimalEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     std::optional<ProtocolCraft::UUID> TamableAnimalEntity::GetDataOwneruuidId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_owneruuid_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_owneruuid_id");
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at(index));
     }
 
 
     void TamableAnimalEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        metadata[index] = data_flags_id;
     }
 
     void TamableAnimalEntity::SetDataOwneruuidId(const std::optional<ProtocolCraft::UUID>& data_owneruuid_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_owneruuid_id"] = data_owneruuid_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_owneruuid_id");
+        metadata[index] = data_owneruuid_id;
     }
 
 }
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, BatEntity::metadata_count> BatEntity::metadata_names{ {
+    constexpr std::array<std::string_view, BatEntity::metadata_count> BatEntity::metadata_names{ {
         "data_id_flags",
     } };
 
@@ -64,21 +64,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char BatEntity::GetDataIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_id_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void BatEntity::SetDataIdFlags(const char data_id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_flags"] = data_id_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        metadata[index] = data_id_flags;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractFishEntity::metadata_count> AbstractFishEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractFishEntity::metadata_count> AbstractFishEntity::metadata_names{ {
         "from_bucket",
     } };
 
@@ -47,21 +47,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractFishEntity::GetFromBucket() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("from_bucket"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "from_bucket");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AbstractFishEntity::SetFromBucket(const bool from_bucket)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["from_bucket"] = from_bucket;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "from_bucket");
+        metadata[index] = from_bucket;
     }
 
 }
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, BeeEntity::metadata_count> BeeEntity::metadata_names{ {
+    constexpr std::array<std::string_view, BeeEntity::metadata_count> BeeEntity::metadata_names{ {
         "data_flags_id",
         "data_remaining_anger_time",
     } };
@@ -78,33 +78,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char BeeEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     int BeeEntity::GetDataRemainingAngerTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_remaining_anger_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void BeeEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        metadata[index] = data_flags_id;
     }
 
     void BeeEntity::SetDataRemainingAngerTime(const int data_remaining_anger_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_remaining_anger_time"] = data_remaining_anger_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        metadata[index] = data_remaining_anger_time;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, CatEntity::metadata_count> CatEntity::metadata_names{ {
+    constexpr std::array<std::string_view, CatEntity::metadata_count> CatEntity::metadata_names{ {
         "data_type_id",
         "is_lying",
         "relax_state_one",
@@ -79,57 +79,65 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int CatEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool CatEntity::GetIsLying() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_lying"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_lying");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool CatEntity::GetRelaxStateOne() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("relax_state_one"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "relax_state_one");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int CatEntity::GetDataCollarColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_collar_color"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void CatEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        metadata[index] = data_type_id;
     }
 
     void CatEntity::SetIsLying(const bool is_lying)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_lying"] = is_lying;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_lying");
+        metadata[index] = is_lying;
     }
 
     void CatEntity::SetRelaxStateOne(const bool relax_state_one)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["relax_state_one"] = relax_state_one;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "relax_state_one");
+        metadata[index] = relax_state_one;
     }
 
     void CatEntity::SetDataCollarColor(const int data_collar_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_collar_color"] = data_collar_color;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        metadata[index] = data_collar_color;
     }
 
 
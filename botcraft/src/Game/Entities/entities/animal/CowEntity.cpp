@@ -7,7 +7,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 769 /* > 1.21.4 */
-    const std::array<std::string, CowEntity::metadata_count> CowEntity::metadata_names{ {
+    constexpr std::array<std::string_view, CowEntity::metadata_count> CowEntity::metadata_names{ {
             "data_variant_id",
     } };
 #endif
@@ -68,7 +68,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -76,14 +76,16 @@ namespace Botcraft
     int CowEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void CowEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 #endif
 
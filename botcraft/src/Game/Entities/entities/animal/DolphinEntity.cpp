@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, DolphinEntity::metadata_count> DolphinEntity::metadata_names{ {
+    constexpr std::array<std::string_view, DolphinEntity::metadata_count> DolphinEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
         "treasure_pos",
 #endif
@@ -89,7 +89,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -97,20 +97,23 @@ namespace Botcraft
     Position DolphinEntity::GetTreasurePos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("treasure_pos"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "treasure_pos");
+        return std::any_cast<Position>(metadata.at(index));
     }
 #endif
 
     bool DolphinEntity::GetGotFish() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("got_fish"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "got_fish");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int DolphinEntity::GetMoistnessLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("moistness_level"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "moistness_level");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
@@ -118,20 +121,23 @@ namespace Botcraft
     void DolphinEntity::SetTreasurePos(const Position& treasure_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["treasure_pos"] = treasure_pos;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "treasure_pos");
+        metadata[index] = treasure_pos;
     }
 #endif
 
     void DolphinEntity::SetGotFish(const bool got_fish)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["got_fish"] = got_fish;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "got_fish");
+        metadata[index] = got_fish;
     }
 
     void DolphinEntity::SetMoistnessLevel(const int moistness_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["moistness_level"] = moistness_level;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "moistness_level");
+        metadata[index] = moistness_level;
     }
 
 
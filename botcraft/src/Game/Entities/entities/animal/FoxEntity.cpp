@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FoxEntity::metadata_count> FoxEntity::metadata_names{ {
+    constexpr std::array<std::string_view, FoxEntity::metadata_count> FoxEntity::metadata_names{ {
         "data_type_id",
         "data_flags_id",
         "data_trusted_id_0",
@@ -83,57 +83,65 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int FoxEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     char FoxEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     std::optional<ProtocolCraft::UUID> FoxEntity::GetDataTrustedId0() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_trusted_id_0"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusted_id_0");
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at(index));
     }
 
     std::optional<ProtocolCraft::UUID> FoxEntity::GetDataTrustedId1() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_trusted_id_1"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusted_id_1");
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at(index));
     }
 
 
     void FoxEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        metadata[index] = data_type_id;
     }
 
     void FoxEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        metadata[index] = data_flags_id;
     }
 
     void FoxEntity::SetDataTrustedId0(const std::optional<ProtocolCraft::UUID>& data_trusted_id_0)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_trusted_id_0"] = data_trusted_id_0;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusted_id_0");
+        metadata[index] = data_trusted_id_0;
     }
 
     void FoxEntity::SetDataTrustedId1(const std::optional<ProtocolCraft::UUID>& data_trusted_id_1)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_trusted_id_1"] = data_trusted_id_1;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusted_id_1");
+        metadata[index] = data_trusted_id_1;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, HappyGhastEntity::metadata_count> HappyGhastEntity::metadata_names{ {
+    constexpr std::array<std::string_view, HappyGhastEntity::metadata_count> HappyGhastEntity::metadata_names{ {
         "is_leash_holder",
         "stays_still",
     } };
@@ -75,33 +75,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool HappyGhastEntity::GetIsLeashHolder() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("is_leash_holder"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_leash_holder");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool HappyGhastEntity::GetStaysStill() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("stays_still"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "stays_still");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void HappyGhastEntity::SetIsLeashHolder(const int is_leash_holder)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_leash_holder"] = is_leash_holder;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_leash_holder");
+        metadata[index] = is_leash_holder;
     }
 
     void HappyGhastEntity::SetStaysStill(const int stays_still)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["stays_still"] = stays_still;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "stays_still");
+        metadata[index] = stays_still;
     }
 
 
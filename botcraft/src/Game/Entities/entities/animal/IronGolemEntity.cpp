@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, IronGolemEntity::metadata_count> IronGolemEntity::metadata_names{ {
+    constexpr std::array<std::string_view, IronGolemEntity::metadata_count> IronGolemEntity::metadata_names{ {
         "data_flags_id",
     } };
 
@@ -72,21 +72,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char IronGolemEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void IronGolemEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_flags_id");
+        metadata[index] = data_flags_id;
     }
 
 
@@ -5,7 +5,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-    const std::array<std::string, MushroomCowEntity::metadata_count> MushroomCowEntity::metadata_names{ {
+    constexpr std::array<std::string_view, MushroomCowEntity::metadata_count> MushroomCowEntity::metadata_names{ {
         "data_type",
     } };
 #endif
@@ -78,7 +78,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -86,27 +86,31 @@ namespace Botcraft
     std::string MushroomCowEntity::GetDataType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        return std::any_cast<std::string>(metadata.at(index));
     }
 
 
     void MushroomCowEntity::SetDataType(const std::string& data_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type"] = data_type;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        metadata[index] = data_type;
     }
 #else
     int MushroomCowEntity::GetDataType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void MushroomCowEntity::SetDataType(const int data_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type"] = data_type;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        metadata[index] = data_type;
     }
 #endif
 #endif
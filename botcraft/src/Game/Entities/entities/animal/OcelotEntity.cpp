@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, OcelotEntity::metadata_count> OcelotEntity::metadata_names{ {
+    constexpr std::array<std::string_view, OcelotEntity::metadata_count> OcelotEntity::metadata_names{ {
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         "data_trusting",
 #else
@@ -80,7 +80,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -88,27 +88,31 @@ namespace Botcraft
     bool OcelotEntity::GetDataTrusting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_trusting"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusting");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void OcelotEntity::SetDataTrusting(const bool data_trusting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_trusting"] = data_trusting;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_trusting");
+        metadata[index] = data_trusting;
     }
 #else
     int OcelotEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void OcelotEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        metadata[index] = data_type_id;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PandaEntity::metadata_count> PandaEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PandaEntity::metadata_count> PandaEntity::metadata_names{ {
         "unhappy_counter",
         "sneeze_counter",
         "eat_counter",
@@ -83,81 +83,93 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PandaEntity::GetUnhappyCounter() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("unhappy_counter"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "unhappy_counter");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int PandaEntity::GetSneezeCounter() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("sneeze_counter"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "sneeze_counter");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int PandaEntity::GetEatCounter() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("eat_counter"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "eat_counter");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     char PandaEntity::GetMainGeneId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("main_gene_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "main_gene_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     char PandaEntity::GetHiddenGeneId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("hidden_gene_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "hidden_gene_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     char PandaEntity::GetDataIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_id_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void PandaEntity::SetUnhappyCounter(const int unhappy_counter)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["unhappy_counter"] = unhappy_counter;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "unhappy_counter");
+        metadata[index] = unhappy_counter;
     }
 
     void PandaEntity::SetSneezeCounter(const int sneeze_counter)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["sneeze_counter"] = sneeze_counter;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "sneeze_counter");
+        metadata[index] = sneeze_counter;
     }
 
     void PandaEntity::SetEatCounter(const int eat_counter)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["eat_counter"] = eat_counter;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "eat_counter");
+        metadata[index] = eat_counter;
     }
 
     void PandaEntity::SetMainGeneId(const char main_gene_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["main_gene_id"] = main_gene_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "main_gene_id");
+        metadata[index] = main_gene_id;
     }
 
     void PandaEntity::SetHiddenGeneId(const char hidden_gene_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["hidden_gene_id"] = hidden_gene_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "hidden_gene_id");
+        metadata[index] = hidden_gene_id;
     }
 
     void PandaEntity::SetDataIdFlags(const char data_id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_flags"] = data_id_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        metadata[index] = data_id_flags;
     }
 
 
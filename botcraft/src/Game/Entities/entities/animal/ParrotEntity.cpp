@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ParrotEntity::metadata_count> ParrotEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ParrotEntity::metadata_count> ParrotEntity::metadata_names{ {
         "data_variant_id",
     } };
 
@@ -74,21 +74,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ParrotEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void ParrotEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PigEntity::metadata_count> PigEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PigEntity::metadata_count> PigEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
         "data_saddle_id",
 #endif
@@ -83,7 +83,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -91,21 +91,24 @@ namespace Botcraft
     bool PigEntity::GetDataSaddleId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_saddle_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_saddle_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
     int PigEntity::GetDataBoostTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_boost_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_boost_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 769 /* > 1.21.4 */
     int PigEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -114,21 +117,24 @@ namespace Botcraft
     void PigEntity::SetDataSaddleId(const bool data_saddle_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_saddle_id"] = data_saddle_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_saddle_id");
+        metadata[index] = data_saddle_id;
     }
 #endif
 
     void PigEntity::SetDataBoostTime(const int data_boost_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_boost_time"] = data_boost_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_boost_time");
+        metadata[index] = data_boost_time;
     }
 
 #if PROTOCOL_VERSION > 769 /* > 1.21.4 */
     void PigEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PolarBearEntity::metadata_count> PolarBearEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PolarBearEntity::metadata_count> PolarBearEntity::metadata_names{ {
         "data_standing_id",
     } };
 
@@ -69,21 +69,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool PolarBearEntity::GetDataStandingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_standing_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_standing_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void PolarBearEntity::SetDataStandingId(const bool data_standing_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_standing_id"] = data_standing_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_standing_id");
+        metadata[index] = data_standing_id;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PufferfishEntity::metadata_count> PufferfishEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PufferfishEntity::metadata_count> PufferfishEntity::metadata_names{ {
         "puff_state",
     } };
 
@@ -62,21 +62,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PufferfishEntity::GetPuffState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("puff_state"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "puff_state");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void PufferfishEntity::SetPuffState(const int puff_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["puff_state"] = puff_state;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "puff_state");
+        metadata[index] = puff_state;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, RabbitEntity::metadata_count> RabbitEntity::metadata_names{ {
+    constexpr std::array<std::string_view, RabbitEntity::metadata_count> RabbitEntity::metadata_names{ {
         "data_type_id",
     } };
 
@@ -72,21 +72,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int RabbitEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void RabbitEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type_id");
+        metadata[index] = data_type_id;
     }
 
 #if PROTOCOL_VERSION > 766 /* > 1.20.6 */
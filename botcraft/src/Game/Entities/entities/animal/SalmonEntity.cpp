@@ -6,7 +6,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 767 /* > 1.21.1 */
-    const std::array<std::string, SalmonEntity::metadata_count> SalmonEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SalmonEntity::metadata_count> SalmonEntity::metadata_names{ {
         "data_type",
     } };
 #endif
@@ -71,7 +71,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -84,7 +84,8 @@ namespace Botcraft
 
     const std::string& SalmonEntity::GetDataTypeImpl() const
     {
-        return std::any_cast<const std::string&>(metadata.at("data_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        return std::any_cast<const std::string&>(metadata.at(index));
     }
 #else
     int SalmonEntity::GetDataType() const
@@ -95,7 +96,8 @@ namespace Botcraft
 
     int SalmonEntity::GetDataTypeImpl() const
     {
-        return std::any_cast<int>(metadata.at("data_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -137,7 +139,8 @@ namespace Botcraft
 #endif
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type"] = data_type;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_type");
+        metadata[index] = data_type;
 #if USE_GUI
         OnSizeUpdated();
 #endif
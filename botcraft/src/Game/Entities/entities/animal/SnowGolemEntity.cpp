@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, SnowGolemEntity::metadata_count> SnowGolemEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SnowGolemEntity::metadata_count> SnowGolemEntity::metadata_names{ {
         "data_pumpkin_id",
     } };
 
@@ -65,21 +65,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SnowGolemEntity::GetDataPumpkinId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_pumpkin_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pumpkin_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void SnowGolemEntity::SetDataPumpkinId(const char data_pumpkin_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_pumpkin_id"] = data_pumpkin_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_pumpkin_id");
+        metadata[index] = data_pumpkin_id;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, TropicalFishEntity::metadata_count> TropicalFishEntity::metadata_names{ {
+    constexpr std::array<std::string_view, TropicalFishEntity::metadata_count> TropicalFishEntity::metadata_names{ {
         "data_id_type_variant",
     } };
 
@@ -62,21 +62,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int TropicalFishEntity::GetDataIdTypeVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type_variant"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type_variant");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void TropicalFishEntity::SetDataIdTypeVariant(const int data_id_type_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type_variant"] = data_id_type_variant;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type_variant");
+        metadata[index] = data_id_type_variant;
     }
 
 
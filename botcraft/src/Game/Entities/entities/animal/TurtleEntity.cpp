@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, TurtleEntity::metadata_count> TurtleEntity::metadata_names{ {
+    constexpr std::array<std::string_view, TurtleEntity::metadata_count> TurtleEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
         "home_pos",
 #endif
@@ -96,7 +96,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -104,39 +104,45 @@ namespace Botcraft
     Position TurtleEntity::GetHomePos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("home_pos"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "home_pos");
+        return std::any_cast<Position>(metadata.at(index));
     }
 #endif
 
     bool TurtleEntity::GetHasEgg() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("has_egg"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "has_egg");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool TurtleEntity::GetLayingEgg() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("laying_egg"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "laying_egg");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     Position TurtleEntity::GetTravelPos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("travel_pos"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "travel_pos");
+        return std::any_cast<Position>(metadata.at(index));
     }
 
     bool TurtleEntity::GetGoingHome() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("going_home"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "going_home");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool TurtleEntity::GetTravelling() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("travelling"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "travelling");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -145,39 +151,45 @@ namespace Botcraft
     void TurtleEntity::SetHomePos(const Position& home_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["home_pos"] = home_pos;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "home_pos");
+        metadata[index] = home_pos;
     }
 #endif
 
     void TurtleEntity::SetHasEgg(const bool has_egg)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["has_egg"] = has_egg;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "has_egg");
+        metadata[index] = has_egg;
     }
 
     void TurtleEntity::SetLayingEgg(const bool laying_egg)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["laying_egg"] = laying_egg;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "laying_egg");
+        metadata[index] = laying_egg;
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     void TurtleEntity::SetTravelPos(const Position& travel_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["travel_pos"] = travel_pos;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "travel_pos");
+        metadata[index] = travel_pos;
     }
 
     void TurtleEntity::SetGoingHome(const bool going_home)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["going_home"] = going_home;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "going_home");
+        metadata[index] = going_home;
     }
 
     void TurtleEntity::SetTravelling(const bool travelling)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["travelling"] = travelling;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "travelling");
+        metadata[index] = travelling;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WolfEntity::metadata_count> WolfEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WolfEntity::metadata_count> WolfEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 499 /* < 1.15 */
         "data_health_id",
 #endif
@@ -103,7 +103,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -111,27 +111,31 @@ namespace Botcraft
     float WolfEntity::GetDataHealthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_health_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_health_id");
+        return std::any_cast<float>(metadata.at(index));
     }
 #endif
 
     bool WolfEntity::GetDataInterestedId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_interested_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interested_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int WolfEntity::GetDataCollarColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_collar_color"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     int WolfEntity::GetDataRemainingAngerTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_remaining_anger_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -139,7 +143,8 @@ namespace Botcraft
     int WolfEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -148,27 +153,31 @@ namespace Botcraft
     void WolfEntity::SetDataHealthId(const float data_health_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_health_id"] = data_health_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_health_id");
+        metadata[index] = data_health_id;
     }
 #endif
 
     void WolfEntity::SetDataInterestedId(const bool data_interested_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_interested_id"] = data_interested_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interested_id");
+        metadata[index] = data_interested_id;
     }
 
     void WolfEntity::SetDataCollarColor(const int data_collar_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_collar_color"] = data_collar_color;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        metadata[index] = data_collar_color;
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     void WolfEntity::SetDataRemainingAngerTime(const int data_remaining_anger_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_remaining_anger_time"] = data_remaining_anger_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        metadata[index] = data_remaining_anger_time;
     }
 #endif
 
@@ -176,7 +185,8 @@ namespace Botcraft
     void WolfEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 #endif
 
@@ -6,7 +6,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 759 /* > 1.19 */
-    const std::array<std::string, AllayEntity::metadata_count> AllayEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AllayEntity::metadata_count> AllayEntity::metadata_names{ {
         "data_dancing",
         "data_can_duplicate",
     } };
@@ -81,33 +81,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AllayEntity::GetDataDancing() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_dancing"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dancing");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool AllayEntity::GetDataCanDuplicate() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_can_duplicate"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_can_duplicate");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AllayEntity::SetDataDancing(const bool data_dancing)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dancing"] = data_dancing;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dancing");
+        metadata[index] = data_dancing;
     }
 
     void AllayEntity::SetDataCanDuplicate(const bool data_can_duplicate)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_can_duplicate"] = data_can_duplicate;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_can_duplicate");
+        metadata[index] = data_can_duplicate;
     }
 #endif
 
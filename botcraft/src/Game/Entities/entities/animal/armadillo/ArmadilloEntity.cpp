@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ArmadilloEntity::metadata_count> ArmadilloEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ArmadilloEntity::metadata_count> ArmadilloEntity::metadata_names{ {
         "armadillo_state",
     } };
 
@@ -66,21 +66,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ArmadilloEntity::GetArmadilloState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("armadillo_state"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "armadillo_state");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void ArmadilloEntity::SetArmadilloState(const int armadillo_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["armadillo_state"] = armadillo_state;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "armadillo_state");
+        metadata[index] = armadillo_state;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AxolotlEntity::metadata_count> AxolotlEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AxolotlEntity::metadata_count> AxolotlEntity::metadata_names{ {
         "data_variant",
         "data_playing_dead",
         "from_bucket",
@@ -80,45 +80,51 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int AxolotlEntity::GetDataVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool AxolotlEntity::GetDataPlayingDead() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_playing_dead"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_playing_dead");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool AxolotlEntity::GetFromBucket() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("from_bucket"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "from_bucket");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AxolotlEntity::SetDataVariant(const int data_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant"] = data_variant;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant");
+        metadata[index] = data_variant;
     }
 
     void AxolotlEntity::SetDataPlayingDead(const bool data_playing_dead)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_playing_dead"] = data_playing_dead;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_playing_dead");
+        metadata[index] = data_playing_dead;
     }
 
     void AxolotlEntity::SetFromBucket(const bool from_bucket)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["from_bucket"] = from_bucket;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "from_bucket");
+        metadata[index] = from_bucket;
     }
 
 
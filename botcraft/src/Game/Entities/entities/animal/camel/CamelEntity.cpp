@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, CamelEntity::metadata_count> CamelEntity::metadata_names{ {
+    constexpr std::array<std::string_view, CamelEntity::metadata_count> CamelEntity::metadata_names{ {
         "dash",
         "last_pose_change_tick",
     } };
@@ -79,33 +79,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool CamelEntity::GetDash() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("dash"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "dash");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     long long int CamelEntity::GetLastPoseChangeTick() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<long long int>(metadata.at("last_pose_change_tick"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "last_pose_change_tick");
+        return std::any_cast<long long int>(metadata.at(index));
     }
 
 
     void CamelEntity::SetDash(const bool dash)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["dash"] = dash;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "dash");
+        metadata[index] = dash;
     }
 
     void CamelEntity::SetLastPoseChangeTick(const long long int last_pose_change_tick)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["last_pose_change_tick"] = last_pose_change_tick;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "last_pose_change_tick");
+        metadata[index] = last_pose_change_tick;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FrogEntity::metadata_count> FrogEntity::metadata_names{ {
+    constexpr std::array<std::string_view, FrogEntity::metadata_count> FrogEntity::metadata_names{ {
         "data_variant_id",
         "data_tongue_target_id",
     } };
@@ -75,33 +75,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int FrogEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     std::optional<int> FrogEntity::GetDataTongueTargetId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_tongue_target_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_tongue_target_id");
+        return std::any_cast<std::optional<int>>(metadata.at(index));
     }
 
 
     void FrogEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 
     void FrogEntity::SetDataTongueTargetId(const std::optional<int>& data_tongue_target_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_tongue_target_id"] = data_tongue_target_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_tongue_target_id");
+        metadata[index] = data_tongue_target_id;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, GoatEntity::metadata_count> GoatEntity::metadata_names{ {
+    constexpr std::array<std::string_view, GoatEntity::metadata_count> GoatEntity::metadata_names{ {
         "data_is_screaming_goat",
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
         "data_has_left_horn",
@@ -81,27 +81,30 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GoatEntity::GetDataIsScreamingGoat() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_screaming_goat"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_screaming_goat");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
     bool GoatEntity::GetDataHasLeftHorn() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_has_left_horn"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_has_left_horn");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool GoatEntity::GetDataHasRightHorn() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_has_right_horn"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_has_right_horn");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -109,20 +112,23 @@ namespace Botcraft
     void GoatEntity::SetDataIsScreamingGoat(const bool data_is_screaming_goat)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_screaming_goat"] = data_is_screaming_goat;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_screaming_goat");
+        metadata[index] = data_is_screaming_goat;
     }
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
     void GoatEntity::SetDataHasLeftHorn(const bool data_has_left_horn)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_has_left_horn"] = data_has_left_horn;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_has_left_horn");
+        metadata[index] = data_has_left_horn;
     }
 
     void GoatEntity::SetDataHasRightHorn(const bool data_has_right_horn)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_has_right_horn"] = data_has_right_horn;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_has_right_horn");
+        metadata[index] = data_has_right_horn;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractChestedHorseEntity::metadata_count> AbstractChestedHorseEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractChestedHorseEntity::metadata_count> AbstractChestedHorseEntity::metadata_names{ {
         "data_id_chest",
     } };
 
@@ -52,21 +52,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractChestedHorseEntity::GetDataIdChest() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_chest"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_chest");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AbstractChestedHorseEntity::SetDataIdChest(const bool data_id_chest)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_chest"] = data_id_chest;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_chest");
+        metadata[index] = data_id_chest;
     }
 
 }
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractHorseEntity::metadata_count> AbstractHorseEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractHorseEntity::metadata_count> AbstractHorseEntity::metadata_names{ {
         "data_id_flags",
 #if PROTOCOL_VERSION < 762 /* < 1.19.4 */
         "data_id_owner_uuid",
@@ -72,21 +72,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char AbstractHorseEntity::GetDataIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_id_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 762 /* < 1.19.4 */
     std::optional<ProtocolCraft::UUID> AbstractHorseEntity::GetDataIdOwnerUuid() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_id_owner_uuid"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_owner_uuid");
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at(index));
     }
 #endif
 
@@ -94,14 +96,16 @@ namespace Botcraft
     void AbstractHorseEntity::SetDataIdFlags(const char data_id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_flags"] = data_id_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_flags");
+        metadata[index] = data_id_flags;
     }
 
 #if PROTOCOL_VERSION < 762 /* < 1.19.4 */
     void AbstractHorseEntity::SetDataIdOwnerUuid(const std::optional<ProtocolCraft::UUID>& data_id_owner_uuid)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_owner_uuid"] = data_id_owner_uuid;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_owner_uuid");
+        metadata[index] = data_id_owner_uuid;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, HorseEntity::metadata_count> HorseEntity::metadata_names{ {
+    constexpr std::array<std::string_view, HorseEntity::metadata_count> HorseEntity::metadata_names{ {
         "data_id_type_variant",
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
         "armor_type",
@@ -70,21 +70,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int HorseEntity::GetDataIdTypeVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type_variant"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type_variant");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     std::optional<int> HorseEntity::GetArmorType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("armor_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "armor_type");
+        return std::any_cast<std::optional<int>>(metadata.at(index));
     }
 #endif
 
@@ -92,14 +94,16 @@ namespace Botcraft
     void HorseEntity::SetDataIdTypeVariant(const int data_id_type_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type_variant"] = data_id_type_variant;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type_variant");
+        metadata[index] = data_id_type_variant;
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     void HorseEntity::SetArmorType(const std::optional<int>& armor_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["armor_type"] = armor_type;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "armor_type");
+        metadata[index] = armor_type;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, LlamaEntity::metadata_count> LlamaEntity::metadata_names{ {
+    constexpr std::array<std::string_view, LlamaEntity::metadata_count> LlamaEntity::metadata_names{ {
         "data_strength_id",
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
         "data_swag_id",
@@ -78,49 +78,55 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int LlamaEntity::GetDataStrengthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_strength_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_strength_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     int LlamaEntity::GetDataSwagId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_swag_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_swag_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
     int LlamaEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void LlamaEntity::SetDataStrengthId(const int data_strength_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_strength_id"] = data_strength_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_strength_id");
+        metadata[index] = data_strength_id;
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     void LlamaEntity::SetDataSwagId(const int data_swag_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_swag_id"] = data_swag_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_swag_id");
+        metadata[index] = data_swag_id;
     }
 #endif
 
     void LlamaEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, SheepEntity::metadata_count> SheepEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SheepEntity::metadata_count> SheepEntity::metadata_names{ {
         "data_wool_id",
     } };
 
@@ -66,21 +66,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SheepEntity::GetDataWoolId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_wool_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_wool_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void SheepEntity::SetDataWoolId(const char data_wool_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_wool_id"] = data_wool_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_wool_id");
+        metadata[index] = data_wool_id;
     }
 
 
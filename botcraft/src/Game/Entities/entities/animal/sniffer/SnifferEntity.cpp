@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, SnifferEntity::metadata_count> SnifferEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SnifferEntity::metadata_count> SnifferEntity::metadata_names{ {
         "data_state",
         "data_drop_seed_at_tick",
     } };
@@ -70,7 +70,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -78,26 +78,30 @@ namespace Botcraft
     int SnifferEntity::GetDataState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_state"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_state");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int SnifferEntity::GetDataDropSeedAtTick() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_drop_seed_at_tick"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_drop_seed_at_tick");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void SnifferEntity::SetDataState(const int data_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_state"] = data_state;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_state");
+        metadata[index] = data_state;
     }
 
     void SnifferEntity::SetDataDropSeedAtTick(const int data_drop_seed_at_tick)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_drop_seed_at_tick"] = data_drop_seed_at_tick;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_drop_seed_at_tick");
+        metadata[index] = data_drop_seed_at_tick;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WolfEntity::metadata_count> WolfEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WolfEntity::metadata_count> WolfEntity::metadata_names{ {
         "data_interested_id",
         "data_collar_color",
         "data_remaining_anger_time",
@@ -81,7 +81,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -89,62 +89,72 @@ namespace Botcraft
     bool WolfEntity::GetDataInterestedId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_interested_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interested_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int WolfEntity::GetDataCollarColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_collar_color"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WolfEntity::GetDataRemainingAngerTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_remaining_anger_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WolfEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WolfEntity::GetDataSoundVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_sound_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_sound_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void WolfEntity::SetDataInterestedId(const bool data_interested_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_interested_id"] = data_interested_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_interested_id");
+        metadata[index] = data_interested_id;
     }
 
     void WolfEntity::SetDataCollarColor(const int data_collar_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_collar_color"] = data_collar_color;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_collar_color");
+        metadata[index] = data_collar_color;
     }
 
     void WolfEntity::SetDataRemainingAngerTime(const int data_remaining_anger_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_remaining_anger_time"] = data_remaining_anger_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_remaining_anger_time");
+        metadata[index] = data_remaining_anger_time;
     }
 
     void WolfEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_variant_id");
+        metadata[index] = data_variant_id;
     }
 
     void WolfEntity::SetDataSoundVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_sound_variant_id"] = data_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_sound_variant_id");
+        metadata[index] = data_variant_id;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, EndCrystalEntity::metadata_count> EndCrystalEntity::metadata_names{ {
+    constexpr std::array<std::string_view, EndCrystalEntity::metadata_count> EndCrystalEntity::metadata_names{ {
         "data_beam_target",
         "data_show_bottom",
     } };
@@ -64,33 +64,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     std::optional<Position> EndCrystalEntity::GetDataBeamTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<Position>>(metadata.at("data_beam_target"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_beam_target");
+        return std::any_cast<std::optional<Position>>(metadata.at(index));
     }
 
     bool EndCrystalEntity::GetDataShowBottom() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_show_bottom"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_show_bottom");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void EndCrystalEntity::SetDataBeamTarget(const std::optional<Position>& data_beam_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_beam_target"] = data_beam_target;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_beam_target");
+        metadata[index] = data_beam_target;
     }
 
     void EndCrystalEntity::SetDataShowBottom(const bool data_show_bottom)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_show_bottom"] = data_show_bottom;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_show_bottom");
+        metadata[index] = data_show_bottom;
     }
 
 
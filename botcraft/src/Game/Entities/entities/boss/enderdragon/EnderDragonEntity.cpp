@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, EnderDragonEntity::metadata_count> EnderDragonEntity::metadata_names{ {
+    constexpr std::array<std::string_view, EnderDragonEntity::metadata_count> EnderDragonEntity::metadata_names{ {
         "data_phase",
     } };
 
@@ -67,21 +67,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int EnderDragonEntity::GetDataPhase() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_phase"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_phase");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void EnderDragonEntity::SetDataPhase(const int data_phase)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_phase"] = data_phase;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_phase");
+        metadata[index] = data_phase;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WitherBossEntity::metadata_count> WitherBossEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WitherBossEntity::metadata_count> WitherBossEntity::metadata_names{ {
         "data_target_a",
         "data_target_b",
         "data_target_c",
@@ -79,57 +79,65 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int WitherBossEntity::GetDataTargetA() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_a"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_a");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WitherBossEntity::GetDataTargetB() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_b"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_b");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WitherBossEntity::GetDataTargetC() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_c"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_c");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int WitherBossEntity::GetDataIdInv() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_inv"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_inv");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void WitherBossEntity::SetDataTargetA(const int data_target_a)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_a"] = data_target_a;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_a");
+        metadata[index] = data_target_a;
     }
 
     void WitherBossEntity::SetDataTargetB(const int data_target_b)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_b"] = data_target_b;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_b");
+        metadata[index] = data_target_b;
     }
 
     void WitherBossEntity::SetDataTargetC(const int data_target_c)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_c"] = data_target_c;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_target_c");
+        metadata[index] = data_target_c;
     }
 
     void WitherBossEntity::SetDataIdInv(const int data_id_inv)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_inv"] = data_id_inv;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_inv");
+        metadata[index] = data_id_inv;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ArmorStandEntity::metadata_count> ArmorStandEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ArmorStandEntity::metadata_count> ArmorStandEntity::metadata_names{ {
         "data_client_flags",
         "data_head_pose",
         "data_body_pose",
@@ -84,93 +84,107 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char ArmorStandEntity::GetDataClientFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_client_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_client_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataHeadPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_head_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_head_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataBodyPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_body_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_body_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataLeftArmPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_left_arm_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_arm_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataRightArmPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_right_arm_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_arm_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataLeftLegPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_left_leg_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_leg_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
     Vector3<float> ArmorStandEntity::GetDataRightLegPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_right_leg_pose"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_leg_pose");
+        return std::any_cast<Vector3<float>>(metadata.at(index));
     }
 
 
     void ArmorStandEntity::SetDataClientFlags(const char data_client_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_client_flags"] = data_client_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_client_flags");
+        metadata[index] = data_client_flags;
     }
 
     void ArmorStandEntity::SetDataHeadPose(const Vector3<float>& data_head_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_head_pose"] = data_head_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_head_pose");
+        metadata[index] = data_head_pose;
     }
 
     void ArmorStandEntity::SetDataBodyPose(const Vector3<float>& data_body_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_body_pose"] = data_body_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_body_pose");
+        metadata[index] = data_body_pose;
     }
 
     void ArmorStandEntity::SetDataLeftArmPose(const Vector3<float>& data_left_arm_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_left_arm_pose"] = data_left_arm_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_arm_pose");
+        metadata[index] = data_left_arm_pose;
     }
 
     void ArmorStandEntity::SetDataRightArmPose(const Vector3<float>& data_right_arm_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_right_arm_pose"] = data_right_arm_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_arm_pose");
+        metadata[index] = data_right_arm_pose;
     }
 
     void ArmorStandEntity::SetDataLeftLegPose(const Vector3<float>& data_left_leg_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_left_leg_pose"] = data_left_leg_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_left_leg_pose");
+        metadata[index] = data_left_leg_pose;
     }
 
     void ArmorStandEntity::SetDataRightLegPose(const Vector3<float>& data_right_leg_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_right_leg_pose"] = data_right_leg_pose;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_right_leg_pose");
+        metadata[index] = data_right_leg_pose;
     }
 
 
@@ -9,7 +9,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 770 /* > 1.21.5 */
-    const std::array<std::string, HangingEntity::metadata_count> HangingEntity::metadata_names{ {
+    constexpr std::array<std::string_view, HangingEntity::metadata_count> HangingEntity::metadata_names{ {
         "data_direction",
     } };
 #endif
@@ -53,7 +53,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -61,14 +61,16 @@ namespace Botcraft
     int HangingEntity::GetDataDirection() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_direction"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_direction");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void HangingEntity::SetDataDirection(const int data_direction)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_direction"] = data_direction;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_direction");
+        metadata[index] = data_direction;
     }
 #endif
 
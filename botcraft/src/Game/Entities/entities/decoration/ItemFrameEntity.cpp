@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ItemFrameEntity::metadata_count> ItemFrameEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ItemFrameEntity::metadata_count> ItemFrameEntity::metadata_names{ {
         "data_item",
         "data_rotation",
     } };
@@ -64,33 +64,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ItemFrameEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        return std::any_cast<ProtocolCraft::Slot>(metadata.at(index));
     }
 
     int ItemFrameEntity::GetDataRotation() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_rotation"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_rotation");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void ItemFrameEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        metadata[index] = data_item;
     }
 
     void ItemFrameEntity::SetDataRotation(const int data_rotation)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_rotation"] = data_rotation;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_rotation");
+        metadata[index] = data_rotation;
     }
 
 
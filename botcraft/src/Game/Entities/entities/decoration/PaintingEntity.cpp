@@ -5,7 +5,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
-    const std::array<std::string, PaintingEntity::metadata_count> PaintingEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PaintingEntity::metadata_count> PaintingEntity::metadata_names{ {
         "data_painting_variant_id",
     } };
 #endif
@@ -66,21 +66,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PaintingEntity::GetDataPaintingVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_painting_variant_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_painting_variant_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void PaintingEntity::SetDataPaintingVariantId(const int data_painting_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_painting_variant_id"] = data_painting_variant_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_painting_variant_id");
+        metadata[index] = data_painting_variant_id;
     }
 #endif
 
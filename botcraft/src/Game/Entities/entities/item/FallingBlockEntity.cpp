@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FallingBlockEntity::metadata_count> FallingBlockEntity::metadata_names{ {
+    constexpr std::array<std::string_view, FallingBlockEntity::metadata_count> FallingBlockEntity::metadata_names{ {
         "data_start_pos",
     } };
 
@@ -61,21 +61,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Position FallingBlockEntity::GetDataStartPos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("data_start_pos"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_start_pos");
+        return std::any_cast<Position>(metadata.at(index));
     }
 
 
     void FallingBlockEntity::SetDataStartPos(const Position& data_start_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_start_pos"] = data_start_pos;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_start_pos");
+        metadata[index] = data_start_pos;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ItemEntity::metadata_count> ItemEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ItemEntity::metadata_count> ItemEntity::metadata_names{ {
         "data_item",
     } };
 
@@ -61,21 +61,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ItemEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        return std::any_cast<ProtocolCraft::Slot>(metadata.at(index));
     }
 
 
     void ItemEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item");
+        metadata[index] = data_item;
     }
 
 
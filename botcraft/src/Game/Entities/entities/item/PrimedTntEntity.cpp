@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PrimedTntEntity::metadata_count> PrimedTntEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PrimedTntEntity::metadata_count> PrimedTntEntity::metadata_names{ {
         "data_fuse_id",
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
         "data_block_state_id",
@@ -72,21 +72,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PrimedTntEntity::GetDataFuseId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_fuse_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_fuse_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
     int PrimedTntEntity::GetDataBlockStateId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_block_state_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_block_state_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -94,14 +96,16 @@ namespace Botcraft
     void PrimedTntEntity::SetDataFuseId(const int data_fuse_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_fuse_id"] = data_fuse_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_fuse_id");
+        metadata[index] = data_fuse_id;
     }
 
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
     void PrimedTntEntity::SetDataBlockStateId(const int data_block_state_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_block_state_id"] = data_block_state_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_block_state_id");
+        metadata[index] = data_block_state_id;
     }
 #endif
 
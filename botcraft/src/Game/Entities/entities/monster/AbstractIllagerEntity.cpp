@@ -5,7 +5,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
-    const std::array<std::string, AbstractIllagerEntity::metadata_count> AbstractIllagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractIllagerEntity::metadata_count> AbstractIllagerEntity::metadata_names{ {
         "has_target",
     } };
 #endif
@@ -48,20 +48,22 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char AbstractIllagerEntity::GetHasTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("has_target"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "has_target");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     void AbstractIllagerEntity::SetHasTarget(const char has_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["has_target"] = has_target;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "has_target");
+        metadata[index] = has_target;
     }
 #endif
 
@@ -5,7 +5,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
-    const std::array<std::string, AbstractSkeletonEntity::metadata_count> AbstractSkeletonEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractSkeletonEntity::metadata_count> AbstractSkeletonEntity::metadata_names{ {
         "is_swinging_arms",
     } };
 #endif
@@ -52,21 +52,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractSkeletonEntity::GetIsSwingingArms() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_swinging_arms"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_swinging_arms");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AbstractSkeletonEntity::SetIsSwingingArms(const bool is_swinging_arms)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_swinging_arms"] = is_swinging_arms;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_swinging_arms");
+        metadata[index] = is_swinging_arms;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, BoggedEntity::metadata_count> BoggedEntity::metadata_names{ {
+    constexpr std::array<std::string_view, BoggedEntity::metadata_count> BoggedEntity::metadata_names{ {
         "data_sheared",
     } };
 
@@ -65,21 +65,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool BoggedEntity::GetDataSheared() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_sheared"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_sheared");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void BoggedEntity::SetDataSheared(const bool data_sheared)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_sheared"] = data_sheared;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_sheared");
+        metadata[index] = data_sheared;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, CreeperEntity::metadata_count> CreeperEntity::metadata_names{ {
+    constexpr std::array<std::string_view, CreeperEntity::metadata_count> CreeperEntity::metadata_names{ {
         "data_swell_dir",
         "data_is_powered",
         "data_is_ignited",
@@ -70,45 +70,51 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int CreeperEntity::GetDataSwellDir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_swell_dir"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_swell_dir");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool CreeperEntity::GetDataIsPowered() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_powered"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_powered");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool CreeperEntity::GetDataIsIgnited() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_ignited"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_ignited");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void CreeperEntity::SetDataSwellDir(const int data_swell_dir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_swell_dir"] = data_swell_dir;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_swell_dir");
+        metadata[index] = data_swell_dir;
     }
 
     void CreeperEntity::SetDataIsPowered(const bool data_is_powered)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_powered"] = data_is_powered;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_powered");
+        metadata[index] = data_is_powered;
     }
 
     void CreeperEntity::SetDataIsIgnited(const bool data_is_ignited)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_ignited"] = data_is_ignited;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_ignited");
+        metadata[index] = data_is_ignited;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, EnderManEntity::metadata_count> EnderManEntity::metadata_names{ {
+    constexpr std::array<std::string_view, EnderManEntity::metadata_count> EnderManEntity::metadata_names{ {
         "data_carry_state",
         "data_creepy",
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
@@ -82,27 +82,30 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int EnderManEntity::GetDataCarryState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_carry_state"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_carry_state");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool EnderManEntity::GetDataCreepy() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_creepy"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_creepy");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     bool EnderManEntity::GetDataStaredAt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_stared_at"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stared_at");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -110,20 +113,23 @@ namespace Botcraft
     void EnderManEntity::SetDataCarryState(const int data_carry_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_carry_state"] = data_carry_state;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_carry_state");
+        metadata[index] = data_carry_state;
     }
 
     void EnderManEntity::SetDataCreepy(const bool data_creepy)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_creepy"] = data_creepy;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_creepy");
+        metadata[index] = data_creepy;
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     void EnderManEntity::SetDataStaredAt(const bool data_stared_at)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_stared_at"] = data_stared_at;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stared_at");
+        metadata[index] = data_stared_at;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, GhastEntity::metadata_count> GhastEntity::metadata_names{ {
+    constexpr std::array<std::string_view, GhastEntity::metadata_count> GhastEntity::metadata_names{ {
         "data_is_charging",
     } };
 
@@ -81,21 +81,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GhastEntity::GetDataIsCharging() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_charging"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_charging");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void GhastEntity::SetDataIsCharging(const bool data_is_charging)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_charging"] = data_is_charging;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_is_charging");
+        metadata[index] = data_is_charging;
     }
 
 
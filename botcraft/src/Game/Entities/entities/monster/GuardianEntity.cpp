@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, GuardianEntity::metadata_count> GuardianEntity::metadata_names{ {
+    constexpr std::array<std::string_view, GuardianEntity::metadata_count> GuardianEntity::metadata_names{ {
         "data_id_moving",
         "data_id_attack_target",
     } };
@@ -72,33 +72,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GuardianEntity::GetDataIdMoving() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_moving"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_moving");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int GuardianEntity::GetDataIdAttackTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_attack_target"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_attack_target");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void GuardianEntity::SetDataIdMoving(const bool data_id_moving)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_moving"] = data_id_moving;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_moving");
+        metadata[index] = data_id_moving;
     }
 
     void GuardianEntity::SetDataIdAttackTarget(const int data_id_attack_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_attack_target"] = data_id_attack_target;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_attack_target");
+        metadata[index] = data_id_attack_target;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PhantomEntity::metadata_count> PhantomEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PhantomEntity::metadata_count> PhantomEntity::metadata_names{ {
         "id_size",
     } };
 
@@ -70,21 +70,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PhantomEntity::GetIdSize() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("id_size"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_size");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void PhantomEntity::SetIdSize(const int id_size)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_size"] = id_size;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_size");
+        metadata[index] = id_size;
     }
 
 
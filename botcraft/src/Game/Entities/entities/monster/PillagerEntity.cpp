@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, PillagerEntity::metadata_count> PillagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, PillagerEntity::metadata_count> PillagerEntity::metadata_names{ {
         "is_charging_crossbow",
     } };
 
@@ -68,21 +68,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool PillagerEntity::GetIsChargingCrossbow() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_charging_crossbow"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_charging_crossbow");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void PillagerEntity::SetIsChargingCrossbow(const bool is_charging_crossbow)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_charging_crossbow"] = is_charging_crossbow;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_charging_crossbow");
+        metadata[index] = is_charging_crossbow;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ShulkerEntity::metadata_count> ShulkerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ShulkerEntity::metadata_count> ShulkerEntity::metadata_names{ {
         "data_attach_face_id",
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
         "data_attach_pos_id",
@@ -79,61 +79,69 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Direction ShulkerEntity::GetDataAttachFaceId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Direction>(metadata.at("data_attach_face_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attach_face_id");
+        return std::any_cast<Direction>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
     std::optional<Position> ShulkerEntity::GetDataAttachPosId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<Position>>(metadata.at("data_attach_pos_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attach_pos_id");
+        return std::any_cast<std::optional<Position>>(metadata.at(index));
     }
 #endif
 
     char ShulkerEntity::GetDataPeekId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_peek_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_peek_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
     char ShulkerEntity::GetDataColorId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_color_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_color_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void ShulkerEntity::SetDataAttachFaceId(const Direction data_attach_face_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attach_face_id"] = data_attach_face_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attach_face_id");
+        metadata[index] = data_attach_face_id;
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
     void ShulkerEntity::SetDataAttachPosId(const std::optional<Position>& data_attach_pos_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attach_pos_id"] = data_attach_pos_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attach_pos_id");
+        metadata[index] = data_attach_pos_id;
     }
 #endif
 
     void ShulkerEntity::SetDataPeekId(const char data_peek_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_peek_id"] = data_peek_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_peek_id");
+        metadata[index] = data_peek_id;
     }
 
     void ShulkerEntity::SetDataColorId(const char data_color_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_color_id"] = data_color_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_color_id");
+        metadata[index] = data_color_id;
     }
 
 
@@ -5,7 +5,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
-    const std::array<std::string, SkeletonEntity::metadata_count> SkeletonEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SkeletonEntity::metadata_count> SkeletonEntity::metadata_names{ {
         "data_stray_conversion_id",
     } };
 #endif
@@ -66,21 +66,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool SkeletonEntity::GetDataStrayConversionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_stray_conversion_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stray_conversion_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void SkeletonEntity::SetDataStrayConversionId(const bool data_stray_conversion_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_stray_conversion_id"] = data_stray_conversion_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_stray_conversion_id");
+        metadata[index] = data_stray_conversion_id;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, SlimeEntity::metadata_count> SlimeEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SlimeEntity::metadata_count> SlimeEntity::metadata_names{ {
         "id_size",
     } };
 
@@ -66,9 +66,8 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            const std::string& metadata_name = metadata_names[index - hierarchy_metadata_count];
-            metadata[metadata_name] = value;
-            if (metadata_name == "id_size")
+            metadata[index] = value;
+            if (index == hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_size"))
             {
                 SizeChanged(std::any_cast<int>(value));
 #if USE_GUI
@@ -88,7 +87,8 @@ namespace Botcraft
     void SlimeEntity::SetIdSize(const int id_size)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_size"] = id_size;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_size");
+        metadata[index] = id_size;
         SizeChanged(id_size);
 #if USE_GUI
         OnSizeUpdated();
@@ -97,7 +97,8 @@ namespace Botcraft
 
     int SlimeEntity::GetIdSizeImpl() const
     {
-        return std::any_cast<int>(metadata.at("id_size"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_size");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     void SlimeEntity::SizeChanged(const int new_size)
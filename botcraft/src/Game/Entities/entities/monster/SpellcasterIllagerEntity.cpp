@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, SpellcasterIllagerEntity::metadata_count> SpellcasterIllagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, SpellcasterIllagerEntity::metadata_count> SpellcasterIllagerEntity::metadata_names{ {
         "data_spell_casting_id",
     } };
 
@@ -44,21 +44,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SpellcasterIllagerEntity::GetDataSpellCastingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_spell_casting_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_spell_casting_id");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 
     void SpellcasterIllagerEntity::SetDataSpellCastingId(const char data_spell_casting_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_spell_casting_id"] = data_spell_casting_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_spell_casting_id");
+        metadata[index] = data_spell_casting_id;
     }
 
 }
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, StriderEntity::metadata_count> StriderEntity::metadata_names{ {
+    constexpr std::array<std::string_view, StriderEntity::metadata_count> StriderEntity::metadata_names{ {
         "data_boost_time",
         "data_suffocating",
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
@@ -80,27 +80,30 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int StriderEntity::GetDataBoostTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_boost_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_boost_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool StriderEntity::GetDataSuffocating() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_suffocating"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_suffocating");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     bool StriderEntity::GetDataSaddleId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_saddle_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_saddle_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -108,20 +111,23 @@ namespace Botcraft
     void StriderEntity::SetDataBoostTime(const int data_boost_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_boost_time"] = data_boost_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_boost_time");
+        metadata[index] = data_boost_time;
     }
 
     void StriderEntity::SetDataSuffocating(const bool data_suffocating)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_suffocating"] = data_suffocating;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_suffocating");
+        metadata[index] = data_suffocating;
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     void StriderEntity::SetDataSaddleId(const bool data_saddle_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_saddle_id"] = data_saddle_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_saddle_id");
+        metadata[index] = data_saddle_id;
     }
 #endif
 
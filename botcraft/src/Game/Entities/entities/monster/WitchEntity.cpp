@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WitchEntity::metadata_count> WitchEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WitchEntity::metadata_count> WitchEntity::metadata_names{ {
         "data_using_item",
     } };
 
@@ -73,21 +73,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool WitchEntity::GetDataUsingItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_using_item"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_using_item");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void WitchEntity::SetDataUsingItem(const bool data_using_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_using_item"] = data_using_item;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_using_item");
+        metadata[index] = data_using_item;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ZoglinEntity::metadata_count> ZoglinEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ZoglinEntity::metadata_count> ZoglinEntity::metadata_names{ {
         "data_baby_id",
     } };
 
@@ -69,21 +69,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool ZoglinEntity::GetDataBabyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_baby_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void ZoglinEntity::SetDataBabyId(const bool data_baby_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_baby_id"] = data_baby_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        metadata[index] = data_baby_id;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ZombieEntity::metadata_count> ZombieEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ZombieEntity::metadata_count> ZombieEntity::metadata_names{ {
         "data_baby_id",
         "data_special_type_id",
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
@@ -91,27 +91,30 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool ZombieEntity::GetDataBabyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_baby_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int ZombieEntity::GetDataSpecialTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_special_type_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_special_type_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     bool ZombieEntity::GetDataAreHandsUp() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_are_hands_up"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_are_hands_up");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -119,7 +122,8 @@ namespace Botcraft
     bool ZombieEntity::GetDataDrownedConversionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_drowned_conversion_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_drowned_conversion_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -127,20 +131,23 @@ namespace Botcraft
     void ZombieEntity::SetDataBabyId(const bool data_baby_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_baby_id"] = data_baby_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_baby_id");
+        metadata[index] = data_baby_id;
     }
 
     void ZombieEntity::SetDataSpecialTypeId(const int data_special_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_special_type_id"] = data_special_type_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_special_type_id");
+        metadata[index] = data_special_type_id;
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     void ZombieEntity::SetDataAreHandsUp(const bool data_are_hands_up)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_are_hands_up"] = data_are_hands_up;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_are_hands_up");
+        metadata[index] = data_are_hands_up;
     }
 #endif
 
@@ -148,7 +155,8 @@ namespace Botcraft
     void ZombieEntity::SetDataDrownedConversionId(const bool data_drowned_conversion_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_drowned_conversion_id"] = data_drowned_conversion_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_drowned_conversion_id");
+        metadata[index] = data_drowned_conversion_id;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ZombieVillagerEntity::metadata_count> ZombieVillagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ZombieVillagerEntity::metadata_count> ZombieVillagerEntity::metadata_names{ {
         "data_converting_id",
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         "data_villager_data",
@@ -76,27 +76,30 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool ZombieVillagerEntity::GetDataConvertingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_converting_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_converting_id");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     VillagerData ZombieVillagerEntity::GetDataVillagerData() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<VillagerData>(metadata.at("data_villager_data"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_data");
+        return std::any_cast<VillagerData>(metadata.at(index));
     }
 #else
     int ZombieVillagerEntity::GetDataVillagerProfessionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_villager_profession_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_profession_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -104,20 +107,23 @@ namespace Botcraft
     void ZombieVillagerEntity::SetDataConvertingId(const bool data_converting_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_converting_id"] = data_converting_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_converting_id");
+        metadata[index] = data_converting_id;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     void ZombieVillagerEntity::SetDataVillagerData(const VillagerData& data_villager_data)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_data"] = data_villager_data;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_data");
+        metadata[index] = data_villager_data;
     }
 #else
     void ZombieVillagerEntity::SetDataVillagerProfessionId(const int data_villager_profession_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_profession_id"] = data_villager_profession_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_profession_id");
+        metadata[index] = data_villager_profession_id;
     }
 #endif
 
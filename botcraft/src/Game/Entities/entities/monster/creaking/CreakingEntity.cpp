@@ -5,12 +5,12 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, CreakingEntity::metadata_count> CreakingEntity::metadata_names{ {
+    constexpr std::array<std::string_view, CreakingEntity::metadata_count> CreakingEntity::metadata_names{ {
         "can_move",
         "is_active",
 #if PROTOCOL_VERSION > 768 /* > 1.21.3 */
         "is_tearing_down",
-        "home_pose",
+        "home_pos",
 #endif
     } };
 
@@ -91,33 +91,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool CreakingEntity::GetCanMove() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("can_move"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "can_move");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool CreakingEntity::GetIsActive() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_active"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_active");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 768 /* > 1.21.3 */
     bool CreakingEntity::GetIsTearingDown() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_tearing_down"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_tearing_down");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     const std::optional<Position>& CreakingEntity::GetHomePos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<const std::optional<Position>&>(metadata.at("home_pos"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "home_pos");
+        return std::any_cast<const std::optional<Position>&>(metadata.at(index));
     }
 #endif
 
@@ -125,26 +129,30 @@ namespace Botcraft
     void CreakingEntity::SetCanMove(const bool can_move)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["can_move"] = can_move;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "can_move");
+        metadata[index] = can_move;
     }
 
     void CreakingEntity::SetIsActive(const bool is_active)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_active"] = is_active;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_active");
+        metadata[index] = is_active;
     }
 
 #if PROTOCOL_VERSION > 768 /* > 1.21.3 */
     void CreakingEntity::SetIsTearingDown(const bool is_tearing_down)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_tearing_down"] = is_tearing_down;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_tearing_down");
+        metadata[index] = is_tearing_down;
     }
 
     void CreakingEntity::SetHomePos(const std::optional<Position>& home_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["home_pos"] = home_pos;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "home_pos");
+        metadata[index] = home_pos;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractPiglinEntity::metadata_count> AbstractPiglinEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractPiglinEntity::metadata_count> AbstractPiglinEntity::metadata_names{ {
         "data_immune_to_zombification",
     } };
 
@@ -45,21 +45,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractPiglinEntity::GetDataImmuneToZombification() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_immune_to_zombification"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_immune_to_zombification");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void AbstractPiglinEntity::SetDataImmuneToZombification(const bool data_immune_to_zombification)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_immune_to_zombification"] = data_immune_to_zombification;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_immune_to_zombification");
+        metadata[index] = data_immune_to_zombification;
     }
 
 }
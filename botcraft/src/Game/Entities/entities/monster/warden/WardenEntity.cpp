@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WardenEntity::metadata_count> WardenEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WardenEntity::metadata_count> WardenEntity::metadata_names{ {
         "client_anger_level",
     } };
 
@@ -72,21 +72,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int WardenEntity::GetClientAngerLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("client_anger_level"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "client_anger_level");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void WardenEntity::SetClientAngerLevel(const int client_anger_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["client_anger_level"] = client_anger_level;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "client_anger_level");
+        metadata[index] = client_anger_level;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractVillagerEntity::metadata_count> AbstractVillagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractVillagerEntity::metadata_count> AbstractVillagerEntity::metadata_names{ {
         "data_unhappy_counter",
     } };
 
@@ -45,21 +45,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int AbstractVillagerEntity::GetDataUnhappyCounter() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_unhappy_counter"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_unhappy_counter");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void AbstractVillagerEntity::SetDataUnhappyCounter(const int data_unhappy_counter)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_unhappy_counter"] = data_unhappy_counter;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_unhappy_counter");
+        metadata[index] = data_unhappy_counter;
     }
 
 }
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, VillagerEntity::metadata_count> VillagerEntity::metadata_names{ {
+    constexpr std::array<std::string_view, VillagerEntity::metadata_count> VillagerEntity::metadata_names{ {
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         "data_villager_data",
 #else
@@ -87,7 +87,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -95,27 +95,31 @@ namespace Botcraft
     VillagerData VillagerEntity::GetDataVillagerData() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<VillagerData>(metadata.at("data_villager_data"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_data");
+        return std::any_cast<VillagerData>(metadata.at(index));
     }
 
 
     void VillagerEntity::SetDataVillagerData(const VillagerData& data_villager_data)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_data"] = data_villager_data;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_data");
+        metadata[index] = data_villager_data;
     }
 #else
     int VillagerEntity::GetDataVillagerProfessionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_villager_profession_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_profession_id");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void VillagerEntity::SetDataVillagerProfessionId(const int data_villager_profession_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_profession_id"] = data_villager_profession_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_villager_profession_id");
+        metadata[index] = data_villager_profession_id;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractArrowEntity::metadata_count> AbstractArrowEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractArrowEntity::metadata_count> AbstractArrowEntity::metadata_names{ {
         "id_flags",
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
         "data_owneruuid_id",
@@ -79,21 +79,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char AbstractArrowEntity::GetIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("id_flags"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_flags");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
     std::optional<ProtocolCraft::UUID> AbstractArrowEntity::GetDataOwneruuidId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_owneruuid_id"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_owneruuid_id");
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at(index));
     }
 #endif
 
@@ -101,7 +103,8 @@ namespace Botcraft
     char AbstractArrowEntity::GetPierceLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("pierce_level"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "pierce_level");
+        return std::any_cast<char>(metadata.at(index));
     }
 #endif
 
@@ -109,7 +112,8 @@ namespace Botcraft
     bool AbstractArrowEntity::GetInGround() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("in_ground"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "in_ground");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -117,14 +121,16 @@ namespace Botcraft
     void AbstractArrowEntity::SetIdFlags(const char id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_flags"] = id_flags;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_flags");
+        metadata[index] = id_flags;
     }
 
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
     void AbstractArrowEntity::SetDataOwneruuidId(const std::optional<ProtocolCraft::UUID>& data_owneruuid_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_owneruuid_id"] = data_owneruuid_id;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_owneruuid_id");
+        metadata[index] = data_owneruuid_id;
     }
 #endif
 
@@ -132,7 +138,8 @@ namespace Botcraft
     void AbstractArrowEntity::SetPierceLevel(const char pierce_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["pierce_level"] = pierce_level;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "pierce_level");
+        metadata[index] = pierce_level;
     }
 #endif
 
@@ -140,7 +147,8 @@ namespace Botcraft
     void AbstractArrowEntity::SetInGround(const bool in_ground)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["in_ground"] = in_ground;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "in_ground");
+        metadata[index] = in_ground;
     }
 #endif
 
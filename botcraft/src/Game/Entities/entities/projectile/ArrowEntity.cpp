@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ArrowEntity::metadata_count> ArrowEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ArrowEntity::metadata_count> ArrowEntity::metadata_names{ {
         "id_effect_color",
     } };
 
@@ -61,21 +61,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ArrowEntity::GetIdEffectColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("id_effect_color"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_effect_color");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void ArrowEntity::SetIdEffectColor(const int id_effect_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_effect_color"] = id_effect_color;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_effect_color");
+        metadata[index] = id_effect_color;
     }
 
 
@@ -8,7 +8,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FireworkRocketEntity::metadata_count> FireworkRocketEntity::metadata_names{ {
+    constexpr std::array<std::string_view, FireworkRocketEntity::metadata_count> FireworkRocketEntity::metadata_names{ {
         "data_id_fireworks_item",
         "data_attached_to_target",
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -98,33 +98,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot FireworkRocketEntity::GetDataIdFireworksItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_id_fireworks_item"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_fireworks_item");
+        return std::any_cast<ProtocolCraft::Slot>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     std::optional<int> FireworkRocketEntity::GetDataAttachedToTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_attached_to_target"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attached_to_target");
+        return std::any_cast<std::optional<int>>(metadata.at(index));
     }
 
     bool FireworkRocketEntity::GetDataShotAtAngle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_shot_at_angle"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shot_at_angle");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #else
     int FireworkRocketEntity::GetDataAttachedToTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_attached_to_target"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attached_to_target");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -132,26 +136,30 @@ namespace Botcraft
     void FireworkRocketEntity::SetDataIdFireworksItem(const ProtocolCraft::Slot& data_id_fireworks_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_fireworks_item"] = data_id_fireworks_item;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_fireworks_item");
+        metadata[index] = data_id_fireworks_item;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     void FireworkRocketEntity::SetDataAttachedToTarget(const std::optional<int>& data_attached_to_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attached_to_target"] = data_attached_to_target;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attached_to_target");
+        metadata[index] = data_attached_to_target;
     }
 
     void FireworkRocketEntity::SetDataShotAtAngle(const bool data_shot_at_angle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shot_at_angle"] = data_shot_at_angle;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_shot_at_angle");
+        metadata[index] = data_shot_at_angle;
     }
 #else
     void FireworkRocketEntity::SetDataAttachedToTarget(const int data_attached_to_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attached_to_target"] = data_attached_to_target;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_attached_to_target");
+        metadata[index] = data_attached_to_target;
     }
 #endif
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FishingHookEntity::metadata_count> FishingHookEntity::metadata_names{ {
+    constexpr std::array<std::string_view, FishingHookEntity::metadata_count> FishingHookEntity::metadata_names{ {
         "data_hooked_entity",
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
         "data_biting",
@@ -77,21 +77,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int FishingHookEntity::GetDataHookedEntity() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_hooked_entity"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_hooked_entity");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     bool FishingHookEntity::GetDataBiting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_biting"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_biting");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -99,14 +101,16 @@ namespace Botcraft
     void FishingHookEntity::SetDataHookedEntity(const int data_hooked_entity)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_hooked_entity"] = data_hooked_entity;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_hooked_entity");
+        metadata[index] = data_hooked_entity;
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     void FishingHookEntity::SetDataBiting(const bool data_biting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_biting"] = data_biting;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_biting");
+        metadata[index] = data_biting;
     }
 #endif
 
@@ -12,7 +12,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION < 579 /* < 1.16 */
-    const std::array<std::string, ThrownPotionEntity::metadata_count> ThrownPotionEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ThrownPotionEntity::metadata_count> ThrownPotionEntity::metadata_names{ {
         "data_item_stack",
     } };
 #endif
@@ -80,21 +80,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ThrownPotionEntity::GetDataItemStack() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item_stack"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_stack");
+        return std::any_cast<ProtocolCraft::Slot>(metadata.at(index));
     }
 
 
     void ThrownPotionEntity::SetDataItemStack(const ProtocolCraft::Slot& data_item_stack)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack"] = data_item_stack;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_item_stack");
+        metadata[index] = data_item_stack;
     }
 #endif
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, ThrownTridentEntity::metadata_count> ThrownTridentEntity::metadata_names{ {
+    constexpr std::array<std::string_view, ThrownTridentEntity::metadata_count> ThrownTridentEntity::metadata_names{ {
         "id_loyalty",
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
         "id_foil",
@@ -71,21 +71,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char ThrownTridentEntity::GetIdLoyalty() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("id_loyalty"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_loyalty");
+        return std::any_cast<char>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     bool ThrownTridentEntity::GetIdFoil() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("id_foil"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_foil");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -93,14 +95,16 @@ namespace Botcraft
     void ThrownTridentEntity::SetIdLoyalty(const char id_loyalty)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_loyalty"] = id_loyalty;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_loyalty");
+        metadata[index] = id_loyalty;
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     void ThrownTridentEntity::SetIdFoil(const bool id_foil)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_foil"] = id_foil;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "id_foil");
+        metadata[index] = id_foil;
     }
 #endif
 
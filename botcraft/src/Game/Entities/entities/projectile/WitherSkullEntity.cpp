@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, WitherSkullEntity::metadata_count> WitherSkullEntity::metadata_names{ {
+    constexpr std::array<std::string_view, WitherSkullEntity::metadata_count> WitherSkullEntity::metadata_names{ {
         "data_dangerous",
     } };
 
@@ -61,21 +61,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool WitherSkullEntity::GetDataDangerous() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_dangerous"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dangerous");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void WitherSkullEntity::SetDataDangerous(const bool data_dangerous)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dangerous"] = data_dangerous;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_dangerous");
+        metadata[index] = data_dangerous;
     }
 
 
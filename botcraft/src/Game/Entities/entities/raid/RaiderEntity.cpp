@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, RaiderEntity::metadata_count> RaiderEntity::metadata_names{ {
+    constexpr std::array<std::string_view, RaiderEntity::metadata_count> RaiderEntity::metadata_names{ {
         "is_celebrating",
     } };
 
@@ -45,21 +45,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool RaiderEntity::GetIsCelebrating() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_celebrating"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_celebrating");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void RaiderEntity::SetIsCelebrating(const bool is_celebrating)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_celebrating"] = is_celebrating;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "is_celebrating");
+        metadata[index] = is_celebrating;
     }
 
 }
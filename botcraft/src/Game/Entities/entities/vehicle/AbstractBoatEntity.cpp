@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractBoatEntity::metadata_count> AbstractBoatEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractBoatEntity::metadata_count> AbstractBoatEntity::metadata_names{ {
         "data_id_paddle_left",
         "data_id_paddle_right",
         "data_id_bubble_time",
@@ -53,45 +53,51 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractBoatEntity::GetDataIdPaddleLeft() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_left"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_left");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool AbstractBoatEntity::GetDataIdPaddleRight() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_right"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_right");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     int AbstractBoatEntity::GetDataIdBubbleTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_bubble_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_bubble_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 
     void AbstractBoatEntity::SetDataIdPaddleLeft(const bool data_id_paddle_left)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_left"] = data_id_paddle_left;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_left");
+        metadata[index] = data_id_paddle_left;
     }
 
     void AbstractBoatEntity::SetDataIdPaddleRight(const bool data_id_paddle_right)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_right"] = data_id_paddle_right;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_right");
+        metadata[index] = data_id_paddle_right;
     }
 
     void AbstractBoatEntity::SetDataIdBubbleTime(const int data_id_bubble_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_bubble_time"] = data_id_bubble_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_bubble_time");
+        metadata[index] = data_id_bubble_time;
     }
 }
 #endif
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractMinecartEntity::metadata_count> AbstractMinecartEntity::metadata_names{ {
+    constexpr std::array<std::string_view, AbstractMinecartEntity::metadata_count> AbstractMinecartEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         "data_id_hurt",
         "data_id_hurtdir",
@@ -91,7 +91,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -99,19 +99,22 @@ namespace Botcraft
     int AbstractMinecartEntity::GetDataIdHurt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurt"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int AbstractMinecartEntity::GetDataIdHurtdir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurtdir"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     float AbstractMinecartEntity::GetDataIdDamage() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_id_damage"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        return std::any_cast<float>(metadata.at(index));
     }
 #endif
 
@@ -119,27 +122,31 @@ namespace Botcraft
     int AbstractMinecartEntity::GetDataIdDisplayBlock() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_display_block"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_display_block");
+        return std::any_cast<int>(metadata.at(index));
     }
 #else
     int AbstractMinecartEntity::GetDataIdCustomDisplayBlock() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_custom_display_block"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_custom_display_block");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
     int AbstractMinecartEntity::GetDataIdDisplayOffset() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_display_offset"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_display_offset");
+        return std::any_cast<int>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     bool AbstractMinecartEntity::GetDataIdCustomDisplay() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_custom_display"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_custom_display");
+        return std::any_cast<bool>(metadata.at(index));
     }
 #endif
 
@@ -148,19 +155,22 @@ namespace Botcraft
     void AbstractMinecartEntity::SetDataIdHurt(const int data_id_hurt)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurt"] = data_id_hurt;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        metadata[index] = data_id_hurt;
     }
 
     void AbstractMinecartEntity::SetDataIdHurtdir(const int data_id_hurtdir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurtdir"] = data_id_hurtdir;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        metadata[index] = data_id_hurtdir;
     }
 
     void AbstractMinecartEntity::SetDataIdDamage(const float data_id_damage)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_damage"] = data_id_damage;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        metadata[index] = data_id_damage;
     }
 #endif
 
@@ -168,27 +178,31 @@ namespace Botcraft
     void AbstractMinecartEntity::SetDataIdDisplayBlock(const int data_id_display_block)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_display_block"] = data_id_display_block;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_display_block");
+        metadata[index] = data_id_display_block;
     }
 #else
     void AbstractMinecartEntity::SetDataIdCustomDisplayBlock(const int data_id_custom_display_block)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_custom_display_block"] = data_id_custom_display_block;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_custom_display_block");
+        metadata[index] = data_id_custom_display_block;
     }
 #endif
 
     void AbstractMinecartEntity::SetDataIdDisplayOffset(const int data_id_display_offset)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_display_offset"] = data_id_display_offset;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_display_offset");
+        metadata[index] = data_id_display_offset;
     }
 
 #if PROTOCOL_VERSION < 770 /* < 1.21.5 */
     void AbstractMinecartEntity::SetDataIdCustomDisplay(const bool data_id_custom_display)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_custom_display"] = data_id_custom_display;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_custom_display");
+        metadata[index] = data_id_custom_display;
     }
 #endif
 
@@ -7,7 +7,7 @@
 namespace Botcraft
 {
 #if PROTOCOL_VERSION < 768 /* < 1.21.2 */
-    const std::array<std::string, BoatEntity::metadata_count> BoatEntity::metadata_names{ {
+    constexpr std::array<std::string_view, BoatEntity::metadata_count> BoatEntity::metadata_names{ {
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         "data_id_hurt",
         "data_id_hurtdir",
@@ -127,7 +127,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -135,45 +135,52 @@ namespace Botcraft
     int BoatEntity::GetDataIdHurt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurt"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int BoatEntity::GetDataIdHurtdir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurtdir"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     float BoatEntity::GetDataIdDamage() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_id_damage"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        return std::any_cast<float>(metadata.at(index));
     }
 #endif
 
     int BoatEntity::GetDataIdType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     bool BoatEntity::GetDataIdPaddleLeft() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_left"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_left");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
     bool BoatEntity::GetDataIdPaddleRight() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_right"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_right");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     int BoatEntity::GetDataIdBubbleTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_bubble_time"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_bubble_time");
+        return std::any_cast<int>(metadata.at(index));
     }
 #endif
 
@@ -182,45 +189,52 @@ namespace Botcraft
     void BoatEntity::SetDataIdHurt(const int data_id_hurt)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurt"] = data_id_hurt;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        metadata[index] = data_id_hurt;
     }
 
     void BoatEntity::SetDataIdHurtdir(const int data_id_hurtdir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurtdir"] = data_id_hurtdir;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        metadata[index] = data_id_hurtdir;
     }
 
     void BoatEntity::SetDataIdDamage(const float data_id_damage)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_damage"] = data_id_damage;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        metadata[index] = data_id_damage;
     }
 #endif
 
     void BoatEntity::SetDataIdType(const int data_id_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type"] = data_id_type;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_type");
+        metadata[index] = data_id_type;
     }
 
     void BoatEntity::SetDataIdPaddleLeft(const bool data_id_paddle_left)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_left"] = data_id_paddle_left;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_left");
+        metadata[index] = data_id_paddle_left;
     }
 
     void BoatEntity::SetDataIdPaddleRight(const bool data_id_paddle_right)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_right"] = data_id_paddle_right;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_paddle_right");
+        metadata[index] = data_id_paddle_right;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void BoatEntity::SetDataIdBubbleTime(const int data_id_bubble_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_bubble_time"] = data_id_bubble_time;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_bubble_time");
+        metadata[index] = data_id_bubble_time;
     }
 #endif
 #endif
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, MinecartCommandBlockEntity::metadata_count> MinecartCommandBlockEntity::metadata_names{ {
+    constexpr std::array<std::string_view, MinecartCommandBlockEntity::metadata_count> MinecartCommandBlockEntity::metadata_names{ {
         "data_id_command_name",
         "data_id_last_output",
     } };
@@ -64,33 +64,37 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     std::string MinecartCommandBlockEntity::GetDataIdCommandName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_id_command_name"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_command_name");
+        return std::any_cast<std::string>(metadata.at(index));
     }
 
     ProtocolCraft::Chat MinecartCommandBlockEntity::GetDataIdLastOutput() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Chat>(metadata.at("data_id_last_output"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_last_output");
+        return std::any_cast<ProtocolCraft::Chat>(metadata.at(index));
     }
 
 
     void MinecartCommandBlockEntity::SetDataIdCommandName(const std::string& data_id_command_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_command_name"] = data_id_command_name;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_command_name");
+        metadata[index] = data_id_command_name;
     }
 
     void MinecartCommandBlockEntity::SetDataIdLastOutput(const ProtocolCraft::Chat& data_id_last_output)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_last_output"] = data_id_last_output;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_last_output");
+        metadata[index] = data_id_last_output;
     }
 
 
@@ -4,7 +4,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, MinecartFurnaceEntity::metadata_count> MinecartFurnaceEntity::metadata_names{ {
+    constexpr std::array<std::string_view, MinecartFurnaceEntity::metadata_count> MinecartFurnaceEntity::metadata_names{ {
         "data_id_fuel",
     } };
 
@@ -61,21 +61,23 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool MinecartFurnaceEntity::GetDataIdFuel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_fuel"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_fuel");
+        return std::any_cast<bool>(metadata.at(index));
     }
 
 
     void MinecartFurnaceEntity::SetDataIdFuel(const bool data_id_fuel)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_fuel"] = data_id_fuel;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_fuel");
+        metadata[index] = data_id_fuel;
     }
 
 
@@ -5,7 +5,7 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, VehicleEntity::metadata_count> VehicleEntity::metadata_names{ {
+    constexpr std::array<std::string_view, VehicleEntity::metadata_count> VehicleEntity::metadata_names{ {
         "data_id_hurt",
         "data_id_hurtdir",
         "data_id_damage",
@@ -51,45 +51,51 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int VehicleEntity::GetDataIdHurt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurt"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     int VehicleEntity::GetDataIdHurtdir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurtdir"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        return std::any_cast<int>(metadata.at(index));
     }
 
     float VehicleEntity::GetDataIdDamage() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_id_damage"));
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        return std::any_cast<float>(metadata.at(index));
     }
 
 
     void VehicleEntity::SetDataIdHurt(const int data_id_hurt)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurt"] = data_id_hurt;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurt");
+        metadata[index] = data_id_hurt;
     }
 
     void VehicleEntity::SetDataIdHurtdir(const int data_id_hurtdir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurtdir"] = data_id_hurtdir;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_hurtdir");
+        metadata[index] = data_id_hurtdir;
     }
 
     void VehicleEntity::SetDataIdDamage(const float data_id_damage)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_damage"] = data_id_damage;
+        constexpr int index = hierarchy_metadata_count + GetMetadataIndex(metadata_names, "data_id_damage");
+        metadata[index] = data_id_damage;
     }
 
 }
@@ -55,10 +55,11 @@ namespace Botcraft
 
     void ManagersClient::Disconnect()
     {
-        std::thread::id network_process_thread_id;
+        // Chunks loaded from packets are loaded by this connection
+        ChunkLoaderId loader_id = std::this_thread::get_id();
         if (network_manager)
         {
-            network_process_thread_id = network_manager->GetProcessingThreadId();
+            loader_id = network_manager->GetConnectionId();
         }
 
         ConnectionClient::Disconnect();
@@ -82,7 +83,7 @@ namespace Botcraft
 
         if (world)
         {
-            world->UnloadAllChunks(network_process_thread_id);
+            world->UnloadAllChunks(loader_id);
             world.reset();
         }
 
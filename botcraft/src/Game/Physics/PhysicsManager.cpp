@@ -1,5 +1,8 @@
+#include <limits>
+
 #include "botcraft/Game/AssetsManager.hpp"
 #include "botcraft/Game/Physics/PhysicsManager.hpp"
+#include "botcraft/Game/Physics/PhysicsTickScheduler.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 #include "botcraft/Utilities/SleepUtilities.hpp"
 #include "botcraft/Utilities/ItemUtilities.hpp"
@@ -58,6 +61,12 @@ namespace Botcraft
     {
         should_run = true;
 
+        if (PhysicsTickScheduler::GetInstance().IsStarted())
+        {
+            shared_tick_id = PhysicsTickScheduler::GetInstance().Register([this]() { Tick(); }, [this]() { return GetMsPerTick(); });
+            return;
+        }
+
         // Launch the physics thread (continuously sending the position to the server)
         thread_physics = std::thread(&PhysicsManager::Physics, this);
     }
@@ -65,6 +74,11 @@ namespace Botcraft
     void PhysicsManager::StopPhysics()
     {
         should_run = false;
+        if (shared_tick_id.has_value())
+        {
+            PhysicsTickScheduler::GetInstance().Unregister(shared_tick_id.value());
+            shared_tick_id = std::nullopt;
+        }
         if (thread_physics.joinable())
         {
             thread_physics.join();
@@ -87,6 +101,16 @@ namespace Botcraft
         return ms_per_tick;
     }
 
+    void PhysicsManager::UseSharedTickScheduler(const size_t num_threads)
+    {
+        PhysicsTickScheduler::GetInstance().Start(num_threads);
+    }
+
+    PhysicsTickStats PhysicsManager::GetSharedTickStats()
+    {
+        return PhysicsTickScheduler::GetInstance().GetStats();
+    }
+
 
     void PhysicsManager::Handle(ClientboundLoginPacket& packet)
     {
@@ -238,51 +262,57 @@ namespace Botcraft
             // End of the current tick
             end += std::chrono::microseconds(static_cast<long long int>(1000.0 * ms_per_tick));
 
-            if (network_manager->GetConnectionState() == ConnectionState::Play)
+            Tick();
+
+            // Wait for end of tick
+            Utilities::SleepUntil(end);
+        }
+    }
+
+    void PhysicsManager::Tick()
+    {
+        if (network_manager->GetConnectionState() == ConnectionState::Play)
+        {
+            if (player != nullptr && !std::isnan(player->GetY()))
             {
-                if (player != nullptr && !std::isnan(player->GetY()))
-                {
-                    // As PhysicsManager is a friend of LocalPlayer, we can lock the whole entity
-                    // while physics is processed. This also means we can't use public interface
-                    // as it's thread-safe by design and would deadlock because of this global lock
-                    std::scoped_lock<std::shared_mutex> lock(player->entity_mutex);
+                // As PhysicsManager is a friend of LocalPlayer, we can lock the whole entity
+                // while physics is processed. This also means we can't use public interface
+                // as it's thread-safe by design and would deadlock because of this global lock
+                std::scoped_lock<std::shared_mutex> lock(player->entity_mutex);
 
-                    // Send player updated position with onground set to false to mimic vanilla client behaviour
-                    if (teleport_id.has_value())
-                    {
-                        std::shared_ptr<ServerboundMovePlayerPacketPosRot> updated_position_packet = std::make_shared<ServerboundMovePlayerPacketPosRot>();
-                        updated_position_packet->SetX(player->position.x);
-                        updated_position_packet->SetY(player->position.y);
-                        updated_position_packet->SetZ(player->position.z);
-                        updated_position_packet->SetYRot(player->yaw);
-                        updated_position_packet->SetXRot(player->pitch);
-                        updated_position_packet->SetOnGround(false);
+                // Send player updated position with onground set to false to mimic vanilla client behaviour
+                if (teleport_id.has_value())
+                {
+                    std::shared_ptr<ServerboundMovePlayerPacketPosRot> updated_position_packet = std::make_shared<ServerboundMovePlayerPacketPosRot>();
+                    updated_position_packet->SetX(player->position.x);
+                    updated_position_packet->SetY(player->position.y);
+                    updated_position_packet->SetZ(player->position.z);
+                    updated_position_packet->SetYRot(player->yaw);
+                    updated_position_packet->SetXRot(player->pitch);
+                    updated_position_packet->SetOnGround(false);
 #if PROTOCOL_VERSION > 767 /* > 1.21.1 */
-                        updated_position_packet->SetHorizontalCollision(false);
+                    updated_position_packet->SetHorizontalCollision(false);
 #endif
 
-                        std::shared_ptr<ServerboundAcceptTeleportationPacket> accept_tp_packet = std::make_shared<ServerboundAcceptTeleportationPacket>();
-                        accept_tp_packet->SetId_(teleport_id.value());
+                    std::shared_ptr<ServerboundAcceptTeleportationPacket> accept_tp_packet = std::make_shared<ServerboundAcceptTeleportationPacket>();
+                    accept_tp_packet->SetId_(teleport_id.value());
 
-                        // Before 1.21.2 -> Accept TP then move player, 1.21.2+ -> move player then accept TP
+                    // Before 1.21.2 -> Accept TP then move player, 1.21.2+ -> move player then accept TP
 #if PROTOCOL_VERSION < 768 /* < 1.21.2 */
-                        network_manager->Send(accept_tp_packet);
-                        network_manager->Send(updated_position_packet);
+                    network_manager->Send(accept_tp_packet);
+                    network_manager->Send(updated_position_packet);
 #else
-                        network_manager->Send(updated_position_packet);
-                        network_manager->Send(accept_tp_packet);
+                    network_manager->Send(updated_position_packet);
+                    network_manager->Send(accept_tp_packet);
 #endif
-                        teleport_id = std::nullopt;
-                    }
-                    PhysicsTick();
+                    teleport_id = std::nullopt;
                 }
+                PhysicsTick();
+            }
 #if PROTOCOL_VERSION > 767 /* > 1.21.1 */
-                std::shared_ptr<ServerboundClientTickEndPacket> tick_end_packet = std::make_shared<ServerboundClientTickEndPacket>();
-                network_manager->Send(tick_end_packet);
+            std::shared_ptr<ServerboundClientTickEndPacket> tick_end_packet = std::make_shared<ServerboundClientTickEndPacket>();
+            network_manager->Send(tick_end_packet);
 #endif
-            }
-            // Wait for end of tick
-            Utilities::SleepUntil(end);
         }
     }
 
@@ -291,23 +321,20 @@ namespace Botcraft
         // Check for rocket boosting if currently in elytra flying mode
         if (player->GetDataSharedFlagsIdImpl(EntitySharedFlagsId::FallFlying))
         {
-            for (const auto& e : *entity_manager->GetEntities())
-            {
-                if (e.second->GetType() != EntityType::FireworkRocketEntity)
+            // Rockets position is only updated when the server sends it, so search all of them
+            entity_manager->QueryRadius(player->position, std::numeric_limits<double>::infinity(), [&](const std::shared_ptr<Entity>& e)
                 {
-                    continue;
-                }
-
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-                const int attached_id = reinterpret_cast<const FireworkRocketEntity*>(e.second.get())->GetDataAttachedToTarget().value_or(0);
+                    const int attached_id = reinterpret_cast<const FireworkRocketEntity*>(e.get())->GetDataAttachedToTarget().value_or(0);
 #else
-                const int attached_id = reinterpret_cast<const FireworkRocketEntity*>(e.second.get())->GetDataAttachedToTarget();
+                    const int attached_id = reinterpret_cast<const FireworkRocketEntity*>(e.get())->GetDataAttachedToTarget();
 #endif
-                if (attached_id == player->entity_id)
-                {
-                    player->speed += player->front_vector * 0.1 + (player->front_vector * 1.5 - player->speed) * 0.5;
-                }
-            }
+                    if (attached_id == player->entity_id)
+                    {
+                        player->speed += player->front_vector * 0.1 + (player->front_vector * 1.5 - player->speed) * 0.5;
+                    }
+                }, EntityType::FireworkRocketEntity
+            );
         }
 
         { // LocalPlayer::tick
@@ -1080,7 +1107,9 @@ namespace Botcraft
 
     Vector3<double> PhysicsManager::CollideBoundingBox(const AABB& aabb, const Vector3<double>& movement) const
     {
-        const std::vector<AABB> colliders = world->GetColliders(aabb, movement);
+        // Reuse the same vector for all collisions, so once it's big enough no allocation happens
+        std::vector<AABB>& colliders = colliders_buffer;
+        world->GetColliders(aabb, movement, colliders);
         // TODO: add world borders to colliders?
         if (colliders.size() == 0)
         {
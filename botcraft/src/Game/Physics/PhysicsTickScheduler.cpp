@@ -0,0 +1,213 @@
+#include <algorithm>
+
+#include "botcraft/Game/Physics/PhysicsTickScheduler.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        std::chrono::steady_clock::duration TickPeriod(const double ms_per_tick)
+        {
+            // Don't let a weird tick rate make a period of 0, that would mean ticking in a loop
+            return std::max(
+                std::chrono::steady_clock::duration(std::chrono::microseconds(100)),
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(ms_per_tick))
+            );
+        }
+    }
+
+    PhysicsTickScheduler& PhysicsTickScheduler::GetInstance()
+    {
+        static PhysicsTickScheduler instance;
+        return instance;
+    }
+
+    PhysicsTickScheduler::PhysicsTickScheduler() : epoch(std::chrono::steady_clock::now())
+    {
+        started = false;
+        should_run = true;
+        next_id = 0;
+        sum_lateness_ms = 0.0;
+    }
+
+    PhysicsTickScheduler::~PhysicsTickScheduler()
+    {
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            should_run = false;
+        }
+        ticks_cv.notify_all();
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    void PhysicsTickScheduler::Start(const size_t num_threads)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (started)
+        {
+            return;
+        }
+
+        const size_t thread_count = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        LOG_INFO("Starting " << thread_count << " shared physics threads");
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([this, i]()
+                {
+                    Logger::GetInstance().RegisterThread("SharedPhysics - " + std::to_string(i));
+                    Run();
+                }
+            );
+        }
+
+        started = true;
+    }
+
+    bool PhysicsTickScheduler::IsStarted() const
+    {
+        return started;
+    }
+
+    size_t PhysicsTickScheduler::Register(const std::function<void()>& tick, const std::function<double()>& get_ms_per_tick)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        const size_t id = next_id++;
+        clients[id] = Client{ tick, get_ms_per_tick };
+
+        const ScheduledTick scheduled{ AlignOnGrid(std::chrono::steady_clock::now(), TickPeriod(get_ms_per_tick())), id };
+        const bool new_first = scheduled_ticks.empty() || scheduled.deadline < scheduled_ticks.top().deadline;
+        scheduled_ticks.push(scheduled);
+        if (new_first)
+        {
+            ticks_cv.notify_one();
+        }
+
+        return id;
+    }
+
+    void PhysicsTickScheduler::Unregister(const size_t id)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = clients.find(id);
+        if (it == clients.end())
+        {
+            return;
+        }
+
+        Client& client = it->second;
+        client.removed = true;
+        unregister_cv.wait(lock, [&client]() { return !client.running; });
+        // Its tick is still in the queue, it will be dropped when it's due
+        clients.erase(id);
+    }
+
+    PhysicsTickStats PhysicsTickScheduler::GetStats() const
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        PhysicsTickStats output = stats;
+        output.mean_lateness_ms = stats.ticks > 0 ? sum_lateness_ms / stats.ticks : 0.0;
+        return output;
+    }
+
+    void PhysicsTickScheduler::ResetStats()
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        stats = PhysicsTickStats();
+        sum_lateness_ms = 0.0;
+    }
+
+    void PhysicsTickScheduler::Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (should_run)
+        {
+            if (scheduled_ticks.empty())
+            {
+                ticks_cv.wait(lock);
+                continue;
+            }
+
+            const ScheduledTick scheduled = scheduled_ticks.top();
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (start < scheduled.deadline)
+            {
+                ticks_cv.wait_until(lock, scheduled.deadline);
+                continue;
+            }
+            scheduled_ticks.pop();
+
+            auto it = clients.find(scheduled.id);
+            // Unregistered while waiting in the queue
+            if (it == clients.end())
+            {
+                continue;
+            }
+            // References to unordered_map elements are stable, and
+            // Unregister doesn't erase a client while its tick is running
+            Client& client = it->second;
+            client.running = true;
+
+            // If other ticks are due, wake another thread to process them in parallel
+            if (!scheduled_ticks.empty() && scheduled_ticks.top().deadline <= start)
+            {
+                ticks_cv.notify_one();
+            }
+
+            lock.unlock();
+            try
+            {
+                client.tick();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception during physics tick: " << e.what());
+            }
+            const std::chrono::steady_clock::duration period = TickPeriod(client.get_ms_per_tick());
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            lock.lock();
+
+            client.running = false;
+            if (client.removed)
+            {
+                unregister_cv.notify_all();
+                continue;
+            }
+
+            const double lateness_ms = std::chrono::duration<double, std::milli>(start - scheduled.deadline).count();
+            stats.ticks += 1;
+            stats.max_lateness_ms = std::max(stats.max_lateness_ms, lateness_ms);
+            sum_lateness_ms += lateness_ms;
+
+            ScheduledTick next{ AlignOnGrid(scheduled.deadline + period, period), scheduled.id };
+            if (end > next.deadline)
+            {
+                stats.overruns += 1;
+                // Don't try to catch up with all the ticks we missed, only the last one is run
+                const auto missed = (end - next.deadline) / period;
+                next.deadline += missed * period;
+                stats.skipped_ticks += static_cast<size_t>(missed);
+            }
+
+            // No need to notify, this thread is going to check the queue right now
+            scheduled_ticks.push(next);
+        }
+    }
+
+    std::chrono::steady_clock::time_point PhysicsTickScheduler::AlignOnGrid(const std::chrono::steady_clock::time_point& t, const std::chrono::steady_clock::duration& period) const
+    {
+        if (t <= epoch)
+        {
+            return epoch;
+        }
+        const auto num_periods = (t - epoch + period - std::chrono::steady_clock::duration(1)) / period;
+        return epoch + num_periods * period;
+    }
+} // Botcraft
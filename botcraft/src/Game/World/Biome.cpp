@@ -37,6 +37,21 @@ namespace Botcraft
         return name;
     }
 
+    float Biome::GetTemperature() const
+    {
+        return temperature;
+    }
+
+    float Biome::GetRainfall() const
+    {
+        return rainfall;
+    }
+
+    BiomeType Biome::GetBiomeType() const
+    {
+        return biome_type;
+    }
+
     unsigned int Biome::GetColorMultiplier(const int height, const bool is_grass) const
     {
         if (height <= sea_level)
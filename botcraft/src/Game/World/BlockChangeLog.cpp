@@ -0,0 +1,62 @@
+#include "botcraft/Game/World/BlockChangeLog.hpp"
+
+namespace Botcraft
+{
+    BlockChangeLog::BlockChangeLog()
+    {
+        entries.resize(capacity);
+        num_changes = 1;
+    }
+
+    BlockChangeLog::~BlockChangeLog()
+    {
+
+    }
+
+    void BlockChangeLog::AddBlock(const Position& pos)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        entries[num_changes % capacity] = Entry{ pos, false };
+        num_changes += 1;
+    }
+
+    void BlockChangeLog::AddChunk(const int x, const int z)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        entries[num_changes % capacity] = Entry{ Position(x, 0, z), true };
+        num_changes += 1;
+    }
+
+    bool BlockChangeLog::Get(unsigned long long int& since, std::vector<Position>& blocks, std::vector<std::pair<int, int>>& chunks) const
+    {
+        blocks.clear();
+        chunks.clear();
+
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (since == 0)
+        {
+            since = num_changes;
+            return true;
+        }
+        // Oldest changes have been overwritten
+        if (num_changes - since > capacity)
+        {
+            since = num_changes;
+            return false;
+        }
+        for (unsigned long long int i = since; i < num_changes; ++i)
+        {
+            const Entry& entry = entries[i % capacity];
+            if (entry.is_chunk)
+            {
+                chunks.push_back({ entry.pos.x, entry.pos.z });
+            }
+            else
+            {
+                blocks.push_back(entry.pos);
+            }
+        }
+        since = num_changes;
+        return true;
+    }
+} // Botcraft
@@ -0,0 +1,219 @@
+#include <algorithm>
+
+#include "botcraft/Game/AssetsManager.hpp"
+#include "botcraft/Game/World/BlockCursor.hpp"
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/ChunkIndex.hpp"
+#include "botcraft/Game/World/Section.hpp"
+#include "botcraft/Game/World/SectionNavigation.hpp"
+#include "botcraft/Utilities/EpochManager.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Integer division rounding towards -inf
+        int FloorDiv(const int a, const int b)
+        {
+            return a >= 0 ? a / b : (a + 1) / b - 1;
+        }
+    }
+
+    BlockCursor::BlockCursor(const ChunkIndex& chunk_index_) : chunk_index(chunk_index_)
+    {
+        Utilities::EpochManager::GetInstance().EnterRead();
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        air = AssetsManager::getInstance().GetBlockstate(std::make_pair(0, 0));
+#else
+        air = AssetsManager::getInstance().GetBlockstate(0);
+#endif
+        center_x = 0;
+        center_z = 0;
+        has_last_section = false;
+        last_chunk_x = 0;
+        last_chunk_z = 0;
+        last_section_min_y = 0;
+        last_section = nullptr;
+    }
+
+    BlockCursor::~BlockCursor()
+    {
+        Utilities::EpochManager::GetInstance().ExitRead();
+    }
+
+    const Blockstate* BlockCursor::GetBlock(const Position& pos)
+    {
+        // Can't get block in unloaded chunk
+        if (!MoveToSection(pos))
+        {
+            return nullptr;
+        }
+
+        // As we are in a loaded chunk, outside of the world or in an
+        // empty section --> return air block instead of nullptr
+        if (last_section == nullptr)
+        {
+            return air;
+        }
+
+        const unsigned short stored_id = last_section->GetBlock(Section::CoordsToBlockIndex(
+            pos.x - last_chunk_x * CHUNK_WIDTH,
+            pos.y - last_section_min_y,
+            pos.z - last_chunk_z * CHUNK_WIDTH
+        ));
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        BlockstateId block_id;
+        Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
+#else
+        const BlockstateId block_id = static_cast<BlockstateId>(stored_id);
+#endif
+        return AssetsManager::getInstance().GetBlockstate(block_id);
+    }
+
+    NavigationColumn BlockCursor::GetNavigationColumn(const Position& bottom, const int height)
+    {
+        NavigationColumn output;
+        int i = 0;
+        while (i < height)
+        {
+            const Position pos(bottom.x, bottom.y + i, bottom.z);
+            // All blocks are in the same chunk, nothing is loaded
+            if (!MoveToSection(pos))
+            {
+                return output;
+            }
+
+            // Number of blocks of the column in this section
+            const int n = std::min(height - i, last_section_min_y + SECTION_HEIGHT - pos.y);
+            const unsigned long long int bits = (1ULL << n) - 1;
+            output.loaded |= static_cast<unsigned int>(bits << i);
+            // Outside of the world or empty section --> air, no property
+            if (last_section != nullptr)
+            {
+                const SectionNavigation& navigation = last_section->GetNavigation();
+                const int x = pos.x - last_chunk_x * CHUNK_WIDTH;
+                const int z = pos.z - last_chunk_z * CHUNK_WIDTH;
+                const int shift = pos.y - last_section_min_y;
+                for (size_t p = 0; p < output.properties.size(); ++p)
+                {
+                    const unsigned long long int column = navigation.GetColumn(static_cast<NavigationProperty>(p), x, z);
+                    output.properties[p] |= static_cast<unsigned int>(((column >> shift) & bits) << i);
+                }
+            }
+            i += n;
+        }
+        return output;
+    }
+
+    float BlockCursor::GetNavigationHeight(const Position& pos)
+    {
+        if (!MoveToSection(pos) || last_section == nullptr)
+        {
+            return static_cast<float>(pos.y);
+        }
+
+        const SectionNavigation::BlockProperties& properties = SectionNavigation::GetBlockProperties(last_section->GetBlock(Section::CoordsToBlockIndex(
+            pos.x - last_chunk_x * CHUNK_WIDTH,
+            pos.y - last_section_min_y,
+            pos.z - last_chunk_z * CHUNK_WIDTH
+        )));
+        if (!((properties.properties >> static_cast<int>(NavigationProperty::Solid)) & 1))
+        {
+            return static_cast<float>(pos.y);
+        }
+        return pos.y + properties.height / static_cast<float>(SectionNavigation::height_resolution);
+    }
+
+    unsigned long long int BlockCursor::GetChunkNavigationVersion(const int chunk_x, const int chunk_z)
+    {
+        const CachedChunk& chunk = GetChunk(chunk_x, chunk_z);
+        if (!chunk.loaded)
+        {
+            return 0;
+        }
+
+        // Versions are globally increasing, so any change
+        // in a section (or a new section) increases the max
+        unsigned long long int output = 1;
+        for (int i = 0; i < chunk.num_sections; ++i)
+        {
+            if (chunk.sections[i] != nullptr)
+            {
+                output = std::max(output, chunk.sections[i]->GetNavigation().GetVersion() + 1);
+            }
+        }
+        return output;
+    }
+
+    bool BlockCursor::MoveToSection(const Position& pos)
+    {
+        const int chunk_x = FloorDiv(pos.x, CHUNK_WIDTH);
+        const int chunk_z = FloorDiv(pos.z, CHUNK_WIDTH);
+
+        // Fast path, same section as the previous call
+        if (has_last_section &&
+            chunk_x == last_chunk_x && chunk_z == last_chunk_z &&
+            pos.y >= last_section_min_y && pos.y < last_section_min_y + SECTION_HEIGHT)
+        {
+            return true;
+        }
+
+        const CachedChunk& chunk = GetChunk(chunk_x, chunk_z);
+        if (!chunk.loaded)
+        {
+            return false;
+        }
+
+        const int section_y = FloorDiv(pos.y - chunk.min_y, SECTION_HEIGHT);
+        has_last_section = true;
+        last_chunk_x = chunk_x;
+        last_chunk_z = chunk_z;
+        last_section_min_y = chunk.min_y + section_y * SECTION_HEIGHT;
+        last_section = section_y < 0 || section_y >= chunk.num_sections ? nullptr : chunk.sections[section_y].get();
+        return true;
+    }
+
+    const BlockCursor::CachedChunk& BlockCursor::GetChunk(const int chunk_x, const int chunk_z)
+    {
+        int dx = chunk_x - center_x;
+        int dz = chunk_z - center_z;
+
+        // Move the neighbourhood, keeping the chunks that are still in it
+        if (dx < -1 || dx > 1 || dz < -1 || dz > 1)
+        {
+            std::array<CachedChunk, 9> moved_neighbourhood;
+            for (int i = -1; i < 2; ++i)
+            {
+                for (int j = -1; j < 2; ++j)
+                {
+                    const int previous_dx = i + dx;
+                    const int previous_dz = j + dz;
+                    if (previous_dx >= -1 && previous_dx <= 1 && previous_dz >= -1 && previous_dz <= 1)
+                    {
+                        moved_neighbourhood[(i + 1) * 3 + (j + 1)] = neighbourhood[(previous_dx + 1) * 3 + (previous_dz + 1)];
+                    }
+                }
+            }
+            neighbourhood = moved_neighbourhood;
+            center_x = chunk_x;
+            center_z = chunk_z;
+            dx = 0;
+            dz = 0;
+        }
+
+        CachedChunk& chunk = neighbourhood[(dx + 1) * 3 + (dz + 1)];
+        if (!chunk.looked_up)
+        {
+            chunk.looked_up = true;
+            const ChunkIndex::Entry* entry = chunk_index.Find(chunk_x, chunk_z);
+            if (entry != nullptr)
+            {
+                chunk.loaded = true;
+                chunk.sections = entry->sections.data();
+                chunk.num_sections = static_cast<int>(entry->sections.size());
+                chunk.min_y = entry->min_y;
+            }
+        }
+        return chunk;
+    }
+} // Botcraft
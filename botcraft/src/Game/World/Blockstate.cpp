@@ -575,6 +575,141 @@ namespace Botcraft
         LoadWeightedModels({ {model_, 1} });
     }
 
+#if !USE_GUI
+    Blockstate::Blockstate(ReadIterator& iter, size_t& length)
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        blockstate_id.first = ReadData<int>(iter, length);
+        blockstate_id.second = ReadData<unsigned char>(iter, length);
+#else
+        blockstate_id = ReadData<unsigned int>(iter, length);
+#endif
+        flags = decltype(flags)(ReadData<unsigned long long>(iter, length));
+        hardness = ReadData<float>(iter, length);
+        friction = ReadData<float>(iter, length);
+        tint_type = static_cast<TintType>(ReadData<int>(iter, length));
+        m_name = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+
+        const int num_variables = ReadData<VarInt>(iter, length);
+        for (int i = 0; i < num_variables; ++i)
+        {
+            const std::string* key = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+            variables[key] = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+        }
+
+        const int num_models = ReadData<VarInt>(iter, length);
+        models_indices.reserve(num_models);
+        models_weights.reserve(num_models);
+        for (int i = 0; i < num_models; ++i)
+        {
+            const size_t index = static_cast<size_t>(ReadData<VarInt>(iter, length));
+            if (index >= unique_models.size())
+            {
+                throw std::runtime_error("Invalid model index in blockstate cache");
+            }
+            models_indices.push_back(index);
+            models_weights.push_back(ReadData<VarInt>(iter, length));
+        }
+        weights_sum = ReadData<VarInt>(iter, length);
+
+        const int num_best_tools = ReadData<VarInt>(iter, length);
+        best_tools.reserve(num_best_tools);
+        for (int i = 0; i < num_best_tools; ++i)
+        {
+            BestTool tool;
+            tool.tool_type = static_cast<ToolType>(ReadData<int>(iter, length));
+            tool.min_material = static_cast<ToolMaterial>(ReadData<int>(iter, length));
+            tool.multiplier = ReadData<float>(iter, length);
+            best_tools.push_back(tool);
+        }
+
+        LoadModelsColliders();
+    }
+
+    void Blockstate::WriteCache(WriteContainer& container) const
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        WriteData<int>(blockstate_id.first, container);
+        WriteData<unsigned char>(blockstate_id.second, container);
+#else
+        WriteData<unsigned int>(blockstate_id, container);
+#endif
+        WriteData<unsigned long long>(flags.to_ullong(), container);
+        WriteData<float>(hardness, container);
+        WriteData<float>(friction, container);
+        WriteData<int>(static_cast<int>(tint_type), container);
+        WriteData<std::string>(*m_name, container);
+
+        WriteData<VarInt>(static_cast<int>(variables.size()), container);
+        for (const auto& [k, v] : variables)
+        {
+            WriteData<std::string>(*k, container);
+            WriteData<std::string>(*v, container);
+        }
+
+        WriteData<VarInt>(static_cast<int>(models_indices.size()), container);
+        for (size_t i = 0; i < models_indices.size(); ++i)
+        {
+            WriteData<VarInt>(static_cast<int>(models_indices[i]), container);
+            WriteData<VarInt>(models_weights[i], container);
+        }
+        WriteData<VarInt>(weights_sum, container);
+
+        WriteData<VarInt>(static_cast<int>(best_tools.size()), container);
+        for (const BestTool& tool : best_tools)
+        {
+            WriteData<int>(static_cast<int>(tool.tool_type), container);
+            WriteData<int>(static_cast<int>(tool.min_material), container);
+            WriteData<float>(tool.multiplier, container);
+        }
+    }
+
+    void Blockstate::WriteModelsCache(WriteContainer& container)
+    {
+        WriteData<VarInt>(static_cast<int>(unique_models.size()), container);
+        for (const Model& model : unique_models)
+        {
+            const std::set<AABB>& colliders = model.GetColliders();
+            WriteData<VarInt>(static_cast<int>(colliders.size()), container);
+            for (const AABB& collider : colliders)
+            {
+                for (const Vector3<double>& v : { collider.GetCenter(), collider.GetHalfSize() })
+                {
+                    WriteData<double>(v.x, container);
+                    WriteData<double>(v.y, container);
+                    WriteData<double>(v.z, container);
+                }
+            }
+        }
+    }
+
+    void Blockstate::ReadModelsCache(ReadIterator& iter, size_t& length)
+    {
+        unique_models.clear();
+        const int num_models = ReadData<VarInt>(iter, length);
+        for (int i = 0; i < num_models; ++i)
+        {
+            std::set<AABB> colliders;
+            const int num_colliders = ReadData<VarInt>(iter, length);
+            for (int j = 0; j < num_colliders; ++j)
+            {
+                Vector3<double> center;
+                center.x = ReadData<double>(iter, length);
+                center.y = ReadData<double>(iter, length);
+                center.z = ReadData<double>(iter, length);
+                Vector3<double> half_size;
+                half_size.x = ReadData<double>(iter, length);
+                half_size.y = ReadData<double>(iter, length);
+                half_size.z = ReadData<double>(iter, length);
+                colliders.insert(AABB(center, half_size));
+            }
+            Model model;
+            model.SetColliders(colliders);
+            unique_models.push_back(model);
+        }
+    }
+#endif
+
     BlockstateId Blockstate::GetId() const
     {
         return blockstate_id;
@@ -643,25 +778,44 @@ namespace Botcraft
     {
         std::set<AABB> output;
 
-        const Model& model = GetModel(GetModelId(pos));
-
-        const std::set<AABB>& colliders = model.GetColliders();
         const Vector3<double> offset = GetHorizontalOffsetAtPos(pos);
-        for (const auto& c : colliders)
+        for (const auto& c : GetLocalColliders(pos))
         {
             output.insert(c + offset);
         }
         return output;
     }
 
+    ColliderRange Blockstate::GetLocalColliders(const Position& pos) const
+    {
+        const unsigned char model_id = GetModelId(pos);
+        const AABB* data = models_colliders.data();
+        return ColliderRange{ data + models_colliders_start[model_id], data + models_colliders_start[model_id + 1] };
+    }
+
+    void Blockstate::AppendCollidersAtPos(const Position& pos, std::vector<AABB>& output) const
+    {
+        const ColliderRange colliders = GetLocalColliders(pos);
+        if (colliders.empty())
+        {
+            return;
+        }
+
+        const Vector3<double> offset = GetHorizontalOffsetAtPos(pos);
+        for (const AABB& c : colliders)
+        {
+            output.push_back(c + offset);
+        }
+    }
+
     Vector3<double> Blockstate::GetClosestPoint(const Position& block_pos, const Vector3<double>& pos) const
     {
-        const std::set<AABB> colliders = GetCollidersAtPos(block_pos);
+        const Vector3<double> offset = GetHorizontalOffsetAtPos(block_pos);
         double distance = std::numeric_limits<double>::max();
         Vector3<double> closest_point;
-        for (const auto& c : colliders)
+        for (const auto& c : GetLocalColliders(block_pos))
         {
-            const Vector3<double> closest_on_current_collider = c.GetClosestPoint(pos);
+            const Vector3<double> closest_on_current_collider = (c + offset).GetClosestPoint(pos);
             const double current_distance = closest_on_current_collider.SqrDist(pos);
             if (current_distance < distance)
             {
@@ -1108,6 +1262,23 @@ namespace Botcraft
 
         models_indices.shrink_to_fit();
         models_weights.shrink_to_fit();
+
+        LoadModelsColliders();
+    }
+
+    void Blockstate::LoadModelsColliders()
+    {
+        models_colliders.clear();
+        models_colliders_start.clear();
+        models_colliders_start.reserve(models_indices.size() + 1);
+        for (const size_t i : models_indices)
+        {
+            models_colliders_start.push_back(static_cast<unsigned short>(models_colliders.size()));
+            const std::set<AABB>& colliders = unique_models[i].GetColliders();
+            models_colliders.insert(models_colliders.end(), colliders.begin(), colliders.end());
+        }
+        models_colliders_start.push_back(static_cast<unsigned short>(models_colliders.size()));
+        models_colliders.shrink_to_fit();
     }
 
     bool Blockstate::GetBoolFromCondition(const Json::Value& condition) const
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include "botcraft/Game/AssetsManager.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
 #include "botcraft/Game/World/Section.hpp"
@@ -16,6 +20,24 @@ namespace Botcraft
         GlobalPalette
     };
 
+    namespace
+    {
+        static constexpr size_t blocks_per_section = CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT;
+
+        /// @brief Above this number of blocks in a section, positions are not
+        /// stored in the block index, and the section is scanned instead
+        static constexpr unsigned short max_indexed_positions = 64;
+
+        unsigned short ToStoredId(const BlockstateId id)
+        {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+            return static_cast<unsigned short>(Blockstate::IdMetadataToId(id.first, id.second));
+#else
+            return static_cast<unsigned short>(id);
+#endif
+        }
+    }
+
 #if PROTOCOL_VERSION < 757 /* < 1.18 */
     Chunk::Chunk(const size_t dim_index, const bool has_sky_light_)
 #else
@@ -36,6 +58,7 @@ namespace Botcraft
         biomes = std::vector<unsigned char>(64 * height / SECTION_HEIGHT, 0);
 #endif
         sections = std::vector<std::shared_ptr<Section> >(height / SECTION_HEIGHT);
+        block_index = std::vector<std::vector<BlockIndexEntry> >(height / SECTION_HEIGHT);
 
 #if USE_GUI
         modified_since_last_rendered = true;
@@ -66,6 +89,7 @@ namespace Botcraft
             }
         }
 
+        block_index = c.block_index;
         block_entities_data = c.block_entities_data;
         loaded_from = c.loaded_from;
     }
@@ -110,7 +134,7 @@ namespace Botcraft
     void Chunk::LoadChunkData(const std::vector<unsigned char>& data, const std::vector<unsigned long long int>& primary_bit_mask)
 #endif
     {
-        std::vector<unsigned char>::const_iterator iter = data.begin();
+        ProtocolCraft::ReadIterator iter = data.data();
         size_t length = data.size();
 
         if (data.size() == 0)
@@ -183,6 +207,19 @@ namespace Botcraft
                 data_array[i] = ReadData<unsigned long long int>(iter, length);
             }
 
+#if PROTOCOL_VERSION > 712 /* > 1.15.2 */ && !USE_GUI
+            // Sections use the same layout, data can be stored without unpacking
+            if (!sections[sectionY])
+            {
+                AddSection(sectionY);
+            }
+            if (sections[sectionY]->LoadBlocks(bits_per_block, palette, data_array))
+            {
+                IndexSection(sectionY);
+                continue;
+            }
+#endif
+
             //Blocks data
 #if PROTOCOL_VERSION > 712 /* > 1.15.2 */
             int bit_offset = 0;
@@ -237,13 +274,14 @@ namespace Botcraft
 
                         Blockstate::IdToIdMetadata(raw_id, id, metadata);
 
-                        SetBlock(pos, { id, metadata });
+                        SetBlockImpl(pos, { id, metadata }, false);
 #else
-                        SetBlock(pos, raw_id);
+                        SetBlockImpl(pos, raw_id, false);
 #endif
                     }
                 }
             }
+            IndexSection(sectionY);
 
 #if PROTOCOL_VERSION <= 404 /* <= 1.13.2 */
             //Block light
@@ -313,7 +351,7 @@ namespace Botcraft
 #else
     void Chunk::LoadChunkData(const std::vector<unsigned char>& data)
     {
-        std::vector<unsigned char>::const_iterator iter = data.begin();
+        ProtocolCraft::ReadIterator iter = data.data();
         size_t length = data.size();
 
         if (data.size() == 0)
@@ -382,6 +420,22 @@ namespace Botcraft
             Position pos;
             if (block_count != 0)
             {
+#if !USE_GUI
+                // Sections use the same layout, data can be stored without unpacking
+                if (!sections[sectionY])
+                {
+                    AddSection(sectionY);
+                }
+                const bool loaded = palette_type == Palette::SingleValue ?
+                    sections[sectionY]->LoadBlocks(0, { palette_value }, {}) :
+                    sections[sectionY]->LoadBlocks(bits_per_block, palette, data_array);
+                if (loaded)
+                {
+                    IndexSection(sectionY);
+                    LoadSectionBiomeData(sectionY, iter, length);
+                    continue;
+                }
+#endif
                 for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
                 {
                     pos.y = block_y + sectionY * SECTION_HEIGHT + min_y;
@@ -393,7 +447,7 @@ namespace Botcraft
                             pos.x = block_x;
                             if (palette_type == Palette::SingleValue)
                             {
-                                SetBlock(pos, palette_value);
+                                SetBlockImpl(pos, palette_value, false);
                                 continue;
                             }
 
@@ -424,7 +478,7 @@ namespace Botcraft
                                 raw_id = palette[raw_id];
                             }
 
-                            SetBlock(pos, raw_id);
+                            SetBlockImpl(pos, raw_id, false);
                         }
                     }
                 }
@@ -433,6 +487,7 @@ namespace Botcraft
             {
                 sections[sectionY] = nullptr;
             }
+            IndexSection(sectionY);
 
             LoadSectionBiomeData(sectionY, iter, length);
         }
@@ -524,10 +579,10 @@ namespace Botcraft
 
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
         BlockstateId block_id;
-        const unsigned short stored_id = *(sections[section_y]->data_blocks.data() + Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z));
+        const unsigned short stored_id = sections[section_y]->GetBlock(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z));
         Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
 #else
-        const BlockstateId block_id = static_cast<BlockstateId>(*(sections[section_y]->data_blocks.data() + Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
+        const BlockstateId block_id = static_cast<BlockstateId>(sections[section_y]->GetBlock(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
 #endif
         return AssetsManager::getInstance().GetBlockstate(block_id);
     }
@@ -549,6 +604,66 @@ namespace Botcraft
     }
 
     void Chunk::SetBlock(const Position& pos, const BlockstateId id)
+    {
+        SetBlockImpl(pos, id, true);
+    }
+
+    void Chunk::FindBlocks(const std::vector<BlockstateId>& ids, const int min_y_, const int max_y_, std::vector<Position>& output) const
+    {
+        std::vector<unsigned short> stored_ids(ids.size());
+        std::transform(ids.begin(), ids.end(), stored_ids.begin(), ToStoredId);
+
+        if (max_y_ < min_y || min_y_ >= min_y + height)
+        {
+            return;
+        }
+        const int first_section = (std::max(min_y_, min_y) - min_y) / SECTION_HEIGHT;
+        const int last_section = (std::min(max_y_, min_y + height - 1) - min_y) / SECTION_HEIGHT;
+        for (int section_y = first_section; section_y <= last_section; ++section_y)
+        {
+            const std::vector<BlockIndexEntry>& entries = block_index[section_y];
+            if (entries.empty())
+            {
+                continue;
+            }
+            const int section_min_y = section_y * SECTION_HEIGHT + min_y;
+            for (const unsigned short id : stored_ids)
+            {
+                const auto it = std::lower_bound(entries.begin(), entries.end(), id, [](const BlockIndexEntry& e, const unsigned short i) { return e.id < i; });
+                if (it == entries.end() || it->id != id)
+                {
+                    continue;
+                }
+
+                if (it->positions_stored)
+                {
+                    for (const unsigned short index : it->positions)
+                    {
+                        const Position pos(index % CHUNK_WIDTH, section_min_y + index / (CHUNK_WIDTH * CHUNK_WIDTH), (index / CHUNK_WIDTH) % CHUNK_WIDTH);
+                        if (pos.y >= min_y_ && pos.y <= max_y_)
+                        {
+                            output.push_back(pos);
+                        }
+                    }
+                    continue;
+                }
+
+                // Too many blocks to store their positions, scan the section
+                std::array<unsigned short, blocks_per_section> blocks;
+                sections[section_y]->GetBlocks(blocks.data());
+                for (size_t index = 0; index < blocks_per_section; ++index)
+                {
+                    const Position pos(static_cast<int>(index % CHUNK_WIDTH), section_min_y + static_cast<int>(index / (CHUNK_WIDTH * CHUNK_WIDTH)), static_cast<int>((index / CHUNK_WIDTH) % CHUNK_WIDTH));
+                    if (blocks[index] == id && pos.y >= min_y_ && pos.y <= max_y_)
+                    {
+                        output.push_back(pos);
+                    }
+                }
+            }
+        }
+    }
+
+    void Chunk::SetBlockImpl(const Position& pos, const BlockstateId id, const bool update_index)
     {
         if (!IsInsideChunk(pos, false))
         {
@@ -577,7 +692,16 @@ namespace Botcraft
 #else
         const unsigned short block_id = static_cast<unsigned short>(id);
 #endif
-        sections[section_y]->data_blocks[Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] = block_id;
+        const size_t index = Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
+        // GUI borders are not part of this chunk, don't index them
+        if (update_index && IsInsideChunk(pos, true))
+        {
+            UpdateBlockIndex(section_y,
+                static_cast<unsigned short>((((pos.y - min_y) % SECTION_HEIGHT) * CHUNK_WIDTH + pos.z) * CHUNK_WIDTH + pos.x),
+                sections[section_y]->GetBlock(index), block_id);
+            sections[section_y]->GetNavigation().SetBlock(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z, block_id);
+        }
+        sections[section_y]->SetBlock(index, block_id);
 
 #if USE_GUI
         modified_since_last_rendered = true;
@@ -597,7 +721,7 @@ namespace Botcraft
             return 0;
         }
 
-        return (sections[section_y]->block_light[Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] >> (4 * (pos.x % 2))) & 0x0F;
+        return sections[section_y]->GetBlockLight(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
     }
 
     void Chunk::SetBlockLight(const Position& pos, const unsigned char v)
@@ -613,17 +737,7 @@ namespace Botcraft
             AddSection(section_y);
         }
 
-        unsigned char* packed_value = sections[section_y]->block_light.data() + Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
-        if (pos.x % 2 == 1)
-        {
-            const unsigned char first_value = *packed_value & 0x0F;
-            *packed_value = first_value | ((v & 0x0F) << 4);
-        }
-        else
-        {
-            const unsigned char second_value = *packed_value & 0xF0;
-            *packed_value = second_value | (v & 0x0F);
-        }
+        sections[section_y]->SetBlockLight(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z, v);
         // Not necessary as we don't render lights
 //#if USE_GUI
 //        modified_since_last_rendered = true;
@@ -643,7 +757,7 @@ namespace Botcraft
             return 0;
         }
 
-        return (sections[section_y]->sky_light[Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] >> (4 * (pos.x % 2))) & 0x0F;
+        return sections[section_y]->GetSkyLight(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
     }
 
     void Chunk::SetSkyLight(const Position& pos, const unsigned char v)
@@ -659,17 +773,7 @@ namespace Botcraft
             AddSection(section_y);
         }
 
-        unsigned char* packed_value = sections[section_y]->sky_light.data() + Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
-        if (pos.x % 2 == 1)
-        {
-            const unsigned char first_value = *packed_value & 0x0F;
-            *packed_value = first_value | ((v & 0x0F) << 4);
-        }
-        else
-        {
-            const unsigned char second_value = *packed_value & 0xF0;
-            *packed_value = second_value | (v & 0x0F);
-        }
+        sections[section_y]->SetSkyLight(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z, v);
 
         // Not necessary as we don't render lights
 //#if USE_GUI
@@ -677,6 +781,35 @@ namespace Botcraft
 //#endif
     }
 
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+    void Chunk::LoadSectionLight(const int section_y, const std::vector<char>& data, const bool sky)
+    {
+        if (section_y < 0 || section_y >= sections.size() || (sky && !has_sky_light))
+        {
+            return;
+        }
+
+        if (!sections[section_y])
+        {
+            // Missing sections are already fully dark
+            if (data.empty())
+            {
+                return;
+            }
+            AddSection(section_y);
+        }
+
+        if (sky)
+        {
+            sections[section_y]->LoadSkyLight(data);
+        }
+        else
+        {
+            sections[section_y]->LoadBlockLight(data);
+        }
+    }
+#endif
+
     size_t Chunk::GetDimensionIndex() const
     {
         return dimension_index;
@@ -694,7 +827,134 @@ namespace Botcraft
 
     void Chunk::AddSection(const int y)
     {
-        sections[y] = std::make_unique<Section>(has_sky_light);
+        sections[y] = std::make_shared<Section>();
+    }
+
+    void Chunk::IndexSection(const int section_y)
+    {
+        std::vector<BlockIndexEntry>& entries = block_index[section_y];
+        entries.clear();
+        if (sections[section_y] == nullptr)
+        {
+            return;
+        }
+
+        thread_local std::array<unsigned short, blocks_per_section> blocks;
+        // Number of blocks of each id, then index of the id entry. Reset to 0 once done
+        thread_local std::vector<unsigned short> id_values(std::numeric_limits<unsigned short>::max() + 1, 0);
+        thread_local std::vector<unsigned short> ids;
+
+        sections[section_y]->GetBlocks(blocks.data());
+        sections[section_y]->GetNavigation().Load(blocks.data());
+        ids.clear();
+        for (const unsigned short id : blocks)
+        {
+            if (id_values[id]++ == 0)
+            {
+                ids.push_back(id);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+
+        entries.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            BlockIndexEntry& entry = entries[i];
+            entry.id = ids[i];
+            entry.count = id_values[ids[i]];
+            entry.positions_stored = entry.count <= max_indexed_positions;
+            if (entry.positions_stored)
+            {
+                entry.positions.reserve(entry.count);
+            }
+            id_values[ids[i]] = static_cast<unsigned short>(i);
+        }
+
+        // Blocks are visited in index order, so positions are sorted
+        for (size_t index = 0; index < blocks_per_section; ++index)
+        {
+            BlockIndexEntry& entry = entries[id_values[blocks[index]]];
+            if (entry.positions_stored)
+            {
+                entry.positions.push_back(static_cast<unsigned short>(index));
+            }
+        }
+
+        for (const unsigned short id : ids)
+        {
+            id_values[id] = 0;
+        }
+    }
+
+    void Chunk::UpdateBlockIndex(const int section_y, const unsigned short index, const unsigned short previous_id, const unsigned short new_id)
+    {
+        if (previous_id == new_id)
+        {
+            return;
+        }
+
+        std::vector<BlockIndexEntry>& entries = block_index[section_y];
+        const auto find_entry = [&](const unsigned short id)
+        {
+            return std::lower_bound(entries.begin(), entries.end(), id, [](const BlockIndexEntry& e, const unsigned short i) { return e.id < i; });
+        };
+
+        // Empty sections are not indexed, so air may not have an entry
+        auto it = find_entry(previous_id);
+        if (it != entries.end() && it->id == previous_id)
+        {
+            it->count -= 1;
+            if (it->count == 0)
+            {
+                entries.erase(it);
+            }
+            else if (it->positions_stored)
+            {
+                const auto position_it = std::lower_bound(it->positions.begin(), it->positions.end(), index);
+                if (position_it != it->positions.end() && *position_it == index)
+                {
+                    it->positions.erase(position_it);
+                }
+            }
+        }
+
+        it = find_entry(new_id);
+        if (it == entries.end() || it->id != new_id)
+        {
+            it = entries.insert(it, BlockIndexEntry{ new_id, 0, true, {} });
+        }
+        it->count += 1;
+        if (!it->positions_stored)
+        {
+            return;
+        }
+        if (it->count > max_indexed_positions)
+        {
+            // Positions are not tracked anymore for this id, until the section is reloaded
+            it->positions_stored = false;
+            it->positions.clear();
+            it->positions.shrink_to_fit();
+            return;
+        }
+        it->positions.insert(std::lower_bound(it->positions.begin(), it->positions.end(), index), index);
+    }
+
+    const std::vector<std::shared_ptr<Section> >& Chunk::GetSections() const
+    {
+        return sections;
+    }
+
+    size_t Chunk::GetSectionsMemorySize() const
+    {
+        size_t output = sections.capacity() * sizeof(std::shared_ptr<Section>);
+        for (const auto& s : sections)
+        {
+            if (s != nullptr)
+            {
+                output += s->GetMemorySize();
+            }
+        }
+        return output;
     }
 
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
@@ -786,7 +1046,7 @@ namespace Botcraft
             return;
         }
 
-        std::vector<unsigned char>::const_iterator iter = data.begin();
+        ProtocolCraft::ReadIterator iter = data.data();
         size_t length = data.size();
         for (int section_y = 0; section_y < height / SECTION_HEIGHT; ++section_y)
         {
@@ -946,17 +1206,22 @@ namespace Botcraft
 #endif
     }
 
-    void Chunk::AddLoader(const std::thread::id& thread_id)
+    void Chunk::AddLoader(const ChunkLoaderId& loader_id)
     {
-        loaded_from.insert(thread_id);
+        loaded_from.insert(loader_id);
     }
 
-    size_t Chunk::RemoveLoader(const std::thread::id& thread_id)
+    size_t Chunk::RemoveLoader(const ChunkLoaderId& loader_id)
     {
-        loaded_from.erase(thread_id);
+        loaded_from.erase(loader_id);
         return loaded_from.size();
     }
 
+    const std::unordered_set<ChunkLoaderId>& Chunk::GetLoaders() const
+    {
+        return loaded_from;
+    }
+
     bool Chunk::IsInsideChunk(const Position& pos, const bool ignore_gui_borders) const
     {
         if (ignore_gui_borders)
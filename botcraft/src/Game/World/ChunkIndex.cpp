@@ -0,0 +1,114 @@
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/ChunkIndex.hpp"
+#include "botcraft/Game/World/Section.hpp"
+#include "botcraft/Utilities/EpochManager.hpp"
+
+namespace Botcraft
+{
+    ChunkIndex::ChunkIndex()
+    {
+        buckets = std::make_unique<std::atomic<const Bucket*>[]>(num_buckets);
+        owned_buckets = std::make_unique<std::shared_ptr<const Bucket>[]>(num_buckets);
+        bucket_mutexes = std::make_unique<std::mutex[]>(num_bucket_mutexes);
+        for (size_t i = 0; i < num_buckets; ++i)
+        {
+            buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ChunkIndex::~ChunkIndex()
+    {
+
+    }
+
+    const ChunkIndex::Entry* ChunkIndex::Find(const int x, const int z) const
+    {
+        const Bucket* bucket = buckets[GetBucketIndex(x, z)].load(std::memory_order_acquire);
+        if (bucket == nullptr)
+        {
+            return nullptr;
+        }
+
+        for (const std::shared_ptr<const Entry>& e : bucket->entries)
+        {
+            if (e->x == x && e->z == z)
+            {
+                return e.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void ChunkIndex::Update(const int x, const int z, const Chunk* chunk)
+    {
+        const size_t index = GetBucketIndex(x, z);
+        std::scoped_lock<std::mutex> lock(bucket_mutexes[index % num_bucket_mutexes]);
+        const std::shared_ptr<const Bucket>& bucket = owned_buckets[index];
+
+        size_t entry_index = bucket == nullptr ? 0 : bucket->entries.size();
+        for (size_t i = 0; bucket != nullptr && i < bucket->entries.size(); ++i)
+        {
+            if (bucket->entries[i]->x == x && bucket->entries[i]->z == z)
+            {
+                entry_index = i;
+                break;
+            }
+        }
+        const bool found = bucket != nullptr && entry_index < bucket->entries.size();
+
+        // Nothing to do if the chunk is not there and not in the index
+        // or if it's already up to date
+        if (chunk == nullptr && !found)
+        {
+            return;
+        }
+        if (chunk != nullptr && found)
+        {
+            const Entry& entry = *bucket->entries[entry_index];
+            const std::vector<std::shared_ptr<Section> >& sections = chunk->GetSections();
+            bool up_to_date = entry.min_y == chunk->GetMinY() && entry.sections.size() == sections.size();
+            for (size_t i = 0; up_to_date && i < sections.size(); ++i)
+            {
+                up_to_date = entry.sections[i] == sections[i];
+            }
+            if (up_to_date)
+            {
+                return;
+            }
+        }
+
+        std::shared_ptr<Bucket> new_bucket = std::make_shared<Bucket>();
+        if (bucket != nullptr)
+        {
+            new_bucket->entries.reserve(bucket->entries.size() + 1);
+            for (size_t i = 0; i < bucket->entries.size(); ++i)
+            {
+                if (i != entry_index)
+                {
+                    new_bucket->entries.push_back(bucket->entries[i]);
+                }
+            }
+        }
+        if (chunk != nullptr)
+        {
+            std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+            entry->x = x;
+            entry->z = z;
+            entry->min_y = chunk->GetMinY();
+            entry->sections = std::vector<std::shared_ptr<const Section> >(chunk->GetSections().begin(), chunk->GetSections().end());
+            new_bucket->entries.push_back(entry);
+        }
+
+        std::shared_ptr<const Bucket> previous = std::move(owned_buckets[index]);
+        owned_buckets[index] = new_bucket->entries.empty() ? nullptr : std::move(new_bucket);
+        buckets[index].store(owned_buckets[index].get(), std::memory_order_release);
+        // Readers may still be using previous bucket (and the sections it owns)
+        Utilities::EpochManager::GetInstance().Retire(std::move(previous));
+    }
+
+    size_t ChunkIndex::GetBucketIndex(const int x, const int z)
+    {
+        const size_t hash = static_cast<size_t>(static_cast<unsigned int>(x)) * 73856093 ^ static_cast<size_t>(static_cast<unsigned int>(z)) * 19349663;
+        return hash % num_buckets;
+    }
+} // Botcraft
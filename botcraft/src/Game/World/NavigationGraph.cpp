@@ -0,0 +1,560 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "botcraft/AI/PathfindingArena.hpp"
+#include "botcraft/Game/World/BlockCursor.hpp"
+#include "botcraft/Game/World/NavigationGraph.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        constexpr uint32_t invalid_node = std::numeric_limits<uint32_t>::max();
+        /// @brief Max vertical distance between a position and the standing position used for it
+        constexpr int max_snap_distance = 3;
+        /// @brief Max number of gates explored in one search
+        constexpr int budget_visit = 200000;
+        /// @brief When there are more cached chunks than that, those not used by the last search are removed
+        constexpr size_t max_cached_chunks = 4096;
+
+        /// @brief Offset of the chunk on the other side of each face
+        constexpr std::array<std::array<int, 2>, 4> face_offsets = { { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } } };
+
+        /// @brief Integer division rounding towards -inf
+        int FloorDiv(const int a, const int b)
+        {
+            return a >= 0 ? a / b : (a + 1) / b - 1;
+        }
+
+        /// @brief Position of a column along a face
+        int GetAlong(const unsigned char face, const int column)
+        {
+            return face < 2 ? column / CHUNK_WIDTH : column % CHUNK_WIDTH;
+        }
+
+        /// @brief Get the column at a given position along a face
+        int GetFaceColumn(const unsigned char face, const int along)
+        {
+            switch (face)
+            {
+            case 0:
+                return along * CHUNK_WIDTH;
+            case 1:
+                return along * CHUNK_WIDTH + CHUNK_WIDTH - 1;
+            case 2:
+                return along;
+            default:
+                return (CHUNK_WIDTH - 1) * CHUNK_WIDTH + along;
+            }
+        }
+
+        /// @brief Get one property of a column of a section, with one extra block below and above
+        /// @return 18 bits, from the top block of below to the bottom block of above
+        unsigned int GetBits(const NavigationColumn& below, const NavigationColumn& current, const NavigationColumn& above, const NavigationProperty property)
+        {
+            const size_t p = static_cast<size_t>(property);
+            return ((below.properties[p] >> (SECTION_HEIGHT - 1)) & 1u) |
+                (current.properties[p] << 1) |
+                ((above.properties[p] & 1u) << (SECTION_HEIGHT + 1));
+        }
+
+        uint32_t Find(std::vector<uint32_t>& parents, uint32_t i)
+        {
+            while (parents[i] != i)
+            {
+                parents[i] = parents[parents[i]];
+                i = parents[i];
+            }
+            return i;
+        }
+    }
+
+    NavigationGraph::NavigationGraph()
+    {
+        search_id = 0;
+    }
+
+    NavigationGraph::~NavigationGraph()
+    {
+
+    }
+
+    std::vector<Position> NavigationGraph::FindRoute(BlockCursor& cursor, const int min_y, const int height, const Position& start, const Position& end)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        search_id += 1;
+
+        std::vector<Position> output;
+
+        const int start_chunk_x = FloorDiv(start.x, CHUNK_WIDTH);
+        const int start_chunk_z = FloorDiv(start.z, CHUNK_WIDTH);
+        const int end_chunk_x = FloorDiv(end.x, CHUNK_WIDTH);
+        const int end_chunk_z = FloorDiv(end.z, CHUNK_WIDTH);
+        const ChunkGraph* start_graph = GetChunkGraph(cursor, start_chunk_x, start_chunk_z, min_y, height);
+        const ChunkGraph* end_graph = GetChunkGraph(cursor, end_chunk_x, end_chunk_z, min_y, height);
+        const uint32_t start_node = start_graph == nullptr ? invalid_node : FindNode(*start_graph, start.x - start_chunk_x * CHUNK_WIDTH, start.y, start.z - start_chunk_z * CHUNK_WIDTH);
+        const uint32_t end_node = end_graph == nullptr ? invalid_node : FindNode(*end_graph, end.x - end_chunk_x * CHUNK_WIDTH, end.y, end.z - end_chunk_z * CHUNK_WIDTH);
+
+        if (start_node != invalid_node && end_node != invalid_node)
+        {
+            const Position start_pos = GetNodePosition(*start_graph, start_node);
+            const Position end_pos = GetNodePosition(*end_graph, end_node);
+
+            thread_local std::vector<int> start_distances;
+            thread_local std::vector<int> end_distances;
+            ComputeDistances(*start_graph, start_node, false, start_distances);
+            ComputeDistances(*end_graph, end_node, true, end_distances);
+
+            // Gates are identified by their position and their face, start and end have a negative "face"
+            const std::pair<Position, float> start_key = { start_pos, -1.0f };
+            const std::pair<Position, float> end_key = { end_pos, -2.0f };
+            const auto get_gate_key = [](const ChunkGraph& graph, const uint32_t gate)
+            {
+                return std::make_pair(GetNodePosition(graph, graph.gates[gate].node), static_cast<float>(graph.gates[gate].face));
+            };
+
+            // Arena nodes are gates of the coarse graph
+            PathfindingArena& arena = PathfindingArena::GetThreadLocal();
+            arena.Reset();
+            // Graph and index of the gate of each arena node, graph is nullptr for start and end
+            thread_local std::vector<std::pair<const ChunkGraph*, uint32_t>> arena_gates;
+            arena_gates.clear();
+
+            uint32_t current_index = 0;
+            const auto add_node = [&](const std::pair<Position, float>& key, const ChunkGraph* graph, const uint32_t gate, const float cost)
+            {
+                const uint32_t index = arena.GetOrCreate(key);
+                if (index == arena_gates.size())
+                {
+                    arena_gates.emplace_back(graph, gate);
+                }
+                arena.Relax(index, cost, static_cast<float>(std::abs(key.first.x - end_pos.x) + std::abs(key.first.z - end_pos.z)), current_index);
+            };
+
+            add_node(start_key, nullptr, 0, 0.0f);
+            if (start_graph == end_graph && start_distances[end_node] >= 0)
+            {
+                add_node(end_key, nullptr, 0, static_cast<float>(start_distances[end_node]));
+            }
+
+            bool end_reached = false;
+            int count_visit = 0;
+            while (!arena.IsOpenEmpty() && count_visit < budget_visit)
+            {
+                count_visit++;
+                current_index = arena.PopOpen();
+                // Copy as the arena can grow while adding neighbours
+                const PathfindingArena::Node current_node = arena.GetNode(current_index);
+                if (current_node.pos == end_key)
+                {
+                    end_reached = true;
+                    break;
+                }
+
+                const auto [graph, gate_index] = arena_gates[current_index];
+                // Start, go to the gates of its chunk
+                if (graph == nullptr)
+                {
+                    for (uint32_t i = 0; i < start_graph->gates.size(); ++i)
+                    {
+                        const int distance = start_distances[start_graph->gates[i].node];
+                        if (distance >= 0)
+                        {
+                            add_node(get_gate_key(*start_graph, i), start_graph, i, current_node.cost + distance);
+                        }
+                    }
+                    continue;
+                }
+
+                const Gate& gate = graph->gates[gate_index];
+                if (graph == end_graph && end_distances[gate.node] >= 0)
+                {
+                    add_node(end_key, nullptr, 0, current_node.cost + end_distances[gate.node]);
+                }
+
+                // Other gates of the same chunk
+                for (const auto& [target, distance] : gate.links)
+                {
+                    add_node(get_gate_key(*graph, target), graph, target, current_node.cost + distance);
+                }
+
+                // Facing gates of the next chunk
+                const ChunkGraph* next_graph = GetChunkGraph(cursor, graph->x + face_offsets[gate.face][0], graph->z + face_offsets[gate.face][1], min_y, height);
+                if (next_graph == nullptr)
+                {
+                    continue;
+                }
+                const Position gate_pos = current_node.pos.first;
+                for (uint32_t i = 0; i < next_graph->gates.size(); ++i)
+                {
+                    const Gate& next_gate = next_graph->gates[i];
+                    if (next_gate.face != (gate.face ^ 1) || !AreGatesLinked(*graph, gate, *next_graph, next_gate))
+                    {
+                        continue;
+                    }
+                    const std::pair<Position, float> next_key = get_gate_key(*next_graph, i);
+                    const Position diff = next_key.first - gate_pos;
+                    add_node(next_key, next_graph, i, current_node.cost + std::max(1, std::abs(diff.x) + std::abs(diff.y) + std::abs(diff.z)));
+                }
+            }
+
+            if (end_reached)
+            {
+                for (uint32_t i = current_index; ; i = arena.GetNode(i).parent)
+                {
+                    // Gates on two faces of a corner can be at the same position
+                    if (output.empty() || output.back() != arena.GetNode(i).pos.first)
+                    {
+                        output.push_back(arena.GetNode(i).pos.first);
+                    }
+                    if (arena.GetNode(i).parent == i)
+                    {
+                        break;
+                    }
+                }
+                std::reverse(output.begin(), output.end());
+            }
+        }
+
+        // Forget the chunks that are not used anymore
+        if (chunks.size() > max_cached_chunks)
+        {
+            for (auto it = chunks.begin(); it != chunks.end();)
+            {
+                it = it->second.last_used == search_id ? std::next(it) : chunks.erase(it);
+            }
+        }
+
+        return output;
+    }
+
+    const NavigationGraph::ChunkGraph* NavigationGraph::GetChunkGraph(BlockCursor& cursor, const int chunk_x, const int chunk_z, const int min_y, const int height)
+    {
+        auto it = chunks.find({ chunk_x, chunk_z });
+        // Always use the same graph during a search, even if the chunk changed since
+        if (it != chunks.end() && it->second.last_used == search_id)
+        {
+            return &it->second;
+        }
+
+        const unsigned long long int version = cursor.GetChunkNavigationVersion(chunk_x, chunk_z);
+        if (version == 0)
+        {
+            if (it != chunks.end())
+            {
+                chunks.erase(it);
+            }
+            return nullptr;
+        }
+
+        if (it == chunks.end())
+        {
+            it = chunks.emplace(std::make_pair(chunk_x, chunk_z), ChunkGraph{}).first;
+        }
+
+        ChunkGraph& graph = it->second;
+        graph.last_used = search_id;
+        if (graph.version != version || graph.min_y != min_y || graph.height != height)
+        {
+            graph.x = chunk_x;
+            graph.z = chunk_z;
+            graph.version = version;
+            graph.min_y = min_y;
+            graph.height = height;
+            Build(graph, cursor);
+        }
+        return &graph;
+    }
+
+    void NavigationGraph::Build(ChunkGraph& graph, BlockCursor& cursor)
+    {
+        constexpr size_t num_columns = CHUNK_WIDTH * CHUNK_WIDTH;
+        thread_local std::array<std::vector<short>, num_columns> columns;
+        for (std::vector<short>& c : columns)
+        {
+            c.clear();
+        }
+
+        // Properties of the sections below, at and above the one being processed.
+        // Outside of the world is air, without any property
+        std::array<NavigationColumn, num_columns> below = {};
+        std::array<NavigationColumn, num_columns> current = {};
+        std::array<NavigationColumn, num_columns> above = {};
+        const int num_sections = graph.height / SECTION_HEIGHT;
+        const auto read_section = [&](const int section_y, std::array<NavigationColumn, num_columns>& output)
+        {
+            if (section_y >= num_sections)
+            {
+                output.fill(NavigationColumn());
+                return;
+            }
+            for (int z = 0; z < CHUNK_WIDTH; ++z)
+            {
+                for (int x = 0; x < CHUNK_WIDTH; ++x)
+                {
+                    output[z * CHUNK_WIDTH + x] = cursor.GetNavigationColumn(
+                        Position(graph.x * CHUNK_WIDTH + x, graph.min_y + section_y * SECTION_HEIGHT, graph.z * CHUNK_WIDTH + z), SECTION_HEIGHT);
+                }
+            }
+        };
+
+        read_section(0, current);
+        for (int section_y = 0; section_y < num_sections; ++section_y)
+        {
+            read_section(section_y + 1, above);
+            for (size_t c = 0; c < num_columns; ++c)
+            {
+                const unsigned int solid = GetBits(below[c], current[c], above[c], NavigationProperty::Solid);
+                const unsigned int hazardous = GetBits(below[c], current[c], above[c], NavigationProperty::Hazardous);
+                const unsigned int climbable = GetBits(below[c], current[c], above[c], NavigationProperty::Climbable);
+                const unsigned int fluid = GetBits(below[c], current[c], above[c], NavigationProperty::Fluid);
+
+                const unsigned int passable = ~(solid | hazardous);
+                const unsigned int support = (solid & ~hazardous) | climbable;
+                // Feet and head in passable blocks, and something to stand on (or to hold on to)
+                const unsigned int nodes = ((passable & (passable >> 1) & ((support << 1) | climbable | fluid)) >> 1) & 0xFFFFu;
+                if (nodes == 0)
+                {
+                    continue;
+                }
+                for (int i = 0; i < SECTION_HEIGHT; ++i)
+                {
+                    if ((nodes >> i) & 1u)
+                    {
+                        columns[c].push_back(static_cast<short>(graph.min_y + section_y * SECTION_HEIGHT + i));
+                    }
+                }
+            }
+            below = current;
+            current = above;
+        }
+
+        graph.nodes_y.clear();
+        graph.nodes_column.clear();
+        for (size_t c = 0; c < num_columns; ++c)
+        {
+            graph.column_start[c] = static_cast<uint32_t>(graph.nodes_y.size());
+            graph.nodes_y.insert(graph.nodes_y.end(), columns[c].begin(), columns[c].end());
+            graph.nodes_column.insert(graph.nodes_column.end(), columns[c].size(), static_cast<unsigned char>(c));
+        }
+        graph.column_start[num_columns] = static_cast<uint32_t>(graph.nodes_y.size());
+
+        BuildGates(graph);
+    }
+
+    void NavigationGraph::BuildGates(ChunkGraph& graph)
+    {
+        graph.gates.clear();
+        graph.gate_nodes.clear();
+
+        thread_local std::vector<uint32_t> parents;
+        thread_local std::vector<uint32_t> root_gate;
+        thread_local std::vector<std::vector<uint32_t>> groups;
+        parents.resize(graph.nodes_y.size());
+        root_gate.assign(graph.nodes_y.size(), invalid_node);
+
+        for (unsigned char face = 0; face < 4; ++face)
+        {
+            // Group the standing positions that are connected along the face
+            for (int along = 0; along < CHUNK_WIDTH; ++along)
+            {
+                const int column = GetFaceColumn(face, along);
+                for (uint32_t n = graph.column_start[column]; n < graph.column_start[column + 1]; ++n)
+                {
+                    parents[n] = n;
+                }
+            }
+            for (int along = 0; along < CHUNK_WIDTH; ++along)
+            {
+                const int column = GetFaceColumn(face, along);
+                const int next_column = along + 1 < CHUNK_WIDTH ? GetFaceColumn(face, along + 1) : -1;
+                for (uint32_t n = graph.column_start[column]; n < graph.column_start[column + 1]; ++n)
+                {
+                    if (n + 1 < graph.column_start[column + 1] && graph.nodes_y[n + 1] == graph.nodes_y[n] + 1)
+                    {
+                        parents[Find(parents, n + 1)] = Find(parents, n);
+                    }
+                    if (next_column == -1)
+                    {
+                        continue;
+                    }
+                    for (uint32_t m = graph.column_start[next_column]; m < graph.column_start[next_column + 1]; ++m)
+                    {
+                        if (std::abs(graph.nodes_y[m] - graph.nodes_y[n]) <= 1)
+                        {
+                            parents[Find(parents, m)] = Find(parents, n);
+                        }
+                    }
+                }
+            }
+
+            // One gate per group, nodes are visited along the face so they stay sorted
+            size_t num_groups = 0;
+            for (int along = 0; along < CHUNK_WIDTH; ++along)
+            {
+                const int column = GetFaceColumn(face, along);
+                for (uint32_t n = graph.column_start[column]; n < graph.column_start[column + 1]; ++n)
+                {
+                    const uint32_t root = Find(parents, n);
+                    if (root_gate[root] == invalid_node)
+                    {
+                        root_gate[root] = static_cast<uint32_t>(num_groups);
+                        if (groups.size() <= num_groups)
+                        {
+                            groups.emplace_back();
+                        }
+                        groups[num_groups].clear();
+                        num_groups += 1;
+                    }
+                    groups[root_gate[root]].push_back(n);
+                }
+            }
+            for (size_t i = 0; i < num_groups; ++i)
+            {
+                Gate gate;
+                gate.face = face;
+                // Middle of the gate, so it's not on a corner if possible
+                gate.node = groups[i][groups[i].size() / 2];
+                gate.first_node = static_cast<uint32_t>(graph.gate_nodes.size());
+                graph.gate_nodes.insert(graph.gate_nodes.end(), groups[i].begin(), groups[i].end());
+                gate.last_node = static_cast<uint32_t>(graph.gate_nodes.size());
+                graph.gates.push_back(gate);
+            }
+
+            // Reset for next face, corner columns are on two faces
+            for (int along = 0; along < CHUNK_WIDTH; ++along)
+            {
+                const int column = GetFaceColumn(face, along);
+                for (uint32_t n = graph.column_start[column]; n < graph.column_start[column + 1]; ++n)
+                {
+                    root_gate[n] = invalid_node;
+                }
+            }
+        }
+
+        // Link gates reachable from each other inside the chunk
+        thread_local std::vector<int> distances;
+        for (Gate& gate : graph.gates)
+        {
+            ComputeDistances(graph, gate.node, false, distances);
+            for (uint32_t i = 0; i < graph.gates.size(); ++i)
+            {
+                const int distance = distances[graph.gates[i].node];
+                if (&graph.gates[i] != &gate && distance >= 0)
+                {
+                    gate.links.emplace_back(i, static_cast<float>(distance));
+                }
+            }
+        }
+    }
+
+    void NavigationGraph::ComputeDistances(const ChunkGraph& graph, const uint32_t node, const bool reverse, std::vector<int>& distances)
+    {
+        thread_local std::vector<uint32_t> queue;
+        queue.clear();
+        distances.assign(graph.nodes_y.size(), -1);
+
+        distances[node] = 0;
+        queue.push_back(node);
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            const uint32_t n = queue[i];
+            const int column = graph.nodes_column[n];
+            const int x = column % CHUNK_WIDTH;
+            const int z = column / CHUNK_WIDTH;
+            const int y = graph.nodes_y[n];
+            const auto visit = [&](const uint32_t m)
+            {
+                if (distances[m] < 0)
+                {
+                    distances[m] = distances[n] + 1;
+                    queue.push_back(m);
+                }
+            };
+
+            // Stacked standing positions, climbable or fluid
+            if (n > graph.column_start[column] && graph.nodes_y[n - 1] == y - 1)
+            {
+                visit(n - 1);
+            }
+            if (n + 1 < graph.column_start[column + 1] && graph.nodes_y[n + 1] == y + 1)
+            {
+                visit(n + 1);
+            }
+
+            for (const std::array<int, 2>& offset : face_offsets)
+            {
+                const int next_x = x + offset[0];
+                const int next_z = z + offset[1];
+                if (next_x < 0 || next_x >= CHUNK_WIDTH || next_z < 0 || next_z >= CHUNK_WIDTH)
+                {
+                    continue;
+                }
+                const int next_column = next_z * CHUNK_WIDTH + next_x;
+                for (uint32_t m = graph.column_start[next_column]; m < graph.column_start[next_column + 1]; ++m)
+                {
+                    const int dy = graph.nodes_y[m] - y;
+                    // Walk up/down one block, or drop (only downward, so upward when reversed)
+                    if ((dy >= -1 && dy <= 1) || (reverse ? (dy >= 2 && dy <= 3) : (dy >= -3 && dy <= -2)))
+                    {
+                        visit(m);
+                    }
+                }
+            }
+        }
+    }
+
+    bool NavigationGraph::AreGatesLinked(const ChunkGraph& from_graph, const Gate& from, const ChunkGraph& to_graph, const Gate& to)
+    {
+        // Both gates nodes are sorted along the face
+        uint32_t first_to = to.first_node;
+        for (uint32_t i = from.first_node; i < from.last_node; ++i)
+        {
+            const uint32_t n = from_graph.gate_nodes[i];
+            const int along = GetAlong(from.face, from_graph.nodes_column[n]);
+            while (first_to < to.last_node && GetAlong(to.face, to_graph.nodes_column[to_graph.gate_nodes[first_to]]) < along)
+            {
+                first_to += 1;
+            }
+            for (uint32_t j = first_to; j < to.last_node; ++j)
+            {
+                const uint32_t m = to_graph.gate_nodes[j];
+                if (GetAlong(to.face, to_graph.nodes_column[m]) != along)
+                {
+                    break;
+                }
+                // Walk up/down one block or drop
+                const int dy = to_graph.nodes_y[m] - from_graph.nodes_y[n];
+                if (dy >= -3 && dy <= 1)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    uint32_t NavigationGraph::FindNode(const ChunkGraph& graph, const int x, const int y, const int z)
+    {
+        const int column = z * CHUNK_WIDTH + x;
+        uint32_t output = invalid_node;
+        int best_dist = max_snap_distance + 1;
+        for (uint32_t n = graph.column_start[column]; n < graph.column_start[column + 1]; ++n)
+        {
+            const int dist = std::abs(graph.nodes_y[n] - y);
+            if (dist < best_dist)
+            {
+                best_dist = dist;
+                output = n;
+            }
+        }
+        return output;
+    }
+
+    Position NavigationGraph::GetNodePosition(const ChunkGraph& graph, const uint32_t node)
+    {
+        const int column = graph.nodes_column[node];
+        return Position(graph.x * CHUNK_WIDTH + column % CHUNK_WIDTH, graph.nodes_y[node], graph.z * CHUNK_WIDTH + column / CHUNK_WIDTH);
+    }
+} // Botcraft
@@ -1,25 +1,123 @@
+#include <algorithm>
+
 #include "botcraft/Game/World/Blockstate.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
 #include "botcraft/Game/World/Section.hpp"
+#include "botcraft/Utilities/EpochManager.hpp"
 
 namespace Botcraft
 {
-    Section::Section(const bool has_sky_light)
+    namespace
     {
 #if USE_GUI
         // +2 because we also store the neighbour section blocks
-        data_blocks = std::vector<unsigned short>((CHUNK_WIDTH + 2) * (CHUNK_WIDTH + 2) * SECTION_HEIGHT);
+        static constexpr size_t num_blocks = (CHUNK_WIDTH + 2) * (CHUNK_WIDTH + 2) * SECTION_HEIGHT;
 #else
-        data_blocks = std::vector<unsigned short>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT);
+        static constexpr size_t num_blocks = CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT;
 #endif
+        static constexpr size_t num_light_bytes = CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2;
+
+        // Same values as vanilla for the section palette
+        static constexpr unsigned char min_palette_bits = 4;
+        static constexpr unsigned char max_palette_bits = 8;
+        static constexpr unsigned char min_global_bits = max_palette_bits + 1;
+
+        size_t NumLongs(const unsigned char bits)
+        {
+            if (bits == 0)
+            {
+                return 0;
+            }
+            const size_t values_per_long = 64 / bits;
+            return (num_blocks + values_per_long - 1) / values_per_long;
+        }
 
-        block_light = std::vector<unsigned char>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2);
-        if (has_sky_light)
+        unsigned char BitWidth(unsigned int v)
         {
-            sky_light = std::vector<unsigned char>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2);
+            unsigned char output = 0;
+            while (v != 0)
+            {
+                v >>= 1;
+                output += 1;
+            }
+            return output;
+        }
+
+        unsigned char GetNibble(const std::vector<unsigned char>& values, const unsigned char uniform_value, const int x, const int y, const int z)
+        {
+            if (values.empty())
+            {
+                return uniform_value;
+            }
+            return (values[Section::CoordsToLightIndex(x, y, z)] >> (4 * (x % 2))) & 0x0F;
+        }
+
+        void SetNibble(std::vector<unsigned char>& values, const unsigned char uniform_value, const int x, const int y, const int z, const unsigned char v)
+        {
+            if (values.empty())
+            {
+                if ((v & 0x0F) == uniform_value)
+                {
+                    return;
+                }
+                values = std::vector<unsigned char>(num_light_bytes, uniform_value | (uniform_value << 4));
+            }
+
+            unsigned char* packed_value = values.data() + Section::CoordsToLightIndex(x, y, z);
+            if (x % 2 == 1)
+            {
+                const unsigned char first_value = *packed_value & 0x0F;
+                *packed_value = first_value | ((v & 0x0F) << 4);
+            }
+            else
+            {
+                const unsigned char second_value = *packed_value & 0xF0;
+                *packed_value = second_value | (v & 0x0F);
+            }
+        }
+
+        void LoadNibbles(std::vector<unsigned char>& values, unsigned char& uniform_value, const std::vector<char>& data)
+        {
+            const unsigned char first_value = data.size() == num_light_bytes ? static_cast<unsigned char>(data[0]) : 0;
+            // Keep only the uniform value if all values are the same (fully lit or fully dark section)
+            if (data.size() != num_light_bytes ||
+                ((first_value & 0x0F) == (first_value >> 4) && std::all_of(data.begin(), data.end(), [&](const char c) { return static_cast<unsigned char>(c) == first_value; })))
+            {
+                uniform_value = first_value & 0x0F;
+                values.clear();
+                values.shrink_to_fit();
+                return;
+            }
+
+            values = std::vector<unsigned char>(data.begin(), data.end());
         }
     }
 
+    Section::Section()
+    {
+        // Sections start filled with air
+        blocks = nullptr;
+
+        uniform_block_light = 0;
+        uniform_sky_light = 0;
+    }
+
+    Section::Section(const Section& s) : navigation(s.navigation)
+    {
+        const BlockStorage* storage = s.blocks.load(std::memory_order_acquire);
+        blocks = storage == nullptr ? nullptr : new BlockStorage(*storage);
+
+        block_light = s.block_light;
+        sky_light = s.sky_light;
+        uniform_block_light = s.uniform_block_light;
+        uniform_sky_light = s.uniform_sky_light;
+    }
+
+    Section::~Section()
+    {
+        delete blocks.load();
+    }
+
     size_t Section::CoordsToBlockIndex(const int x, const int y, const int z)
     {
 #if USE_GUI
@@ -33,4 +131,260 @@ namespace Botcraft
     {
         return ((y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x) / 2;
     }
+
+    unsigned short Section::GetBlock(const size_t index) const
+    {
+        const BlockStorage* storage = blocks.load(std::memory_order_acquire);
+        if (storage == nullptr)
+        {
+            return 0;
+        }
+        if (storage->bits_per_block == 0)
+        {
+            return storage->palette[0];
+        }
+
+        const unsigned int value = storage->ReadEntry(index);
+        return storage->global_ids ? static_cast<unsigned short>(value) : storage->palette[value];
+    }
+
+    void Section::SetBlock(const size_t index, const unsigned short id)
+    {
+        // There is only one writer at a time, no need to synchronize with other threads
+        BlockStorage* storage = blocks.load(std::memory_order_relaxed);
+        if (storage == nullptr)
+        {
+            if (id == 0)
+            {
+                return;
+            }
+            storage = new BlockStorage(0, false);
+            storage->palette[0] = 0;
+            storage->palette_size = 1;
+            PublishBlocks(storage);
+        }
+
+        if (!storage->global_ids)
+        {
+            const unsigned short* palette_begin = storage->palette.get();
+            const unsigned short* palette_end = palette_begin + storage->palette_size;
+            const unsigned short* it = std::find(palette_begin, palette_end, id);
+            if (it != palette_end)
+            {
+                if (storage->bits_per_block != 0)
+                {
+                    storage->WriteEntry(index, static_cast<unsigned int>(std::distance(palette_begin, it)));
+                }
+                return;
+            }
+
+            // New value, make some room in the palette if it's full
+            if (storage->palette_size == (size_t{ 1 } << storage->bits_per_block))
+            {
+                if (storage->bits_per_block < max_palette_bits)
+                {
+                    storage = Repack(std::max(min_palette_bits, static_cast<unsigned char>(storage->bits_per_block + 1)), false);
+                }
+                // Promotion to global ids
+                else
+                {
+                    const unsigned short max_id = *std::max_element(palette_begin, palette_end);
+                    storage = Repack(std::max({ min_global_bits, BitWidth(max_id), BitWidth(id) }), true);
+                    storage->WriteEntry(index, id);
+                    return;
+                }
+            }
+            // Palette value is written before the entry using it is released
+            storage->palette[storage->palette_size] = id;
+            storage->palette_size += 1;
+            storage->WriteEntry(index, static_cast<unsigned int>(storage->palette_size - 1));
+            return;
+        }
+
+        if (BitWidth(id) > storage->bits_per_block)
+        {
+            storage = Repack(BitWidth(id), true);
+        }
+        storage->WriteEntry(index, id);
+    }
+
+    void Section::GetBlocks(unsigned short* output) const
+    {
+        const BlockStorage* storage = blocks.load(std::memory_order_acquire);
+        if (storage == nullptr || storage->bits_per_block == 0)
+        {
+            std::fill(output, output + CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT, storage == nullptr ? 0 : storage->palette[0]);
+            return;
+        }
+
+        for (int y = 0; y < SECTION_HEIGHT; ++y)
+        {
+            for (int z = 0; z < CHUNK_WIDTH; ++z)
+            {
+                for (int x = 0; x < CHUNK_WIDTH; ++x)
+                {
+                    const unsigned int value = storage->ReadEntry(CoordsToBlockIndex(x, y, z));
+                    *output = storage->global_ids ? static_cast<unsigned short>(value) : storage->palette[value];
+                    ++output;
+                }
+            }
+        }
+    }
+
+    bool Section::LoadBlocks(const unsigned char bits, const std::vector<int>& section_palette, const std::vector<unsigned long long int>& data)
+    {
+        if (bits > 32 || data.size() != NumLongs(bits) || (bits == 0 && section_palette.size() != 1) ||
+            (!section_palette.empty() && (bits > max_palette_bits || section_palette.size() > (size_t{ 1 } << bits))))
+        {
+            return false;
+        }
+
+        // Don't store anything for air only sections
+        if (bits == 0 && section_palette[0] == 0)
+        {
+            PublishBlocks(nullptr);
+            return true;
+        }
+
+        BlockStorage* storage = new BlockStorage(bits, section_palette.empty());
+        for (size_t i = 0; i < section_palette.size(); ++i)
+        {
+            storage->palette[i] = static_cast<unsigned short>(section_palette[i]);
+        }
+        storage->palette_size = section_palette.size();
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            storage->data[i].store(data[i], std::memory_order_relaxed);
+        }
+        PublishBlocks(storage);
+
+        return true;
+    }
+
+    unsigned char Section::GetBlockLight(const int x, const int y, const int z) const
+    {
+        return GetNibble(block_light, uniform_block_light, x, y, z);
+    }
+
+    void Section::SetBlockLight(const int x, const int y, const int z, const unsigned char v)
+    {
+        SetNibble(block_light, uniform_block_light, x, y, z, v);
+    }
+
+    unsigned char Section::GetSkyLight(const int x, const int y, const int z) const
+    {
+        return GetNibble(sky_light, uniform_sky_light, x, y, z);
+    }
+
+    void Section::SetSkyLight(const int x, const int y, const int z, const unsigned char v)
+    {
+        SetNibble(sky_light, uniform_sky_light, x, y, z, v);
+    }
+
+    void Section::LoadBlockLight(const std::vector<char>& data)
+    {
+        LoadNibbles(block_light, uniform_block_light, data);
+    }
+
+    void Section::LoadSkyLight(const std::vector<char>& data)
+    {
+        LoadNibbles(sky_light, uniform_sky_light, data);
+    }
+
+    SectionNavigation& Section::GetNavigation()
+    {
+        return navigation;
+    }
+
+    const SectionNavigation& Section::GetNavigation() const
+    {
+        return navigation;
+    }
+
+    size_t Section::GetMemorySize() const
+    {
+        const BlockStorage* storage = blocks.load(std::memory_order_acquire);
+        size_t output = sizeof(Section) + block_light.capacity() + sky_light.capacity() + navigation.GetMemorySize();
+        if (storage != nullptr)
+        {
+            output += sizeof(BlockStorage) +
+                (storage->global_ids ? 0 : (size_t{ 1 } << storage->bits_per_block) * sizeof(unsigned short)) +
+                NumLongs(storage->bits_per_block) * sizeof(unsigned long long int);
+        }
+        return output;
+    }
+
+    Section::BlockStorage* Section::Repack(const unsigned char new_bits, const bool to_global)
+    {
+        const BlockStorage* storage = blocks.load(std::memory_order_relaxed);
+        BlockStorage* repacked = new BlockStorage(new_bits, to_global || storage->global_ids);
+        if (!repacked->global_ids)
+        {
+            std::copy(storage->palette.get(), storage->palette.get() + storage->palette_size, repacked->palette.get());
+            repacked->palette_size = storage->palette_size;
+        }
+
+        for (size_t i = 0; i < num_blocks; ++i)
+        {
+            const unsigned int value = storage->bits_per_block == 0 ? 0 : storage->ReadEntry(i);
+            repacked->WriteEntry(i, (repacked->global_ids && !storage->global_ids) ? storage->palette[value] : value);
+        }
+
+        PublishBlocks(repacked);
+        return repacked;
+    }
+
+    void Section::PublishBlocks(BlockStorage* storage)
+    {
+        BlockStorage* previous = blocks.exchange(storage, std::memory_order_acq_rel);
+        if (previous != nullptr)
+        {
+            // Concurrent readers may still be using it
+            Utilities::EpochManager::GetInstance().Retire(std::unique_ptr<const BlockStorage>(previous));
+        }
+    }
+
+    Section::BlockStorage::BlockStorage(const unsigned char bits, const bool global_ids_) : bits_per_block(bits), global_ids(global_ids_)
+    {
+        palette = global_ids ? nullptr : std::make_unique<unsigned short[]>(size_t{ 1 } << bits_per_block);
+        palette_size = 0;
+        const size_t num_longs = NumLongs(bits_per_block);
+        data = std::make_unique<std::atomic<unsigned long long int>[]>(num_longs);
+        for (size_t i = 0; i < num_longs; ++i)
+        {
+            data[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    Section::BlockStorage::BlockStorage(const BlockStorage& s) : BlockStorage(s.bits_per_block, s.global_ids)
+    {
+        if (!global_ids)
+        {
+            std::copy(s.palette.get(), s.palette.get() + s.palette_size, palette.get());
+            palette_size = s.palette_size;
+        }
+        const size_t num_longs = NumLongs(bits_per_block);
+        for (size_t i = 0; i < num_longs; ++i)
+        {
+            data[i].store(s.data[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    unsigned int Section::BlockStorage::ReadEntry(const size_t index) const
+    {
+        const size_t values_per_long = 64 / bits_per_block;
+        const unsigned long long int mask = (1ULL << bits_per_block) - 1;
+        return static_cast<unsigned int>((data[index / values_per_long].load(std::memory_order_acquire) >> ((index % values_per_long) * bits_per_block)) & mask);
+    }
+
+    void Section::BlockStorage::WriteEntry(const size_t index, const unsigned int value)
+    {
+        const size_t values_per_long = 64 / bits_per_block;
+        const size_t offset = (index % values_per_long) * bits_per_block;
+        const unsigned long long int mask = (1ULL << bits_per_block) - 1;
+        std::atomic<unsigned long long int>& packed_value = data[index / values_per_long];
+        // Only one writer, a plain load/store is enough
+        const unsigned long long int current_value = packed_value.load(std::memory_order_relaxed);
+        packed_value.store((current_value & ~(mask << offset)) | ((static_cast<unsigned long long int>(value) & mask) << offset), std::memory_order_release);
+    }
 } // Botcraft
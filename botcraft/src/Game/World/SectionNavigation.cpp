@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "botcraft/Game/AssetsManager.hpp"
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/SectionNavigation.hpp"
+#include "botcraft/Utilities/EpochManager.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Index of the word containing a column, and position of its first bit in this word
+        std::pair<size_t, unsigned int> GetColumnLocation(const int x, const int z)
+        {
+            const int column = z * CHUNK_WIDTH + x;
+            return { static_cast<size_t>(column / 4), static_cast<unsigned int>((column % 4) * SECTION_HEIGHT) };
+        }
+
+        SectionNavigation::BlockProperties ComputeBlockProperties(const Blockstate* block)
+        {
+            SectionNavigation::BlockProperties output{ 0, 0 };
+            if (block == nullptr)
+            {
+                return output;
+            }
+
+            const auto set = [&](const NavigationProperty p) { output.properties |= 1 << static_cast<int>(p); };
+            if (block->IsSolid())
+            {
+                set(NavigationProperty::Solid);
+                // Colliders are relative to the block origin
+                double top = 0.0;
+                for (size_t i = 0; i < block->GetNumModels(); ++i)
+                {
+                    for (const AABB& c : block->GetModel(static_cast<unsigned short>(i)).GetColliders())
+                    {
+                        top = std::max(top, c.GetMax().y);
+                    }
+                }
+                output.height = static_cast<unsigned char>(std::clamp(std::lround(top * SectionNavigation::height_resolution), 0l, 255l));
+                if (output.height != SectionNavigation::height_resolution)
+                {
+                    set(NavigationProperty::PartialHeight);
+                }
+            }
+            if (block->IsHazardous())
+            {
+                set(NavigationProperty::Hazardous);
+            }
+            if (block->IsClimbable())
+            {
+                set(NavigationProperty::Climbable);
+            }
+            if (block->IsFluidOrWaterlogged() && !block->IsSolid())
+            {
+                set(NavigationProperty::Fluid);
+            }
+            if (!block->CanJumpWhenFeetInside())
+            {
+                set(NavigationProperty::NoJump);
+            }
+            return output;
+        }
+
+        std::vector<SectionNavigation::BlockProperties> ComputeAllBlockProperties()
+        {
+            const AssetsManager& assets = AssetsManager::getInstance();
+            std::vector<SectionNavigation::BlockProperties> output(std::numeric_limits<unsigned short>::max() + 1);
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+                BlockstateId id;
+                Blockstate::IdToIdMetadata(static_cast<unsigned int>(i), id.first, id.second);
+#else
+                const BlockstateId id = static_cast<BlockstateId>(i);
+#endif
+                output[i] = ComputeBlockProperties(assets.GetBlockstate(id));
+            }
+            return output;
+        }
+
+        /// @brief Next version given to a section
+        std::atomic<unsigned long long int> next_version = 1;
+    }
+
+    SectionNavigation::SectionNavigation()
+    {
+        // Sections start filled with air, which has no property
+        for (std::atomic<Mask*>& m : masks)
+        {
+            m = nullptr;
+        }
+        uniform_properties = 0;
+        UpdateVersion();
+    }
+
+    SectionNavigation::SectionNavigation(const SectionNavigation& other)
+    {
+        for (size_t i = 0; i < num_properties; ++i)
+        {
+            const Mask* mask = other.masks[i].load(std::memory_order_acquire);
+            Mask* copy = nullptr;
+            if (mask != nullptr)
+            {
+                copy = new Mask();
+                for (size_t j = 0; j < words_per_mask; ++j)
+                {
+                    copy->words[j].store(mask->words[j].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+            }
+            masks[i] = copy;
+        }
+        uniform_properties = other.uniform_properties.load(std::memory_order_relaxed);
+        UpdateVersion();
+    }
+
+    SectionNavigation::~SectionNavigation()
+    {
+        for (std::atomic<Mask*>& m : masks)
+        {
+            delete m.load();
+        }
+    }
+
+    const SectionNavigation::BlockProperties& SectionNavigation::GetBlockProperties(const unsigned short stored_id)
+    {
+        static const std::vector<BlockProperties> properties = ComputeAllBlockProperties();
+        return properties[stored_id];
+    }
+
+    unsigned int SectionNavigation::GetColumn(const NavigationProperty property, const int x, const int z) const
+    {
+        const size_t p = static_cast<size_t>(property);
+        const Mask* mask = masks[p].load(std::memory_order_acquire);
+        if (mask == nullptr)
+        {
+            return ((uniform_properties.load(std::memory_order_relaxed) >> p) & 1) ? 0xFFFFu : 0u;
+        }
+        const auto [word, shift] = GetColumnLocation(x, z);
+        return static_cast<unsigned int>(mask->words[word].load(std::memory_order_relaxed) >> shift) & 0xFFFFu;
+    }
+
+    void SectionNavigation::SetBlock(const int x, const int y, const int z, const unsigned short stored_id)
+    {
+        // There is only one writer at a time, no need to synchronize with other threads
+        const unsigned char properties = GetBlockProperties(stored_id).properties;
+        const auto [word, shift] = GetColumnLocation(x, z);
+        const unsigned long long int bit = 1ULL << (shift + y);
+        bool changed = false;
+        for (size_t p = 0; p < num_properties; ++p)
+        {
+            const bool value = (properties >> p) & 1;
+            Mask* mask = masks[p].load(std::memory_order_relaxed);
+            if (mask == nullptr)
+            {
+                const bool uniform_value = (uniform_properties.load(std::memory_order_relaxed) >> p) & 1;
+                if (value == uniform_value)
+                {
+                    continue;
+                }
+                // Property is not uniform anymore
+                changed = true;
+                const unsigned long long int fill = uniform_value ? ~0ULL : 0ULL;
+                mask = new Mask();
+                for (size_t i = 0; i < words_per_mask; ++i)
+                {
+                    mask->words[i].store(i == word ? fill ^ bit : fill, std::memory_order_relaxed);
+                }
+                PublishMask(p, mask);
+                continue;
+            }
+
+            const unsigned long long int current = mask->words[word].load(std::memory_order_relaxed);
+            if (((current & bit) != 0) == value)
+            {
+                continue;
+            }
+            changed = true;
+            mask->words[word].store(current ^ bit, std::memory_order_relaxed);
+        }
+
+        if (changed)
+        {
+            UpdateVersion();
+        }
+    }
+
+    void SectionNavigation::Load(const unsigned short* blocks)
+    {
+        std::array<std::array<unsigned long long int, words_per_mask>, num_properties> new_masks{};
+        unsigned char any = 0;
+        unsigned char all = 0xFF;
+        for (int y = 0; y < SECTION_HEIGHT; ++y)
+        {
+            for (int z = 0; z < CHUNK_WIDTH; ++z)
+            {
+                for (int x = 0; x < CHUNK_WIDTH; ++x)
+                {
+                    const unsigned char properties = GetBlockProperties(blocks[(y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x]).properties;
+                    any |= properties;
+                    all &= properties;
+                    if (properties == 0)
+                    {
+                        continue;
+                    }
+                    const auto [word, shift] = GetColumnLocation(x, z);
+                    for (size_t p = 0; p < num_properties; ++p)
+                    {
+                        new_masks[p][word] |= static_cast<unsigned long long int>((properties >> p) & 1) << (shift + y);
+                    }
+                }
+            }
+        }
+
+        // Uniform values are published before the masks are removed,
+        // so readers never see a missing mask with an outdated value
+        const unsigned char uniform = ~(any ^ all);
+        const unsigned char previous_uniform_properties = uniform_properties.load(std::memory_order_relaxed);
+        uniform_properties.store((previous_uniform_properties & ~uniform) | (all & uniform), std::memory_order_release);
+
+        for (size_t p = 0; p < num_properties; ++p)
+        {
+            Mask* mask = masks[p].load(std::memory_order_relaxed);
+            if ((uniform >> p) & 1)
+            {
+                if (mask != nullptr)
+                {
+                    PublishMask(p, nullptr);
+                }
+                continue;
+            }
+
+            const bool is_new = mask == nullptr;
+            if (is_new)
+            {
+                mask = new Mask();
+            }
+            for (size_t i = 0; i < words_per_mask; ++i)
+            {
+                mask->words[i].store(new_masks[p][i], std::memory_order_relaxed);
+            }
+            if (is_new)
+            {
+                PublishMask(p, mask);
+            }
+        }
+        UpdateVersion();
+    }
+
+    unsigned long long int SectionNavigation::GetVersion() const
+    {
+        return version.load(std::memory_order_acquire);
+    }
+
+    size_t SectionNavigation::GetMemorySize() const
+    {
+        size_t output = 0;
+        for (const std::atomic<Mask*>& m : masks)
+        {
+            output += m.load(std::memory_order_relaxed) == nullptr ? 0 : sizeof(Mask);
+        }
+        return output;
+    }
+
+    void SectionNavigation::PublishMask(const size_t property, Mask* mask)
+    {
+        Mask* previous = masks[property].exchange(mask, std::memory_order_acq_rel);
+        if (previous != nullptr)
+        {
+            // Concurrent readers may still be using it
+            Utilities::EpochManager::GetInstance().Retire(std::unique_ptr<const Mask>(previous));
+        }
+    }
+
+    void SectionNavigation::UpdateVersion()
+    {
+        // Release so a reader seeing the new version also sees the new blocks
+        version.store(next_version.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+    }
+} // Botcraft
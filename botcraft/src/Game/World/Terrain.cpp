@@ -0,0 +1,305 @@
+#include <stdexcept>
+#include <string>
+
+#include "botcraft/Game/World/Terrain.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Must be a power of two
+        constexpr size_t initial_shard_capacity = 16;
+    }
+
+    TerrainShard::TerrainShard()
+    {
+        num_chunks = 0;
+    }
+
+    TerrainShard::~TerrainShard()
+    {
+
+    }
+
+    std::shared_mutex& TerrainShard::GetMutex() const
+    {
+        return mutex;
+    }
+
+    size_t TerrainShard::Size() const
+    {
+        return num_chunks;
+    }
+
+    Chunk* TerrainShard::Find(const int x, const int z)
+    {
+        const size_t index = FindSlot(x, z);
+        return index == slots.size() ? nullptr : &slots[index]->second;
+    }
+
+    const Chunk* TerrainShard::Find(const int x, const int z) const
+    {
+        const size_t index = FindSlot(x, z);
+        return index == slots.size() ? nullptr : &slots[index]->second;
+    }
+
+    std::pair<Chunk*, bool> TerrainShard::Insert(const int x, const int z, Chunk&& chunk)
+    {
+        if (Chunk* existing = Find(x, z); existing != nullptr)
+        {
+            return { existing, false };
+        }
+
+        // Keep load factor under 0.5 so probe sequences stay short
+        if (2 * (num_chunks + 1) > slots.size())
+        {
+            Rehash(slots.empty() ? initial_shard_capacity : 2 * slots.size());
+        }
+
+        const size_t mask = slots.size() - 1;
+        size_t index = Hash(x, z) & mask;
+        while (slots[index].has_value())
+        {
+            index = (index + 1) & mask;
+        }
+        slots[index].emplace(std::make_pair(x, z), std::move(chunk));
+        num_chunks += 1;
+        return { &slots[index]->second, true };
+    }
+
+    bool TerrainShard::Erase(const int x, const int z)
+    {
+        size_t index = FindSlot(x, z);
+        if (index == slots.size())
+        {
+            return false;
+        }
+
+        slots[index].reset();
+        num_chunks -= 1;
+
+        // Backward shift deletion: move back following entries of the
+        // probe sequence so lookups never need tombstones
+        const size_t mask = slots.size() - 1;
+        size_t next = (index + 1) & mask;
+        while (slots[next].has_value())
+        {
+            const size_t ideal = Hash(slots[next]->first.first, slots[next]->first.second) & mask;
+            // Entry can be moved if the empty slot is between its ideal slot and its current one
+            if (((next - ideal) & mask) >= ((next - index) & mask))
+            {
+                slots[index].emplace(std::move(*slots[next]));
+                slots[next].reset();
+                index = next;
+            }
+            next = (next + 1) & mask;
+        }
+
+        return true;
+    }
+
+    size_t TerrainShard::GetCapacity() const
+    {
+        return slots.size();
+    }
+
+    const TerrainShard::value_type* TerrainShard::GetSlot(const size_t index) const
+    {
+        return slots[index].has_value() ? &slots[index].value() : nullptr;
+    }
+
+    TerrainShard::value_type* TerrainShard::GetSlot(const size_t index)
+    {
+        return slots[index].has_value() ? &slots[index].value() : nullptr;
+    }
+
+    size_t TerrainShard::FindSlot(const int x, const int z) const
+    {
+        if (num_chunks == 0)
+        {
+            return slots.size();
+        }
+
+        const size_t mask = slots.size() - 1;
+        size_t index = Hash(x, z) & mask;
+        while (slots[index].has_value())
+        {
+            if (slots[index]->first.first == x && slots[index]->first.second == z)
+            {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return slots.size();
+    }
+
+    void TerrainShard::Rehash(const size_t new_capacity)
+    {
+        std::vector<std::optional<value_type> > old_slots(new_capacity);
+        std::swap(slots, old_slots);
+
+        const size_t mask = slots.size() - 1;
+        for (std::optional<value_type>& s : old_slots)
+        {
+            if (!s.has_value())
+            {
+                continue;
+            }
+            size_t index = Hash(s->first.first, s->first.second) & mask;
+            while (slots[index].has_value())
+            {
+                index = (index + 1) & mask;
+            }
+            slots[index].emplace(std::move(*s));
+        }
+    }
+
+    size_t TerrainShard::Hash(const int x, const int z)
+    {
+        // Chunks of a shard are mostly in the same regions, so low
+        // bits of the coordinates are the ones that need to be mixed
+        size_t hash = static_cast<size_t>(static_cast<unsigned int>(x)) * 0x9E3779B1u;
+        hash ^= static_cast<size_t>(static_cast<unsigned int>(z)) * 0x85EBCA77u;
+        return hash ^ (hash >> 15);
+    }
+
+
+    size_t Terrain::GetShardIndex(const int x, const int z)
+    {
+        // Floor division, as chunk coordinates can be negative
+        const int region_x = x >= 0 ? x / region_width : (x + 1) / region_width - 1;
+        const int region_z = z >= 0 ? z / region_width : (z + 1) / region_width - 1;
+        const size_t hash = static_cast<size_t>(static_cast<unsigned int>(region_x)) * 73856093 ^ static_cast<size_t>(static_cast<unsigned int>(region_z)) * 19349663;
+        return hash % num_shards;
+    }
+
+    TerrainShard& Terrain::GetShard(const int x, const int z)
+    {
+        return shards[GetShardIndex(x, z)];
+    }
+
+    const TerrainShard& Terrain::GetShard(const int x, const int z) const
+    {
+        return shards[GetShardIndex(x, z)];
+    }
+
+    TerrainShard& Terrain::GetShard(const size_t index)
+    {
+        return shards[index];
+    }
+
+    const TerrainShard& Terrain::GetShard(const size_t index) const
+    {
+        return shards[index];
+    }
+
+
+    TerrainView::Iterator::Iterator(const Terrain* terrain_, const size_t shard_index_) : terrain(terrain_), shard_index(shard_index_), slot_index(0)
+    {
+        if (shard_index < Terrain::num_shards)
+        {
+            lock = std::shared_lock<std::shared_mutex>(terrain->GetShard(shard_index).GetMutex());
+            Advance();
+        }
+    }
+
+    const TerrainShard::value_type& TerrainView::Iterator::operator*() const
+    {
+        return *terrain->GetShard(shard_index).GetSlot(slot_index);
+    }
+
+    const TerrainShard::value_type* TerrainView::Iterator::operator->() const
+    {
+        return terrain->GetShard(shard_index).GetSlot(slot_index);
+    }
+
+    TerrainView::Iterator& TerrainView::Iterator::operator++()
+    {
+        slot_index += 1;
+        Advance();
+        return *this;
+    }
+
+    bool TerrainView::Iterator::operator==(const Iterator& other) const
+    {
+        return shard_index == other.shard_index && slot_index == other.slot_index;
+    }
+
+    bool TerrainView::Iterator::operator!=(const Iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    void TerrainView::Iterator::Advance()
+    {
+        while (shard_index < Terrain::num_shards)
+        {
+            const TerrainShard& shard = terrain->GetShard(shard_index);
+            for (; slot_index < shard.GetCapacity(); ++slot_index)
+            {
+                if (shard.GetSlot(slot_index) != nullptr)
+                {
+                    return;
+                }
+            }
+
+            // Release this shard before locking the next one
+            lock.unlock();
+            shard_index += 1;
+            slot_index = 0;
+            if (shard_index < Terrain::num_shards)
+            {
+                lock = std::shared_lock<std::shared_mutex>(terrain->GetShard(shard_index).GetMutex());
+            }
+        }
+    }
+
+    TerrainView::TerrainView(const Terrain& terrain_) : terrain(&terrain_)
+    {
+
+    }
+
+    TerrainView::Iterator TerrainView::begin() const
+    {
+        return Iterator(terrain, 0);
+    }
+
+    TerrainView::Iterator TerrainView::end() const
+    {
+        return Iterator(terrain, Terrain::num_shards);
+    }
+
+    size_t TerrainView::size() const
+    {
+        size_t output = 0;
+        for (size_t i = 0; i < Terrain::num_shards; ++i)
+        {
+            const TerrainShard& shard = terrain->GetShard(i);
+            std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+            output += shard.Size();
+        }
+        return output;
+    }
+
+    Utilities::ScopeLockedWrapper<const Chunk, std::shared_mutex, std::shared_lock> TerrainView::at(const std::pair<int, int>& coords) const
+    {
+        const TerrainShard& shard = terrain->GetShard(coords.first, coords.second);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(coords.first, coords.second);
+        if (chunk == nullptr)
+        {
+            throw std::out_of_range("Chunk (" + std::to_string(coords.first) + ", " + std::to_string(coords.second) + ") is not loaded");
+        }
+        return Utilities::ScopeLockedWrapper<const Chunk, std::shared_mutex, std::shared_lock>(*chunk, std::move(lock));
+    }
+
+    const TerrainView* TerrainView::operator->() const
+    {
+        return this;
+    }
+
+    TerrainView TerrainView::operator*() const
+    {
+        return *this;
+    }
+} // Botcraft
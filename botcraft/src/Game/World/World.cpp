@@ -1,11 +1,35 @@
+#include <algorithm>
+#include <array>
+
 #include "botcraft/Game/AssetsManager.hpp"
+#include "botcraft/Game/World/BlockChangeLog.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/ChunkIndex.hpp"
+#include "botcraft/Game/World/NavigationGraph.hpp"
+#include "botcraft/Game/World/Section.hpp"
 #include "botcraft/Game/World/World.hpp"
+#include "botcraft/Network/NetworkManager.hpp"
 
+#include "botcraft/Utilities/EpochManager.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 
 namespace Botcraft
 {
+    namespace
+    {
+        /// @brief Get the loader id for chunks loaded/unloaded by a packet
+        /// @return The connection the packet comes from, or current thread if unknown
+        ChunkLoaderId GetPacketLoaderId()
+        {
+            const size_t connection_id = NetworkManager::GetCurrentConnectionId();
+            if (connection_id == 0)
+            {
+                return std::this_thread::get_id();
+            }
+            return connection_id;
+        }
+    }
+
     World::World(const bool is_shared_) : is_shared(is_shared_)
     {
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -17,6 +41,9 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
         world_interaction_sequence_id = 0;
 #endif
+        chunk_index = std::make_unique<ChunkIndex>();
+        navigation_graph = std::make_unique<NavigationGraph>();
+        change_log = std::make_unique<BlockChangeLog>();
     }
 
     World::~World()
@@ -26,12 +53,12 @@ namespace Botcraft
 
     bool World::IsLoaded(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        Utilities::EpochReadGuard guard;
 
         const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
         const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
 
-        return terrain.find({ chunk_x, chunk_z }) != terrain.end();
+        return chunk_index->Find(chunk_x, chunk_z) != nullptr;
     }
 
     bool World::IsShared() const
@@ -72,13 +99,14 @@ namespace Botcraft
     bool World::HasChunkBeenModified(const int x, const int z)
     {
 #if USE_GUI
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({ x,z });
-        if (it == terrain.end())
+        const TerrainShard& shard = terrain.GetShard(x, z);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(x, z);
+        if (chunk == nullptr)
         {
             return true;
         }
-        return it->second.GetModifiedSinceLastRender();
+        return chunk->GetModifiedSinceLastRender();
 #else
         return false;
 #endif
@@ -87,85 +115,111 @@ namespace Botcraft
     std::optional<Chunk> World::ResetChunkModificationState(const int x, const int z)
     {
 #if USE_GUI
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({ x,z });
-        if (it == terrain.end())
+        TerrainShard& shard = terrain.GetShard(x, z);
+        std::scoped_lock<std::shared_mutex> lock(shard.GetMutex());
+        Chunk* chunk = shard.Find(x, z);
+        if (chunk == nullptr)
         {
             return std::optional<Chunk>();
         }
-        it->second.SetModifiedSinceLastRender(false);
-        return std::optional<Chunk>(it->second);
+        chunk->SetModifiedSinceLastRender(false);
+        return std::optional<Chunk>(*chunk);
 #else
         return std::optional<Chunk>();
 #endif
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-    void World::LoadChunk(const int x, const int z, const Dimension dim, const std::thread::id& loader_id)
+    void World::LoadChunk(const int x, const int z, const Dimension dim, const ChunkLoaderId& loader_id)
 #else
-    void World::LoadChunk(const int x, const int z, const std::string& dim, const std::thread::id& loader_id)
+    void World::LoadChunk(const int x, const int z, const std::string& dim, const ChunkLoaderId& loader_id)
 #endif
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        TerrainWriteLock terrain_lock = LockChunkForWrite(x, z);
         LoadChunkImpl(x, z, dim, loader_id);
     }
 
-    void World::UnloadChunk(const int x, const int z, const std::thread::id& loader_id)
+    void World::UnloadChunk(const int x, const int z, const ChunkLoaderId& loader_id)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        TerrainWriteLock terrain_lock = LockChunkForWrite(x, z);
         UnloadChunkImpl(x, z, loader_id);
     }
 
-    void World::UnloadAllChunks(const std::thread::id& loader_id)
+    void World::UnloadAllChunks(const ChunkLoaderId& loader_id)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
-        for (auto it = terrain.begin(); it != terrain.end();)
+        std::vector<std::pair<int, int> > unloaded;
+        // Shards are processed one at a time so other shards can still be used meanwhile
+        for (size_t i = 0; i < Terrain::num_shards; ++i)
         {
-            const int load_count = it->second.RemoveLoader(loader_id);
-            if (load_count == 0)
+            TerrainShard& shard = terrain.GetShard(i);
+            std::scoped_lock<std::shared_mutex> lock(shard.GetMutex());
+            unloaded.clear();
+            for (size_t j = 0; j < shard.GetCapacity(); ++j)
             {
-                terrain.erase(it++);
+                TerrainShard::value_type* slot = shard.GetSlot(j);
+                if (slot != nullptr && slot->second.RemoveLoader(loader_id) == 0)
+                {
+                    unloaded.push_back(slot->first);
+                }
             }
-            else
+            for (const auto& [x, z] : unloaded)
             {
-                ++it;
+                shard.Erase(x, z);
+                chunk_index->Update(x, z, nullptr);
+                change_log->AddChunk(x, z);
             }
         }
     }
 
     void World::SetBlock(const Position& pos, const BlockstateId id)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        TerrainWriteLock terrain_lock = LockChunkForWrite(
+            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
+            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
+        );
         SetBlockImpl(pos, id);
     }
 
     const Blockstate* World::GetBlock(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        Utilities::EpochReadGuard guard;
         return GetBlockImpl(pos);
     }
 
     std::vector<const Blockstate*> World::GetBlocks(const std::vector<Position>& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        BlockCursor cursor = GetBlockCursor();
         std::vector<const Blockstate*> output(pos.size());
         for (size_t i = 0; i < pos.size(); ++i)
         {
-            output[i] = GetBlockImpl(pos[i]);
+            output[i] = cursor.GetBlock(pos[i]);
         }
 
         return output;
     }
 
+    BlockCursor World::GetBlockCursor() const
+    {
+        return BlockCursor(*chunk_index);
+    }
+
     std::vector<AABB> World::GetColliders(const AABB& aabb, const Vector3<double>& movement) const
+    {
+        std::vector<AABB> output;
+        output.reserve(32);
+        GetColliders(aabb, movement, output);
+        return output;
+    }
+
+    void World::GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output) const
     {
         const AABB movement_extended_aabb(aabb.GetCenter() + movement * 0.5, aabb.GetHalfSize() + movement.Abs() * 0.5);
         const Vector3<double> min_aabb = movement_extended_aabb.GetMin();
         const Vector3<double> max_aabb = movement_extended_aabb.GetMax();
-        std::vector<AABB> output;
-        output.reserve(32);
+        output.clear();
         Position current_pos;
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        BlockCursor cursor = GetBlockCursor();
         for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
         {
             current_pos.y = y;
@@ -175,29 +229,27 @@ namespace Botcraft
                 for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
                 {
                     current_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(current_pos);
+                    const Blockstate* block = cursor.GetBlock(current_pos);
                     if (block == nullptr || !block->IsSolid())
                     {
                         continue;
                     }
 
-                    const std::set<AABB> colliders = block->GetCollidersAtPos(current_pos);
-                    output.insert(output.end(), colliders.begin(), colliders.end());
+                    block->AppendCollidersAtPos(current_pos, output);
                 }
             }
         }
-        return output;
     }
 
     Vector3<double> World::GetFlow(const Position& pos)
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        BlockCursor cursor = GetBlockCursor();
         Vector3<double> flow(0.0);
         std::vector<Position> horizontal_neighbours = {
             Position(0, 0, -1), Position(1, 0, 0),
             Position(0, 0, 1), Position(-1, 0, 0)
         };
-        const Blockstate* block = GetBlockImpl(pos);
+        const Blockstate* block = cursor.GetBlock(pos);
         if (block == nullptr || !block->IsFluidOrWaterlogged())
         {
             return flow;
@@ -206,7 +258,7 @@ namespace Botcraft
         const float current_fluid_height = block->GetFluidHeight();
         for (const Position& neighbour_pos : horizontal_neighbours)
         {
-            const Blockstate* neighbour = GetBlockImpl(pos + neighbour_pos);
+            const Blockstate* neighbour = cursor.GetBlock(pos + neighbour_pos);
             if (neighbour == nullptr || (neighbour->IsFluidOrWaterlogged() && neighbour->IsWaterOrWaterlogged() != block->IsWaterOrWaterlogged()))
             {
                 continue;
@@ -216,7 +268,7 @@ namespace Botcraft
             {
                 if (!neighbour->IsSolid())
                 {
-                    const Blockstate* block_below_neighbour = GetBlockImpl(pos + neighbour_pos + Position(0, -1, 0));
+                    const Blockstate* block_below_neighbour = cursor.GetBlock(pos + neighbour_pos + Position(0, -1, 0));
                     if (block_below_neighbour != nullptr &&
                         (!block_below_neighbour->IsFluidOrWaterlogged() || block_below_neighbour->IsWaterOrWaterlogged() == block->IsWaterOrWaterlogged()))
                     {
@@ -240,12 +292,12 @@ namespace Botcraft
         {
             for (const Position& neighbour_pos : horizontal_neighbours)
             {
-                const Blockstate* neighbour = GetBlockImpl(pos + neighbour_pos);
+                const Blockstate* neighbour = cursor.GetBlock(pos + neighbour_pos);
                 if (neighbour == nullptr)
                 {
                     continue;
                 }
-                const Blockstate* above_neighbour = GetBlockImpl(pos + neighbour_pos + Position(0, 1, 0));
+                const Blockstate* above_neighbour = cursor.GetBlock(pos + neighbour_pos + Position(0, 1, 0));
                 if (above_neighbour == nullptr)
                 {
                     continue;
@@ -263,9 +315,106 @@ namespace Botcraft
         return flow;
     }
 
-    Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock> World::GetChunks() const
+    TerrainView World::GetChunks() const
     {
-        return Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock>(terrain, world_mutex);
+        return TerrainView(terrain);
+    }
+
+    std::vector<Position> World::FindBlocks(const std::string& name, const Position& center, const int radius, const size_t max_results) const
+    {
+        return FindBlocks(AssetsManager::getInstance().GetBlockstateIds(name), center, radius, max_results);
+    }
+
+    std::vector<Position> World::FindBlocks(const std::vector<BlockstateId>& ids, const Position& center, const int radius, const size_t max_results) const
+    {
+        if (ids.empty() || radius < 0 || max_results == 0)
+        {
+            return {};
+        }
+
+        const long long int sqr_radius = static_cast<long long int>(radius) * radius;
+        const auto sqr_dist = [&](const Position& p)
+        {
+            const long long int dx = static_cast<long long int>(p.x) - center.x;
+            const long long int dy = static_cast<long long int>(p.y) - center.y;
+            const long long int dz = static_cast<long long int>(p.z) - center.z;
+            return dx * dx + dy * dy + dz * dz;
+        };
+        const int min_y = static_cast<int>(std::max<long long int>(std::numeric_limits<int>::min(), static_cast<long long int>(center.y) - radius));
+        const int max_y = static_cast<int>(std::min<long long int>(std::numeric_limits<int>::max(), static_cast<long long int>(center.y) + radius));
+
+        std::vector<std::pair<long long int, Position> > found;
+        std::vector<Position> chunk_blocks;
+        for (size_t i = 0; i < Terrain::num_shards; ++i)
+        {
+            const TerrainShard& shard = terrain.GetShard(i);
+            std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+            for (size_t slot = 0; slot < shard.GetCapacity(); ++slot)
+            {
+                const TerrainShard::value_type* value = shard.GetSlot(slot);
+                if (value == nullptr)
+                {
+                    continue;
+                }
+
+                // Skip chunks whose closest block column is already too far
+                const int chunk_min_x = value->first.first * CHUNK_WIDTH;
+                const int chunk_min_z = value->first.second * CHUNK_WIDTH;
+                const Position closest(
+                    std::clamp(center.x, chunk_min_x, chunk_min_x + CHUNK_WIDTH - 1),
+                    center.y,
+                    std::clamp(center.z, chunk_min_z, chunk_min_z + CHUNK_WIDTH - 1)
+                );
+                if (sqr_dist(closest) > sqr_radius)
+                {
+                    continue;
+                }
+
+                chunk_blocks.clear();
+                value->second.FindBlocks(ids, min_y, max_y, chunk_blocks);
+                for (const Position& p : chunk_blocks)
+                {
+                    const Position world_pos(chunk_min_x + p.x, p.y, chunk_min_z + p.z);
+                    const long long int d = sqr_dist(world_pos);
+                    if (d <= sqr_radius)
+                    {
+                        found.emplace_back(d, world_pos);
+                    }
+                }
+            }
+        }
+
+        // Sort by distance, then by coordinates so the order doesn't depend on chunks storage
+        const auto nearest_first = [](const std::pair<long long int, Position>& a, const std::pair<long long int, Position>& b)
+        {
+            return a.first < b.first || (a.first == b.first && a.second < b.second);
+        };
+        if (max_results < found.size())
+        {
+            std::partial_sort(found.begin(), found.begin() + max_results, found.end(), nearest_first);
+            found.resize(max_results);
+        }
+        else
+        {
+            std::sort(found.begin(), found.end(), nearest_first);
+        }
+
+        std::vector<Position> output(found.size());
+        std::transform(found.begin(), found.end(), output.begin(), [](const std::pair<long long int, Position>& p) { return p.second; });
+        return output;
+    }
+
+    std::vector<Position> World::FindRoute(const Position& start, const Position& end) const
+    {
+        const int min_y = GetMinY();
+        const int height = GetHeight();
+        BlockCursor cursor = GetBlockCursor();
+        return navigation_graph->FindRoute(cursor, min_y, height, start, end);
+    }
+
+    bool World::GetChanges(unsigned long long int& since, std::vector<Position>& blocks, std::vector<std::pair<int, int>>& chunks) const
+    {
+        return change_log->Get(since, blocks, chunks);
     }
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
@@ -276,7 +425,10 @@ namespace Botcraft
     void World::SetBiome(const int x, const int y, const int z, const int biome)
 #endif
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        std::scoped_lock<std::shared_mutex> lock(terrain.GetShard(
+            static_cast<int>(std::floor(x / static_cast<double>(CHUNK_WIDTH))),
+            static_cast<int>(std::floor(z / static_cast<double>(CHUNK_WIDTH)))
+        ).GetMutex());
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
         SetBiomeImpl(x, z, biome);
 #else
@@ -286,12 +438,12 @@ namespace Botcraft
 
     const Biome* World::GetBiome(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
-        if (it == terrain.end())
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        const TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(chunk_x, chunk_z);
+        if (chunk == nullptr)
         {
             return nullptr;
         }
@@ -300,86 +452,90 @@ namespace Botcraft
         const int in_chunk_z = (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
 
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
-        return it->second.GetBiome(in_chunk_x, in_chunk_z);
+        return chunk->GetBiome(in_chunk_x, in_chunk_z);
 #else
-        return it->second.GetBiome(in_chunk_x, pos.y, in_chunk_z);
+        return chunk->GetBiome(in_chunk_x, pos.y, in_chunk_z);
 #endif
     }
 
     void World::SetSkyLight(const Position& pos, const unsigned char skylight)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::scoped_lock<std::shared_mutex> lock(shard.GetMutex());
+        Chunk* chunk = shard.Find(chunk_x, chunk_z);
 
-        if (it != terrain.end() && it->second.GetHasSkyLight())
+        if (chunk != nullptr && chunk->GetHasSkyLight())
         {
             const int in_chunk_x = (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
             const int in_chunk_z = (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
-            it->second.SetSkyLight(Position(in_chunk_x, pos.y, in_chunk_z), skylight);
+            chunk->SetSkyLight(Position(in_chunk_x, pos.y, in_chunk_z), skylight);
+            // Setting a light value can create a new section
+            chunk_index->Update(chunk_x, chunk_z, chunk);
         }
     }
 
     void World::SetBlockLight(const Position& pos, const unsigned char blocklight)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::scoped_lock<std::shared_mutex> lock(shard.GetMutex());
+        Chunk* chunk = shard.Find(chunk_x, chunk_z);
 
-        if (it != terrain.end())
+        if (chunk != nullptr)
         {
             const int in_chunk_x = (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
             const int in_chunk_z = (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
-            it->second.SetBlockLight(Position(in_chunk_x, pos.y, in_chunk_z), blocklight);
+            chunk->SetBlockLight(Position(in_chunk_x, pos.y, in_chunk_z), blocklight);
+            // Setting a light value can create a new section
+            chunk_index->Update(chunk_x, chunk_z, chunk);
         }
     }
 
     unsigned char World::GetSkyLight(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
-        if (it == terrain.end())
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        const TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(chunk_x, chunk_z);
+        if (chunk == nullptr)
         {
             return 0;
         }
 
         const int in_chunk_x = (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
         const int in_chunk_z = (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
-        return it->second.GetSkyLight(Position(in_chunk_x, pos.y, in_chunk_z));
+        return chunk->GetSkyLight(Position(in_chunk_x, pos.y, in_chunk_z));
     }
 
     unsigned char World::GetBlockLight(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
-        if (it == terrain.end())
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        const TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(chunk_x, chunk_z);
+        if (chunk == nullptr)
         {
             return 0;
         }
 
         const int in_chunk_x = (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
         const int in_chunk_z = (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH;
-        return it->second.GetBlockLight(Position(in_chunk_x, pos.y, in_chunk_z));
+        return chunk->GetBlockLight(Position(in_chunk_x, pos.y, in_chunk_z));
     }
 
     void World::SetBlockEntityData(const Position& pos, const ProtocolCraft::NBT::Value& data)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
-        if (it == terrain.end())
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::scoped_lock<std::shared_mutex> lock(shard.GetMutex());
+        Chunk* chunk = shard.Find(chunk_x, chunk_z);
+        if (chunk == nullptr)
         {
             return;
         }
@@ -392,23 +548,23 @@ namespace Botcraft
 
         if (data.HasData())
         {
-            it->second.SetBlockEntityData(chunk_pos, data);
+            chunk->SetBlockEntityData(chunk_pos, data);
         }
         else
         {
-            it->second.RemoveBlockEntityData(chunk_pos);
+            chunk->RemoveBlockEntityData(chunk_pos);
         }
     }
 
     ProtocolCraft::NBT::Value World::GetBlockEntityData(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({
-            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
-            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
-        });
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+        const TerrainShard& shard = terrain.GetShard(chunk_x, chunk_z);
+        std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+        const Chunk* chunk = shard.Find(chunk_x, chunk_z);
 
-        if (it == terrain.end())
+        if (chunk == nullptr)
         {
             return ProtocolCraft::NBT::Value();
         }
@@ -419,7 +575,7 @@ namespace Botcraft
             (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH
         );
 
-        return it->second.GetBlockEntityData(chunk_pos);
+        return chunk->GetBlockEntityData(chunk_pos);
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -428,18 +584,24 @@ namespace Botcraft
     std::string World::GetDimension(const int x, const int z) const
 #endif
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        auto it = terrain.find({ x, z });
-        if (it == terrain.end())
-        {
+        size_t dim_index;
+        { // lock scope
+            const TerrainShard& shard = terrain.GetShard(x, z);
+            std::shared_lock<std::shared_mutex> lock(shard.GetMutex());
+            const Chunk* chunk = shard.Find(x, z);
+            if (chunk == nullptr)
+            {
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-            return Dimension::None;
+                return Dimension::None;
 #else
-            return "";
+                return "";
 #endif
+            }
+            dim_index = chunk->GetDimensionIndex();
         }
 
-        return index_dimension_map.at(it->second.GetDimensionIndex());
+        std::scoped_lock<std::mutex> lock(dimension_index_mutex);
+        return index_dimension_map.at(dim_index);
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -545,15 +707,17 @@ namespace Botcraft
 
         const float radius = max_radius / static_cast<float>(std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z));
 
+        Utilities::EpochReadGuard guard;
         while (true)
         {
-            const Blockstate* block = GetBlock(out_pos);
+            const Blockstate* block = GetBlockImpl(out_pos);
 
             if (block != nullptr && !block->IsAir())
             {
-                for (const auto& collider : block->GetCollidersAtPos(out_pos))
+                const Vector3<double> offset = block->GetHorizontalOffsetAtPos(out_pos);
+                for (const auto& collider : block->GetLocalColliders(out_pos))
                 {
-                    if (collider.Intersect(origin, direction))
+                    if ((collider + offset).Intersect(origin, direction))
                     {
                         return block;
                     }
@@ -612,7 +776,7 @@ namespace Botcraft
 
     bool World::IsFree(const AABB& aabb, const bool fluid_collide) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        BlockCursor cursor = GetBlockCursor();
 
         const Vector3<double> min_aabb = aabb.GetMin();
         const Vector3<double> max_aabb = aabb.GetMax();
@@ -627,7 +791,7 @@ namespace Botcraft
                 for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
                 {
                     cube_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(cube_pos);
+                    const Blockstate* block = cursor.GetBlock(cube_pos);
 
                     if (block == nullptr)
                     {
@@ -646,9 +810,10 @@ namespace Botcraft
                         continue;
                     }
 
-                    for (const auto& collider : block->GetCollidersAtPos(cube_pos))
+                    const Vector3<double> offset = block->GetHorizontalOffsetAtPos(cube_pos);
+                    for (const auto& collider : block->GetLocalColliders(cube_pos))
                     {
-                        if (aabb.Collide(collider))
+                        if (aabb.Collide(collider + offset))
                         {
                             return false;
                         }
@@ -662,7 +827,7 @@ namespace Botcraft
 
     std::optional<Position> World::GetSupportingBlockPos(const AABB& aabb) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        BlockCursor cursor = GetBlockCursor();
 
         const Vector3<double> min_aabb = aabb.GetMin();
         const Vector3<double> max_aabb = aabb.GetMax();
@@ -679,15 +844,17 @@ namespace Botcraft
                 for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
                 {
                     cube_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(cube_pos);
+                    const Blockstate* block = cursor.GetBlock(cube_pos);
 
                     if (block == nullptr || !block->IsSolid())
                     {
                         continue;
                     }
 
-                    for (const auto& collider : block->GetCollidersAtPos(cube_pos))
+                    const Vector3<double> offset = block->GetHorizontalOffsetAtPos(cube_pos);
+                    for (const auto& local_collider : block->GetLocalColliders(cube_pos))
                     {
+                        const AABB collider = local_collider + offset;
                         if (aabb.Collide(collider))
                         {
                             const double distance = aabb.GetCenter().SqrDist(collider.GetCenter());
@@ -739,7 +906,7 @@ namespace Botcraft
 
     void World::Handle(ProtocolCraft::ClientboundRespawnPacket& packet)
     {
-        UnloadAllChunks(std::this_thread::get_id());
+        UnloadAllChunks(GetPacketLoaderId());
 
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -761,21 +928,25 @@ namespace Botcraft
 
     void World::Handle(ProtocolCraft::ClientboundBlockUpdatePacket& packet)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        const Position pos = packet.GetPos();
+        TerrainWriteLock terrain_lock = LockChunkForWrite(
+            static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
+            static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
+        );
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
         int id;
         unsigned char metadata;
         Blockstate::IdToIdMetadata(packet.GetBlockstate(), id, metadata);
-        SetBlockImpl(packet.GetPos(), { id, metadata });
+        SetBlockImpl(pos, { id, metadata });
 #else
-        SetBlockImpl(packet.GetPos(), packet.GetBlockstate());
+        SetBlockImpl(pos, packet.GetBlockstate());
 #endif
     }
 
     void World::Handle(ProtocolCraft::ClientboundSectionBlocksUpdatePacket& packet)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
 #if PROTOCOL_VERSION < 739 /* < 1.16.2 */
+        TerrainWriteLock terrain_lock = LockChunkForWrite(packet.GetChunkX(), packet.GetChunkZ());
         for (size_t i = 0; i < packet.GetRecords().size(); ++i)
         {
             unsigned char x = (packet.GetRecords()[i].GetHorizontalPosition() >> 4) & 0x0F;
@@ -789,6 +960,7 @@ namespace Botcraft
         const int chunk_z = CHUNK_WIDTH * (packet.GetSectionPos() << 22 >> 42); // 22 bits
         const int chunk_y = SECTION_HEIGHT * (packet.GetSectionPos() << 44 >> 44); // 20 bits
 
+        TerrainWriteLock terrain_lock = LockChunkForWrite(chunk_x / CHUNK_WIDTH, chunk_z / CHUNK_WIDTH);
         for (size_t i = 0; i < packet.GetPosState().size(); ++i)
         {
             const unsigned int block_id = packet.GetPosState()[i] >> 12;
@@ -819,9 +991,9 @@ namespace Botcraft
     void World::Handle(ProtocolCraft::ClientboundForgetLevelChunkPacket& packet)
     {
 #if PROTOCOL_VERSION < 764 /* < 1.20.2 */
-        UnloadChunk(packet.GetX(), packet.GetZ(), std::this_thread::get_id());
+        UnloadChunk(packet.GetX(), packet.GetZ(), GetPacketLoaderId());
 #else
-        UnloadChunk(packet.GetPos().GetX(), packet.GetPos().GetZ(), std::this_thread::get_id());
+        UnloadChunk(packet.GetPos().GetX(), packet.GetPos().GetZ(), GetPacketLoaderId());
 #endif
     }
 
@@ -833,20 +1005,24 @@ namespace Botcraft
         if (packet.GetFullChunk())
         {
 #endif
-            LoadChunk(packet.GetX(), packet.GetZ(), current_dimension, std::this_thread::get_id());
+            LoadChunk(packet.GetX(), packet.GetZ(), current_dimension, GetPacketLoaderId());
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
         }
 #endif
 
         { // lock scope
+            // world_mutex protects delayed_light_updates
             std::scoped_lock<std::shared_mutex> lock(world_mutex);
+            TerrainWriteLock terrain_lock = LockChunkForWrite(packet.GetX(), packet.GetZ());
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
             if (auto it = delayed_light_updates.find({ packet.GetX(), packet.GetZ() }); it != delayed_light_updates.end())
             {
-                UpdateChunkLight(it->second.GetX(), it->second.GetZ(), current_dimension,
-                    it->second.GetSkyYMask(), it->second.GetEmptySkyYMask(), it->second.GetSkyUpdates(), true);
-                UpdateChunkLight(it->second.GetX(), it->second.GetZ(), current_dimension,
-                    it->second.GetBlockYMask(), it->second.GetEmptyBlockYMask(), it->second.GetBlockUpdates(), false);
+                Chunk* chunk = GetChunk(packet.GetX(), packet.GetZ());
+                if (chunk != nullptr)
+                {
+                    UpdateChunkLight(*chunk, it->second.GetSkyYMask(), it->second.GetEmptySkyYMask(), it->second.GetSkyUpdates(), true);
+                    UpdateChunkLight(*chunk, it->second.GetBlockYMask(), it->second.GetEmptyBlockYMask(), it->second.GetBlockUpdates(), false);
+                }
                 delayed_light_updates.erase(it);
             }
 #endif
@@ -869,41 +1045,62 @@ namespace Botcraft
 #endif
 #endif
             LoadBlockEntityDataInChunk(packet.GetX(), packet.GetZ(), packet.GetBlockEntitiesTags());
+            chunk_index->Update(packet.GetX(), packet.GetZ(), GetChunk(packet.GetX(), packet.GetZ()));
         }
     }
 #else
     void World::Handle(ProtocolCraft::ClientboundLevelChunkWithLightPacket& packet)
     {
-            std::scoped_lock<std::shared_mutex> lock(world_mutex);
-            LoadChunkImpl(packet.GetX(), packet.GetZ(), current_dimension, std::this_thread::get_id());
-            LoadDataInChunk(packet.GetX(), packet.GetZ(), packet.GetChunkData().GetBuffer());
-            LoadBlockEntityDataInChunk(packet.GetX(), packet.GetZ(), packet.GetChunkData().GetBlockEntitiesData());
-            UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-                packet.GetLightData().GetSkyYMask(), packet.GetLightData().GetEmptySkyYMask(), packet.GetLightData().GetSkyUpdates(), true);
-            UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-                packet.GetLightData().GetBlockYMask(), packet.GetLightData().GetEmptyBlockYMask(), packet.GetLightData().GetBlockUpdates(), false);
+        std::optional<Chunk> chunk;
+        { // lock scope
+            std::shared_lock<std::shared_mutex> lock(world_mutex);
+            chunk = CreateChunkImpl(current_dimension);
+        }
+
+        // Decode everything without holding the lock, as this
+        // is by far the most expensive part of loading a chunk
+        chunk->LoadChunkData(packet.GetChunkData().GetBuffer());
+        chunk->LoadChunkBlockEntitiesData(packet.GetChunkData().GetBlockEntitiesData());
+        UpdateChunkLight(*chunk, packet.GetLightData().GetSkyYMask(), packet.GetLightData().GetEmptySkyYMask(), packet.GetLightData().GetSkyUpdates(), true);
+        UpdateChunkLight(*chunk, packet.GetLightData().GetBlockYMask(), packet.GetLightData().GetEmptyBlockYMask(), packet.GetLightData().GetBlockUpdates(), false);
+
+        { // lock scope
+            TerrainWriteLock terrain_lock = LockChunkForWrite(packet.GetX(), packet.GetZ());
+            PublishChunkImpl(packet.GetX(), packet.GetZ(), *chunk, GetPacketLoaderId());
+        }
+        // Previous chunk data (if any) is freed here, after the lock is released
     }
 #endif
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     void World::Handle(ProtocolCraft::ClientboundLightUpdatePacket& packet)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
 #if PROTOCOL_VERSION < 757 /* < 1.18 */
-        if (terrain.find({ packet.GetX(), packet.GetZ() }) == terrain.end())
+        // world_mutex protects delayed_light_updates
+        std::scoped_lock<std::shared_mutex> lock(world_mutex);
+        std::scoped_lock<std::shared_mutex> terrain_lock(terrain.GetShard(packet.GetX(), packet.GetZ()).GetMutex());
+        Chunk* chunk = GetChunk(packet.GetX(), packet.GetZ());
+        if (chunk == nullptr)
         {
             delayed_light_updates[{packet.GetX(), packet.GetZ()}] = packet;
             return;
         }
-        UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-            packet.GetSkyYMask(), packet.GetEmptySkyYMask(), packet.GetSkyUpdates(), true);
-        UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-            packet.GetBlockYMask(), packet.GetEmptyBlockYMask(), packet.GetBlockUpdates(), false);
+        UpdateChunkLight(*chunk, packet.GetSkyYMask(), packet.GetEmptySkyYMask(), packet.GetSkyUpdates(), true);
+        UpdateChunkLight(*chunk, packet.GetBlockYMask(), packet.GetEmptyBlockYMask(), packet.GetBlockUpdates(), false);
+        // Light data can create new sections
+        chunk_index->Update(packet.GetX(), packet.GetZ(), chunk);
 #else
-        UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-            packet.GetLightData().GetSkyYMask(), packet.GetLightData().GetEmptySkyYMask(), packet.GetLightData().GetSkyUpdates(), true);
-        UpdateChunkLight(packet.GetX(), packet.GetZ(), current_dimension,
-            packet.GetLightData().GetBlockYMask(), packet.GetLightData().GetEmptyBlockYMask(), packet.GetLightData().GetBlockUpdates(), false);
+        std::scoped_lock<std::shared_mutex> terrain_lock(terrain.GetShard(packet.GetX(), packet.GetZ()).GetMutex());
+        Chunk* chunk = GetChunk(packet.GetX(), packet.GetZ());
+        if (chunk == nullptr)
+        {
+            LOG_WARNING("Trying to update lights in an unloaded chunk: (" << packet.GetX() << "," << packet.GetZ() << ")");
+            return;
+        }
+        UpdateChunkLight(*chunk, packet.GetLightData().GetSkyYMask(), packet.GetLightData().GetEmptySkyYMask(), packet.GetLightData().GetSkyUpdates(), true);
+        UpdateChunkLight(*chunk, packet.GetLightData().GetBlockYMask(), packet.GetLightData().GetEmptyBlockYMask(), packet.GetLightData().GetBlockUpdates(), false);
+        // Light data can create new sections
+        chunk_index->Update(packet.GetX(), packet.GetZ(), chunk);
 #endif
     }
 #endif
@@ -916,13 +1113,13 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
     void World::Handle(ProtocolCraft::ClientboundChunksBiomesPacket& packet)
     {
-        std::scoped_lock<std::shared_mutex> lock(world_mutex);
         for (const auto& chunk_data : packet.GetChunkBiomeData())
         {
-            auto it = terrain.find({ chunk_data.GetPos().GetX(), chunk_data.GetPos().GetZ()});
-            if (it != terrain.end())
+            std::scoped_lock<std::shared_mutex> lock(terrain.GetShard(chunk_data.GetPos().GetX(), chunk_data.GetPos().GetZ()).GetMutex());
+            Chunk* chunk = GetChunk(chunk_data.GetPos().GetX(), chunk_data.GetPos().GetZ());
+            if (chunk != nullptr)
             {
-                it->second.LoadBiomesData(chunk_data.GetBuffer());
+                chunk->LoadBiomesData(chunk_data.GetBuffer());
             }
             else
             {
@@ -956,8 +1153,11 @@ namespace Botcraft
             const std::string dim_name = entries[i].GetId().GetFull();
             // Make sure we use the same indices as minecraft registry
             // Not really useful but just in case
-            dimension_index_map.insert({ dim_name, i });
-            index_dimension_map.insert({ i, dim_name });
+            {
+                std::scoped_lock<std::mutex> dimension_lock(dimension_index_mutex);
+                dimension_index_map.insert({ dim_name, i });
+                index_dimension_map.insert({ i, dim_name });
+            }
 
             if (entries[i].GetData().has_value())
             {
@@ -972,60 +1172,104 @@ namespace Botcraft
 #endif
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-    void World::LoadChunkImpl(const int x, const int z, const Dimension dim, const std::thread::id& loader_id)
+    void World::LoadChunkImpl(const int x, const int z, const Dimension dim, const ChunkLoaderId& loader_id)
 #else
-    void World::LoadChunkImpl(const int x, const int z, const std::string& dim, const std::thread::id& loader_id)
+    void World::LoadChunkImpl(const int x, const int z, const std::string& dim, const ChunkLoaderId& loader_id)
 #endif
     {
-#if PROTOCOL_VERSION < 719 /* < 1.16 */
-        const bool has_sky_light = dim == Dimension::Overworld;
-#else
-        const bool has_sky_light = dim == "minecraft:overworld";
-#endif
         const size_t dim_index = GetDimIndex(dim);
-        auto it = terrain.find({ x,z });
-        if (it == terrain.end())
+        Chunk* chunk = GetChunk(x, z);
+        if (chunk == nullptr)
         {
-#if PROTOCOL_VERSION < 757 /* < 1.18 */
-            auto inserted = terrain.insert({ {x, z}, Chunk(dim_index, has_sky_light) });
-#else
-            auto inserted = terrain.insert({ { x, z }, Chunk(dimension_min_y.at(dim), dimension_height.at(dim), dim_index, has_sky_light)});
-#endif
-            inserted.first->second.AddLoader(loader_id);
+            chunk = terrain.GetShard(x, z).Insert(x, z, CreateChunkImpl(dim)).first;
+            chunk->AddLoader(loader_id);
         }
         // This may already exists in this dimension if this is a shared world
-        else if (it->second.GetDimensionIndex() != dim_index)
+        else if (chunk->GetDimensionIndex() != dim_index)
         {
             if (is_shared)
             {
                 LOG_WARNING("Changing dimension with a shared world is not supported and can lead to wrong world data");
             }
-            UnloadChunkImpl(x, z, loader_id);
+            // Previous chunk is replaced with all its loaders, no need to unload it first
+            *chunk = CreateChunkImpl(dim);
+            chunk->AddLoader(loader_id);
+        }
+        else
+        {
+            chunk->AddLoader(loader_id);
+        }
+        chunk_index->Update(x, z, chunk);
+        change_log->AddChunk(x, z);
+
+        //Not necessary, from void to air, there is no difference
+        //UpdateChunk(x, z);
+    }
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    Chunk World::CreateChunkImpl(const Dimension dim)
+#else
+    Chunk World::CreateChunkImpl(const std::string& dim)
+#endif
+    {
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+        const bool has_sky_light = dim == Dimension::Overworld;
+#else
+        const bool has_sky_light = dim == "minecraft:overworld";
+#endif
+        const size_t dim_index = GetDimIndex(dim);
 #if PROTOCOL_VERSION < 757 /* < 1.18 */
-            it->second = Chunk(dim_index, has_sky_light);
+        return Chunk(dim_index, has_sky_light);
 #else
-            it->second = Chunk(dimension_min_y.at(dim), dimension_height.at(dim), dim_index, has_sky_light);
+        return Chunk(dimension_min_y.at(dim), dimension_height.at(dim), dim_index, has_sky_light);
 #endif
-            it->second.AddLoader(loader_id);
+    }
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    void World::PublishChunkImpl(const int x, const int z, Chunk& chunk, const ChunkLoaderId& loader_id)
+    {
+        Chunk* published = GetChunk(x, z);
+        if (published == nullptr)
+        {
+            published = terrain.GetShard(x, z).Insert(x, z, std::move(chunk)).first;
         }
         else
         {
-            it->second.AddLoader(loader_id);
+            // This may already exists in this dimension if this is a shared world
+            if (published->GetDimensionIndex() == chunk.GetDimensionIndex())
+            {
+                for (const ChunkLoaderId& id : published->GetLoaders())
+                {
+                    chunk.AddLoader(id);
+                }
+            }
+            else if (is_shared)
+            {
+                LOG_WARNING("Changing dimension with a shared world is not supported and can lead to wrong world data");
+            }
+            std::swap(*published, chunk);
         }
+        published->AddLoader(loader_id);
+        chunk_index->Update(x, z, published);
+        change_log->AddChunk(x, z);
 
-        //Not necessary, from void to air, there is no difference
-        //UpdateChunk(x, z);
+#if USE_GUI
+        UpdateChunk(x, z);
+#endif
     }
+#endif
 
-    void World::UnloadChunkImpl(const int x, const int z, const std::thread::id& loader_id)
+    void World::UnloadChunkImpl(const int x, const int z, const ChunkLoaderId& loader_id)
     {
-        auto it = terrain.find({ x, z });
-        if (it != terrain.end())
+        Chunk* chunk = GetChunk(x, z);
+        if (chunk != nullptr)
         {
-            const size_t load_counter = it->second.RemoveLoader(loader_id);
+            const size_t load_counter = chunk->RemoveLoader(loader_id);
             if (load_counter == 0)
             {
-                terrain.erase(it);
+                terrain.GetShard(x, z).Erase(x, z);
+                chunk_index->Update(x, z, nullptr);
+                change_log->AddChunk(x, z);
 #if USE_GUI
                 UpdateChunk(x, z);
 #endif
@@ -1038,10 +1282,10 @@ namespace Botcraft
         const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
         const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
 
-        auto it = terrain.find({ chunk_x, chunk_z });
+        Chunk* chunk = GetChunk(chunk_x, chunk_z);
 
         // Can't set block in unloaded chunk
-        if (it == terrain.end())
+        if (chunk == nullptr)
         {
             return;
         }
@@ -1052,7 +1296,10 @@ namespace Botcraft
             (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH
         );
 
-        it->second.SetBlock(set_pos, id);
+        chunk->SetBlock(set_pos, id);
+        // Setting a block in an empty section creates it
+        chunk_index->Update(chunk_x, chunk_z, chunk);
+        change_log->AddBlock(pos);
 
 #if USE_GUI
         // If this block is on the edge, update neighbours chunks
@@ -1065,32 +1312,38 @@ namespace Botcraft
         const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
         const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
 
-        auto it = terrain.find({ chunk_x, chunk_z });
+        const ChunkIndex::Entry* chunk = chunk_index->Find(chunk_x, chunk_z);
 
         // Can't get block in unloaded chunk
-        if (it == terrain.end())
+        if (chunk == nullptr)
         {
             return nullptr;
         }
 
-        const Position chunk_pos(
+        // As we are in a loaded chunk, outside of the world or in an
+        // empty section --> return air block instead of nullptr
+        const int section_y = pos.y < chunk->min_y ? -1 : (pos.y - chunk->min_y) / SECTION_HEIGHT;
+        if (section_y < 0 || section_y >= static_cast<int>(chunk->sections.size()) || chunk->sections[section_y] == nullptr)
+        {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+            return AssetsManager::getInstance().GetBlockstate(std::make_pair(0, 0));
+#else
+            return AssetsManager::getInstance().GetBlockstate(0);
+#endif
+        }
+
+        const unsigned short stored_id = chunk->sections[section_y]->GetBlock(Section::CoordsToBlockIndex(
             (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH,
-            pos.y,
+            (pos.y - chunk->min_y) % SECTION_HEIGHT,
             (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH
-        );
-
-        const Blockstate* output = it->second.GetBlock(chunk_pos);
-
-        // As we are in a loaded chunk, nullptr means it's in an empty section
-        // (or the chunk position was invalid but we know it's valid given how it's constructed above)
-        // --> return air block instead of nullptr
-        return output != nullptr ?
-            output :
+        ));
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
-            AssetsManager::getInstance().GetBlockstate(std::make_pair(0, 0));
+        BlockstateId block_id;
+        Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
 #else
-            AssetsManager::getInstance().GetBlockstate(0);
+        const BlockstateId block_id = static_cast<BlockstateId>(stored_id);
 #endif
+        return AssetsManager::getInstance().GetBlockstate(block_id);
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -1131,17 +1384,17 @@ namespace Botcraft
     void World::SetBiomeImpl(const int x, const int y, const int z, const int biome)
 #endif
     {
-        auto it = terrain.find({
+        Chunk* chunk = GetChunk(
             static_cast<int>(std::floor(x / static_cast<double>(CHUNK_WIDTH))),
             static_cast<int>(std::floor(z / static_cast<double>(CHUNK_WIDTH)))
-            });
+        );
 
-        if (it != terrain.end())
+        if (chunk != nullptr)
         {
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
-            it->second.SetBiome((x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, (z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, biome);
+            chunk->SetBiome((x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, (z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, biome);
 #else
-            it->second.SetBiome((x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, y, (z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, biome);
+            chunk->SetBiome((x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, y, (z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, biome);
 #endif
         }
     }
@@ -1254,12 +1507,35 @@ namespace Botcraft
 
     Chunk* World::GetChunk(const int x, const int z)
     {
-        auto it = terrain.find({ x,z });
-        if (it == terrain.end())
+        return terrain.GetShard(x, z).Find(x, z);
+    }
+
+    World::TerrainWriteLock World::LockChunkForWrite(const int x, const int z)
+    {
+#if USE_GUI
+        // Always lock shards in the same order to prevent deadlocks
+        std::array<size_t, 5> shard_indices = {
+            Terrain::GetShardIndex(x, z),
+            Terrain::GetShardIndex(x - 1, z),
+            Terrain::GetShardIndex(x + 1, z),
+            Terrain::GetShardIndex(x, z - 1),
+            Terrain::GetShardIndex(x, z + 1)
+        };
+        std::sort(shard_indices.begin(), shard_indices.end());
+
+        TerrainWriteLock output;
+        output.reserve(shard_indices.size());
+        for (size_t i = 0; i < shard_indices.size(); ++i)
         {
-            return nullptr;
+            if (i == 0 || shard_indices[i] != shard_indices[i - 1])
+            {
+                output.emplace_back(terrain.GetShard(shard_indices[i]).GetMutex());
+            }
         }
-        return &it->second;
+        return output;
+#else
+        return TerrainWriteLock(terrain.GetShard(x, z).GetMutex());
+#endif
     }
 
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
@@ -1275,16 +1551,18 @@ namespace Botcraft
     void World::LoadDataInChunk(const int x, const int z, const std::vector<unsigned char>& data)
 #endif
     {
-        auto it = terrain.find({ x,z });
-        if (it != terrain.end())
+        Chunk* chunk = GetChunk(x, z);
+        if (chunk != nullptr)
         {
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
-            it->second.LoadChunkData(data, primary_bit_mask, ground_up_continuous);
+            chunk->LoadChunkData(data, primary_bit_mask, ground_up_continuous);
 #elif PROTOCOL_VERSION < 757 /* < 1.18 */
-            it->second.LoadChunkData(data, primary_bit_mask);
+            chunk->LoadChunkData(data, primary_bit_mask);
 #else
-            it->second.LoadChunkData(data);
+            chunk->LoadChunkData(data);
 #endif
+            chunk_index->Update(x, z, chunk);
+            change_log->AddChunk(x, z);
 #if USE_GUI
             UpdateChunk(x, z);
 #endif
@@ -1297,55 +1575,43 @@ namespace Botcraft
     void World::LoadBlockEntityDataInChunk(const int x, const int z, const std::vector<ProtocolCraft::BlockEntityInfo>& block_entities)
 #endif
     {
-        auto it = terrain.find({ x,z });
-        if (it != terrain.end())
+        Chunk* chunk = GetChunk(x, z);
+        if (chunk != nullptr)
         {
-            it->second.LoadChunkBlockEntitiesData(block_entities);
+            chunk->LoadChunkBlockEntitiesData(block_entities);
         }
     }
 
 #if PROTOCOL_VERSION > 551 /* > 1.14.4 */ && PROTOCOL_VERSION < 757 /* < 1.18 */
     void World::LoadBiomesInChunk(const int x, const int z, const std::vector<int>& biomes)
     {
-        auto it = terrain.find({ x,z });
-        if (it != terrain.end())
+        Chunk* chunk = GetChunk(x, z);
+        if (chunk != nullptr)
         {
-            it->second.SetBiomes(biomes);
+            chunk->SetBiomes(biomes);
         }
     }
 #endif
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-#if PROTOCOL_VERSION < 719 /* < 1.16 */
-    void World::UpdateChunkLight(const int x, const int z, const Dimension dim, const int light_mask, const int empty_light_mask,
-        const std::vector<std::vector<char>>& data, const bool sky)
-#elif PROTOCOL_VERSION < 755 /* < 1.17 */
-    void World::UpdateChunkLight(const int x, const int z, const std::string& dim, const int light_mask, const int empty_light_mask,
+#if PROTOCOL_VERSION < 755 /* < 1.17 */
+    void World::UpdateChunkLight(Chunk& chunk, const int light_mask, const int empty_light_mask,
         const std::vector<std::vector<char>>& data, const bool sky)
 #else
-    void World::UpdateChunkLight(const int x, const int z, const std::string& dim,
+    void World::UpdateChunkLight(Chunk& chunk,
         const std::vector<unsigned long long int>& light_mask, const std::vector<unsigned long long int>& empty_light_mask,
         const std::vector<std::vector<char>>& data, const bool sky)
 #endif
     {
-        auto it = terrain.find({ x, z });
-
-        if (it == terrain.end())
-        {
-            LOG_WARNING("Trying to update lights in an unloaded chunk: (" << x << "," << z << ")");
-            return;
-        }
-
         int counter_arrays = 0;
-        Position pos1, pos2;
 
-        const int num_sections = GetHeightImpl() / 16 + 2;
+        const int num_sections = chunk.GetHeight() / 16 + 2;
 
         for (int i = 0; i < num_sections; ++i)
         {
+            // First and last sections are outside of the world
             const int section_Y = i - 1;
 
-            // Sky light
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
             if ((light_mask >> i) & 1)
 #else
@@ -1354,33 +1620,7 @@ namespace Botcraft
             {
                 if (i > 0 && i < num_sections - 1)
                 {
-                    for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
-                    {
-                        pos1.y = block_y + section_Y * SECTION_HEIGHT + GetMinYImpl();
-                        pos2.y = pos1.y;
-                        for (int block_z = 0; block_z < CHUNK_WIDTH; ++block_z)
-                        {
-                            pos1.z = block_z;
-                            pos2.z = block_z;
-                            for (int block_x = 0; block_x < CHUNK_WIDTH; block_x += 2)
-                            {
-                                pos1.x = block_x;
-                                pos2.x = block_x + 1;
-                                const char two_light_values = data[counter_arrays][(block_y * CHUNK_WIDTH * CHUNK_WIDTH + block_z * CHUNK_WIDTH + block_x) / 2];
-
-                                if (sky)
-                                {
-                                    it->second.SetSkyLight(pos1, two_light_values & 0x0F);
-                                    it->second.SetSkyLight(pos2, (two_light_values >> 4) & 0x0F);
-                                }
-                                else
-                                {
-                                    it->second.SetBlockLight(pos1, two_light_values & 0x0F);
-                                    it->second.SetBlockLight(pos2, (two_light_values >> 4) & 0x0F);
-                                }
-                            }
-                        }
-                    }
+                    chunk.LoadSectionLight(section_Y, data[counter_arrays], sky);
                 }
                 counter_arrays++;
             }
@@ -1392,31 +1632,7 @@ namespace Botcraft
             {
                 if (i > 0 && i < num_sections - 1)
                 {
-                    for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
-                    {
-                        pos1.y = block_y + section_Y * SECTION_HEIGHT + GetMinYImpl();
-                        pos2.y = pos1.y;
-                        for (int block_z = 0; block_z < CHUNK_WIDTH; ++block_z)
-                        {
-                            pos1.z = block_z;
-                            pos2.z = block_z;
-                            for (int block_x = 0; block_x < CHUNK_WIDTH; block_x += 2)
-                            {
-                                pos1.x = block_x;
-                                pos2.x = block_x + 1;
-                                if (sky)
-                                {
-                                    it->second.SetSkyLight(pos1, 0);
-                                    it->second.SetSkyLight(pos2, 0);
-                                }
-                                else
-                                {
-                                    it->second.SetBlockLight(pos1, 0);
-                                    it->second.SetBlockLight(pos2, 0);
-                                }
-                            }
-                        }
-                    }
+                    chunk.LoadSectionLight(section_Y, {}, sky);
                 }
             }
         }
@@ -1429,6 +1645,7 @@ namespace Botcraft
     size_t World::GetDimIndex(const std::string& dim)
 #endif
     {
+        std::scoped_lock<std::mutex> lock(dimension_index_mutex);
         auto it = dimension_index_map.find(dim);
 
         if (it == dimension_index_map.end())
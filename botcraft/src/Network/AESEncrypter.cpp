@@ -157,5 +157,18 @@ namespace Botcraft
 
         return output;
     }
+
+    void AESEncrypter::DecryptInPlace(unsigned char* data, const size_t size)
+    {
+        if (decryption_context == nullptr)
+        {
+            LOG_WARNING("Warning, trying to decrypt packet while decryption is not initialized yet");
+            return;
+        }
+
+        // CFB8 is a stream mode, so output can overwrite input
+        int out_size = 0;
+        EVP_DecryptUpdate(decryption_context, data, &out_size, data, static_cast<int>(size));
+    }
 }
 #endif // USE_ENCRYPTION
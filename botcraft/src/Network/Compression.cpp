@@ -2,6 +2,9 @@
 
 #ifdef USE_COMPRESSION
 #include <zlib.h>
+#ifdef USE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
 #include <string>
 #include <cstring>
 #include <stdexcept>
@@ -74,5 +77,139 @@ namespace Botcraft
             }
         }
     }
+
+#ifdef USE_LIBDEFLATE
+    Compressor::Compressor()
+    {
+        // Same as Z_DEFAULT_COMPRESSION
+        compressor = libdeflate_alloc_compressor(6);
+        if (compressor == nullptr)
+        {
+            throw std::runtime_error("Error allocating libdeflate compressor");
+        }
+    }
+
+    Compressor::~Compressor()
+    {
+        libdeflate_free_compressor(compressor);
+    }
+
+    void Compressor::Compress(const unsigned char* raw, const size_t size, std::vector<unsigned char>& output)
+    {
+        const size_t start = output.size();
+        output.resize(start + libdeflate_zlib_compress_bound(compressor, size));
+        const size_t compressed_size = libdeflate_zlib_compress(compressor, raw, size, output.data() + start, output.size() - start);
+        if (compressed_size == 0)
+        {
+            throw std::runtime_error("Error compressing packet");
+        }
+        output.resize(start + compressed_size);
+    }
+
+    Decompressor::Decompressor()
+    {
+        decompressor = libdeflate_alloc_decompressor();
+        if (decompressor == nullptr)
+        {
+            throw std::runtime_error("Error allocating libdeflate decompressor");
+        }
+    }
+
+    Decompressor::~Decompressor()
+    {
+        libdeflate_free_decompressor(decompressor);
+    }
+
+    void Decompressor::Decompress(const unsigned char* compressed, const size_t compressed_size, unsigned char* output, const size_t output_size)
+    {
+        // Without actual_out_nbytes_ret, libdeflate fails if the output is not exactly output_size bytes
+        const libdeflate_result res = libdeflate_zlib_decompress(decompressor, compressed, compressed_size, output, output_size, nullptr);
+        if (res != LIBDEFLATE_SUCCESS)
+        {
+            throw std::runtime_error("Inflate decompression failed with libdeflate error " + std::to_string(static_cast<int>(res)));
+        }
+    }
+#else
+    Compressor::Compressor()
+    {
+        stream = new z_stream;
+        memset(stream, 0, sizeof(z_stream));
+        const int res = deflateInit(stream, Z_DEFAULT_COMPRESSION);
+        if (res != Z_OK)
+        {
+            delete stream;
+            throw std::runtime_error("deflateInit failed with error " + std::to_string(res));
+        }
+    }
+
+    Compressor::~Compressor()
+    {
+        deflateEnd(stream);
+        delete stream;
+    }
+
+    void Compressor::Compress(const unsigned char* raw, const size_t size, std::vector<unsigned char>& output)
+    {
+        // Keep the allocated state, only reset the stream position
+        deflateReset(stream);
+
+        const size_t start = output.size();
+        output.resize(start + deflateBound(stream, static_cast<unsigned long>(size)));
+
+        stream->next_in = const_cast<unsigned char*>(raw);
+        stream->avail_in = static_cast<unsigned int>(size);
+        stream->next_out = output.data() + start;
+        stream->avail_out = static_cast<unsigned int>(output.size() - start);
+
+        // Output is big enough for everything, so it can be done in one call
+        const int res = deflate(stream, Z_FINISH);
+        if (res != Z_STREAM_END)
+        {
+            output.resize(start);
+            throw std::runtime_error("Error compressing packet");
+        }
+        output.resize(start + stream->total_out);
+    }
+
+    Decompressor::Decompressor()
+    {
+        stream = new z_stream;
+        memset(stream, 0, sizeof(z_stream));
+        const int res = inflateInit(stream);
+        if (res != Z_OK)
+        {
+            delete stream;
+            throw std::runtime_error("inflateInit failed with error " + std::to_string(res));
+        }
+    }
+
+    Decompressor::~Decompressor()
+    {
+        inflateEnd(stream);
+        delete stream;
+    }
+
+    void Decompressor::Decompress(const unsigned char* compressed, const size_t compressed_size, unsigned char* output, const size_t output_size)
+    {
+        // Keep the allocated state and window, only reset the stream position
+        inflateReset(stream);
+
+        stream->next_in = const_cast<unsigned char*>(compressed);
+        stream->avail_in = static_cast<unsigned int>(compressed_size);
+        stream->next_out = output;
+        stream->avail_out = static_cast<unsigned int>(output_size);
+
+        // Output size is known, so everything can be inflated in one call
+        const int res = inflate(stream, Z_FINISH);
+        if (res != Z_STREAM_END)
+        {
+            throw std::runtime_error("Inflate decompression failed: " + (stream->msg == nullptr ? std::to_string(res) : std::string(stream->msg)));
+        }
+        if (stream->total_out != output_size)
+        {
+            throw std::runtime_error("Wrong decompressed size, expected " + std::to_string(output_size) + " but got " + std::to_string(stream->total_out));
+        }
+    }
+#endif
 } //Botcraft
 #endif
@@ -1,3 +1,5 @@
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <optional>
 
@@ -5,6 +7,7 @@
 #include "botcraft/Network/TCP_Com.hpp"
 #include "botcraft/Network/Authentifier.hpp"
 #include "botcraft/Network/AESEncrypter.hpp"
+#include "botcraft/Network/NetworkThreadPool.hpp"
 #if USE_COMPRESSION
 #include "botcraft/Network/Compression.hpp"
 #endif
@@ -22,6 +25,76 @@ using namespace ProtocolCraft;
 
 namespace Botcraft
 {
+    namespace
+    {
+        std::atomic<size_t> next_connection_id = 1;
+        /// @brief Connection whose packets are processed by this thread
+        thread_local size_t current_connection_id = 0;
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        /// @brief Max number of packets waiting to be dispatched, per decoding thread
+        static constexpr size_t max_pending_per_decoding_thread = 8;
+#endif
+
+        std::shared_ptr<Packet> ReadPacket(ReadIterator& iter, size_t& length, const ConnectionState state)
+        {
+            const int packet_id = ReadData<VarInt>(iter, length);
+
+            std::shared_ptr<Packet> packet = CreateClientboundPacket(state, packet_id);
+
+            if (packet != nullptr)
+            {
+                try
+                {
+                    packet->Read(iter, length);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_FATAL("Parsing exception while parsing message \"" << packet->GetName() << "\"\n" << e.what());
+                    throw;
+                }
+            }
+            return packet;
+        }
+
+        /// @brief Decompress (if required) and parse a packet. Thread-safe
+        /// @param bytes Raw packet data
+        /// @param state Connection state used to create the packet
+        /// @param compression Compression threshold, -1 if compression is disabled
+        /// @param pool Pool used to get the decompression buffer
+        /// @param decompressor Decompression state of the calling thread
+        /// @return The parsed packet, or nullptr if unknown
+        std::shared_ptr<Packet> ParsePacket(const std::vector<unsigned char>& bytes, const ConnectionState state, const int compression, PacketBufferPool& pool, Decompressor* decompressor)
+        {
+            ReadIterator iter = bytes.data();
+            size_t length = bytes.size();
+
+            if (compression == -1)
+            {
+                return length == 0 ? nullptr : ReadPacket(iter, length, state);
+            }
+
+#ifdef USE_COMPRESSION
+            const int data_length = ReadData<VarInt>(iter, length);
+
+            //Packet not compressed
+            if (data_length == 0)
+            {
+                return length == 0 ? nullptr : ReadPacket(iter, length, state);
+            }
+
+            //Packet compressed
+            const PacketBuffer uncompressed_packet = pool.Acquire(data_length);
+            decompressor->Decompress(iter, length, uncompressed_packet->data(), uncompressed_packet->size());
+            ReadIterator uncompressed_iter = uncompressed_packet->data();
+            size_t uncompressed_length = uncompressed_packet->size();
+            return ReadPacket(uncompressed_iter, uncompressed_length, state);
+#else
+            throw std::runtime_error("Program compiled without USE_COMPRESSION. Cannot read compressed message");
+#endif
+        }
+    }
+
     NetworkManager::NetworkManager(const std::string& address, const std::string& login, const bool force_microsoft_auth, const std::vector<Handler*>& handlers)
     {
         com = nullptr;
@@ -44,6 +117,18 @@ namespace Botcraft
         }
 
         compression = -1;
+        connection_id = next_connection_id++;
+        processing_scheduled = false;
+        processing_running = true;
+#ifdef USE_COMPRESSION
+        compressor = std::make_shared<Compressor>();
+        decompressor = std::make_shared<Decompressor>();
+#endif
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        in_chunk_batch = false;
+        chunk_batch_decoding_threads = 0;
+        decoding_running = false;
+#endif
         AddHandler(this);
         for (Handler* p : handlers)
         {
@@ -52,10 +137,19 @@ namespace Botcraft
 
         state = ConnectionState::Handshake;
 
-        //Start the thread to process the incoming packets
-        m_thread_process = std::thread(&NetworkManager::WaitForNewPackets, this);
+        if (NetworkThreadPool::GetInstance().IsStarted())
+        {
+            processing_strand = NetworkThreadPool::GetInstance().MakeProcessingStrand();
+            com = std::make_shared<TCP_Com>(address, std::bind(&NetworkManager::OnNewRawData, this, std::placeholders::_1, std::placeholders::_2),
+                &NetworkThreadPool::GetInstance().GetIOContext());
+        }
+        else
+        {
+            //Start the thread to process the incoming packets
+            m_thread_process = std::thread(&NetworkManager::WaitForNewPackets, this);
 
-        com = std::make_shared<TCP_Com>(address, std::bind(&NetworkManager::OnNewRawData, this, std::placeholders::_1));
+            com = std::make_shared<TCP_Com>(address, std::bind(&NetworkManager::OnNewRawData, this, std::placeholders::_1, std::placeholders::_2));
+        }
 
         // Wait for the communication to be ready before sending any data
         Utilities::WaitForCondition([&]() {
@@ -100,6 +194,14 @@ namespace Botcraft
     {
         state = constant_connection_state;
         compression = -1;
+        connection_id = next_connection_id++;
+        processing_scheduled = false;
+        processing_running = true;
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        in_chunk_batch = false;
+        chunk_batch_decoding_threads = 0;
+        decoding_running = false;
+#endif
     }
 
     NetworkManager::~NetworkManager()
@@ -122,6 +224,18 @@ namespace Botcraft
         {
             m_thread_process.join();
         }
+        if (processing_strand != nullptr)
+        {
+            std::unique_lock<std::mutex> lock(mutex_process);
+            processing_running = false;
+            process_condition.wait(lock, [this]() { return !processing_scheduled; });
+        }
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        // Processing thread is stopped, so nothing can be waiting for a decoded packet anymore
+        StopDecodingThreads();
+        pending_packets.clear();
+        in_chunk_batch = false;
+#endif
         compression = -1;
 
         com.reset();
@@ -155,10 +269,9 @@ namespace Botcraft
                 else
                 {
                     std::vector<unsigned char> compressed_packet;
-                    compressed_packet.reserve(packet_data.size() + 5);
+                    compressed_packet.reserve(packet_data.size() + 16);
                     WriteData<VarInt>(static_cast<int>(packet_data.size()), compressed_packet);
-                    std::vector<unsigned char> compressed_data = Compress(packet_data);
-                    compressed_packet.insert(compressed_packet.end(), compressed_data.begin(), compressed_data.end());
+                    compressor->Compress(packet_data.data(), packet_data.size(), compressed_packet);
                     com->SendPacket(compressed_packet);
                 }
 #else
@@ -296,62 +409,46 @@ namespace Botcraft
         return m_thread_process.get_id();
     }
 
+    size_t NetworkManager::GetConnectionId() const
+    {
+        return connection_id;
+    }
+
+    size_t NetworkManager::GetCurrentConnectionId()
+    {
+        return current_connection_id;
+    }
+
+    void NetworkManager::UseSharedThreads(const size_t num_threads)
+    {
+        NetworkThreadPool::GetInstance().Start(num_threads);
+    }
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+    void NetworkManager::SetChunkBatchDecodingThreads(const size_t num_threads)
+    {
+        chunk_batch_decoding_threads = num_threads;
+    }
+#endif
+
     void NetworkManager::WaitForNewPackets()
     {
         Logger::GetInstance().RegisterThread("NetworkPacketProcessing - " + name);
+        current_connection_id = connection_id;
         try
         {
+            // Swapped with packets_to_process, so both vectors keep their capacity
+            std::vector<PacketBuffer> packets;
             while (state != ConnectionState::None)
             {
                 {
                     std::unique_lock<std::mutex> lck(mutex_process);
-                    process_condition.wait(lck);
-                }
-                while (!packets_to_process.empty())
-                {
-                    std::vector<unsigned char> packet;
-                    { // process_guard scope
-                        std::lock_guard<std::mutex> process_guard(mutex_process);
-                        if (!packets_to_process.empty())
-                        {
-                            packet = packets_to_process.front();
-                            packets_to_process.pop();
-                        }
-                    }
-                    if (packet.size() > 0)
+                    if (packets_to_process.empty())
                     {
-                        if (compression == -1)
-                        {
-                            ProcessPacket(packet);
-                        }
-                        else
-                        {
-#ifdef USE_COMPRESSION
-                            size_t length = packet.size();
-                            ReadIterator iter = packet.begin();
-                            int data_length = ReadData<VarInt>(iter, length);
-
-                            //Packet not compressed
-                            if (data_length == 0)
-                            {
-                                //Erase the first 0
-                                packet.erase(packet.begin());
-                                ProcessPacket(packet);
-                            }
-                            //Packet compressed
-                            else
-                            {
-                                const int size_varint = static_cast<int>(packet.size() - length);
-
-                                std::vector<unsigned char> uncompressed_packet = Decompress(packet, size_varint);
-                                ProcessPacket(uncompressed_packet);
-                            }
-#else
-                            throw std::runtime_error("Program compiled without USE_COMPRESSION. Cannot read compressed message");
-#endif
-                        }
+                        process_condition.wait(lck);
                     }
                 }
+                ProcessPackets(packets);
             }
         }
         catch (const std::exception& e)
@@ -366,47 +463,225 @@ namespace Botcraft
         }
     }
 
-    void NetworkManager::ProcessPacket(const std::vector<unsigned char>& bytes)
+    void NetworkManager::ProcessPackets(std::vector<PacketBuffer>& packets)
     {
-        if (bytes.empty())
+        while (true)
         {
-            return;
+            { // process_guard scope
+                std::lock_guard<std::mutex> process_guard(mutex_process);
+                std::swap(packets, packets_to_process);
+            }
+            if (packets.empty())
+            {
+                break;
+            }
+            for (const PacketBuffer& packet : packets)
+            {
+                if (packet->empty())
+                {
+                    continue;
+                }
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+                if (in_chunk_batch && !decoding_threads.empty())
+                {
+                    SubmitDecoding(packet);
+                    DispatchDecodedPackets(max_pending_per_decoding_thread * decoding_threads.size());
+                    continue;
+                }
+                // Make sure all previous packets have been dispatched first
+                DispatchDecodedPackets(0);
+#endif
+                DispatchPacket(ParsePacket(*packet, state, compression, buffer_pool, decompressor.get()));
+            }
+            // Give the buffers back to the pool
+            packets.clear();
         }
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+        // Don't wait for new data with decoded packets not dispatched yet
+        DispatchDecodedPackets(0);
+#endif
+    }
 
-        std::vector<unsigned char>::const_iterator packet_iterator = bytes.begin();
-        size_t length = bytes.size();
-
-        const int packet_id = ReadData<VarInt>(packet_iterator, length);
-
-        std::shared_ptr<Packet> packet = CreateClientboundPacket(state, packet_id);
+    void NetworkManager::ProcessPacketsOnStrand()
+    {
+        current_connection_id = connection_id;
+        try
+        {
+            ProcessPackets(strand_packets);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_FATAL("Exception:\n" << e.what());
+            throw;
+        }
+        catch (...)
+        {
+            LOG_FATAL("Unknown exception");
+            throw;
+        }
+        current_connection_id = 0;
+
+        bool reschedule = false;
+        { // process_guard scope
+            std::lock_guard<std::mutex> process_guard(mutex_process);
+            // Packets may have been received after the last check in ProcessPackets
+            reschedule = processing_running && !packets_to_process.empty();
+            processing_scheduled = reschedule;
+        }
+        if (reschedule)
+        {
+            processing_strand->Post([this]() { ProcessPacketsOnStrand(); });
+        }
+        else
+        {
+            process_condition.notify_all();
+        }
+    }
 
+    void NetworkManager::DispatchPacket(const std::shared_ptr<Packet>& packet)
+    {
         if (packet != nullptr)
         {
-            try
+            for (size_t i = 0; i < subscribed.size(); i++)
             {
-                packet->Read(packet_iterator, length);
+                packet->Dispatch(subscribed[i]);
             }
-            catch (const std::exception& e)
+        }
+    }
+
+    void NetworkManager::OnNewRawData(const unsigned char* data, const size_t length)
+    {
+        // data is only valid during this call, copy it in a pooled buffer
+        PacketBuffer packet = buffer_pool.Acquire(length);
+        if (length > 0)
+        {
+            std::memcpy(packet->data(), data, length);
+        }
+        bool schedule = false;
+        {
+            std::unique_lock<std::mutex> lck(mutex_process);
+            packets_to_process.push_back(std::move(packet));
+            if (processing_strand != nullptr && processing_running && !processing_scheduled)
             {
-                LOG_FATAL("Parsing exception while parsing message \"" << packet->GetName() << "\"\n" << e.what());
-                throw;
+                processing_scheduled = true;
+                schedule = true;
             }
-            for (size_t i = 0; i < subscribed.size(); i++)
+        }
+        if (schedule)
+        {
+            processing_strand->Post([this]() { ProcessPacketsOnStrand(); });
+        }
+        else
+        {
+            process_condition.notify_all();
+        }
+    }
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+    void NetworkManager::SubmitDecoding(const PacketBuffer& bytes)
+    {
+        PendingPacket pending;
+        pending.bytes = bytes;
+        pending.state = state;
+
+        std::packaged_task<std::shared_ptr<Packet>(Decompressor*)> task(
+            [bytes, parsing_state = state, parsing_compression = compression, &pool = buffer_pool](Decompressor* thread_decompressor)
             {
-                packet->Dispatch(subscribed[i]);
+                return ParsePacket(*bytes, parsing_state, parsing_compression, pool, thread_decompressor);
             }
+        );
+        pending.packet = task.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(decoding_mutex);
+            decoding_jobs.push_back(std::move(task));
         }
+        decoding_condition.notify_one();
+
+        pending_packets.push_back(std::move(pending));
     }
 
-    void NetworkManager::OnNewRawData(const std::vector<unsigned char>& bytes)
+    void NetworkManager::DispatchDecodedPackets(const size_t max_pending)
     {
+        while (!pending_packets.empty())
         {
-            std::unique_lock<std::mutex> lck(mutex_process);
-            packets_to_process.push(bytes);
+            PendingPacket& front = pending_packets.front();
+            // A previously dispatched packet changed the connection state,
+            // this one has to be parsed again with the new state
+            if (front.state != state)
+            {
+                const PacketBuffer bytes = front.bytes;
+                pending_packets.pop_front();
+                DispatchPacket(ParsePacket(*bytes, state, compression, buffer_pool, decompressor.get()));
+                continue;
+            }
+
+            if (pending_packets.size() <= max_pending && front.packet.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                return;
+            }
+
+            // Rethrow parsing exceptions on this thread if any
+            const std::shared_ptr<Packet> packet = front.packet.get();
+            pending_packets.pop_front();
+            DispatchPacket(packet);
         }
-        process_condition.notify_all();
     }
 
+    void NetworkManager::StartDecodingThreads(const size_t num_threads)
+    {
+        decoding_running = true;
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            decoding_threads.emplace_back(&NetworkManager::DecodePackets, this);
+        }
+    }
+
+    void NetworkManager::StopDecodingThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(decoding_mutex);
+            decoding_running = false;
+        }
+        decoding_condition.notify_all();
+        for (std::thread& t : decoding_threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+        decoding_threads.clear();
+    }
+
+    void NetworkManager::DecodePackets()
+    {
+        Logger::GetInstance().RegisterThread("NetworkPacketDecoding - " + name);
+#ifdef USE_COMPRESSION
+        Decompressor thread_decompressor;
+        Decompressor* decompressor_ptr = &thread_decompressor;
+#else
+        Decompressor* decompressor_ptr = nullptr;
+#endif
+        while (true)
+        {
+            std::packaged_task<std::shared_ptr<Packet>(Decompressor*)> task;
+            {
+                std::unique_lock<std::mutex> lock(decoding_mutex);
+                decoding_condition.wait(lock, [this]() { return !decoding_running || !decoding_jobs.empty(); });
+                // Only stop once all the submitted packets are decoded
+                if (decoding_jobs.empty())
+                {
+                    return;
+                }
+                task = std::move(decoding_jobs.front());
+                decoding_jobs.pop_front();
+            }
+            // Exceptions are stored in the future and rethrown on the processing thread
+            task(decompressor_ptr);
+        }
+    }
+#endif
 
     void NetworkManager::Handle(ClientboundLoginCompressionPacket& packet)
     {
@@ -618,10 +893,23 @@ namespace Botcraft
     void NetworkManager::Handle(ClientboundChunkBatchStartPacket& packet)
     {
         chunk_batch_start_time = std::chrono::steady_clock::now();
+
+        // Apply new number of decoding threads. Stopping them waits for all
+        // submitted packets to be decoded, so no pending packet is lost
+        const size_t num_decoding_threads = chunk_batch_decoding_threads;
+        if (num_decoding_threads != decoding_threads.size())
+        {
+            StopDecodingThreads();
+            StartDecodingThreads(num_decoding_threads);
+        }
+        in_chunk_batch = true;
     }
 
     void NetworkManager::Handle(ClientboundChunkBatchFinishedPacket& packet)
     {
+        in_chunk_batch = false;
+        // Packets are dispatched in order, so when we get here all the chunks of
+        // the batch have been decoded and handled, even when decoded in parallel
         using count_return = decltype(std::declval<std::chrono::milliseconds>().count());
         const count_return time_elapsed_ms = std::max(static_cast<count_return>(1), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - chunk_batch_start_time).count());
         std::shared_ptr<ServerboundChunkBatchReceivedPacket> chunk_per_tick_packet = std::make_shared<ServerboundChunkBatchReceivedPacket>();
@@ -0,0 +1,98 @@
+#include <algorithm>
+
+#include <asio/post.hpp>
+
+#include "botcraft/Network/NetworkThreadPool.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    NetworkStrand::NetworkStrand(asio::io_context& io_context) : strand(asio::make_strand(io_context))
+    {
+
+    }
+
+    void NetworkStrand::Post(std::function<void()>&& task)
+    {
+        asio::post(strand, std::move(task));
+    }
+
+
+    NetworkThreadPool& NetworkThreadPool::GetInstance()
+    {
+        static NetworkThreadPool instance;
+        return instance;
+    }
+
+    NetworkThreadPool::NetworkThreadPool()
+    {
+        started = false;
+        next_io_context = 0;
+    }
+
+    NetworkThreadPool::~NetworkThreadPool()
+    {
+        // Let the threads return once they don't have anything left to do
+        work_guards.clear();
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    void NetworkThreadPool::Start(const size_t num_threads)
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        if (started)
+        {
+            return;
+        }
+
+        const size_t thread_count = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        LOG_INFO("Starting " << thread_count << " shared network threads and " << thread_count << " shared processing threads");
+
+        work_guards.emplace_back(asio::make_work_guard(processing_context));
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([this, i]()
+                {
+                    Logger::GetInstance().RegisterThread("SharedPacketProcessing - " + std::to_string(i));
+                    processing_context.run();
+                }
+            );
+        }
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            io_contexts.push_back(std::make_unique<asio::io_context>(1));
+            asio::io_context* io_context = io_contexts.back().get();
+            work_guards.emplace_back(asio::make_work_guard(*io_context));
+            threads.emplace_back([io_context, i]()
+                {
+                    Logger::GetInstance().RegisterThread("SharedNetworkIOService - " + std::to_string(i));
+                    io_context->run();
+                }
+            );
+        }
+
+        started = true;
+    }
+
+    bool NetworkThreadPool::IsStarted() const
+    {
+        return started;
+    }
+
+    asio::io_context& NetworkThreadPool::GetIOContext()
+    {
+        return *io_contexts[next_io_context.fetch_add(1, std::memory_order_relaxed) % io_contexts.size()];
+    }
+
+    std::shared_ptr<NetworkStrand> NetworkThreadPool::MakeProcessingStrand()
+    {
+        return std::make_shared<NetworkStrand>(processing_context);
+    }
+} // Botcraft
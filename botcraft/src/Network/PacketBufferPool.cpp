@@ -0,0 +1,146 @@
+#include "botcraft/Network/PacketBufferPool.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Buffers bigger than that are not kept, so one huge packet
+        /// doesn't keep a lot of memory used for the whole session
+        constexpr size_t max_pooled_capacity = 4 * 1024 * 1024;
+        /// @brief Max number of buffers waiting in the pool
+        constexpr size_t max_free_nodes = 256;
+    }
+
+    PacketBuffer::PacketBuffer() : node(nullptr)
+    {
+
+    }
+
+    PacketBuffer::PacketBuffer(PacketBufferNode* node_) : node(node_)
+    {
+
+    }
+
+    PacketBuffer::PacketBuffer(const PacketBuffer& other) : node(other.node)
+    {
+        if (node != nullptr)
+        {
+            node->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PacketBuffer::PacketBuffer(PacketBuffer&& other) noexcept : node(other.node)
+    {
+        other.node = nullptr;
+    }
+
+    PacketBuffer::~PacketBuffer()
+    {
+        Release();
+    }
+
+    PacketBuffer& PacketBuffer::operator=(const PacketBuffer& other)
+    {
+        if (node != other.node)
+        {
+            Release();
+            node = other.node;
+            if (node != nullptr)
+            {
+                node->ref_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            node = other.node;
+            other.node = nullptr;
+        }
+        return *this;
+    }
+
+    PacketBuffer::operator bool() const
+    {
+        return node != nullptr;
+    }
+
+    std::vector<unsigned char>& PacketBuffer::operator*() const
+    {
+        return node->bytes;
+    }
+
+    std::vector<unsigned char>* PacketBuffer::operator->() const
+    {
+        return &node->bytes;
+    }
+
+    void PacketBuffer::Release()
+    {
+        if (node != nullptr && node->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            node->pool->Release(node);
+        }
+        node = nullptr;
+    }
+
+
+    PacketBufferPool::PacketBufferPool()
+    {
+        free_nodes.reserve(max_free_nodes);
+    }
+
+    PacketBufferPool::~PacketBufferPool()
+    {
+        for (PacketBufferNode* node : free_nodes)
+        {
+            delete node;
+        }
+    }
+
+    PacketBuffer PacketBufferPool::Acquire(const size_t size)
+    {
+        PacketBufferNode* node = nullptr;
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            if (!free_nodes.empty())
+            {
+                node = free_nodes.back();
+                free_nodes.pop_back();
+            }
+        }
+
+        if (node == nullptr)
+        {
+            node = new PacketBufferNode();
+            node->pool = this;
+        }
+        node->ref_count.store(1, std::memory_order_relaxed);
+        // Only allocates if the recycled buffer is too small
+        node->bytes.resize(size);
+
+        return PacketBuffer(node);
+    }
+
+    void PacketBufferPool::Release(PacketBufferNode* node)
+    {
+        if (node->bytes.capacity() > max_pooled_capacity)
+        {
+            node->bytes = std::vector<unsigned char>();
+        }
+
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            if (free_nodes.size() < max_free_nodes)
+            {
+                free_nodes.push_back(node);
+                return;
+            }
+        }
+        delete node;
+    }
+} // Botcraft
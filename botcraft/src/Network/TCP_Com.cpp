@@ -1,3 +1,4 @@
+#include <cstring>
 #include <functional>
 #include <asio/connect.hpp>
 #include <asio/write.hpp>
@@ -13,27 +14,98 @@
 #endif
 
 #include "botcraft/Utilities/Logger.hpp"
+#include "botcraft/Utilities/SleepUtilities.hpp"
 #include "botcraft/Utilities/StringUtilities.hpp"
 
 namespace Botcraft
 {
+    namespace
+    {
+        /// @brief Initial size of the input buffer
+        constexpr size_t initial_input_buffer_size = 1 << 17;
+        /// @brief Minimum free space at the end of the input buffer for each read,
+        /// so big bursts (chunks data) are received with a few large reads
+        constexpr size_t min_read_size = 1 << 15;
+
+        /// @brief Result of ReadFrameHeader
+        enum class FrameHeaderStatus
+        {
+            Ok,
+            NotEnoughData,
+            Invalid
+        };
+
+        /// @brief Read the VarInt size prefix of a packet
+        /// @param data Start of the packet
+        /// @param size Number of available bytes
+        /// @param packet_length Output packet length
+        /// @param header_length Output size prefix length
+        FrameHeaderStatus ReadFrameHeader(const unsigned char* data, const size_t size, int& packet_length, size_t& header_length)
+        {
+            unsigned int value = 0;
+            for (size_t i = 0; i < 5; ++i)
+            {
+                if (i == size)
+                {
+                    return FrameHeaderStatus::NotEnoughData;
+                }
+                value |= static_cast<unsigned int>(data[i] & 0x7F) << (7 * i);
+                if ((data[i] & 0x80) == 0)
+                {
+                    packet_length = static_cast<int>(value);
+                    header_length = i + 1;
+                    return packet_length > 0 ? FrameHeaderStatus::Ok : FrameHeaderStatus::Invalid;
+                }
+            }
+            return FrameHeaderStatus::Invalid;
+        }
+
+        /// @brief Mark a handler as done when going out of scope
+        class HandlerGuard
+        {
+        public:
+            HandlerGuard(std::atomic<size_t>& pending_handlers_) : pending_handlers(pending_handlers_)
+            {
+
+            }
+
+            ~HandlerGuard()
+            {
+                pending_handlers.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+        private:
+            std::atomic<size_t>& pending_handlers;
+        };
+    }
+
     TCP_Com::TCP_Com(const std::string& address,
-        std::function<void(const std::vector<unsigned char>&)> callback)
-        : socket(io_context), initialized(false)
+        std::function<void(const unsigned char*, const size_t)> callback,
+        asio::io_context* shared_io_context)
+        : owned_io_context(shared_io_context == nullptr ? std::make_unique<asio::io_context>() : nullptr),
+        io_context(shared_io_context == nullptr ? *owned_io_context : *shared_io_context),
+        socket(io_context), pending_handlers(0), initialized(false)
     {
         NewPacketCallback = callback;
+        input_buffer = std::vector<unsigned char>(initial_input_buffer_size);
+        input_start = 0;
+        input_end = 0;
 
         SetIPAndPortFromAddress(address);
 
         asio::ip::tcp::resolver resolver(io_context);
         asio::ip::tcp::resolver::results_type results = resolver.resolve(ip, std::to_string(port));
         LOG_INFO("Trying to connect to " << ip << ":" << port);
+        pending_handlers += 1;
         asio::async_connect(socket, results,
             std::bind(&TCP_Com::handle_connect, this,
             std::placeholders::_1));
 
-        thread_com = std::thread([&] { io_context.run(); });
-        Logger::GetInstance().RegisterThread(thread_com.get_id(), "NetworkIOService");
+        if (owned_io_context != nullptr)
+        {
+            thread_com = std::thread([&] { io_context.run(); });
+            Logger::GetInstance().RegisterThread(thread_com.get_id(), "NetworkIOService");
+        }
     }
 
     TCP_Com::~TCP_Com()
@@ -43,6 +115,13 @@ namespace Botcraft
             Logger::GetInstance().UnregisterThread(thread_com.get_id());
             thread_com.join();
         }
+        else if (owned_io_context == nullptr)
+        {
+            // Shared io_context keeps running, wait for all
+            // the handlers using this object to be done
+            close();
+            Utilities::WaitForCondition([&]() { return pending_handlers == 0; }, 0, 1);
+        }
     }
 
     bool TCP_Com::IsInitialized() const
@@ -60,16 +139,16 @@ namespace Botcraft
 #ifdef USE_ENCRYPTION
         if (encrypter != nullptr)
         {
-            std::vector<unsigned char> encrypted = encrypter->Encrypt(sized_packet);
-            asio::post(io_context, std::bind(&TCP_Com::do_write, this, encrypted));
+            sized_packet = encrypter->Encrypt(sized_packet);
         }
-        else
-        {
-            asio::post(io_context, std::bind(&TCP_Com::do_write, this, sized_packet));
-        }
-#else
-        asio::post(io_context, std::bind(&TCP_Com::do_write, this, sized_packet));
 #endif
+        pending_handlers += 1;
+        asio::post(io_context, [this, bytes = std::move(sized_packet)]()
+            {
+                const HandlerGuard guard(pending_handlers);
+                do_write(bytes);
+            }
+        );
     }
 
 #ifdef USE_ENCRYPTION
@@ -91,18 +170,23 @@ namespace Botcraft
 
     void TCP_Com::close()
     {
-        asio::post(io_context, std::bind(&TCP_Com::do_close, this));
+        pending_handlers += 1;
+        asio::post(io_context, [this]()
+            {
+                const HandlerGuard guard(pending_handlers);
+                do_close();
+            }
+        );
     }
 
     void TCP_Com::handle_connect(const asio::error_code& error)
     {
+        const HandlerGuard guard(pending_handlers);
         if (!error)
         {
             LOG_INFO("Connection to server established.");
             initialized = true;
-            socket.async_read_some(asio::buffer(read_packet.data(), read_packet.size()),
-                std::bind(&TCP_Com::handle_read, this,
-                std::placeholders::_1, std::placeholders::_2));
+            start_read();
         }
         else
         {
@@ -112,70 +196,85 @@ namespace Botcraft
 
     void TCP_Com::handle_read(const asio::error_code& error, std::size_t bytes_transferred)
     {
-        if (!error)
+        const HandlerGuard guard(pending_handlers);
+        if (error)
         {
+            do_close();
+            return;
+        }
+
 #ifdef USE_ENCRYPTION
-            if (encrypter != nullptr)
-            {
-                std::vector<unsigned char> decrypted(bytes_transferred);
-                std::copy_n(read_packet.begin(), bytes_transferred, decrypted.data());
-                decrypted = encrypter->Decrypt(decrypted);
-                for (int i = 0; i < decrypted.size(); ++i)
-                {
-                    input_packet.push_back(decrypted[i]);
-                }
-            }
-            else
+        if (encrypter != nullptr)
+        {
+            encrypter->DecryptInPlace(input_buffer.data() + input_end, bytes_transferred);
+        }
+#endif
+        input_end += bytes_transferred;
+
+        while (input_start != input_end)
+        {
+            int packet_length = 0;
+            size_t header_length = 0;
+            const FrameHeaderStatus status = ReadFrameHeader(input_buffer.data() + input_start, input_end - input_start, packet_length, header_length);
+            if (status == FrameHeaderStatus::Invalid)
             {
-                for (int i = 0; i < bytes_transferred; ++i)
-                {
-                    input_packet.push_back(read_packet[i]);
-                }
+                LOG_ERROR("Invalid packet size received, closing connection");
+                do_close();
+                return;
             }
-#else
-            for (int i = 0; i < bytes_transferred; ++i)
+            if (status == FrameHeaderStatus::NotEnoughData)
             {
-                input_packet.push_back(read_packet[i]);
+                break;
             }
-#endif
 
-            while (input_packet.size() != 0)
+            const size_t frame_length = header_length + static_cast<size_t>(packet_length);
+            if (input_end - input_start < frame_length)
             {
-                std::vector<unsigned char>::const_iterator read_iter = input_packet.begin();
-                size_t max_length = input_packet.size();
-                int packet_length;
-                try
+                // Make sure the whole packet fits in the buffer
+                // so it doesn't need to be copied more than once
+                if (input_buffer.size() - input_start < frame_length + min_read_size)
                 {
-                    packet_length = ProtocolCraft::ReadData<ProtocolCraft::VarInt>(read_iter, max_length);
+                    std::memmove(input_buffer.data(), input_buffer.data() + input_start, input_end - input_start);
+                    input_end -= input_start;
+                    input_start = 0;
+                    if (input_buffer.size() < frame_length + min_read_size)
+                    {
+                        input_buffer.resize(frame_length + min_read_size);
+                    }
                 }
-                catch (const std::runtime_error)
-                {
-                    break;
-                }
-                const int bytes_read = static_cast<int>(std::distance<std::vector<unsigned char>::const_iterator>(input_packet.begin(), read_iter));
-                std::vector<unsigned char> data_packet;
+                break;
+            }
 
-                if (packet_length > 0 && input_packet.size() >= bytes_read + packet_length)
-                {
-                    data_packet = std::vector<unsigned char>(input_packet.begin() + bytes_read, input_packet.begin() + bytes_read + packet_length);
+            NewPacketCallback(input_buffer.data() + input_start + header_length, static_cast<size_t>(packet_length));
+            input_start += frame_length;
+        }
 
-                    NewPacketCallback(data_packet);
-                    input_packet.erase(input_packet.begin(), input_packet.begin() + bytes_read + packet_length);
-                }
-                else
-                {
-                    break;
-                }
-            }
+        start_read();
+    }
 
-            socket.async_read_some(asio::buffer(read_packet.data(), read_packet.size()),
-                std::bind(&TCP_Com::handle_read, this,
-                std::placeholders::_1, std::placeholders::_2));
+    void TCP_Com::start_read()
+    {
+        if (input_start == input_end)
+        {
+            input_start = 0;
+            input_end = 0;
         }
-        else
+        else if (input_buffer.size() - input_end < min_read_size)
         {
-            do_close();
+            // Move remaining bytes (the beginning of a packet) to the front
+            std::memmove(input_buffer.data(), input_buffer.data() + input_start, input_end - input_start);
+            input_end -= input_start;
+            input_start = 0;
+            if (input_buffer.size() - input_end < min_read_size)
+            {
+                input_buffer.resize(2 * input_buffer.size());
+            }
         }
+
+        pending_handlers += 1;
+        socket.async_read_some(asio::buffer(input_buffer.data() + input_end, input_buffer.size() - input_end),
+            std::bind(&TCP_Com::handle_read, this,
+            std::placeholders::_1, std::placeholders::_2));
     }
 
     void TCP_Com::do_write(const std::vector<unsigned char>& bytes)
@@ -187,6 +286,7 @@ namespace Botcraft
 
         if (!write_in_progress)
         {
+            pending_handlers += 1;
             asio::async_write(socket,
                 asio::buffer(output_packet.front().data(),
                 output_packet.front().size()),
@@ -197,6 +297,7 @@ namespace Botcraft
 
     void TCP_Com::handle_write(const asio::error_code& error)
     {
+        const HandlerGuard guard(pending_handlers);
         if (!error)
         {
             mutex_output.lock();
@@ -205,6 +306,7 @@ namespace Botcraft
 
             if (!output_packet.empty())
             {
+                pending_handlers += 1;
                 asio::async_write(socket,
                     asio::buffer(output_packet.front().data(),
                     output_packet.front().size()),
@@ -289,7 +391,7 @@ namespace Botcraft
         asio::ip::udp::endpoint sender_endpoint;
         const size_t len = udp_socket.receive_from(asio::buffer(answer_buffer), sender_endpoint);
 
-        ProtocolCraft::ReadIterator iter = answer_buffer.begin();
+        ProtocolCraft::ReadIterator iter = answer_buffer.data();
         size_t remaining = len;
 
         // Read answer
@@ -301,7 +403,7 @@ namespace Botcraft
             && answer.GetAnswers()[0].GetTypeCode() == 0x21)
         {
             DNSSrvData data;
-            auto iter2 = answer.GetAnswers()[0].GetRData().begin();
+            ProtocolCraft::ReadIterator iter2 = answer.GetAnswers()[0].GetRData().data();
             size_t len2 = answer.GetAnswers()[0].GetRDLength();
             data.Read(iter2, len2);
             ip = "";
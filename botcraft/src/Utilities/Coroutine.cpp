@@ -0,0 +1,166 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if _WIN32
+#include <Windows.h>
+#undef Yield // Because there is a Yield macro in Windows API somewhere :]
+#else
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+#include "botcraft/Utilities/Coroutine.hpp"
+
+namespace Botcraft::Utilities
+{
+    namespace
+    {
+        /// @brief Coroutine currently running on this thread
+        thread_local Coroutine* current_coroutine = nullptr;
+    }
+
+    struct Coroutine::Context
+    {
+#if _WIN32
+        LPVOID fiber = nullptr;
+        LPVOID caller = nullptr;
+
+        static void WINAPI Entry(LPVOID parameter)
+        {
+            Run(static_cast<Coroutine*>(parameter));
+        }
+#else
+        ucontext_t context;
+        ucontext_t caller;
+        void* stack = nullptr;
+        size_t mapped_size = 0;
+
+        // makecontext only passes int arguments, so the pointer is split in two
+        static void Entry(const unsigned int high, const unsigned int low)
+        {
+            Run(reinterpret_cast<Coroutine*>((static_cast<std::uintptr_t>(high) << 32) | static_cast<std::uintptr_t>(low)));
+        }
+#endif
+
+        static void Run(Coroutine* coroutine)
+        {
+            try
+            {
+                coroutine->function();
+            }
+            catch (...)
+            {
+                // Exceptions can't go through the coroutine boundary, it's rethrown by Resume
+                coroutine->exception = std::current_exception();
+            }
+            coroutine->finished = true;
+            // Never resumed again
+            Suspend();
+        }
+    };
+
+    Coroutine::Coroutine(std::function<void()>&& function_, const size_t stack_size) : function(std::move(function_))
+    {
+        finished = false;
+        context = new Context();
+#if _WIN32
+        context->fiber = CreateFiber(stack_size, &Context::Entry, this);
+        if (context->fiber == nullptr)
+        {
+            delete context;
+            throw std::runtime_error("Error creating fiber: " + std::to_string(GetLastError()));
+        }
+#else
+        // Stack is mmapped so pages are only committed when actually used,
+        // with a guard page at the bottom to crash instead of silently overflowing
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        context->mapped_size = ((stack_size + page_size - 1) / page_size + 1) * page_size;
+        context->stack = mmap(nullptr, context->mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (context->stack == MAP_FAILED)
+        {
+            const int error = errno;
+            delete context;
+            throw std::runtime_error(std::string("Error allocating coroutine stack: ") + std::strerror(error));
+        }
+        mprotect(context->stack, page_size, PROT_NONE);
+
+        getcontext(&context->context);
+        context->context.uc_stack.ss_sp = static_cast<char*>(context->stack) + page_size;
+        context->context.uc_stack.ss_size = context->mapped_size - page_size;
+        context->context.uc_link = nullptr;
+        const std::uintptr_t ptr = reinterpret_cast<std::uintptr_t>(this);
+        makecontext(&context->context, reinterpret_cast<void(*)()>(&Context::Entry), 2,
+            static_cast<unsigned int>(static_cast<std::uint64_t>(ptr) >> 32), static_cast<unsigned int>(ptr & 0xFFFFFFFF));
+#endif
+    }
+
+    Coroutine::~Coroutine()
+    {
+#if _WIN32
+        DeleteFiber(context->fiber);
+#else
+        munmap(context->stack, context->mapped_size);
+#endif
+        delete context;
+    }
+
+    void Coroutine::Resume()
+    {
+        if (finished)
+        {
+            return;
+        }
+        if (current_coroutine != nullptr)
+        {
+            throw std::runtime_error("Resuming a coroutine from inside another one is not supported");
+        }
+
+        current_coroutine = this;
+#if _WIN32
+        if (!IsThreadAFiber())
+        {
+            ConvertThreadToFiber(nullptr);
+        }
+        context->caller = GetCurrentFiber();
+        SwitchToFiber(context->fiber);
+#else
+        swapcontext(&context->caller, &context->context);
+#endif
+        current_coroutine = nullptr;
+
+        if (exception)
+        {
+            std::exception_ptr e = exception;
+            exception = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void Coroutine::Suspend()
+    {
+        Coroutine* coroutine = current_coroutine;
+        if (coroutine == nullptr)
+        {
+            throw std::runtime_error("Suspend called outside of a coroutine");
+        }
+#if _WIN32
+        SwitchToFiber(coroutine->context->caller);
+#else
+        swapcontext(&coroutine->context->context, &coroutine->context->caller);
+#endif
+    }
+
+    bool Coroutine::IsInsideCoroutine()
+    {
+        return current_coroutine != nullptr;
+    }
+
+    bool Coroutine::IsFinished() const
+    {
+        return finished;
+    }
+} // Botcraft::Utilities
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "botcraft/Utilities/EpochManager.hpp"
+
+namespace Botcraft::Utilities
+{
+    struct ThreadEpochSlot
+    {
+        ~ThreadEpochSlot()
+        {
+            if (index != invalid_index)
+            {
+                EpochManager::GetInstance().ReleaseSlot(index);
+            }
+        }
+
+        static constexpr size_t invalid_index = std::numeric_limits<size_t>::max();
+        size_t index = invalid_index;
+        /// @brief Number of nested read sections
+        size_t depth = 0;
+    };
+
+    namespace
+    {
+        thread_local ThreadEpochSlot thread_slot;
+    }
+
+    EpochManager::EpochManager()
+    {
+        // Start at 1 as 0 means "not reading" in slots
+        global_epoch = 1;
+        num_used_slots = 0;
+        for (ReaderSlot& s : slots)
+        {
+            s.epoch = 0;
+        }
+    }
+
+    EpochManager::~EpochManager()
+    {
+
+    }
+
+    EpochManager& EpochManager::GetInstance()
+    {
+        static EpochManager instance;
+        return instance;
+    }
+
+    void EpochManager::EnterRead()
+    {
+        if (thread_slot.depth++ > 0)
+        {
+            return;
+        }
+
+        if (thread_slot.index == ThreadEpochSlot::invalid_index)
+        {
+            thread_slot.index = AcquireSlot();
+        }
+
+        std::atomic<unsigned long long int>& slot_epoch = slots[thread_slot.index].epoch;
+        unsigned long long int epoch = global_epoch.load();
+        // Make sure the published epoch is still the current one, otherwise a writer
+        // may have checked the slots between our read of global_epoch and our store
+        while (true)
+        {
+            slot_epoch.store(epoch);
+            const unsigned long long int current_epoch = global_epoch.load();
+            if (current_epoch == epoch)
+            {
+                break;
+            }
+            epoch = current_epoch;
+        }
+    }
+
+    void EpochManager::ExitRead()
+    {
+        if (--thread_slot.depth > 0)
+        {
+            return;
+        }
+        slots[thread_slot.index].epoch.store(0, std::memory_order_release);
+    }
+
+    void EpochManager::Retire(std::shared_ptr<const void>&& object)
+    {
+        if (object == nullptr)
+        {
+            return;
+        }
+
+        // Readers that will enter after this point get a greater epoch and
+        // can't reach the object anymore
+        const unsigned long long int epoch = global_epoch.fetch_add(1);
+
+        bool should_collect = false;
+        {
+            std::scoped_lock<std::mutex> lock(retired_mutex);
+            retired.emplace_back(epoch, std::move(object));
+            should_collect = retired.size() >= collect_threshold;
+        }
+
+        if (should_collect)
+        {
+            Collect();
+        }
+    }
+
+    size_t EpochManager::AcquireSlot()
+    {
+        std::scoped_lock<std::mutex> lock(slots_mutex);
+        if (!free_slots.empty())
+        {
+            const size_t index = free_slots.back();
+            free_slots.pop_back();
+            return index;
+        }
+
+        if (num_used_slots == max_threads)
+        {
+            throw std::runtime_error("Too many threads reading shared data");
+        }
+        return num_used_slots++;
+    }
+
+    void EpochManager::ReleaseSlot(const size_t index)
+    {
+        std::scoped_lock<std::mutex> lock(slots_mutex);
+        free_slots.push_back(index);
+    }
+
+    void EpochManager::Collect()
+    {
+        unsigned long long int min_reading_epoch = std::numeric_limits<unsigned long long int>::max();
+        const size_t num_slots = num_used_slots;
+        for (size_t i = 0; i < num_slots; ++i)
+        {
+            const unsigned long long int epoch = slots[i].epoch.load();
+            if (epoch != 0)
+            {
+                min_reading_epoch = std::min(min_reading_epoch, epoch);
+            }
+        }
+
+        // Objects are destroyed outside of the lock
+        std::vector<std::shared_ptr<const void> > to_free;
+        {
+            std::scoped_lock<std::mutex> lock(retired_mutex);
+            auto it = std::partition(retired.begin(), retired.end(),
+                [&](const std::pair<unsigned long long int, std::shared_ptr<const void> >& p) { return p.first >= min_reading_epoch; });
+            to_free.reserve(std::distance(it, retired.end()));
+            for (auto it2 = it; it2 != retired.end(); ++it2)
+            {
+                to_free.push_back(std::move(it2->second));
+            }
+            retired.erase(it, retired.end());
+        }
+    }
+
+    EpochReadGuard::EpochReadGuard()
+    {
+        EpochManager::GetInstance().EnterRead();
+    }
+
+    EpochReadGuard::~EpochReadGuard()
+    {
+        EpochManager::GetInstance().ExitRead();
+    }
+}
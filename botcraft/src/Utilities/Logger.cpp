@@ -1,36 +1,68 @@
 #include "botcraft/Utilities/EnumUtilities.hpp"
 #include "botcraft/Utilities/Logger.hpp"
+#include "botcraft/Utilities/MPSCRingBuffer.hpp"
 
-#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 namespace Botcraft
 {
     DEFINE_ENUM_STRINGIFYER_RANGE(LogLevel, LogLevel::Trace, LogLevel::None);
 
+    namespace
+    {
+        /// @brief Max time between two checks of the queue by the writer thread
+        constexpr std::chrono::milliseconds writer_wait_timeout(10);
+        /// @brief Max time a thread waits for space in the queue before dropping its message
+        constexpr std::chrono::milliseconds max_push_wait(1);
+
+        struct ThreadPrefixCache
+        {
+            size_t version = std::numeric_limits<size_t>::max();
+            std::shared_ptr<const std::string> prefix;
+        };
+        thread_local ThreadPrefixCache thread_prefix_cache;
+    }
+
     Logger::Logger()
     {
         filename = "";
-        file_buffer = "";
         log_level = LogLevel::Info;
-        last_time_logged = std::chrono::steady_clock::now();
-        log_func = [this](const std::string& s)
-        {
-            std::cout << s;
-            std::cout.flush();
-        };
+        log_func = nullptr;
+        last_time_flushed = std::chrono::steady_clock::now();
+        queue = std::make_unique<Utilities::MPSCRingBuffer<LogEntry> >(queue_capacity);
+        num_dropped = 0;
+        num_dropped_reported = 0;
+        writer_waiting = false;
+        cached_date_time = 0;
+        thread_names_version = 0;
+
+        running = true;
+        writer_thread = std::thread(&Logger::WriterLoop, this);
     }
 
     Logger::~Logger()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (filename != "")
+        { // lock scope
+            std::scoped_lock<std::mutex> lock(mutex);
+            running = false;
+        }
+        writer_cv.notify_all();
+        if (writer_thread.joinable())
+        {
+            writer_thread.join();
+        }
+
+        std::scoped_lock<std::mutex> lock(mutex);
+        while (ProcessQueue())
         {
-            std::ofstream outfile(filename, std::ios::out | std::ios::app);
-            outfile << file_buffer;
+
+        }
+        if (file.is_open())
+        {
+            file.close();
         }
-        file_buffer = "";
     }
 
     Logger& Logger::GetInstance()
@@ -39,30 +71,68 @@ namespace Botcraft
         return test;
     }
 
+    void Logger::Log(const LogLevel level, const char* file, const int line, std::string&& message)
+    {
+        LogEntry entry;
+        entry.time = std::chrono::system_clock::now();
+        entry.level = level;
+        entry.file = file;
+        entry.line = line;
+        entry.thread = GetCurrentThreadPrefix();
+        entry.message = std::move(message);
+        Push(std::move(entry));
+
+        // Make sure fatal errors are visible even if we crash right after
+        if (level == LogLevel::Fatal)
+        {
+            Flush();
+        }
+    }
+
     void Logger::Log(const std::string& s)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        log_func(s);
+        LogEntry entry;
+        entry.time = std::chrono::system_clock::now();
+        entry.level = LogLevel::Info;
+        entry.message = s;
+        Push(std::move(entry));
+    }
 
-        file_buffer += s;
-        auto now = std::chrono::steady_clock::now();
-        // Only write to file every 5 seconds
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - last_time_logged).count() > 5000)
+    void Logger::Flush()
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        const size_t pushed = queue->GetNumPushed();
+        // Some entries may have been claimed by other threads but not written yet
+        while (queue->GetNumPopped() < pushed)
         {
-            if (filename != "")
+            if (!ProcessQueue())
             {
-                std::ofstream outfile(filename, std::ios::out | std::ios::app);
-                outfile << file_buffer;
+                std::this_thread::yield();
             }
-            file_buffer = "";
-            last_time_logged = now;
+        }
+        if (file.is_open())
+        {
+            file.flush();
         }
     }
 
     void Logger::SetFilename(const std::string& s)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::scoped_lock<std::mutex> lock(mutex);
+        // Write what's already there in the previous file
+        while (ProcessQueue())
+        {
+
+        }
+        if (file.is_open())
+        {
+            file.close();
+        }
         filename = s;
+        if (filename != "")
+        {
+            file.open(filename, std::ios::out | std::ios::app);
+        }
     }
 
     void Logger::SetLogLevel(const LogLevel l)
@@ -77,7 +147,7 @@ namespace Botcraft
 
     void Logger::SetLogFunc(const std::function<void(const std::string&)>& f)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::scoped_lock<std::mutex> lock(mutex);
         log_func = f;
     }
 
@@ -101,10 +171,18 @@ namespace Botcraft
         return s;
     }
 
+    size_t Logger::GetNumDroppedMessages() const
+    {
+        return num_dropped.load(std::memory_order_relaxed);
+    }
+
     void Logger::RegisterThread(const std::string& name)
     {
-        std::lock_guard<std::mutex> lock(thread_mutex);
-        thread_names[std::this_thread::get_id()] = name;
+        { // lock scope
+            std::lock_guard<std::mutex> lock(thread_mutex);
+            thread_names[std::this_thread::get_id()] = name;
+            thread_names_version.fetch_add(1, std::memory_order_release);
+        }
 
         thread_local struct ThreadExiter
         {
@@ -119,17 +197,195 @@ namespace Botcraft
     {
         std::lock_guard<std::mutex> lock(thread_mutex);
         thread_names[id] = name;
+        thread_names_version.fetch_add(1, std::memory_order_release);
     }
 
     std::string Logger::GetThreadName(const std::thread::id id)
     {
         std::lock_guard<std::mutex> lock(thread_mutex);
-        return thread_names[id];
+        const auto it = thread_names.find(id);
+        return it == thread_names.end() ? "" : it->second;
     }
 
     void Logger::UnregisterThread(const std::thread::id id)
     {
         std::lock_guard<std::mutex> lock(thread_mutex);
         thread_names.erase(id);
+        thread_names_version.fetch_add(1, std::memory_order_release);
+    }
+
+    std::shared_ptr<const std::string> Logger::GetCurrentThreadPrefix()
+    {
+        const size_t version = thread_names_version.load(std::memory_order_acquire);
+        if (thread_prefix_cache.version != version || thread_prefix_cache.prefix == nullptr)
+        {
+            std::ostringstream s;
+            s << '[' << GetThreadName(std::this_thread::get_id()) << '(' << std::this_thread::get_id() << ")]";
+            thread_prefix_cache.prefix = std::make_shared<const std::string>(s.str());
+            thread_prefix_cache.version = version;
+        }
+        return thread_prefix_cache.prefix;
+    }
+
+    void Logger::Push(LogEntry&& entry)
+    {
+        // Writer thread is stopped, write it ourselves
+        if (!running)
+        {
+            std::scoped_lock<std::mutex> lock(mutex);
+            std::string formatted;
+            Format(entry, formatted);
+            Output(formatted);
+            if (log_func == nullptr)
+            {
+                std::cout.flush();
+            }
+            return;
+        }
+
+        if (queue->TryPush(std::move(entry)))
+        {
+            if (writer_waiting.load(std::memory_order_relaxed))
+            {
+                writer_cv.notify_one();
+            }
+            return;
+        }
+
+        // Queue is full, give some time to the writer thread before dropping the message.
+        // Errors are never dropped
+        const bool can_drop = entry.level < LogLevel::Error;
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + max_push_wait;
+        do
+        {
+            writer_cv.notify_one();
+            std::this_thread::yield();
+            if (queue->TryPush(std::move(entry)))
+            {
+                return;
+            }
+        } while (!can_drop || std::chrono::steady_clock::now() < deadline);
+
+        num_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Logger::WriterLoop()
+    {
+        RegisterThread("Logger");
+        while (running)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!ProcessQueue())
+            {
+                // Notifications sent between ProcessQueue and wait_for are lost, but the timeout bounds the delay
+                writer_waiting = true;
+                writer_cv.wait_for(lock, writer_wait_timeout, [this]() { return !running; });
+                writer_waiting = false;
+            }
+
+            // Only flush file every 5 seconds
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (file.is_open() && now - last_time_flushed > std::chrono::seconds(5))
+            {
+                file.flush();
+                last_time_flushed = now;
+            }
+        }
+    }
+
+    bool Logger::ProcessQueue()
+    {
+        std::string formatted;
+        LogEntry entry;
+        size_t num_processed = 0;
+        // Limit the number of entries so the mutex is regularly released under heavy load
+        while (num_processed < queue_capacity && queue->TryPop(entry))
+        {
+            formatted.clear();
+            Format(entry, formatted);
+            Output(formatted);
+            num_processed += 1;
+        }
+
+        const size_t dropped = num_dropped.load(std::memory_order_relaxed);
+        if (dropped != num_dropped_reported)
+        {
+            LogEntry warning;
+            warning.time = std::chrono::system_clock::now();
+            warning.level = LogLevel::Warning;
+            warning.file = file_name(__FILE__);
+            warning.line = __LINE__;
+            warning.thread = GetCurrentThreadPrefix();
+            warning.message = std::to_string(dropped - num_dropped_reported) + " log messages dropped because the queue was full";
+            formatted.clear();
+            Format(warning, formatted);
+            Output(formatted);
+            num_dropped_reported = dropped;
+        }
+
+        if (num_processed > 0 && log_func == nullptr)
+        {
+            std::cout.flush();
+        }
+
+        return num_processed > 0;
+    }
+
+    void Logger::Format(const LogEntry& entry, std::string& output)
+    {
+        if (entry.file == nullptr)
+        {
+            output += entry.message;
+            return;
+        }
+
+        const std::time_t t = std::chrono::system_clock::to_time_t(entry.time);
+        if (t != cached_date_time || cached_date.empty())
+        {
+            std::tm tm;
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "[%Y-%m-%d %H:%M:%S.", &tm);
+            cached_date = buffer;
+            cached_date_time = t;
+        }
+        const int ms = static_cast<int>((std::chrono::duration_cast<std::chrono::milliseconds>(entry.time.time_since_epoch()) % 1000).count());
+
+        output += cached_date;
+        output += static_cast<char>('0' + ms / 100);
+        output += static_cast<char>('0' + (ms / 10) % 10);
+        output += static_cast<char>('0' + ms % 10);
+        output += "] ";
+        output += level_strings[static_cast<size_t>(entry.level)];
+        output += ' ';
+        output += *entry.thread;
+        output += ' ';
+        output += entry.file;
+        output += '(';
+        output += std::to_string(entry.line);
+        output += "): ";
+        output += entry.message;
+        output += '\n';
+    }
+
+    void Logger::Output(const std::string& s)
+    {
+        if (log_func != nullptr)
+        {
+            log_func(s);
+        }
+        else
+        {
+            std::cout << s;
+        }
+
+        if (file.is_open())
+        {
+            file << s;
+        }
     }
 }
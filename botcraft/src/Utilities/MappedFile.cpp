@@ -0,0 +1,111 @@
+#if _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "botcraft/Utilities/MappedFile.hpp"
+
+namespace Botcraft::Utilities
+{
+    MappedFile::MappedFile(const std::string& path)
+    {
+        data = nullptr;
+        size = 0;
+#if _WIN32
+        file = nullptr;
+        mapping = nullptr;
+
+        HANDLE file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        file = file_handle;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+        {
+            return;
+        }
+
+        mapping = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            return;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            return;
+        }
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(file_size.QuadPart);
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+            close(fd);
+            return;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after closing the file descriptor
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            return;
+        }
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(file_stat.st_size);
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#if _WIN32
+        if (data != nullptr)
+        {
+            UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr)
+        {
+            CloseHandle(mapping);
+        }
+        if (file != nullptr)
+        {
+            CloseHandle(file);
+        }
+#else
+        if (data != nullptr)
+        {
+            munmap(const_cast<unsigned char*>(data), size);
+        }
+#endif
+    }
+
+    bool MappedFile::IsValid() const
+    {
+        return data != nullptr;
+    }
+
+    const unsigned char* MappedFile::GetData() const
+    {
+        return data;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return size;
+    }
+} // Botcraft::Utilities
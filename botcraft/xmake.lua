@@ -113,6 +113,11 @@ target("botcraft")
     if has_config("compression") then
         add_packages("zlib")
         add_defines("USE_COMPRESSION")
+
+        if has_config("libdeflate") then
+            add_packages("libdeflate")
+            add_defines("USE_LIBDEFLATE")
+        end
     end
 
     -- If encryption is enabled
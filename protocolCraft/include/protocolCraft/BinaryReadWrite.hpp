@@ -14,7 +14,9 @@ namespace ProtocolCraft
 {
     class NetworkType;
 
-    using ReadIterator = std::vector<unsigned char>::const_iterator;
+    /// @brief Data is read from plain pointers, so any contiguous buffer
+    /// can be parsed without copying it into a std::vector first
+    using ReadIterator = const unsigned char*;
     using WriteContainer = std::vector<unsigned char>;
 
     using UUID = std::array<unsigned char, 16>;
@@ -18,7 +18,7 @@ namespace ProtocolCraft
             template <typename C>
             static storage_type Read(
                 const C* c,
-                std::vector<unsigned char>::const_iterator& iter,
+                ReadIterator& iter,
                 size_t& length
 #ifdef PROTOCOLCRAFT_DETAILED_PARSING
                 ,
@@ -4,5 +4,5 @@
 
 namespace ProtocolCraft
 {
-    std::vector<unsigned char> ExtractGZip(std::vector<unsigned char>::const_iterator& iter, std::size_t& length);
+    std::vector<unsigned char> ExtractGZip(const unsigned char*& iter, std::size_t& length);
 }
@@ -72,7 +72,7 @@ namespace ProtocolCraft
                 std::istream_iterator<unsigned char>()
             );
 
-            ReadIterator iter = file_content.begin();
+            ReadIterator iter = file_content.data();
             size_t length = file_content.size();
 
             v = ReadData<Value>(iter, length);
@@ -86,7 +86,7 @@ namespace ProtocolCraft
             if (length > 10 && *iter == 0x1F && *(iter + 1) == 0x8B)
             {
                 const std::vector<unsigned char> decompressed = ExtractGZip(iter, length);
-                ReadIterator decomp_iter = decompressed.begin();
+                ReadIterator decomp_iter = decompressed.data();
                 size_t decomp_length = decompressed.size();
                 Tag::ReadImpl(decomp_iter, decomp_length);
             }
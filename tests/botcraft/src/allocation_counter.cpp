@@ -0,0 +1,50 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+namespace
+{
+    thread_local size_t num_allocations = 0;
+}
+
+size_t GetNumAllocations()
+{
+    return num_allocations;
+}
+
+// Count allocations to check some queries don't allocate
+void* operator new(std::size_t size)
+{
+    num_allocations += 1;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+/// @brief Get the number of heap allocations made by the current thread since it started.
+/// Counted by the global operator new replacement defined in allocation_counter.cpp
+size_t GetNumAllocations();
@@ -1,7 +1,17 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include <botcraft/AI/BehaviourTree.hpp>
+#include <botcraft/AI/SharedBehaviourThreads.hpp>
+#include <botcraft/Utilities/Coroutine.hpp>
 
 using namespace Botcraft;
 
@@ -653,3 +663,110 @@ TEST_CASE("NodeCallbacks")
     CHECK(context.num_failure_tick == 3);
     CHECK(context.num_child_tick == 8);
 }
+
+/// @brief Step num_behaviours trees, half of them always ready, on the shared threads
+/// @return Time to run 10 steps of the first one, in ms
+double RunSharedBehaviours(const size_t num_behaviours)
+{
+    std::vector<std::unique_ptr<std::atomic<int>>> counters;
+    std::atomic<bool> should_stop = false;
+    std::vector<std::shared_ptr<SharedBehaviour>> behaviours;
+    for (size_t i = 0; i < num_behaviours; ++i)
+    {
+        counters.push_back(std::make_unique<std::atomic<int>>(0));
+        std::atomic<int>* counter = counters.back().get();
+        auto tree = Builder<std::atomic<int>>()
+            .leaf([](std::atomic<int>& c) { c += 1; Utilities::Coroutine::Suspend(); return Status::Success; });
+        behaviours.push_back(SharedBehaviourThreads::GetInstance().Add(
+            [tree, counter, &should_stop]() { while (!should_stop) { tree->Tick(*counter); } },
+            [i]() { return i % 2 == 0; }
+        ));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i)
+    {
+        behaviours.front()->WaitNextStep();
+    }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    should_stop = true;
+    for (const std::shared_ptr<SharedBehaviour>& b : behaviours)
+    {
+        SharedBehaviourThreads::GetInstance().Stop(b);
+    }
+
+    int min_steps = std::numeric_limits<int>::max();
+    for (size_t i = 0; i < num_behaviours; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            min_steps = std::min(min_steps, counters[i]->load());
+        }
+        else
+        {
+            // Never stepped, only resumed once to stop
+            CHECK(*counters[i] <= 1);
+        }
+    }
+    CHECK(min_steps >= 8);
+    return elapsed_ms;
+}
+
+TEST_CASE("Coroutine trees")
+{
+    SECTION("Suspend inside a tree")
+    {
+        // Same as a task calling client.Yield() while it's waiting for something
+        auto tree = Builder<int>()
+            .sequence()
+                .leaf([](int& i) { i += 1; return Status::Success; })
+                .leaf([](int& i) { while (i < 4) { Utilities::Coroutine::Suspend(); i += 1; } return Status::Success; })
+                .leaf([](int& i) { i += 10; return Status::Success; })
+            .end();
+
+        int i = 0;
+        Status status = Status::Failure;
+        Utilities::Coroutine coroutine([&]() { status = tree->Tick(i); }, 64 * 1024);
+        CHECK_FALSE(Utilities::Coroutine::IsInsideCoroutine());
+        coroutine.Resume();
+        CHECK(i == 1);
+        CHECK_FALSE(coroutine.IsFinished());
+        coroutine.Resume();
+        coroutine.Resume();
+        CHECK(i == 3);
+        coroutine.Resume();
+        CHECK(i == 14);
+        CHECK(coroutine.IsFinished());
+        CHECK(status == Status::Success);
+    }
+
+    SECTION("Exceptions")
+    {
+        Utilities::Coroutine coroutine([]() { Utilities::Coroutine::Suspend(); throw std::runtime_error("Exception to catch"); }, 64 * 1024);
+        coroutine.Resume();
+        CHECK_THROWS_AS(coroutine.Resume(), std::runtime_error);
+        CHECK(coroutine.IsFinished());
+        CHECK_THROWS(Utilities::Coroutine::Suspend());
+    }
+
+    SECTION("Shared behaviour threads")
+    {
+        SharedBehaviourThreads::GetInstance().Start(2, 64 * 1024);
+        REQUIRE(SharedBehaviourThreads::GetInstance().IsStarted());
+
+        // More trees than threads
+        RunSharedBehaviours(200);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Shared behaviour threads timings", "[.benchmark]")
+{
+    SharedBehaviourThreads::GetInstance().Start(2, 64 * 1024);
+    REQUIRE(SharedBehaviourThreads::GetInstance().IsStarted());
+
+    constexpr size_t num_behaviours = 2000;
+    const double elapsed_ms = RunSharedBehaviours(num_behaviours);
+    WARN(num_behaviours << " trees on 2 threads, 10 steps in " << elapsed_ms << " ms");
+}
@@ -1,5 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <botcraft/AI/Blackboard.hpp>
 
 using namespace Botcraft;
@@ -77,3 +82,130 @@ TEST_CASE("Blackboard notifications")
     blackboard.Reset();
     REQUIRE(observer.is_reset);
 }
+
+TEST_CASE("Blackboard typed keys")
+{
+    Blackboard blackboard;
+    TestBlackboardObserver observer;
+    blackboard.Subscribe(&observer);
+
+    const BlackboardKey<int> int_key("Test.int");
+    const BlackboardKey<std::string> string_key("Test.string");
+
+    SECTION("Interning")
+    {
+        CHECK(BlackboardKey<int>("Test.int").GetId() == int_key.GetId());
+        CHECK(int_key.GetId() != string_key.GetId());
+        CHECK(int_key.GetName() == "Test.int");
+    }
+
+    SECTION("Shared with string API")
+    {
+        REQUIRE_FALSE(blackboard.Contains(int_key));
+        REQUIRE_THROWS_AS(blackboard.Get(int_key), std::out_of_range);
+
+        blackboard.Set(int_key, 3);
+        REQUIRE(observer.is_value_changed);
+        REQUIRE(blackboard.Contains("Test.int"));
+        REQUIRE(blackboard.Get<int>("Test.int") == 3);
+
+        blackboard.Set("Test.string", std::string("hello"));
+        REQUIRE(blackboard.Get(string_key) == "hello");
+        REQUIRE_THROWS(blackboard.Get<int>("Test.string"));
+
+        REQUIRE(blackboard.Get(BlackboardKey<int>("Test.other"), 42) == 42);
+        REQUIRE(blackboard.Get<int>("Test.other") == 42);
+
+        blackboard.Copy("Test.int", "Test.copy");
+        REQUIRE(blackboard.Get(BlackboardKey<int>("Test.copy")) == 3);
+
+        blackboard.Erase(int_key);
+        REQUIRE(observer.is_value_removed);
+        REQUIRE_FALSE(blackboard.Contains("Test.int"));
+
+        blackboard.Reset({ { "Test.int", 7 } });
+        REQUIRE(observer.is_reset);
+        REQUIRE(blackboard.Get(int_key) == 7);
+        REQUIRE_FALSE(blackboard.Contains(string_key));
+    }
+
+    SECTION("References")
+    {
+        blackboard.Set(string_key, std::string("hello"));
+        observer.is_value_changed = false;
+        {
+            const NotifyOnEndUseRef<std::string> wrapped_ref = blackboard.GetRef(string_key);
+            wrapped_ref.ref() += " world";
+            REQUIRE_FALSE(observer.is_value_changed);
+        }
+        REQUIRE(observer.is_value_changed);
+        REQUIRE(blackboard.Get<std::string>("Test.string") == "hello world");
+
+        {
+            const NotifyOnEndUseRef<int> wrapped_ref = blackboard.GetRef(int_key, 5);
+            wrapped_ref.ref() += 1;
+            // Erased while the ref is alive, no notification but no crash either
+            blackboard.Erase(int_key);
+        }
+
+        // References stay valid when new keys are added
+        blackboard.Set(int_key, 12);
+        const int& int_ref = blackboard.Get(int_key);
+        const std::string& string_ref = blackboard.Get(string_key);
+        for (int i = 0; i < 256; ++i)
+        {
+            blackboard.Set("Test.references." + std::to_string(i), i);
+        }
+        REQUIRE(int_ref == 12);
+        REQUIRE(string_ref == "hello world");
+    }
+
+    SECTION("Many keys")
+    {
+        std::vector<BlackboardKey<int>> keys;
+        for (int i = 0; i < 64; ++i)
+        {
+            keys.emplace_back("Test.Many.key_" + std::to_string(i));
+            blackboard.Set(keys.back(), i);
+        }
+        for (int i = 0; i < 64; ++i)
+        {
+            CHECK(blackboard.Get(keys[i]) == i);
+            CHECK(blackboard.Get<int>(keys[i].GetName()) == i);
+        }
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Blackboard typed keys access time", "[.benchmark]")
+{
+    Blackboard blackboard;
+
+    constexpr int num_keys = 64;
+    constexpr int num_runs = 100000;
+    std::vector<BlackboardKey<int>> keys;
+    for (int i = 0; i < num_keys; ++i)
+    {
+        keys.emplace_back("Test.Bench.key_" + std::to_string(i));
+        blackboard.Set(keys.back(), i);
+    }
+
+    long long sum_string = 0;
+    const auto string_start = std::chrono::steady_clock::now();
+    for (int k = 0; k < num_runs; ++k)
+    {
+        sum_string += blackboard.Get<int>(keys[k % num_keys].GetName());
+    }
+    const double string_elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - string_start).count();
+
+    long long sum_key = 0;
+    const auto key_start = std::chrono::steady_clock::now();
+    for (int k = 0; k < num_runs; ++k)
+    {
+        sum_key += blackboard.Get(keys[k % num_keys]);
+    }
+    const double key_elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - key_start).count();
+
+    REQUIRE(sum_string == sum_key);
+    WARN("Blackboard Get with " << num_keys << " keys, string: " << string_elapsed / num_runs << " ns, typed key: " << key_elapsed / num_runs << " ns");
+}
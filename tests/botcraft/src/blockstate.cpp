@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <set>
+#include <vector>
+
 #include <botcraft/Game/World/Blockstate.hpp>
 
 using namespace Botcraft;
@@ -176,3 +179,110 @@ TEST_CASE("Testing mining time calculation")
         REQUIRE_THAT(blockstate.GetMiningTimeSeconds(ToolType::Hoe, ToolMaterial::Diamond), Catch::Matchers::WithinAbs(0.0, 0.04));
     }
 }
+
+TEST_CASE("Blockstate colliders")
+{
+    BlockstateProperties blockstate_properties;
+    blockstate_properties.solid = true;
+    Model model;
+    // Fence like shape, with two colliders
+    model.SetColliders({
+        AABB(Vector3<double>(0.5, 0.75, 0.5), Vector3<double>(0.125, 0.75, 0.125)),
+        AABB(Vector3<double>(0.75, 0.75, 0.5), Vector3<double>(0.25, 0.75, 0.0625))
+    });
+
+    SECTION("No offset")
+    {
+        Blockstate blockstate(blockstate_properties, model);
+        const Position pos(-3, 64, 17);
+
+        const ColliderRange local_colliders = blockstate.GetLocalColliders(pos);
+        REQUIRE(local_colliders.size() == 2);
+        const std::set<AABB> colliders = blockstate.GetCollidersAtPos(pos);
+        std::vector<AABB> output = { AABB(Vector3<double>(0.0), Vector3<double>(1.0)) };
+        blockstate.AppendCollidersAtPos(pos, output);
+        REQUIRE(output.size() == 3);
+        CHECK(std::set<AABB>(output.begin() + 1, output.end()) == colliders);
+        for (const AABB& c : local_colliders)
+        {
+            CHECK(colliders.count(c + Vector3<double>(pos.x, pos.y, pos.z)) == 1);
+        }
+    }
+
+    SECTION("Horizontal offset")
+    {
+        blockstate_properties.horizontal_offset = 0.25f;
+        Blockstate blockstate(blockstate_properties, model);
+
+        bool any_offset = false;
+        for (int x = 0; x < 16; ++x)
+        {
+            const Position pos(x, 0, 2 * x);
+            const Vector3<double> offset = blockstate.GetHorizontalOffsetAtPos(pos);
+            any_offset |= offset.x != pos.x || offset.z != pos.z;
+            std::vector<AABB> output;
+            blockstate.AppendCollidersAtPos(pos, output);
+            CHECK(std::set<AABB>(output.begin(), output.end()) == blockstate.GetCollidersAtPos(pos));
+        }
+        CHECK(any_offset);
+    }
+
+    SECTION("No collider")
+    {
+        Blockstate blockstate(blockstate_properties, Model());
+        CHECK(blockstate.GetLocalColliders(Position(0, 0, 0)).empty());
+        std::vector<AABB> output;
+        blockstate.AppendCollidersAtPos(Position(0, 0, 0), output);
+        CHECK(output.empty());
+    }
+}
+
+#if !USE_GUI
+TEST_CASE("Blockstate cache")
+{
+    BlockstateProperties blockstate_properties;
+    blockstate_properties.id = 42;
+    blockstate_properties.name = "minecraft:test_block";
+    blockstate_properties.solid = true;
+    blockstate_properties.hardness = 3.0f;
+    blockstate_properties.friction = 0.8f;
+    blockstate_properties.horizontal_offset = 0.25f;
+    blockstate_properties.tint_type = TintType::Grass;
+    blockstate_properties.variables = { "facing=north", "waterlogged=true" };
+    blockstate_properties.waterlogged = "waterlogged=true";
+    blockstate_properties.best_tools = { BestTool{ ToolType::Pickaxe, ToolMaterial::Stone, 1.0f } };
+
+    Model model;
+    model.SetColliders({ AABB(Vector3<double>(0.5, 0.25, 0.5), Vector3<double>(0.5, 0.25, 0.5)), AABB(Vector3<double>(0.5, 0.75, 0.25), Vector3<double>(0.5, 0.25, 0.25)) });
+    const Blockstate blockstate(blockstate_properties, model);
+
+    ProtocolCraft::WriteContainer container;
+    blockstate.WriteCache(container);
+
+    ProtocolCraft::ReadIterator iter = container.data();
+    size_t length = container.size();
+    const Blockstate loaded(iter, length);
+    CHECK(length == 0);
+
+    CHECK(loaded.GetId() == blockstate.GetId());
+    CHECK(loaded.GetName() == blockstate.GetName());
+    CHECK(loaded.IsSolid());
+    CHECK(loaded.IsWaterlogged());
+    CHECK(loaded.GetHardness() == blockstate.GetHardness());
+    CHECK(loaded.GetFriction() == blockstate.GetFriction());
+    CHECK(loaded.GetTintType() == blockstate.GetTintType());
+    CHECK(loaded.GetVariables() == blockstate.GetVariables());
+    CHECK(loaded.GetNumModels() == blockstate.GetNumModels());
+    for (const Position& pos : { Position(0, 0, 0), Position(3, 7, -5), Position(-12, 64, 9) })
+    {
+        CHECK(loaded.GetCollidersAtPos(pos) == blockstate.GetCollidersAtPos(pos));
+    }
+    CHECK(loaded.GetMiningTimeSeconds(ToolType::Pickaxe, ToolMaterial::Iron) == blockstate.GetMiningTimeSeconds(ToolType::Pickaxe, ToolMaterial::Iron));
+    CHECK(loaded.GetMiningTimeSeconds(ToolType::None, ToolMaterial::None) == blockstate.GetMiningTimeSeconds(ToolType::None, ToolMaterial::None));
+
+    // Truncated data
+    iter = container.data();
+    length = container.size() / 2;
+    CHECK_THROWS(Blockstate(iter, length));
+}
+#endif
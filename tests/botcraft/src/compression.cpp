@@ -0,0 +1,169 @@
+#ifdef USE_COMPRESSION
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <botcraft/Network/Compression.hpp>
+#include <botcraft/Network/PacketBufferPool.hpp>
+#include <protocolCraft/BinaryReadWrite.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+    /// @brief Build chunk data payloads with the same layout as the ones sent by
+    /// a server: 24 paletted sections (stone with some ores underground, a few
+    /// surface blocks, then air) followed by light arrays
+    std::vector<std::vector<unsigned char>> MakeChunkPayloads(const size_t num_chunks)
+    {
+        std::mt19937 random_gen(42);
+        std::vector<std::vector<unsigned char>> payloads(num_chunks);
+        for (std::vector<unsigned char>& payload : payloads)
+        {
+            for (int section = 0; section < 24; ++section)
+            {
+                if (section > 12)
+                {
+                    // Single value air section
+                    ProtocolCraft::WriteData<short>(0, payload);
+                    ProtocolCraft::WriteData<unsigned char>(0, payload);
+                    ProtocolCraft::WriteData<ProtocolCraft::VarInt>(0, payload);
+                }
+                else
+                {
+                    // 4 bits per block palette, mostly stone
+                    ProtocolCraft::WriteData<short>(4096, payload);
+                    ProtocolCraft::WriteData<unsigned char>(4, payload);
+                    ProtocolCraft::WriteData<ProtocolCraft::VarInt>(8, payload);
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(1 + i * 97, payload);
+                    }
+                    ProtocolCraft::WriteData<ProtocolCraft::VarInt>(256, payload);
+                    for (int i = 0; i < 256; ++i)
+                    {
+                        unsigned long long int l = 0;
+                        for (int j = 0; j < 16; ++j)
+                        {
+                            const unsigned long long int block = random_gen() % (section == 12 ? 3 : 40);
+                            l |= (block < 8 ? block : 0ULL) << (4 * j);
+                        }
+                        ProtocolCraft::WriteData<unsigned long long int>(l, payload);
+                    }
+                }
+                // Single value biome
+                ProtocolCraft::WriteData<unsigned char>(0, payload);
+                ProtocolCraft::WriteData<ProtocolCraft::VarInt>(random_gen() % 4, payload);
+            }
+            // Sky light, dark underground and full above
+            for (int section = 0; section < 26; ++section)
+            {
+                ProtocolCraft::WriteData<ProtocolCraft::VarInt>(2048, payload);
+                payload.insert(payload.end(), 2048, section > 13 ? 0xFF : 0x00);
+            }
+        }
+        return payloads;
+    }
+}
+
+TEST_CASE("Compression")
+{
+    const std::vector<std::vector<unsigned char>> payloads = MakeChunkPayloads(16);
+    Compressor compressor;
+    Decompressor decompressor;
+
+    std::vector<std::vector<unsigned char>> compressed_payloads(payloads.size());
+    for (size_t i = 0; i < payloads.size(); ++i)
+    {
+        compressor.Compress(payloads[i].data(), payloads[i].size(), compressed_payloads[i]);
+        REQUIRE(compressed_payloads[i].size() < payloads[i].size());
+    }
+
+    SECTION("Round trip")
+    {
+        // Go through everything twice to check the streams are properly reset
+        for (int k = 0; k < 2; ++k)
+        {
+            for (size_t i = 0; i < payloads.size(); ++i)
+            {
+                std::vector<unsigned char> decompressed(payloads[i].size());
+                decompressor.Decompress(compressed_payloads[i].data(), compressed_payloads[i].size(), decompressed.data(), decompressed.size());
+                CHECK(decompressed == payloads[i]);
+                // Legacy one-shot version must read the same stream
+                CHECK(Decompress(compressed_payloads[i]) == payloads[i]);
+            }
+        }
+    }
+
+    SECTION("Append to output")
+    {
+        std::vector<unsigned char> output = { 1, 2, 3 };
+        compressor.Compress(payloads[0].data(), payloads[0].size(), output);
+        REQUIRE(output.size() == compressed_payloads[0].size() + 3);
+        std::vector<unsigned char> decompressed(payloads[0].size());
+        decompressor.Decompress(output.data() + 3, output.size() - 3, decompressed.data(), decompressed.size());
+        CHECK(decompressed == payloads[0]);
+    }
+
+    SECTION("Wrong size")
+    {
+        std::vector<unsigned char> decompressed(payloads[0].size() + 1);
+        CHECK_THROWS(decompressor.Decompress(compressed_payloads[0].data(), compressed_payloads[0].size(), decompressed.data(), payloads[0].size() - 1));
+        CHECK_THROWS(decompressor.Decompress(compressed_payloads[0].data(), compressed_payloads[0].size(), decompressed.data(), payloads[0].size() + 1));
+        // Decompressor is still usable after an error
+        decompressor.Decompress(compressed_payloads[0].data(), compressed_payloads[0].size(), decompressed.data(), payloads[0].size());
+        decompressed.pop_back();
+        CHECK(decompressed == payloads[0]);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Compression throughput", "[.benchmark]")
+{
+    const std::vector<std::vector<unsigned char>> payloads = MakeChunkPayloads(16);
+    Compressor compressor;
+    Decompressor decompressor;
+
+    std::vector<std::vector<unsigned char>> compressed_payloads(payloads.size());
+    for (size_t i = 0; i < payloads.size(); ++i)
+    {
+        compressor.Compress(payloads[i].data(), payloads[i].size(), compressed_payloads[i]);
+    }
+
+    constexpr int num_runs = 20;
+    size_t total_size = 0;
+    for (const std::vector<unsigned char>& p : payloads)
+    {
+        total_size += p.size() * num_runs;
+    }
+
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < num_runs; ++k)
+    {
+        for (const std::vector<unsigned char>& c : compressed_payloads)
+        {
+            checksum += Decompress(c).back();
+        }
+    }
+    const double one_shot_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PacketBufferPool pool;
+    const auto reused_start = std::chrono::steady_clock::now();
+    for (int k = 0; k < num_runs; ++k)
+    {
+        for (size_t i = 0; i < compressed_payloads.size(); ++i)
+        {
+            const PacketBuffer buffer = pool.Acquire(payloads[i].size());
+            decompressor.Decompress(compressed_payloads[i].data(), compressed_payloads[i].size(), buffer->data(), buffer->size());
+            checksum -= buffer->back();
+        }
+    }
+    const double reused_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - reused_start).count();
+
+    CHECK(checksum == 0);
+    WARN("Decompressed " << total_size / (1024 * 1024) << " MB of chunk data, one-shot: " << static_cast<size_t>(total_size / (1024.0 * 1024.0 * one_shot_elapsed)) << " MB/s, reused stream: " << static_cast<size_t>(total_size / (1024.0 * 1024.0 * reused_elapsed)) << " MB/s");
+}
+#endif
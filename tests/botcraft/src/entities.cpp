@@ -0,0 +1,333 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <botcraft/Game/Entities/EntityManager.hpp>
+#include <botcraft/Game/Entities/entities/Entity.hpp>
+#include <botcraft/Game/Entities/entities/LivingEntity.hpp>
+
+#include <protocolCraft/BinaryReadWrite.hpp>
+#include <protocolCraft/Handler.hpp>
+#include <protocolCraft/Packets/Game/Clientbound/ClientboundMoveEntityPacketPos.hpp>
+#include <protocolCraft/Packets/Game/Clientbound/ClientboundSetEntityDataPacket.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+    std::shared_ptr<Entity> AddTestEntity(EntityManager& entity_manager, const EntityType type, const int id, const Vector3<double>& position)
+    {
+        std::shared_ptr<Entity> entity = Entity::CreateEntity(type);
+        entity->SetEntityID(id);
+        entity->SetPosition(position);
+        entity_manager.AddEntity(entity);
+        return entity;
+    }
+
+    std::set<int> BruteForceRadius(EntityManager& entity_manager, const Vector3<double>& center, const double radius, const EntityType type)
+    {
+        std::set<int> output;
+        auto entities = entity_manager.GetEntities();
+        for (const auto& [id, entity] : *entities)
+        {
+            if ((type == EntityType::None || entity->GetType() == type) &&
+                (entity->GetPosition() - center).SqrNorm() <= radius * radius)
+            {
+                output.insert(id);
+            }
+        }
+        return output;
+    }
+
+    std::set<int> QueryRadiusIds(const EntityManager& entity_manager, const Vector3<double>& center, const double radius, const EntityType type)
+    {
+        std::set<int> output;
+        entity_manager.QueryRadius(center, radius, [&](const std::shared_ptr<Entity>& e) { output.insert(e->GetEntityID()); }, type);
+        return output;
+    }
+
+    /// @brief Random position in a 1000x1000 area, over the whole world height
+    Vector3<double> RandomPosition(std::mt19937& random_engine)
+    {
+        std::uniform_real_distribution<double> horizontal(-500.0, 500.0);
+        std::uniform_real_distribution<double> vertical(-64.0, 320.0);
+        return Vector3<double>(horizontal(random_engine), vertical(random_engine), horizontal(random_engine));
+    }
+
+    /// @brief Add num_entities monsters, animals and items at random positions
+    void AddRandomEntities(EntityManager& entity_manager, const int num_entities, std::mt19937& random_engine)
+    {
+        const std::vector<EntityType> types = { EntityType::Zombie, EntityType::Skeleton, EntityType::Cow, EntityType::ItemEntity };
+        for (int i = 0; i < num_entities; ++i)
+        {
+            AddTestEntity(entity_manager, types[i % types.size()], i, RandomPosition(random_engine));
+        }
+    }
+
+#if PROTOCOL_VERSION > 760 /* > 1.19.2 */
+    /// @brief Zombie metadata (index, type, value), as sent in a SetEntityData packet
+    std::vector<unsigned char> MetadataPacketData(const int i)
+    {
+        std::vector<unsigned char> data;
+        ProtocolCraft::WriteData<unsigned char>(0, data); // data_shared_flags_id
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(0, data); // Char
+        ProtocolCraft::WriteData<char>(static_cast<char>(i % 2), data);
+        ProtocolCraft::WriteData<unsigned char>(1, data); // data_air_supply_id
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(1, data); // Int
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(i, data);
+        ProtocolCraft::WriteData<unsigned char>(4, data); // data_silent
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(8, data); // Bool
+        ProtocolCraft::WriteData<bool>(i % 3 == 0, data);
+        ProtocolCraft::WriteData<unsigned char>(9, data); // data_health_id
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(3, data); // Float
+        ProtocolCraft::WriteData<float>(static_cast<float>(i % 20), data);
+        ProtocolCraft::WriteData<unsigned char>(0xFF, data);
+        return data;
+    }
+#endif
+}
+
+TEST_CASE("Entity spatial queries")
+{
+    EntityManager entity_manager(nullptr);
+
+    constexpr int num_entities = 2000;
+    std::mt19937 random_engine(42);
+    AddRandomEntities(entity_manager, num_entities, random_engine);
+
+    SECTION("Radius")
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            const Vector3<double> center = RandomPosition(random_engine);
+            const double radius = i < 25 ? 20.0 : 200.0;
+            for (const EntityType type : { EntityType::None, EntityType::Zombie, EntityType::Cow, EntityType::Player })
+            {
+                CHECK(QueryRadiusIds(entity_manager, center, radius, type) == BruteForceRadius(entity_manager, center, radius, type));
+            }
+        }
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(0.0), std::numeric_limits<double>::infinity(), EntityType::None).size() == num_entities);
+    }
+
+    SECTION("AABB")
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            const Vector3<double> center = RandomPosition(random_engine);
+            const AABB aabb(center, Vector3<double>(30.0, 100.0, 45.0));
+
+            std::set<int> expected;
+            {
+                auto entities = entity_manager.GetEntities();
+                for (const auto& [id, entity] : *entities)
+                {
+                    const Vector3<double> p = entity->GetPosition();
+                    if (p.x >= aabb.GetMin().x && p.x <= aabb.GetMax().x &&
+                        p.y >= aabb.GetMin().y && p.y <= aabb.GetMax().y &&
+                        p.z >= aabb.GetMin().z && p.z <= aabb.GetMax().z)
+                    {
+                        expected.insert(id);
+                    }
+                }
+            }
+
+            std::set<int> found;
+            entity_manager.QueryAABB(aabb, [&](const std::shared_ptr<Entity>& e) { found.insert(e->GetEntityID()); });
+            CHECK(found == expected);
+        }
+    }
+
+    SECTION("Nearest")
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            const Vector3<double> position = RandomPosition(random_engine);
+
+            double best_distance = std::numeric_limits<double>::max();
+            {
+                auto entities = entity_manager.GetEntities();
+                for (const auto& [id, entity] : *entities)
+                {
+                    if (entity->GetType() == EntityType::Skeleton && id % 2 == 1)
+                    {
+                        best_distance = std::min(best_distance, (entity->GetPosition() - position).SqrNorm());
+                    }
+                }
+            }
+
+            const std::shared_ptr<Entity> nearest = entity_manager.Nearest(position, std::numeric_limits<double>::max(), EntityType::Skeleton,
+                [](const Entity& e) { return e.GetEntityID() % 2 == 1; });
+            REQUIRE(nearest != nullptr);
+            CHECK(nearest->GetType() == EntityType::Skeleton);
+            CHECK(nearest->GetEntityID() % 2 == 1);
+            CHECK((nearest->GetPosition() - position).SqrNorm() == best_distance);
+        }
+
+        CHECK(entity_manager.Nearest(Vector3<double>(0.0), 1000.0, EntityType::Player) == nullptr);
+        CHECK(entity_manager.Nearest(Vector3<double>(10000.0, 0.0, 10000.0), 10.0) == nullptr);
+    }
+
+    SECTION("Updates")
+    {
+        // Moving the entity through a packet updates the index
+        const std::shared_ptr<Entity> moving = AddTestEntity(entity_manager, EntityType::Creeper, num_entities, Vector3<double>(1000.0, 64.0, 1000.0));
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(1000.0, 64.0, 1000.0), 1.0, EntityType::Creeper) == std::set<int>{ num_entities });
+
+        ProtocolCraft::ClientboundMoveEntityPacketPos move;
+        move.SetEntityId(num_entities);
+        move.SetXA(7 * 4096);
+        move.SetYA(0);
+        move.SetZA(-7 * 4096);
+        for (int i = 0; i < 3; ++i)
+        {
+            static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(move);
+        }
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(1000.0, 64.0, 1000.0), 1.0, EntityType::Creeper).empty());
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(1021.0, 64.0, 979.0), 1.0, EntityType::Creeper) == std::set<int>{ num_entities });
+        CHECK(entity_manager.Nearest(Vector3<double>(1020.0, 64.0, 980.0), 10.0) == moving);
+
+        // Replacing an entity with the same id
+        AddTestEntity(entity_manager, EntityType::Cow, num_entities, Vector3<double>(-1000.0, 64.0, -1000.0));
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(1021.0, 64.0, 979.0), 1.0, EntityType::None).empty());
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(-1000.0, 64.0, -1000.0), 1.0, EntityType::Cow) == std::set<int>{ num_entities });
+        CHECK(QueryRadiusIds(entity_manager, Vector3<double>(-1000.0, 64.0, -1000.0), 1.0, EntityType::Creeper).empty());
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Entity spatial queries time", "[.benchmark]")
+{
+    EntityManager entity_manager(nullptr);
+
+    constexpr int num_entities = 2000;
+    std::mt19937 random_engine(42);
+    AddRandomEntities(entity_manager, num_entities, random_engine);
+
+    std::vector<Vector3<double>> centers;
+    for (int i = 0; i < 1000; ++i)
+    {
+        centers.push_back(RandomPosition(random_engine));
+    }
+
+    size_t scan_count = 0;
+    const auto scan_start = std::chrono::steady_clock::now();
+    for (const Vector3<double>& center : centers)
+    {
+        auto entities = entity_manager.GetEntities();
+        for (const auto& [id, entity] : *entities)
+        {
+            if (entity->IsMonster() && (entity->GetPosition() - center).SqrNorm() < 16.0 * 16.0)
+            {
+                scan_count += 1;
+            }
+        }
+    }
+    const auto scan_end = std::chrono::steady_clock::now();
+
+    size_t query_count = 0;
+    const auto query_start = std::chrono::steady_clock::now();
+    for (const Vector3<double>& center : centers)
+    {
+        entity_manager.QueryRadius(center, 16.0, [&](const std::shared_ptr<Entity>& e)
+            {
+                if (e->IsMonster() && (e->GetPosition() - center).SqrNorm() < 16.0 * 16.0)
+                {
+                    query_count += 1;
+                }
+            }
+        );
+    }
+    const auto query_end = std::chrono::steady_clock::now();
+
+    const double scan_ms = std::chrono::duration<double, std::milli>(scan_end - scan_start).count();
+    const double query_ms = std::chrono::duration<double, std::milli>(query_end - query_start).count();
+    CHECK(scan_count == query_count);
+    WARN("Monsters around 1000 positions (" << num_entities << " entities): scanning all entities took " << scan_ms << " ms, spatial query took " << query_ms << " ms");
+}
+
+#if PROTOCOL_VERSION > 760 /* > 1.19.2 */
+TEST_CASE("Entity metadata")
+{
+    EntityManager entity_manager(nullptr);
+
+    constexpr int num_entities = 2000;
+    for (int i = 0; i < num_entities; ++i)
+    {
+        AddTestEntity(entity_manager, EntityType::Zombie, i, Vector3<double>(0.0));
+    }
+
+    ProtocolCraft::ClientboundSetEntityDataPacket packet;
+    for (int i = 0; i < num_entities; ++i)
+    {
+        packet.SetEntityId(i);
+        packet.SetPackedItems(MetadataPacketData(i));
+        static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(packet);
+    }
+
+    {
+        auto entities = entity_manager.GetEntities();
+        for (const auto& [id, entity] : *entities)
+        {
+            const std::shared_ptr<LivingEntity> living = std::static_pointer_cast<LivingEntity>(entity);
+            CHECK(living->GetDataSharedFlagsId() == id % 2);
+            CHECK(living->GetDataAirSupplyId() == id);
+            CHECK(living->GetDataSilent() == (id % 3 == 0));
+            CHECK(living->GetDataHealthId() == static_cast<float>(id % 20));
+            // Not in the packet, must still be the default value
+            CHECK(living->GetDataCustomNameVisible() == false);
+#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
+            CHECK(living->GetDataEffectParticles().empty());
+#endif
+        }
+    }
+
+    // Updating existing values
+    for (int i = 0; i < num_entities; ++i)
+    {
+        packet.SetEntityId(i);
+        packet.SetPackedItems(MetadataPacketData(i + 1));
+        static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(packet);
+    }
+    CHECK(std::static_pointer_cast<LivingEntity>(entity_manager.GetEntity(0))->GetDataAirSupplyId() == 1);
+    CHECK(std::static_pointer_cast<LivingEntity>(entity_manager.GetEntity(0))->GetDataHealthId() == 1.0f);
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Entity metadata time", "[.benchmark]")
+{
+    EntityManager entity_manager(nullptr);
+
+    constexpr int num_entities = 2000;
+    for (int i = 0; i < num_entities; ++i)
+    {
+        AddTestEntity(entity_manager, EntityType::Zombie, i, Vector3<double>(0.0));
+    }
+
+    std::vector<ProtocolCraft::ClientboundSetEntityDataPacket> packets(num_entities);
+    for (int i = 0; i < num_entities; ++i)
+    {
+        packets[i].SetEntityId(i);
+        packets[i].SetPackedItems(MetadataPacketData(i + 1));
+    }
+
+    constexpr int num_rounds = 50;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < num_rounds; ++round)
+    {
+        for (ProtocolCraft::ClientboundSetEntityDataPacket& p : packets)
+        {
+            static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(p);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    CHECK(std::static_pointer_cast<LivingEntity>(entity_manager.GetEntity(0))->GetDataAirSupplyId() == 1);
+
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    WARN("Applying " << num_rounds * num_entities << " SetEntityData packets took " << ms << " ms");
+}
+#endif
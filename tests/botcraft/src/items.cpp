@@ -1,7 +1,34 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
 #include <botcraft/Game/AssetsManager.hpp>
 
+namespace
+{
+    std::vector<std::string> LookupNames()
+    {
+        return { "minecraft:stone", "minecraft:oak_fence", "minecraft:redstone_wire", "minecraft:chest", "minecraft:water" };
+    }
+
+    /// @brief Reference result, scanning all blockstates like GetBlockstates used to
+    std::vector<const Botcraft::Blockstate*> LinearScan(const Botcraft::AssetsManager& assets, const std::string& name)
+    {
+        std::vector<const Botcraft::Blockstate*> output;
+        for (const auto& [id, block] : assets.Blockstates())
+        {
+            if (block->GetName() == name)
+            {
+                output.push_back(block.get());
+            }
+        }
+        return output;
+    }
+}
+
 TEST_CASE("Items durability")
 {
     REQUIRE(Botcraft::AssetsManager::getInstance().GetItem("minecraft:stone")->GetMaxDurability() == -1);
@@ -9,3 +36,71 @@ TEST_CASE("Items durability")
     REQUIRE(Botcraft::AssetsManager::getInstance().GetItem("minecraft:chainmail_chestplate")->GetMaxDurability() == 240);
     REQUIRE(Botcraft::AssetsManager::getInstance().GetItem("minecraft:diamond_sword")->GetMaxDurability() == 1561);
 }
+
+TEST_CASE("Assets name lookups")
+{
+    const Botcraft::AssetsManager& assets = Botcraft::AssetsManager::getInstance();
+
+    const std::vector<std::string> names = LookupNames();
+
+    SECTION("Blockstates")
+    {
+        for (const std::string& name : names)
+        {
+            std::vector<const Botcraft::Blockstate*> expected = LinearScan(assets, name);
+            std::sort(expected.begin(), expected.end(), [](const Botcraft::Blockstate* a, const Botcraft::Blockstate* b) { return a->GetId() < b->GetId(); });
+            REQUIRE_FALSE(expected.empty());
+
+            const std::vector<const Botcraft::Blockstate*>& blockstates = assets.GetBlockstates(name);
+            const std::vector<Botcraft::BlockstateId>& ids = assets.GetBlockstateIds(name);
+            CHECK(blockstates == expected);
+            REQUIRE(ids.size() == expected.size());
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                CHECK(ids[i] == expected[i]->GetId());
+            }
+            CHECK(assets.GetBlockstate(name) == expected.front());
+        }
+
+        CHECK(assets.GetBlockstates("minecraft:not_a_block").empty());
+        CHECK(assets.GetBlockstateIds("minecraft:not_a_block").empty());
+        CHECK(assets.GetBlockstate("minecraft:not_a_block")->GetName() == "default");
+    }
+
+    SECTION("Items")
+    {
+        for (const auto& [id, item] : assets.Items())
+        {
+            CHECK(assets.GetItem(item->GetName())->GetName() == item->GetName());
+            CHECK(assets.GetItemID(item->GetName()) == assets.GetItem(item->GetName())->GetId());
+        }
+        CHECK(assets.GetItem("minecraft:not_an_item") == nullptr);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Assets name lookups time", "[.benchmark]")
+{
+    const Botcraft::AssetsManager& assets = Botcraft::AssetsManager::getInstance();
+    const std::vector<std::string> names = LookupNames();
+
+    constexpr int num_runs = 200;
+    size_t num_found = 0;
+    const auto linear_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_runs; ++i)
+    {
+        num_found += LinearScan(assets, names[i % names.size()]).size();
+    }
+    const double linear_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - linear_start).count();
+
+    size_t num_found_index = 0;
+    const auto index_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_runs; ++i)
+    {
+        num_found_index += assets.GetBlockstates(names[i % names.size()]).size();
+    }
+    const double index_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - index_start).count();
+
+    CHECK(num_found == num_found_index);
+    WARN("GetBlockstates over " << assets.Blockstates().size() << " blockstates, linear scan: " << linear_elapsed / num_runs << " us, name index: " << index_elapsed / num_runs << " us");
+}
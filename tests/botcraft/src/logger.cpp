@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <botcraft/Utilities/Logger.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+    /// @brief Capture logs for the duration of a test, then restore defaults
+    class LogCapture
+    {
+    public:
+        LogCapture()
+        {
+            Logger::GetInstance().Flush();
+            Logger::GetInstance().SetLogFunc([this](const std::string& s)
+                {
+                    std::scoped_lock<std::mutex> lock(mutex);
+                    lines.push_back(s);
+                }
+            );
+            Logger::GetInstance().SetLogLevel(LogLevel::Info);
+        }
+
+        ~LogCapture()
+        {
+            Logger::GetInstance().Flush();
+            Logger::GetInstance().SetLogFunc(nullptr);
+            Logger::GetInstance().SetLogLevel(LogLevel::Warning);
+        }
+
+        std::vector<std::string> GetLines()
+        {
+            Logger::GetInstance().Flush();
+            std::scoped_lock<std::mutex> lock(mutex);
+            return lines;
+        }
+
+    private:
+        std::mutex mutex;
+        std::vector<std::string> lines;
+    };
+
+    struct ConcurrentLogsResult
+    {
+        /// @brief Time spent logging by the slowest thread, in ms
+        double max_duration;
+        size_t dropped;
+    };
+
+    /// @brief Log num_messages messages from num_threads threads at the same time, and check they are all written in order or reported as dropped
+    ConcurrentLogsResult LogConcurrently(LogCapture& capture, const int num_threads, const int num_messages)
+    {
+        const size_t dropped_before = Logger::GetInstance().GetNumDroppedMessages();
+
+        std::atomic<bool> start = false;
+        std::vector<std::thread> threads;
+        std::vector<double> durations(num_threads);
+        for (int i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([&, i]()
+                {
+                    while (!start)
+                    {
+                        std::this_thread::yield();
+                    }
+                    const auto thread_start = std::chrono::steady_clock::now();
+                    for (int j = 0; j < num_messages; ++j)
+                    {
+                        LOG_INFO("thread " << i << " message " << j);
+                    }
+                    durations[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - thread_start).count();
+                }
+            );
+        }
+        start = true;
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+
+        const std::vector<std::string> lines = capture.GetLines();
+        const size_t dropped = Logger::GetInstance().GetNumDroppedMessages() - dropped_before;
+
+        size_t num_logged = 0;
+        size_t num_reported_dropped = 0;
+        std::vector<int> last_message(num_threads, -1);
+        bool ordered = true;
+        for (const std::string& line : lines)
+        {
+            const size_t thread_pos = line.find("): thread ");
+            if (thread_pos == std::string::npos)
+            {
+                const size_t dropped_pos = line.find(" log messages dropped");
+                REQUIRE(dropped_pos != std::string::npos);
+                const size_t number_start = line.rfind(' ', dropped_pos - 1) + 1;
+                num_reported_dropped += std::stoul(line.substr(number_start, dropped_pos - number_start));
+                continue;
+            }
+            num_logged += 1;
+            const int thread = std::stoi(line.substr(thread_pos + 10));
+            const int message = std::stoi(line.substr(line.find(" message ", thread_pos) + 9));
+            // Messages from one thread are always written in order
+            ordered &= message > last_message[thread];
+            last_message[thread] = message;
+        }
+
+        CHECK(ordered);
+        CHECK(num_logged + dropped == num_threads * num_messages);
+        CHECK(num_reported_dropped == dropped);
+
+        ConcurrentLogsResult result;
+        result.max_duration = 0.0;
+        for (const double d : durations)
+        {
+            result.max_duration = std::max(result.max_duration, d);
+        }
+        result.dropped = dropped;
+        return result;
+    }
+}
+
+TEST_CASE("Logger format and order")
+{
+    LogCapture capture;
+
+    std::thread t([]()
+        {
+            Logger::GetInstance().RegisterThread("LoggerTest");
+            for (int i = 0; i < 100; ++i)
+            {
+                LOG_INFO("message " << i);
+            }
+            LOG_DEBUG("below log level");
+        }
+    );
+    t.join();
+
+    const std::vector<std::string> lines = capture.GetLines();
+    REQUIRE(lines.size() == 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        const std::string& line = lines[i];
+        CHECK(line.front() == '[');
+        CHECK(line.back() == '\n');
+        CHECK(line.find("] [ INFO  ] [LoggerTest(") != std::string::npos);
+        CHECK(line.find(" logger.cpp(") != std::string::npos);
+        CHECK(line.find("): message " + std::to_string(i) + "\n") != std::string::npos);
+    }
+}
+
+TEST_CASE("Logger concurrent threads")
+{
+    LogCapture capture;
+    LogConcurrently(capture, 8, 2000);
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Logger concurrent threads time", "[.benchmark]")
+{
+    LogCapture capture;
+
+    constexpr int num_threads = 8;
+    constexpr int num_messages = 20000;
+    const ConcurrentLogsResult result = LogConcurrently(capture, num_threads, num_messages);
+    WARN(num_threads << " threads logging " << num_messages << " messages each: slowest thread took " << result.max_duration << " ms (" << result.dropped << " messages dropped)");
+}
@@ -0,0 +1,492 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <botcraft/Network/NetworkManager.hpp>
+#include <botcraft/Network/NetworkThreadPool.hpp>
+#include <botcraft/Network/PacketBufferPool.hpp>
+#include <botcraft/Network/TCP_Com.hpp>
+#include <botcraft/Utilities/SleepUtilities.hpp>
+#include <protocolCraft/AllPackets.hpp>
+#include <protocolCraft/BinaryReadWrite.hpp>
+
+// After the packets, asio brings termios macros colliding with some field names
+#include <asio/ip/tcp.hpp>
+#include <asio/read.hpp>
+#include <asio/write.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+    unsigned char PayloadByte(const size_t packet_index, const size_t i)
+    {
+        return static_cast<unsigned char>((packet_index * 31 + i) & 0xFF);
+    }
+
+    /// @brief Build a stream of size prefixed packets, mimicking what is received while
+    /// joining a server: a lot of small packets with some big chunk data in between
+    std::vector<unsigned char> MakeCapture(const size_t num_packets, std::vector<size_t>& packet_sizes, const size_t big_packet_size = 0)
+    {
+        std::mt19937 random_gen(42);
+        std::vector<unsigned char> capture;
+        packet_sizes.resize(num_packets);
+        for (size_t i = 0; i < num_packets; ++i)
+        {
+            if (big_packet_size > 0 && i == num_packets / 2)
+            {
+                packet_sizes[i] = big_packet_size;
+            }
+            else if (random_gen() % 10 < 7)
+            {
+                packet_sizes[i] = 1 + random_gen() % 200;
+            }
+            else
+            {
+                packet_sizes[i] = 4096 + random_gen() % 28672;
+            }
+            ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(packet_sizes[i]), capture);
+            for (size_t j = 0; j < packet_sizes[i]; ++j)
+            {
+                capture.push_back(PayloadByte(i, j));
+            }
+        }
+        return capture;
+    }
+
+    /// @brief Loopback server sending a capture to the first client connecting
+    class ReplayServer
+    {
+    public:
+        ReplayServer(const std::vector<unsigned char>& capture_, const size_t max_write_size_) :
+            acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)),
+            capture(capture_), max_write_size(max_write_size_)
+        {
+            thread = std::thread(&ReplayServer::Run, this);
+        }
+
+        ~ReplayServer()
+        {
+            thread.join();
+        }
+
+        unsigned short GetPort() const
+        {
+            return acceptor.local_endpoint().port();
+        }
+
+    private:
+        void Run()
+        {
+            asio::ip::tcp::socket socket(io_context);
+            acceptor.accept(socket);
+
+            std::mt19937 random_gen(42);
+            size_t index = 0;
+            while (index < capture.size())
+            {
+                const size_t write_size = std::min(capture.size() - index, 1 + random_gen() % max_write_size);
+                asio::write(socket, asio::buffer(capture.data() + index, write_size));
+                index += write_size;
+            }
+
+            // Wait for the client to close the connection
+            asio::error_code error;
+            std::array<unsigned char, 16> buffer;
+            while (!error)
+            {
+                socket.read_some(asio::buffer(buffer), error);
+            }
+        }
+
+    private:
+        asio::io_context io_context;
+        asio::ip::tcp::acceptor acceptor;
+        const std::vector<unsigned char>& capture;
+        const size_t max_write_size;
+        std::thread thread;
+    };
+
+    /// @brief Replay capture through a loopback socket and check all the packets are received
+    /// @param io_context If not nullptr, shared io_context used by the client
+    /// @return Time between connection and last packet reception, in seconds
+    double ReplayCapture(const std::vector<unsigned char>& capture, const std::vector<size_t>& packet_sizes, const size_t max_write_size, asio::io_context* io_context = nullptr)
+    {
+        ReplayServer server(capture, max_write_size);
+
+        std::atomic<size_t> num_received = 0;
+        std::atomic<size_t> num_errors = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<TCP_Com> com = std::make_unique<TCP_Com>("127.0.0.1:" + std::to_string(server.GetPort()),
+            [&](const unsigned char* data, const size_t length)
+            {
+                const size_t index = num_received;
+                bool error = index >= packet_sizes.size() || length != packet_sizes[index];
+                for (size_t i = 0; !error && i < length; ++i)
+                {
+                    error = data[i] != PayloadByte(index, i);
+                }
+                num_errors += error;
+                num_received += 1;
+            },
+            io_context
+        );
+        Utilities::WaitForCondition([&]() { return num_received >= packet_sizes.size(); }, 60000, 0);
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        com->close();
+        com.reset();
+
+        REQUIRE(num_errors == 0);
+        REQUIRE(num_received == packet_sizes.size());
+        return elapsed;
+    }
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+    /// @brief Loopback server sending packets to the first client connecting once Start
+    /// is called, and recording all the packets the client sends back
+    class RecordingServer
+    {
+    public:
+        /// @param writes_ Streams of packets, each one sent in a single write, with a pause in between
+        RecordingServer(const std::vector<std::vector<unsigned char>>& writes_) :
+            acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0)),
+            writes(writes_)
+        {
+            started = false;
+            thread = std::thread(&RecordingServer::Run, this);
+        }
+
+        ~RecordingServer()
+        {
+            thread.join();
+        }
+
+        unsigned short GetPort() const
+        {
+            return acceptor.local_endpoint().port();
+        }
+
+        void Start()
+        {
+            started = true;
+        }
+
+        /// @brief Get the packets received so far, without their size prefix
+        std::vector<std::vector<unsigned char>> GetReceived() const
+        {
+            std::scoped_lock<std::mutex> lock(mutex);
+            return received;
+        }
+
+    private:
+        void Run()
+        {
+            asio::ip::tcp::socket socket(io_context);
+            acceptor.accept(socket);
+
+            Utilities::WaitForCondition([&]() { return started.load(); }, 10000, 0);
+            for (size_t i = 0; i < writes.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    Utilities::SleepFor(std::chrono::milliseconds(100));
+                }
+                asio::write(socket, asio::buffer(writes[i]));
+            }
+
+            // Record everything until the client closes the connection
+            asio::error_code error;
+            while (!error)
+            {
+                int length = 0;
+                for (int shift = 0; !error; shift += 7)
+                {
+                    unsigned char b = 0;
+                    asio::read(socket, asio::buffer(&b, 1), error);
+                    length |= (b & 0x7F) << shift;
+                    if (!(b & 0x80))
+                    {
+                        break;
+                    }
+                }
+                std::vector<unsigned char> packet(length);
+                if (!error && length > 0)
+                {
+                    asio::read(socket, asio::buffer(packet), error);
+                }
+                if (!error)
+                {
+                    std::scoped_lock<std::mutex> lock(mutex);
+                    received.push_back(std::move(packet));
+                }
+            }
+        }
+
+    private:
+        asio::io_context io_context;
+        asio::ip::tcp::acceptor acceptor;
+        const std::vector<std::vector<unsigned char>>& writes;
+        std::atomic<bool> started;
+        std::thread thread;
+
+        mutable std::mutex mutex;
+        std::vector<std::vector<unsigned char>> received;
+    };
+
+    /// @brief Record the name of all the packets dispatched by a NetworkManager
+    class PacketRecorder : public ProtocolCraft::Handler
+    {
+    public:
+        using ProtocolCraft::Handler::Handle;
+
+        virtual void Handle(ProtocolCraft::Packet& packet) override
+        {
+            std::scoped_lock<std::mutex> lock(mutex);
+            names.emplace_back(packet.GetName());
+        }
+
+        std::vector<std::string> GetNames() const
+        {
+            std::scoped_lock<std::mutex> lock(mutex);
+            return names;
+        }
+
+    private:
+        mutable std::mutex mutex;
+        std::vector<std::string> names;
+    };
+
+    /// @brief Append a size prefixed uncompressed packet to stream
+    void AddPacket(const ProtocolCraft::Packet& packet, std::vector<unsigned char>& stream, std::vector<std::string>& names)
+    {
+        std::vector<unsigned char> data;
+        packet.Write(data);
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(data.size()), stream);
+        stream.insert(stream.end(), data.begin(), data.end());
+        names.emplace_back(packet.GetName());
+    }
+#endif
+}
+
+TEST_CASE("TCP framing")
+{
+    SECTION("Split writes")
+    {
+        // Small writes split size prefixes, and one packet is bigger than the input buffer
+        std::vector<size_t> packet_sizes;
+        const std::vector<unsigned char> capture = MakeCapture(2000, packet_sizes, 1 << 20);
+        ReplayCapture(capture, packet_sizes, 4096);
+    }
+
+    SECTION("Big writes")
+    {
+        std::vector<size_t> packet_sizes;
+        const std::vector<unsigned char> capture = MakeCapture(2000, packet_sizes);
+        ReplayCapture(capture, packet_sizes, 1 << 16);
+    }
+}
+
+// Sends about 100 MB through the loopback and only reports timings, so only run on demand
+TEST_CASE("TCP framing throughput", "[.benchmark]")
+{
+    std::vector<size_t> packet_sizes;
+    const std::vector<unsigned char> capture = MakeCapture(20000, packet_sizes);
+    const double elapsed = ReplayCapture(capture, packet_sizes, 1 << 16);
+    WARN("Received " << packet_sizes.size() << " packets (" << capture.size() / (1024 * 1024) << " MB) in " << elapsed << "s, " << static_cast<size_t>(capture.size() / (1024.0 * 1024.0 * elapsed)) << " MB/s, " << static_cast<size_t>(packet_sizes.size() / elapsed) << " packets/s");
+}
+
+TEST_CASE("Shared network threads")
+{
+    NetworkThreadPool::GetInstance().Start(2);
+    REQUIRE(NetworkThreadPool::GetInstance().IsStarted());
+
+    SECTION("Connections on shared io_contexts")
+    {
+        // More connections than threads, each one must still receive its packets in order
+        std::vector<size_t> packet_sizes;
+        const std::vector<unsigned char> capture = MakeCapture(500, packet_sizes, 1 << 18);
+        std::vector<std::thread> clients;
+        for (int i = 0; i < 6; ++i)
+        {
+            clients.emplace_back([&]()
+                {
+                    ReplayCapture(capture, packet_sizes, 4096, &NetworkThreadPool::GetInstance().GetIOContext());
+                }
+            );
+        }
+        for (std::thread& t : clients)
+        {
+            t.join();
+        }
+    }
+
+    SECTION("Strand ordering")
+    {
+        std::vector<std::shared_ptr<NetworkStrand>> strands;
+        std::vector<std::vector<int>> results(4);
+        std::atomic<int> num_done = 0;
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            strands.push_back(NetworkThreadPool::GetInstance().MakeProcessingStrand());
+        }
+        for (int j = 0; j < 1000; ++j)
+        {
+            for (size_t i = 0; i < strands.size(); ++i)
+            {
+                // No lock, tasks on the same strand never run concurrently
+                strands[i]->Post([&, i, j]() { results[i].push_back(j); num_done += 1; });
+            }
+        }
+        Utilities::WaitForCondition([&]() { return num_done == 4000; }, 10000, 0);
+        REQUIRE(num_done == 4000);
+        for (const std::vector<int>& r : results)
+        {
+            REQUIRE(r.size() == 1000);
+            CHECK(std::is_sorted(r.begin(), r.end()));
+        }
+    }
+}
+
+TEST_CASE("Packet buffer pool")
+{
+    PacketBufferPool pool;
+
+    PacketBuffer buffer = pool.Acquire(1024);
+    REQUIRE(buffer);
+    CHECK(buffer->size() == 1024);
+    const unsigned char* data = buffer->data();
+
+    SECTION("Copies share data")
+    {
+        PacketBuffer copy = buffer;
+        (*buffer)[0] = 42;
+        CHECK((*copy)[0] == 42);
+        buffer = PacketBuffer();
+        CHECK_FALSE(buffer);
+        // Still referenced by copy, must not be reused
+        PacketBuffer other = pool.Acquire(16);
+        CHECK(other->data() != data);
+    }
+
+    SECTION("Buffers are reused")
+    {
+        buffer = PacketBuffer();
+        PacketBuffer reused = pool.Acquire(512);
+        CHECK(reused->size() == 512);
+        CHECK(reused->data() == data);
+    }
+}
+
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+TEST_CASE("Parallel chunk batch decoding")
+{
+    using namespace ProtocolCraft;
+
+    constexpr int batch_size = 6;
+
+    // Chunks with a lot of block entities, slow to decode but small enough to
+    // be received in the same read as the packets following them
+    const auto make_chunk = [](const int i)
+    {
+        ClientboundLevelChunkWithLightPacket chunk;
+        chunk.SetX(i);
+        chunk.SetZ(-i);
+        ClientboundLevelChunkPacketData chunk_data;
+        chunk_data.SetBlockEntitiesData(std::vector<BlockEntityInfo>(10000));
+        chunk.SetChunkData(chunk_data);
+        return chunk;
+    };
+
+    // End of login then a chunk batch, with a configuration phase in the middle
+    std::vector<std::vector<unsigned char>> writes(2);
+    std::vector<std::string> expected_names;
+#if PROTOCOL_VERSION < 768 /* < 1.21.2 */
+    AddPacket(ClientboundGameProfilePacket(), writes[0], expected_names);
+#else
+    AddPacket(ClientboundLoginFinishedPacket(), writes[0], expected_names);
+#endif
+    AddPacket(ClientboundFinishConfigurationPacket(), writes[0], expected_names);
+    AddPacket(ClientboundChunkBatchStartPacket(), writes[0], expected_names);
+    for (int i = 0; i < batch_size - 1; ++i)
+    {
+        AddPacket(make_chunk(i), writes[0], expected_names);
+    }
+    // The last chunk is still decoding when StartConfiguration is read, so the next packets
+    // are decoded with the Play state and must be parsed again once it has been dispatched
+    AddPacket(make_chunk(batch_size - 1), writes[1], expected_names);
+    AddPacket(ClientboundStartConfigurationPacket(), writes[1], expected_names);
+    ClientboundKeepAliveConfigurationPacket keep_alive;
+    keep_alive.SetId_(42);
+    AddPacket(keep_alive, writes[1], expected_names);
+    AddPacket(ClientboundFinishConfigurationPacket(), writes[1], expected_names);
+    ClientboundChunkBatchFinishedPacket batch_finished;
+    batch_finished.SetBatchSize(batch_size);
+    AddPacket(batch_finished, writes[1], expected_names);
+
+    RecordingServer server(writes);
+    PacketRecorder recorder;
+    std::unique_ptr<NetworkManager> network_manager = std::make_unique<NetworkManager>("127.0.0.1:" + std::to_string(server.GetPort()), "Botcraft", false, std::vector<Handler*>{ &recorder });
+    network_manager->SetChunkBatchDecodingThreads(2);
+    server.Start();
+
+    // Handshake, login start and one answer per packet sent by the server
+    const std::vector<int> expected_ids = {
+        ServerboundClientIntentionPacket().GetId(),
+        ServerboundHelloPacket().GetId(),
+        ServerboundLoginAcknowledgedPacket().GetId(),
+        ServerboundFinishConfigurationPacket().GetId(),
+        ServerboundConfigurationAcknowledgedPacket().GetId(),
+        ServerboundKeepAliveConfigurationPacket().GetId(),
+        ServerboundFinishConfigurationPacket().GetId(),
+        ServerboundChunkBatchReceivedPacket().GetId(),
+    };
+    Utilities::WaitForCondition([&]() { return server.GetReceived().size() >= expected_ids.size(); }, 30000, 0);
+
+    network_manager->Stop();
+    CHECK(network_manager->GetConnectionState() == ConnectionState::None);
+    const std::vector<std::vector<unsigned char>> received = server.GetReceived();
+    network_manager.reset();
+
+    // Handlers see the packets in the order they were sent, and the ones
+    // after the state switch are dispatched as configuration packets
+    CHECK(recorder.GetNames() == expected_names);
+
+    REQUIRE(received.size() == expected_ids.size());
+    for (size_t i = 0; i < received.size(); ++i)
+    {
+        ReadIterator iter = received[i].data();
+        size_t length = received[i].size();
+        CHECK(ReadData<VarInt>(iter, length) == expected_ids[i]);
+    }
+
+    // Keep alive id only matches if it was parsed with the configuration state
+    {
+        ReadIterator iter = received[5].data();
+        size_t length = received[5].size();
+        ReadData<VarInt>(iter, length);
+        ServerboundKeepAliveConfigurationPacket keep_alive_answer;
+        keep_alive_answer.Read(iter, length);
+        CHECK(keep_alive_answer.GetId_() == 42);
+    }
+
+    // Ack is sent once all the chunks of the batch have been dispatched
+    {
+        ReadIterator iter = received.back().data();
+        size_t length = received.back().size();
+        ReadData<VarInt>(iter, length);
+        ServerboundChunkBatchReceivedPacket ack;
+        ack.Read(iter, length);
+        CHECK(ack.GetDesiredChunksPerTick() > 0.0f);
+    }
+}
+#endif
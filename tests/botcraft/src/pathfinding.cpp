@@ -0,0 +1,687 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <botcraft/AI/IncrementalPathfinder.hpp>
+#include <botcraft/AI/PathfindingArena.hpp>
+#include <botcraft/AI/PathfindingMoves.hpp>
+#include <botcraft/AI/PathPlanningService.hpp>
+#include <botcraft/AI/Tasks/PathfindingTask.hpp>
+#include <botcraft/Game/AssetsManager.hpp>
+#include <botcraft/Game/World/BlockCursor.hpp>
+#include <botcraft/Game/World/World.hpp>
+
+#include "allocation_counter.hpp"
+
+using namespace Botcraft;
+
+namespace
+{
+    constexpr int chunk_radius = 3;
+
+    /// @brief Y of the highest solid block of the canned terrain
+    int GetTerrainTop(const int x, const int z)
+    {
+        // Walls every 10 blocks, with a 2 blocks wide gap every 20 blocks
+        if (std::abs(x) % 10 == 0 && std::abs(z) % 20 > 1)
+        {
+            return 7;
+        }
+        // Small bumps that can be walked or jumped up
+        return 3 + ((x / 3) * 7 + (z / 3) * 13) % 2;
+    }
+
+    /// @brief Load chunks around 0, 0 and fill them with the canned terrain
+    void FillWorld(World& world, const int radius = chunk_radius)
+    {
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+        const Dimension dimension = Dimension::Overworld;
+#else
+        const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        world.SetDimensionMinY(dimension, 0);
+        world.SetDimensionHeight(dimension, 256);
+#endif
+        world.SetCurrentDimension(dimension);
+
+        const BlockstateId stone = AssetsManager::getInstance().GetBlockstateIds("minecraft:stone").front();
+        for (int x = -radius; x <= radius; ++x)
+        {
+            for (int z = -radius; z <= radius; ++z)
+            {
+                world.LoadChunk(x, z, dimension);
+            }
+        }
+        for (int x = -radius * CHUNK_WIDTH; x < (radius + 1) * CHUNK_WIDTH; ++x)
+        {
+            for (int z = -radius * CHUNK_WIDTH; z < (radius + 1) * CHUNK_WIDTH; ++z)
+            {
+                for (int y = 0; y <= GetTerrainTop(x, z); ++y)
+                {
+                    world.SetBlock(Position(x, y, z), stone);
+                }
+            }
+        }
+    }
+
+    /// @brief Feet position when standing on the terrain at x, z
+    Position GetStandingPosition(const int x, const int z)
+    {
+        return Position(x, GetTerrainTop(x, z) + 1, z);
+    }
+
+    /// @brief Start and end positions of searches across the whole test world
+    std::vector<std::pair<Position, Position>> GetLongQueries()
+    {
+        return {
+            { GetStandingPosition(-35, -33), GetStandingPosition(35, 34) },
+            { GetStandingPosition(-42, 38), GetStandingPosition(41, -37) },
+            { GetStandingPosition(2, -45), GetStandingPosition(-3, 47) },
+            { GetStandingPosition(-47, 1), GetStandingPosition(48, 2) },
+        };
+    }
+
+    /// @brief Get the total cost of the moves of a path
+    /// @return Sum of the cheapest move to each step, -1 if a step can't be reached from the previous one
+    float GetPathCost(const World& world, const Position& start, const std::vector<std::pair<Position, float>>& path)
+    {
+        BlockCursor cursor = world.GetBlockCursor();
+        PathfindingMoves moves;
+        std::pair<Position, float> current = { start, GetPathfindingHeight(cursor, start, true) };
+        float output = 0.0f;
+        for (const std::pair<Position, float>& next : path)
+        {
+            GetPathfindingMoves(cursor, current, world.GetMinY(), false, true, 0.6f, moves);
+            float cost = -1.0f;
+            for (size_t i = 0; i < moves.size; ++i)
+            {
+                if (moves.moves[i].first == next && (cost < 0.0f || moves.moves[i].second < cost))
+                {
+                    cost = moves.moves[i].second;
+                }
+            }
+            if (cost < 0.0f)
+            {
+                return -1.0f;
+            }
+            output += cost;
+            current = next;
+        }
+        return output;
+    }
+
+    struct ReplanningTimes
+    {
+        double replan_ms;
+        double search_ms;
+        size_t expansions_per_replan;
+    };
+
+    /// @brief Walk a part of path, then alternately close and open the next wall gap, checking
+    /// the replanned path costs the same as a new search each time
+    /// @param num_runs Number of replannings
+    ReplanningTimes ReplanAroundGap(World& world, IncrementalPathfinder& planner, const std::vector<std::pair<Position, float>>& path, const Position& end, const int num_runs)
+    {
+        const BlockstateId stone = AssetsManager::getInstance().GetBlockstateIds("minecraft:stone").front();
+        const BlockstateId air = AssetsManager::getInstance().GetBlockstateIds("minecraft:air").front();
+
+        // Walk a part of the path, then block the next wall gap
+        const size_t walked = path.size() / 4;
+        const Position current = path[walked - 1].first;
+        size_t gap_index = walked;
+        while (gap_index < path.size() && std::abs(path[gap_index].first.x) % 10 != 0)
+        {
+            gap_index += 1;
+        }
+        REQUIRE(gap_index < path.size());
+        const Position gap = path[gap_index].first;
+
+        bool is_gap_closed = false;
+        const auto toggle_gap = [&]()
+        {
+            is_gap_closed = !is_gap_closed;
+            for (int z = gap.z - 2; z <= gap.z + 2; ++z)
+            {
+                for (int y = GetTerrainTop(gap.x, z) + 1; y <= 7; ++y)
+                {
+                    world.SetBlock(Position(gap.x, y, z), is_gap_closed ? stone : air);
+                }
+            }
+        };
+
+        toggle_gap();
+        CHECK(planner.Update(world));
+
+        double replan_time = 0.0;
+        double search_time = 0.0;
+        size_t num_expansions = 0;
+        for (int i = 0; i < num_runs; ++i)
+        {
+            if (i > 0)
+            {
+                toggle_gap();
+            }
+
+            auto t_start = std::chrono::steady_clock::now();
+            const std::vector<std::pair<Position, float>> replanned = planner.FindPath(world, current, end);
+            replan_time += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+            num_expansions += planner.GetNumExpansions();
+
+            t_start = std::chrono::steady_clock::now();
+            const std::vector<std::pair<Position, float>> new_path = FindPath(world, current, end, 0, 0, 0, false, true, 0.6f);
+            search_time += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+
+            REQUIRE(!replanned.empty());
+            CHECK(replanned.back().first == end);
+            // Same cost as a new search
+            CHECK(GetPathCost(world, current, replanned) == GetPathCost(world, current, new_path));
+            if (is_gap_closed)
+            {
+                for (const std::pair<Position, float>& p : replanned)
+                {
+                    CHECK_FALSE((p.first.x == gap.x && std::abs(p.first.z - gap.z) <= 2));
+                }
+            }
+        }
+
+        ReplanningTimes times;
+        times.replan_ms = replan_time / num_runs;
+        times.search_ms = search_time / num_runs;
+        times.expansions_per_replan = num_expansions / num_runs;
+        return times;
+    }
+
+    /// @brief Wait for the next segment of a job, polling like a behaviour would, sleeping instead of yielding
+    /// @return False if the job is done and all its segments have been read
+    bool WaitSegment(PathPlanningJob& job, std::vector<std::pair<Position, float>>& segment)
+    {
+        while (!job.PopSegment(segment))
+        {
+            if (job.IsDone())
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Navigation properties")
+{
+    World world(false);
+    FillWorld(world);
+    const BlockstateId stone = AssetsManager::getInstance().GetBlockstateIds("minecraft:stone").front();
+    const BlockstateId air = AssetsManager::getInstance().GetBlockstateIds("minecraft:air").front();
+
+    // Column crossing a section boundary, with a floating block and a hole
+    for (const int y : { 14, 15, 16, 17 })
+    {
+        world.SetBlock(Position(5, y, -9), stone);
+    }
+    world.SetBlock(Position(5, 16, -9), air);
+    world.SetBlock(Position(5, 2, -9), air);
+
+    // Properties must match what is read block by block
+    const auto check_column = [&](const Position& bottom, const int height)
+    {
+        BlockCursor cursor = world.GetBlockCursor();
+        const NavigationColumn column = cursor.GetNavigationColumn(bottom, height);
+        for (int i = 0; i < height; ++i)
+        {
+            const Position pos = bottom + Position(0, i, 0);
+            const Blockstate* block = cursor.GetBlock(pos);
+            CHECK(column.IsLoaded(i) == (block != nullptr));
+            CHECK(column.Has(NavigationProperty::Solid, i) == (block != nullptr && block->IsSolid()));
+            CHECK(column.Has(NavigationProperty::Fluid, i) == (block != nullptr && block->IsFluidOrWaterlogged() && !block->IsSolid()));
+            CHECK(column.Has(NavigationProperty::Climbable, i) == (block != nullptr && block->IsClimbable()));
+            if (column.Has(NavigationProperty::Solid, i) && !column.Has(NavigationProperty::PartialHeight, i))
+            {
+                CHECK(cursor.GetNavigationHeight(pos) == pos.y + 1.0f);
+            }
+        }
+    };
+
+    check_column(Position(5, 0, -9), 32);
+    check_column(Position(5, -4, -9), 8);
+    check_column(Position(-20, 0, 30), 16);
+    check_column(Position(10, 250, 10), 12);
+
+    SECTION("Unloaded chunk")
+    {
+        BlockCursor cursor = world.GetBlockCursor();
+        const NavigationColumn column = cursor.GetNavigationColumn(Position((chunk_radius + 1) * CHUNK_WIDTH, 0, 0), 16);
+        CHECK(column.loaded == 0);
+        CHECK(column.properties[static_cast<size_t>(NavigationProperty::Solid)] == 0);
+    }
+
+    SECTION("Block updates")
+    {
+        for (int y = 0; y < 16; ++y)
+        {
+            world.SetBlock(Position(-20, y, 30), y % 3 == 0 ? stone : air);
+        }
+        check_column(Position(-20, 0, 30), 16);
+
+        // Whole section set to the same block, then emptied again
+        for (int x = 0; x < CHUNK_WIDTH; ++x)
+        {
+            for (int z = 0; z < CHUNK_WIDTH; ++z)
+            {
+                for (int y = 32; y < 48; ++y)
+                {
+                    world.SetBlock(Position(x, y, z), stone);
+                }
+            }
+        }
+        check_column(Position(7, 30, 3), 20);
+        for (int x = 0; x < CHUNK_WIDTH; ++x)
+        {
+            for (int z = 0; z < CHUNK_WIDTH; ++z)
+            {
+                for (int y = 32; y < 48; ++y)
+                {
+                    world.SetBlock(Position(x, y, z), air);
+                }
+            }
+        }
+        check_column(Position(7, 30, 3), 20);
+    }
+}
+
+TEST_CASE("Pathfinding")
+{
+    World world(false);
+    FillWorld(world);
+
+    SECTION("Path around walls")
+    {
+        const Position start = GetStandingPosition(-35, -33);
+        const Position end = GetStandingPosition(35, 34);
+        const std::vector<std::pair<Position, float>> path = FindPath(world, start, end, 0, 0, 0, false, true, 0.6f);
+
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == end);
+        const Position first_step = path.front().first - start;
+        CHECK(std::abs(first_step.x) + std::abs(first_step.z) <= 2);
+        for (size_t i = 1; i < path.size(); ++i)
+        {
+            const Position step = path[i].first - path[i - 1].first;
+            CHECK(std::abs(step.x) + std::abs(step.z) <= 2);
+            // Walls can't be climbed
+            CHECK(path[i].first.y <= 5);
+        }
+    }
+
+    SECTION("Unreachable goal")
+    {
+        // Inside a wall, should get as close as possible
+        const Position start = GetStandingPosition(-35, -33);
+        const Position end(0, 5, 5);
+        const std::vector<std::pair<Position, float>> path = FindPath(world, start, end, 0, 0, 0, false, true, 0.6f);
+
+        REQUIRE(!path.empty());
+        const Position diff = path.back().first - end;
+        CHECK(std::abs(diff.x) + std::abs(diff.y) + std::abs(diff.z) == 1);
+    }
+
+    SECTION("Arena reuse")
+    {
+        // Searches reusing the same arena must give the same paths
+        const std::vector<std::pair<Position, Position>> queries = GetLongQueries();
+        std::vector<std::vector<std::pair<Position, float>>> paths;
+        for (const auto& [from, to] : queries)
+        {
+            paths.push_back(FindPath(world, from, to, 0, 0, 0, false, true, 0.6f));
+            REQUIRE(!paths.back().empty());
+            CHECK(paths.back().back().first == to);
+        }
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            CHECK(FindPath(world, queries[i].first, queries[i].second, 0, 0, 0, false, true, 0.6f) == paths[i]);
+        }
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Pathfinding search time", "[.benchmark]")
+{
+    World world(false);
+    FillWorld(world);
+
+    const std::vector<std::pair<Position, Position>> queries = GetLongQueries();
+
+    // First search to let the arena grow to its working size
+    FindPath(world, queries[0].first, queries[0].second, 0, 0, 0, false, true, 0.6f);
+
+    constexpr int num_runs = 25;
+    size_t num_nodes = 0;
+    const size_t allocations_before = GetNumAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_runs; ++i)
+    {
+        for (const auto& [from, to] : queries)
+        {
+            const std::vector<std::pair<Position, float>> path = FindPath(world, from, to, 0, 0, 0, false, true, 0.6f);
+            CHECK(path.back().first == to);
+            num_nodes += PathfindingArena::GetThreadLocal().GetNumNodes();
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const size_t num_searches = num_runs * queries.size();
+    const double allocations_per_search = static_cast<double>(GetNumAllocations() - allocations_before) / num_searches;
+
+    WARN("FindPath: " << num_searches << " searches, " << num_nodes / num_searches << " nodes per search, " << static_cast<size_t>(num_nodes / elapsed) << " nodes/s, " << allocations_per_search << " allocations per search");
+}
+
+TEST_CASE("Incremental pathfinding")
+{
+    World world(false);
+    FillWorld(world);
+    const BlockstateId stone = AssetsManager::getInstance().GetBlockstateIds("minecraft:stone").front();
+
+    const Position start = GetStandingPosition(-35, -33);
+    const Position end = GetStandingPosition(35, 34);
+    IncrementalPathfinder planner(false, true, 0.6f);
+
+    const std::vector<std::pair<Position, float>> path = planner.FindPath(world, start, end);
+    REQUIRE(!path.empty());
+    CHECK(path.back().first == end);
+    CHECK(GetPathCost(world, start, path) == GetPathCost(world, start, FindPath(world, start, end, 0, 0, 0, false, true, 0.6f)));
+
+    SECTION("Nothing changed")
+    {
+        CHECK(planner.FindPath(world, start, end) == path);
+        CHECK(planner.GetNumExpansions() == 0);
+
+        // Moving along the path doesn't require a new search
+        const Position current = path[path.size() / 2].first;
+        CHECK(planner.FindPath(world, current, end) == std::vector<std::pair<Position, float>>(path.begin() + path.size() / 2 + 1, path.end()));
+        CHECK(planner.GetNumExpansions() == 0);
+
+        // Blocks far from the explored area don't change anything
+        world.SetBlock(Position(40, 30, -40), stone);
+        CHECK_FALSE(planner.Update(world));
+    }
+
+    SECTION("Replanning")
+    {
+        // Once closed, then opened again
+        ReplanAroundGap(world, planner, path, end, 2);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Incremental pathfinding time", "[.benchmark]")
+{
+    World world(false);
+    FillWorld(world);
+
+    const Position start = GetStandingPosition(-35, -33);
+    const Position end = GetStandingPosition(35, 34);
+    IncrementalPathfinder planner(false, true, 0.6f);
+    const std::vector<std::pair<Position, float>> path = planner.FindPath(world, start, end);
+    REQUIRE(!path.empty());
+
+    const ReplanningTimes times = ReplanAroundGap(world, planner, path, end, 10);
+    WARN("Replanning after a block change: " << times.replan_ms << " ms (" << times.expansions_per_replan << " nodes read, " << planner.GetNumNodes() << " in graph), new FindPath: " << times.search_ms << " ms");
+}
+
+TEST_CASE("Hierarchical pathfinding")
+{
+    constexpr int route_chunk_radius = 16;
+    World world(false);
+    FillWorld(world, route_chunk_radius);
+    const BlockstateId stone = AssetsManager::getInstance().GetBlockstateIds("minecraft:stone").front();
+    const BlockstateId air = AssetsManager::getInstance().GetBlockstateIds("minecraft:air").front();
+
+    // Opposite corners of the loaded area
+    const int min_coord = -route_chunk_radius * CHUNK_WIDTH;
+    const int max_coord = (route_chunk_radius + 1) * CHUNK_WIDTH - 1;
+    const Position start = GetStandingPosition(min_coord + 5, min_coord + 7);
+    const Position end = GetStandingPosition(max_coord - 8, max_coord - 3);
+
+    SECTION("Route across the map")
+    {
+        const std::vector<Position> route = world.FindRoute(start, end);
+
+        REQUIRE(route.size() > 2);
+        CHECK(route.front() == start);
+        CHECK(route.back() == end);
+        const auto get_chunk = [](const int coord) { return static_cast<int>(std::floor(coord / static_cast<double>(CHUNK_WIDTH))); };
+        for (size_t i = 1; i < route.size(); ++i)
+        {
+            CHECK(std::abs(get_chunk(route[i].x) - get_chunk(route[i - 1].x)) <= 1);
+            CHECK(std::abs(get_chunk(route[i].z) - get_chunk(route[i - 1].z)) <= 1);
+        }
+
+        // Each part of the route can be refined with the actual movement rules
+        for (size_t i = 1; i < route.size(); ++i)
+        {
+            const std::vector<std::pair<Position, float>> path = FindPath(world, route[i - 1], route[i], 0, 0, 0, false, true, 0.6f);
+            REQUIRE(!path.empty());
+            CHECK(path.back().first == route[i]);
+        }
+
+        // Same route with the chunk graphs already built
+        CHECK(world.FindRoute(start, end) == route);
+    }
+
+    SECTION("Block updates")
+    {
+        REQUIRE(!world.FindRoute(start, end).empty());
+
+        // Close all the gaps of one wall, splitting the world in two
+        constexpr int wall_x = 100;
+        for (int z = min_coord; z <= max_coord; ++z)
+        {
+            for (int y = GetTerrainTop(wall_x, z) + 1; y <= 7; ++y)
+            {
+                world.SetBlock(Position(wall_x, y, z), stone);
+            }
+        }
+        CHECK(world.FindRoute(start, end).empty());
+
+        // Open a new gap, far from the straight line
+        constexpr int gap_z = -205;
+        for (const int z : { gap_z, gap_z + 1 })
+        {
+            for (int y = 4; y <= 7; ++y)
+            {
+                world.SetBlock(Position(wall_x, y, z), air);
+            }
+        }
+        const std::vector<Position> route = world.FindRoute(start, end);
+        REQUIRE(!route.empty());
+        for (const Position& p : route)
+        {
+            if (p.x == wall_x)
+            {
+                CHECK(std::abs(p.z - gap_z) <= 1);
+            }
+        }
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Hierarchical pathfinding time", "[.benchmark]")
+{
+    constexpr int route_chunk_radius = 16;
+    World world(false);
+    FillWorld(world, route_chunk_radius);
+
+    const int min_coord = -route_chunk_radius * CHUNK_WIDTH;
+    const int max_coord = (route_chunk_radius + 1) * CHUNK_WIDTH - 1;
+    const Position start = GetStandingPosition(min_coord + 5, min_coord + 7);
+    const Position end = GetStandingPosition(max_coord - 8, max_coord - 3);
+
+    auto t_start = std::chrono::steady_clock::now();
+    const std::vector<Position> route = world.FindRoute(start, end);
+    const double first_search_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+    REQUIRE(!route.empty());
+
+    constexpr int num_runs = 20;
+    t_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_runs; ++i)
+    {
+        CHECK(world.FindRoute(start, end).size() == route.size());
+    }
+    const double search_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count() / num_runs;
+    const int distance = std::abs(end.x - start.x) + std::abs(end.z - start.z);
+
+    WARN("FindRoute: " << distance << " blocks, " << route.size() << " waypoints, " << first_search_ms << " ms for the first search (building chunk graphs), then " << search_ms << " ms per search");
+}
+
+TEST_CASE("Path planning service")
+{
+    // Jobs run on the shared threads and can outlive a section that exits early,
+    // so they share the ownership of everything they use
+    const std::shared_ptr<World> world = std::make_shared<World>(false);
+    FillWorld(*world);
+
+    const Position start = GetStandingPosition(-35, -33);
+    const Position middle = GetStandingPosition(5, 5);
+    const Position end = GetStandingPosition(35, 34);
+
+    SECTION("Progressive path")
+    {
+        const std::shared_ptr<PathPlanningJob> job = PathPlanningService::GetInstance().Submit([world, start, middle, end](PathPlanningJob& j)
+            {
+                std::vector<std::pair<Position, float>> first_leg = FindPath(*world, start, middle, 0, 0, 0, false, true, 0.6f);
+                const Position leg_end = first_leg.back().first;
+                j.PushSegment(std::move(first_leg));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                j.PushSegment(FindPath(*world, leg_end, end, 0, 0, 0, false, true, 0.6f));
+            }
+        );
+
+        std::vector<std::pair<Position, float>> segment;
+        REQUIRE(WaitSegment(*job, segment));
+        CHECK(segment.back().first == middle);
+        // First leg is available while the second one is still being searched
+        CHECK_FALSE(job->IsDone());
+
+        REQUIRE(WaitSegment(*job, segment));
+        CHECK(segment.back().first == end);
+        CHECK_FALSE(WaitSegment(*job, segment));
+        CHECK(job->IsDone());
+    }
+
+    SECTION("Cancellation")
+    {
+        const std::shared_ptr<PathPlanningJob> job = PathPlanningService::GetInstance().Submit([world, start, end](PathPlanningJob& j)
+            {
+                // Bounded in case the section exits before cancelling it
+                for (int i = 0; i < 1000 && !j.IsCancelled(); ++i)
+                {
+                    j.PushSegment(FindPath(*world, start, end, 0, 0, 0, false, true, 0.6f));
+                }
+            }
+        );
+
+        std::vector<std::pair<Position, float>> segment;
+        REQUIRE(WaitSegment(*job, segment));
+        job->Cancel();
+        // Segments published before the cancellation can still be read
+        while (WaitSegment(*job, segment))
+        {
+            CHECK(segment.back().first == end);
+        }
+        CHECK(job->IsDone());
+
+        // Jobs cancelled before they start are skipped. Keep all
+        // the threads busy so they can't start before we cancel them
+        const std::shared_ptr<std::atomic<bool>> release = std::make_shared<std::atomic<bool>>(false);
+        const std::shared_ptr<std::atomic<bool>> started = std::make_shared<std::atomic<bool>>(false);
+        std::vector<std::shared_ptr<PathPlanningJob>> blocking_jobs;
+        for (size_t i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i)
+        {
+            blocking_jobs.push_back(PathPlanningService::GetInstance().Submit([release](PathPlanningJob&)
+                {
+                    while (!*release)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            ));
+        }
+        std::vector<std::shared_ptr<PathPlanningJob>> cancelled_jobs;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            cancelled_jobs.push_back(PathPlanningService::GetInstance().Submit([started](PathPlanningJob&) { *started = true; }));
+            cancelled_jobs.back()->Cancel();
+        }
+        *release = true;
+        for (const std::shared_ptr<PathPlanningJob>& j : blocking_jobs)
+        {
+            CHECK_FALSE(WaitSegment(*j, segment));
+        }
+        for (const std::shared_ptr<PathPlanningJob>& j : cancelled_jobs)
+        {
+            CHECK_FALSE(WaitSegment(*j, segment));
+        }
+        CHECK_FALSE(*started);
+    }
+
+    SECTION("Shared threads")
+    {
+        const std::vector<std::pair<Position, float>> expected = FindPath(*world, start, end, 0, 0, 0, false, true, 0.6f);
+
+        // More jobs than threads
+        std::vector<std::shared_ptr<PathPlanningJob>> jobs;
+        for (size_t i = 0; i < 2 * std::max(1u, std::thread::hardware_concurrency()); ++i)
+        {
+            jobs.push_back(PathPlanningService::GetInstance().Submit([world, start, end](PathPlanningJob& j)
+                {
+                    j.PushSegment(FindPath(*world, start, end, 0, 0, 0, false, true, 0.6f));
+                }
+            ));
+        }
+
+        for (const std::shared_ptr<PathPlanningJob>& job : jobs)
+        {
+            std::vector<std::pair<Position, float>> path;
+            REQUIRE(WaitSegment(*job, path));
+            CHECK(path == expected);
+        }
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Path planning service time", "[.benchmark]")
+{
+    const std::shared_ptr<World> world = std::make_shared<World>(false);
+    FillWorld(*world);
+
+    const Position start = GetStandingPosition(-35, -33);
+    const Position end = GetStandingPosition(35, 34);
+
+    constexpr size_t num_jobs = 16;
+    const auto t_start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<PathPlanningJob>> jobs;
+    for (size_t i = 0; i < num_jobs; ++i)
+    {
+        jobs.push_back(PathPlanningService::GetInstance().Submit([world, start, end](PathPlanningJob& j)
+            {
+                j.PushSegment(FindPath(*world, start, end, 0, 0, 0, false, true, 0.6f));
+            }
+        ));
+    }
+    const double submit_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+
+    for (const std::shared_ptr<PathPlanningJob>& job : jobs)
+    {
+        std::vector<std::pair<Position, float>> path;
+        REQUIRE(WaitSegment(*job, path));
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+
+    WARN(num_jobs << " searches submitted in " << submit_ms << " ms, all done after " << total_ms << " ms");
+}
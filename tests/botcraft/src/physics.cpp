@@ -0,0 +1,303 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <botcraft/Game/AssetsManager.hpp>
+#include <botcraft/Game/Physics/PhysicsTickScheduler.hpp>
+#include <botcraft/Game/World/World.hpp>
+#include <botcraft/Utilities/SleepUtilities.hpp>
+
+#include "allocation_counter.hpp"
+
+using namespace Botcraft;
+
+namespace
+{
+    struct FakeClient
+    {
+        std::atomic<double> ms_per_tick = 50.0;
+        std::atomic<int> num_ticks = 0;
+        std::atomic<bool> in_tick = false;
+        std::atomic<bool> concurrent_ticks = false;
+    };
+
+    /// @brief Load a chunk with a stone floor and some fences and bamboos on it
+    void FillCollisionWorld(World& world)
+    {
+        const std::string dimension = "minecraft:overworld";
+        world.SetDimensionMinY(dimension, -64);
+        world.SetDimensionHeight(dimension, 384);
+        world.SetCurrentDimension(dimension);
+        world.LoadChunk(0, 0, dimension);
+
+        const BlockstateId stone = AssetsManager::getInstance().GetBlockstate("minecraft:stone")->GetId();
+        const BlockstateId fence = AssetsManager::getInstance().GetBlockstate("minecraft:oak_fence")->GetId();
+        // Bamboo colliders have a horizontal offset
+        const BlockstateId bamboo = AssetsManager::getInstance().GetBlockstate("minecraft:bamboo")->GetId();
+        for (int x = 0; x < 16; ++x)
+        {
+            for (int z = 0; z < 16; ++z)
+            {
+                world.SetBlock(Position(x, 63, z), stone);
+                if ((x + z) % 5 == 0)
+                {
+                    world.SetBlock(Position(x, 64, z), (x % 2) ? fence : bamboo);
+                }
+            }
+        }
+    }
+
+    /// @brief Roughly the queries made by a walking player during one tick
+    std::vector<AABB> MakePlayerAABBs()
+    {
+        std::vector<AABB> player_aabbs;
+        for (int i = 0; i < 64; ++i)
+        {
+            player_aabbs.push_back(AABB(Vector3<double>(2.0 + (i % 12) + 0.37 * (i % 3), 64.9, 2.0 + (i / 12) * 2.1), Vector3<double>(0.3, 0.9, 0.3)));
+        }
+        return player_aabbs;
+    }
+}
+
+TEST_CASE("Physics tick scheduler")
+{
+    PhysicsTickScheduler& scheduler = PhysicsTickScheduler::GetInstance();
+    scheduler.Start(2);
+    REQUIRE(scheduler.IsStarted());
+    scheduler.ResetStats();
+
+    SECTION("Tick rates")
+    {
+        std::vector<std::unique_ptr<FakeClient>> clients;
+        std::vector<size_t> ids;
+        for (const double ms_per_tick : { 50.0, 50.0, 10.0 })
+        {
+            clients.push_back(std::make_unique<FakeClient>());
+            FakeClient* client = clients.back().get();
+            client->ms_per_tick = ms_per_tick;
+            ids.push_back(scheduler.Register([client]()
+                {
+                    if (client->in_tick.exchange(true))
+                    {
+                        client->concurrent_ticks = true;
+                    }
+                    client->num_ticks += 1;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    client->in_tick = false;
+                }, [client]() { return client->ms_per_tick.load(); }
+            ));
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // Change the rate while ticking, like after a ClientboundTickingStatePacket
+        clients[0]->ms_per_tick = 25.0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        for (const size_t id : ids)
+        {
+            scheduler.Unregister(id);
+        }
+        // Unregister waited for any running tick, nothing can happen after that
+        const int num_ticks_after_unregister = clients[2]->num_ticks;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        CHECK(clients[2]->num_ticks == num_ticks_after_unregister);
+
+        for (const std::unique_ptr<FakeClient>& c : clients)
+        {
+            CHECK_FALSE(c->concurrent_ticks);
+        }
+        // Generous bounds, we don't want the test to fail on a busy machine
+        CHECK(clients[0]->num_ticks >= 20);
+        CHECK(clients[0]->num_ticks <= 34);
+        CHECK(clients[1]->num_ticks >= 15);
+        CHECK(clients[1]->num_ticks <= 22);
+        CHECK(clients[2]->num_ticks >= 60);
+        CHECK(clients[2]->num_ticks <= 102);
+
+        const PhysicsTickStats stats = scheduler.GetStats();
+        CHECK(stats.ticks > 0);
+    }
+
+    SECTION("Aligned ticks")
+    {
+        // Clients registered at different times with the same rate tick together
+        std::vector<std::unique_ptr<FakeClient>> clients;
+        std::vector<size_t> ids;
+        for (int i = 0; i < 4; ++i)
+        {
+            clients.push_back(std::make_unique<FakeClient>());
+            FakeClient* client = clients.back().get();
+            ids.push_back(scheduler.Register([client]() { client->num_ticks += 1; }, [client]() { return client->ms_per_tick.load(); }));
+            std::this_thread::sleep_for(std::chrono::milliseconds(13));
+        }
+
+        Utilities::WaitForCondition([&]() { return clients.back()->num_ticks >= 3; }, 2000, 1);
+        for (const size_t id : ids)
+        {
+            scheduler.Unregister(id);
+        }
+
+        for (size_t i = 1; i < clients.size(); ++i)
+        {
+            // Some ticks of the first one happened before the others registered
+            CHECK(clients[i]->num_ticks <= clients[0]->num_ticks);
+            CHECK(clients[0]->num_ticks - clients[i]->num_ticks <= 1);
+        }
+    }
+}
+
+// Starts hundreds of threads and depends on the machine load, so only run on demand
+TEST_CASE("Physics tick scheduler idle CPU usage", "[.benchmark]")
+{
+    PhysicsTickScheduler& scheduler = PhysicsTickScheduler::GetInstance();
+    scheduler.Start(2);
+    REQUIRE(scheduler.IsStarted());
+
+    constexpr int num_clients = 300;
+    constexpr auto duration = std::chrono::seconds(1);
+
+    // One thread per client, like the non-shared PhysicsManager
+    std::atomic<bool> should_run = true;
+    std::atomic<int> thread_ticks = 0;
+    std::vector<std::thread> threads;
+    std::clock_t cpu_start = std::clock();
+    for (int i = 0; i < num_clients; ++i)
+    {
+        threads.emplace_back([&]()
+            {
+                while (should_run)
+                {
+                    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+                    thread_ticks += 1;
+                    Utilities::SleepUntil(end);
+                }
+            }
+        );
+    }
+    std::this_thread::sleep_for(duration);
+    should_run = false;
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+    const double threads_cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    std::atomic<int> scheduler_ticks = 0;
+    std::vector<size_t> ids;
+    cpu_start = std::clock();
+    for (int i = 0; i < num_clients; ++i)
+    {
+        ids.push_back(scheduler.Register([&]() { scheduler_ticks += 1; }, []() { return 50.0; }));
+    }
+    std::this_thread::sleep_for(duration);
+    for (const size_t id : ids)
+    {
+        scheduler.Unregister(id);
+    }
+    const double scheduler_cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    // No timing assertion, the tick count depends on the machine load
+    CHECK(scheduler_ticks > 0);
+    WARN(num_clients << " idle clients for 1s, one thread each: " << threads_cpu_ms << " ms CPU (" << thread_ticks << " ticks), shared scheduler: " << scheduler_cpu_ms << " ms CPU (" << scheduler_ticks << " ticks)");
+}
+
+TEST_CASE("Collision queries")
+{
+    World world = World(false);
+    FillCollisionWorld(world);
+    const std::vector<AABB> player_aabbs = MakePlayerAABBs();
+    const Vector3<double> movement(0.2, -0.08, 0.13);
+
+    std::vector<AABB> colliders;
+    size_t num_colliders = 0;
+    for (const AABB& aabb : player_aabbs)
+    {
+        world.GetColliders(aabb, movement, colliders);
+        CHECK(colliders == world.GetColliders(aabb, movement));
+        num_colliders += colliders.size();
+    }
+    REQUIRE(num_colliders > 0);
+
+    // Once the output vector has grown, queries don't allocate
+    const size_t allocations_before = GetNumAllocations();
+    size_t num_free = 0;
+    for (const AABB& aabb : player_aabbs)
+    {
+        world.GetColliders(aabb, movement, colliders);
+        num_free += world.IsFree(aabb + movement, false);
+    }
+    CHECK(GetNumAllocations() - allocations_before == 0);
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Collision queries timings", "[.benchmark]")
+{
+    World world = World(false);
+    FillCollisionWorld(world);
+    const std::vector<AABB> player_aabbs = MakePlayerAABBs();
+    const Vector3<double> movement(0.2, -0.08, 0.13);
+
+    // Grow the output vector first so the timed queries don't allocate
+    std::vector<AABB> colliders;
+    for (const AABB& aabb : player_aabbs)
+    {
+        world.GetColliders(aabb, movement, colliders);
+    }
+
+    constexpr int num_runs = 2000;
+    const size_t allocations_before = GetNumAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    size_t num_free = 0;
+    for (int k = 0; k < num_runs; ++k)
+    {
+        for (const AABB& aabb : player_aabbs)
+        {
+            world.GetColliders(aabb, movement, colliders);
+            num_free += world.IsFree(aabb + movement, false);
+        }
+    }
+    const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const size_t query_allocations = GetNumAllocations() - allocations_before;
+    CHECK(query_allocations == 0);
+
+    // Colliders gathered in sets, like GetColliders used to do
+    const size_t set_allocations_before = GetNumAllocations();
+    const auto set_start = std::chrono::steady_clock::now();
+    for (int k = 0; k < num_runs; ++k)
+    {
+        for (const AABB& aabb : player_aabbs)
+        {
+            BlockCursor cursor = world.GetBlockCursor();
+            const Vector3<double> min_aabb = (aabb + movement).GetMin();
+            const Vector3<double> max_aabb = (aabb + movement).GetMax();
+            for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
+            {
+                for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
+                {
+                    for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
+                    {
+                        const Blockstate* block = cursor.GetBlock(Position(x, y, z));
+                        if (block != nullptr && block->IsSolid())
+                        {
+                            num_free += block->GetCollidersAtPos(Position(x, y, z)).size();
+                        }
+                    }
+                }
+            }
+        }
+    }
+    const double set_elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - set_start).count();
+
+    const size_t set_allocations = GetNumAllocations() - set_allocations_before;
+
+    WARN("GetColliders + IsFree: " << elapsed / (num_runs * player_aabbs.size()) << " us and " << query_allocations << " allocations per AABB, "
+        << "set based gathering: " << set_elapsed / (num_runs * player_aabbs.size()) << " us and " << set_allocations / (num_runs * player_aabbs.size()) << " allocations per AABB");
+}
@@ -1,5 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <set>
+#include <thread>
+
 #include <botcraft/Game/AssetsManager.hpp>
 #include <botcraft/Game/World/World.hpp>
 #include <botcraft/Game/World/Biome.hpp>
@@ -38,6 +47,72 @@ TEST_CASE("Add/Remove chunks")
     REQUIRE(world.GetChunks()->size() == 0);
 }
 
+TEST_CASE("Terrain shards")
+{
+    World world = World(false);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+
+    // Chunks in multiple regions, with negative coordinates
+    std::set<std::pair<int, int>> loaded;
+    for (int x = -40; x < 40; x += 3)
+    {
+        for (int z = -40; z < 40; z += 5)
+        {
+            world.LoadChunk(x, z, dimension);
+            loaded.insert({ x, z });
+        }
+    }
+    // Unload some of them to shift entries of the shard tables
+    for (int x = -40; x < 40; x += 6)
+    {
+        for (int z = -40; z < 40; z += 5)
+        {
+            world.UnloadChunk(x, z);
+            loaded.erase({ x, z });
+        }
+    }
+
+    REQUIRE(world.GetChunks()->size() == loaded.size());
+    std::set<std::pair<int, int>> iterated;
+    for (const auto& [coords, chunk] : *world.GetChunks())
+    {
+        CHECK(iterated.insert(coords).second);
+    }
+    REQUIRE(iterated == loaded);
+    for (const auto& [x, z] : loaded)
+    {
+        CHECK(world.IsLoaded(Position(x * CHUNK_WIDTH, 0, z * CHUNK_WIDTH)));
+    }
+    CHECK_FALSE(world.IsLoaded(Position(-40 * CHUNK_WIDTH, 0, -40 * CHUNK_WIDTH)));
+    CHECK_THROWS(world.GetChunks()->at({ -40, -40 }));
+
+    SECTION("Other shards are not blocked")
+    {
+        // Find a chunk in another shard
+        int other_x = 0;
+        while (Terrain::GetShardIndex(other_x, 0) == Terrain::GetShardIndex(-37, -40))
+        {
+            other_x += Terrain::region_width;
+        }
+
+        auto chunk = world.GetChunks()->at({ -37, -40 });
+        std::future<void> load = std::async(std::launch::async, [&]() { world.LoadChunk(other_x, 0, dimension); });
+        REQUIRE(load.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(world.IsLoaded(Position(other_x * CHUNK_WIDTH, 0, 0)));
+    }
+}
+
 TEST_CASE("Set/Get blocks")
 {
     World world = World(false);
@@ -129,10 +204,10 @@ TEST_CASE("Neighbour chunk update")
     world.SetBlock(Position(0, 0, CHUNK_WIDTH - 1), id);
     {
         auto world_terrain = world.GetChunks();
-        REQUIRE(world_terrain->at({ 0,0 }).GetBlock(Position(0, 0, CHUNK_WIDTH - 1)) != nullptr);
-        REQUIRE(world_terrain->at({ 0,0 }).GetBlock(Position(0, 0, CHUNK_WIDTH - 1))->GetId() == id);
-        REQUIRE(world_terrain->at({ 0,1 }).GetBlock(Position(0, 0, -1)) != nullptr);
-        REQUIRE(world_terrain->at({ 0,1 }).GetBlock(Position(0, 0, -1))->GetId() == id);
+        REQUIRE(world_terrain->at({ 0,0 })->GetBlock(Position(0, 0, CHUNK_WIDTH - 1)) != nullptr);
+        REQUIRE(world_terrain->at({ 0,0 })->GetBlock(Position(0, 0, CHUNK_WIDTH - 1))->GetId() == id);
+        REQUIRE(world_terrain->at({ 0,1 })->GetBlock(Position(0, 0, -1)) != nullptr);
+        REQUIRE(world_terrain->at({ 0,1 })->GetBlock(Position(0, 0, -1))->GetId() == id);
     }
 }
 #endif
@@ -226,3 +301,682 @@ TEST_CASE("Set/Get lights")
     CHECK(world.GetSkyLight(Position(0, 0, 0)) == 12);
     CHECK(world.GetSkyLight(Position(1, 0, 0)) == 6);
 }
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+namespace
+{
+    void WriteSection(std::vector<unsigned char>& data, const short block_count, const unsigned char bits, const std::vector<int>& palette, const std::vector<unsigned long long int>& data_array)
+    {
+        ProtocolCraft::WriteData<short>(block_count, data);
+        ProtocolCraft::WriteData<unsigned char>(bits, data);
+        if (bits == 0)
+        {
+            ProtocolCraft::WriteData<ProtocolCraft::VarInt>(palette[0], data);
+        }
+        else if (bits <= 8)
+        {
+            ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(palette.size()), data);
+            for (const int p : palette)
+            {
+                ProtocolCraft::WriteData<ProtocolCraft::VarInt>(p, data);
+            }
+        }
+#if PROTOCOL_VERSION < 770 /* < 1.21.5 */
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(data_array.size()), data);
+#endif
+        for (const unsigned long long int l : data_array)
+        {
+            ProtocolCraft::WriteData<unsigned long long int>(l, data);
+        }
+
+        // Single value biomes
+        ProtocolCraft::WriteData<unsigned char>(0, data);
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(0, data);
+#if PROTOCOL_VERSION < 770 /* < 1.21.5 */
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(0, data);
+#endif
+    }
+
+    struct LoadingStats
+    {
+        long long int loading_time;
+        size_t num_reads;
+        long long int max_read_latency;
+    };
+
+    /// @brief Load num_chunks chunks in world while two threads keep reading blocks in it
+    LoadingStats LoadChunksWhileReading(World& world, const int num_chunks)
+    {
+        const std::string dimension = "minecraft:overworld";
+        world.SetDimensionMinY(dimension, 0);
+        world.SetDimensionHeight(dimension, 256);
+        world.SetCurrentDimension(dimension);
+
+        std::vector<unsigned char> data;
+        std::vector<unsigned long long int> data_array(256, 0);
+        for (int i = 0; i < 4096; ++i)
+        {
+            data_array[i / 16] |= static_cast<unsigned long long int>(i % 3) << (4 * (i % 16));
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            WriteSection(data, 4096, 4, { 0, 1, 2 }, data_array);
+        }
+
+        std::vector<char> light_array(2048);
+        for (size_t i = 0; i < light_array.size(); ++i)
+        {
+            light_array[i] = static_cast<char>(i % 256);
+        }
+        ProtocolCraft::ClientboundLightUpdatePacketData light_data;
+        // 16 sections + one above and one below
+        light_data.SetSkyYMask({ 0x3FFFF });
+        light_data.SetSkyUpdates(std::vector<std::vector<char>>(18, light_array));
+        light_data.SetEmptyBlockYMask({ 0x3FFFF });
+
+        ProtocolCraft::ClientboundLevelChunkPacketData chunk_data;
+        chunk_data.SetBuffer(data);
+
+        ProtocolCraft::ClientboundLevelChunkWithLightPacket packet;
+        packet.SetChunkData(chunk_data);
+        packet.SetLightData(light_data);
+
+        // Readers keep querying blocks while chunks are streamed in
+        std::atomic<bool> loading = true;
+        std::atomic<long long int> max_read_latency = 0;
+        std::atomic<size_t> num_reads = 0;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 2; ++i)
+        {
+            readers.emplace_back([&, i]() {
+                while (loading)
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    world.GetBlock(Position(i, 64, 0));
+                    const long long int latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+                    long long int current_max = max_read_latency;
+                    while (latency > current_max && !max_read_latency.compare_exchange_weak(current_max, latency))
+                    {
+                    }
+                    num_reads += 1;
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_chunks; ++i)
+        {
+            packet.SetX(i % 8);
+            packet.SetZ(i / 8);
+            static_cast<ProtocolCraft::Handler&>(world).Handle(packet);
+        }
+        LoadingStats stats;
+        stats.loading_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        loading = false;
+        for (auto& t : readers)
+        {
+            t.join();
+        }
+        stats.num_reads = num_reads;
+        stats.max_read_latency = max_read_latency;
+        return stats;
+    }
+
+    /// @brief Load 2x2 chunks with their bottom layer set to blockstate 1
+    void LoadFlatChunks(World& world, const std::string& dimension)
+    {
+        world.SetDimensionMinY(dimension, 0);
+        world.SetDimensionHeight(dimension, 256);
+        world.SetCurrentDimension(dimension);
+
+        for (int x = 0; x < 2; ++x)
+        {
+            for (int z = 0; z < 2; ++z)
+            {
+                world.LoadChunk(x, z, dimension);
+            }
+        }
+        for (int x = 0; x < 32; ++x)
+        {
+            for (int z = 0; z < 32; ++z)
+            {
+                world.SetBlock(Position(x, 0, z), 1);
+            }
+        }
+    }
+
+    /// @brief Read num_reads blocks of the layer set by LoadFlatChunks
+    /// @return The number of wrong blocks read
+    size_t CountFlatChunksReadErrors(const World& world, const size_t num_reads)
+    {
+        size_t errors = 0;
+        for (size_t i = 0; i < num_reads; ++i)
+        {
+            const Blockstate* block = world.GetBlock(Position(i % 32, 0, (i / 32) % 32));
+            errors += block == nullptr || block->GetId() != 1;
+        }
+        return errors;
+    }
+
+    /// @brief Load 3x3 chunks around (0, 0), with (1, 1) not loaded, and fill some layers with varying blocks
+    void LoadBlockCursorChunks(World& world)
+    {
+        const std::string dimension = "minecraft:overworld";
+        world.SetDimensionMinY(dimension, -64);
+        world.SetDimensionHeight(dimension, 384);
+        world.SetCurrentDimension(dimension);
+
+        for (int x = -1; x < 2; ++x)
+        {
+            for (int z = -1; z < 2; ++z)
+            {
+                if (x != 1 || z != 1)
+                {
+                    world.LoadChunk(x, z, dimension);
+                }
+            }
+        }
+        for (int x = -16; x < 32; ++x)
+        {
+            for (int z = -16; z < 32; ++z)
+            {
+                for (int y = -64; y < -60; ++y)
+                {
+                    world.SetBlock(Position(x, y, z), (x * 7 + y * 13 + z * 3) & 0x0F);
+                }
+                for (int y = 14; y < 18; ++y)
+                {
+                    world.SetBlock(Position(x, y, z), (x * 5 + y * 11 + z * 17) & 0x0F);
+                }
+            }
+        }
+    }
+
+    /// @brief Random walk around the chunks loaded by LoadBlockCursorChunks
+    std::vector<Position> PathfindingLikeWalk(const int num_nodes)
+    {
+        std::vector<Position> nodes(num_nodes);
+        Position current(0, 16, 0);
+        unsigned int seed = 42;
+        for (int i = 0; i < num_nodes; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            current.x = std::min(30, std::max(-15, current.x + static_cast<int>(seed % 3) - 1));
+            current.z = std::min(30, std::max(-15, current.z + static_cast<int>((seed >> 8) % 3) - 1));
+            nodes[i] = current;
+        }
+        return nodes;
+    }
+
+    /// @brief Same access pattern as FindPath: for each visited node,
+    /// read the column around it and the neighbour columns
+    /// @return A checksum of all the blocks read
+    template<typename GetBlock>
+    size_t ExpandPathfindingLikeNodes(const std::vector<Position>& nodes, GetBlock&& get_block)
+    {
+        const std::array<Position, 4> neighbour_offsets = { Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1) };
+        size_t checksum = 0;
+        for (const Position& node : nodes)
+        {
+            for (int y = -3; y < 3; ++y)
+            {
+                const Blockstate* block = get_block(node + Position(0, y, 0));
+                checksum += block == nullptr ? 1 : block->GetId();
+            }
+            for (const Position& offset : neighbour_offsets)
+            {
+                for (int y = -3; y < 4; ++y)
+                {
+                    const Blockstate* block = get_block(node + offset + Position(0, y, 0));
+                    checksum += block == nullptr ? 1 : block->GetId();
+                }
+            }
+        }
+        return checksum;
+    }
+
+    /// @brief Load 9x9 chunks around (0, 0) filled with filler, with roughly one target block out of 1000
+    void LoadBlockIndexChunks(World& world, const BlockstateId filler, const BlockstateId target)
+    {
+        const std::string dimension = "minecraft:overworld";
+        world.SetDimensionMinY(dimension, -64);
+        world.SetDimensionHeight(dimension, 384);
+        world.SetCurrentDimension(dimension);
+
+        constexpr int chunk_radius = 4;
+        for (int x = -chunk_radius; x <= chunk_radius; ++x)
+        {
+            for (int z = -chunk_radius; z <= chunk_radius; ++z)
+            {
+                world.LoadChunk(x, z, dimension);
+            }
+        }
+
+        unsigned int seed = 42;
+        for (int x = -chunk_radius * CHUNK_WIDTH; x < (chunk_radius + 1) * CHUNK_WIDTH; ++x)
+        {
+            for (int z = -chunk_radius * CHUNK_WIDTH; z < (chunk_radius + 1) * CHUNK_WIDTH; ++z)
+            {
+                for (int y = -64; y < 64; ++y)
+                {
+                    seed = seed * 1103515245u + 12345u;
+                    world.SetBlock(Position(x, y, z), (seed >> 16) % 1000 == 0 ? target : filler);
+                }
+            }
+        }
+    }
+
+    /// @brief Find blocks scanning all loaded chunks, same as what GetAllChestsAround used to do
+    /// @return All the positions of id blocks within radius of center, nearest first
+    std::vector<Position> BruteForceFindBlocks(const World& world, const BlockstateId id, const Position& center, const int radius)
+    {
+        std::vector<std::pair<double, Position> > found;
+        for (const auto& [coords, chunk] : *world.GetChunks())
+        {
+            for (int y = chunk.GetMinY(); y < chunk.GetMinY() + chunk.GetHeight(); ++y)
+            {
+                for (int z = 0; z < CHUNK_WIDTH; ++z)
+                {
+                    for (int x = 0; x < CHUNK_WIDTH; ++x)
+                    {
+                        const Blockstate* block = chunk.GetBlock(Position(x, y, z));
+                        const Position pos(coords.first * CHUNK_WIDTH + x, y, coords.second * CHUNK_WIDTH + z);
+                        if (block != nullptr && block->GetId() == id && (pos - center).SqrNorm() <= static_cast<double>(radius) * radius)
+                        {
+                            found.emplace_back((pos - center).SqrNorm(), pos);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+        std::vector<Position> output;
+        for (const auto& [d, p] : found)
+        {
+            output.push_back(p);
+        }
+        return output;
+    }
+}
+
+TEST_CASE("Paletted chunk sections")
+{
+    Chunk chunk(0, 256, 0, true);
+
+    std::vector<unsigned char> data;
+    // 4 full sections of the same block
+    for (int i = 0; i < 4; ++i)
+    {
+        WriteSection(data, 4096, 0, { 1 }, {});
+    }
+    // 1 section with 3 blocks in a 4 bits palette
+    std::vector<unsigned long long int> data_array(256, 0);
+    for (int i = 0; i < 4096; ++i)
+    {
+        data_array[i / 16] |= static_cast<unsigned long long int>(i % 3) << (4 * (i % 16));
+    }
+    WriteSection(data, 4096, 4, { 0, 1, 2 }, data_array);
+    // Empty sections
+    for (int i = 5; i < 16; ++i)
+    {
+        WriteSection(data, 0, 0, { 0 }, {});
+    }
+
+    chunk.LoadChunkData(data);
+
+    REQUIRE(chunk.GetBlock(Position(3, 5, 7))->GetId() == 1);
+    REQUIRE(chunk.GetBlock(Position(15, 63, 15))->GetId() == 1);
+    for (int i = 0; i < 16; ++i)
+    {
+        const Position pos(i, 64 + i, 15 - i);
+        CHECK(chunk.GetBlock(pos)->GetId() == ((pos.y - 64) * 256 + pos.z * 16 + pos.x) % 3);
+    }
+    REQUIRE(chunk.GetBlock(Position(0, 80, 0)) == nullptr);
+
+    // Old layout: 2 bytes per block + 2 nibble arrays for each non empty section
+    const size_t unpacked_size = 5 * (4096 * sizeof(unsigned short) + 2 * 2048);
+    CHECK(chunk.GetSectionsMemorySize() < unpacked_size / 10);
+
+    SECTION("Palette growth")
+    {
+        // Fill a section with more different blocks than a section palette can hold
+        for (int i = 0; i < 300; ++i)
+        {
+            chunk.SetBlock(Position(i % 16, 80 + i / 256, (i / 16) % 16), i + 1);
+        }
+        for (int i = 0; i < 300; ++i)
+        {
+            REQUIRE(chunk.GetBlock(Position(i % 16, 80 + i / 256, (i / 16) % 16))->GetId() == i + 1);
+        }
+        // Previous blocks are still there
+        REQUIRE(chunk.GetBlock(Position(3, 5, 7))->GetId() == 1);
+        REQUIRE(chunk.GetBlock(Position(0, 81, 15))->GetId() == 0);
+    }
+
+    SECTION("Uniform lights")
+    {
+        chunk.SetSkyLight(Position(0, 0, 0), 15);
+        chunk.SetSkyLight(Position(1, 0, 0), 7);
+        REQUIRE(chunk.GetSkyLight(Position(0, 0, 0)) == 15);
+        REQUIRE(chunk.GetSkyLight(Position(1, 0, 0)) == 7);
+        REQUIRE(chunk.GetSkyLight(Position(2, 0, 0)) == 0);
+
+        chunk.LoadSectionLight(0, std::vector<char>(2048, static_cast<char>(0xFF)), true);
+        REQUIRE(chunk.GetSkyLight(Position(1, 0, 0)) == 15);
+        REQUIRE(chunk.GetSkyLight(Position(2, 3, 4)) == 15);
+        REQUIRE(chunk.GetBlockLight(Position(2, 3, 4)) == 0);
+    }
+}
+
+TEST_CASE("Chunk loading contention")
+{
+    World world = World(false);
+    LoadChunksWhileReading(world, 64);
+
+    REQUIRE(world.GetChunks()->size() == 64);
+    for (int i = 0; i < 16; ++i)
+    {
+        const Position pos(7 * 16 + i, 64 + i, 7 * 16 + 15 - i);
+        CHECK(world.GetBlock(pos)->GetId() == ((pos.y % 16) * 256 + (15 - i) * 16 + i) % 3);
+    }
+    CHECK(world.GetSkyLight(Position(2, 0, 0)) == 1);
+    CHECK(world.GetSkyLight(Position(0, 0, 1)) == 8);
+    CHECK(world.GetSkyLight(Position(1, 0, 15)) == 7);
+    CHECK(world.GetBlockLight(Position(1, 0, 15)) == 0);
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Chunk loading contention timings", "[.benchmark]")
+{
+    World world = World(false);
+    constexpr int num_chunks = 64;
+    const LoadingStats stats = LoadChunksWhileReading(world, num_chunks);
+
+    REQUIRE(world.GetChunks()->size() == num_chunks);
+    WARN("Loaded " << num_chunks << " chunks in " << stats.loading_time << "us, " << stats.num_reads << " concurrent reads, max read latency " << stats.max_read_latency << "us");
+}
+
+TEST_CASE("Lock-free block reads")
+{
+    World world = World(false);
+    const std::string dimension = "minecraft:overworld";
+    LoadFlatChunks(world, dimension);
+
+    SECTION("Concurrent reads")
+    {
+        std::atomic<size_t> num_errors = 0;
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]() { num_errors += CountFlatChunksReadErrors(world, 100000); });
+        }
+        for (auto& t : readers)
+        {
+            t.join();
+        }
+        REQUIRE(num_errors == 0);
+    }
+
+    SECTION("Concurrent writes")
+    {
+        std::atomic<bool> writing = true;
+        std::atomic<size_t> num_errors = 0;
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 2; ++t)
+        {
+            readers.emplace_back([&]() {
+                while (writing)
+                {
+                    for (int i = 0; i < 300; ++i)
+                    {
+                        // Blocks in chunk (0, 0) are either still air or the written value
+                        const Blockstate* block = world.GetBlock(Position(i % 16, 16 + i / 256, (i / 16) % 16));
+                        num_errors += block == nullptr || (block->GetId() != 0 && block->GetId() != i + 1);
+                        // Chunk (1, 1) is either loaded with its blocks or not loaded at all
+                        block = world.GetBlock(Position(16 + i % 16, 0, 16 + (i / 16) % 16));
+                        num_errors += block != nullptr && block->GetId() != 1 && block->GetId() != 0;
+                    }
+                }
+            });
+        }
+
+        for (int i = 0; i < 300; ++i)
+        {
+            // Palette grows while readers are reading the section
+            world.SetBlock(Position(i % 16, 16 + i / 256, (i / 16) % 16), i + 1);
+            if (i % 30 == 0)
+            {
+                world.UnloadChunk(1, 1);
+                world.LoadChunk(1, 1, dimension);
+                world.SetBlock(Position(16, 0, 16), 1);
+            }
+        }
+        writing = false;
+        for (auto& t : readers)
+        {
+            t.join();
+        }
+
+        REQUIRE(num_errors == 0);
+        for (int i = 0; i < 300; ++i)
+        {
+            REQUIRE(world.GetBlock(Position(i % 16, 16 + i / 256, (i / 16) % 16))->GetId() == i + 1);
+        }
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Lock-free block reads scaling", "[.benchmark]")
+{
+    World world = World(false);
+    LoadFlatChunks(world, "minecraft:overworld");
+
+    constexpr size_t num_reads_per_thread = 1000000;
+    double single_thread_throughput = 0.0;
+    for (const size_t num_threads : { 1, 2, 4 })
+    {
+        std::atomic<size_t> num_errors = 0;
+        std::vector<std::thread> readers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            readers.emplace_back([&]() { num_errors += CountFlatChunksReadErrors(world, num_reads_per_thread); });
+        }
+        for (auto& t : readers)
+        {
+            t.join();
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double throughput = num_threads * num_reads_per_thread / elapsed;
+        if (num_threads == 1)
+        {
+            single_thread_throughput = throughput;
+        }
+
+        WARN(num_threads << " reader thread(s): " << static_cast<size_t>(throughput) << " reads/s (x" << throughput / single_thread_throughput << ")");
+        REQUIRE(num_errors == 0);
+    }
+}
+
+TEST_CASE("Block cursor")
+{
+    World world = World(false);
+    LoadBlockCursorChunks(world);
+
+    SECTION("Same blocks as World::GetBlock")
+    {
+        size_t num_errors = 0;
+        BlockCursor cursor = world.GetBlockCursor();
+        // Scan, including unloaded chunks and positions outside of the world
+        for (int x = -20; x < 40; ++x)
+        {
+            for (int z = -20; z < 40; ++z)
+            {
+                for (int y = -66; y < 20; ++y)
+                {
+                    num_errors += cursor.GetBlock(Position(x, y, z)) != world.GetBlock(Position(x, y, z));
+                }
+            }
+        }
+        // Random jumps, moving the cached neighbourhood
+        unsigned int seed = 42;
+        for (int i = 0; i < 100000; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            const Position pos(static_cast<int>(seed % 128) - 64, static_cast<int>((seed >> 8) % 96) - 70, static_cast<int>((seed >> 16) % 128) - 64);
+            num_errors += cursor.GetBlock(pos) != world.GetBlock(pos);
+        }
+        REQUIRE(num_errors == 0);
+    }
+
+    SECTION("Block changes are visible")
+    {
+        BlockCursor cursor = world.GetBlockCursor();
+        REQUIRE(cursor.GetBlock(Position(3, 15, 3))->GetId() == ((3 * 5 + 15 * 11 + 3 * 17) & 0x0F));
+        world.SetBlock(Position(3, 15, 3), 42);
+        CHECK(cursor.GetBlock(Position(3, 15, 3))->GetId() == 42);
+    }
+
+    SECTION("Pathfinding-like reads")
+    {
+        const std::vector<Position> nodes = PathfindingLikeWalk(20000);
+        const size_t world_checksum = ExpandPathfindingLikeNodes(nodes, [&](const Position& pos) { return world.GetBlock(pos); });
+        BlockCursor cursor = world.GetBlockCursor();
+        const size_t cursor_checksum = ExpandPathfindingLikeNodes(nodes, [&](const Position& pos) { return cursor.GetBlock(pos); });
+        REQUIRE(world_checksum == cursor_checksum);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Block cursor pathfinding-like reads", "[.benchmark]")
+{
+    World world = World(false);
+    LoadBlockCursorChunks(world);
+
+    constexpr int num_nodes = 200000;
+    const std::vector<Position> nodes = PathfindingLikeWalk(num_nodes);
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t world_checksum = ExpandPathfindingLikeNodes(nodes, [&](const Position& pos) { return world.GetBlock(pos); });
+    const double world_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t cursor_checksum = 0;
+    {
+        BlockCursor cursor = world.GetBlockCursor();
+        cursor_checksum = ExpandPathfindingLikeNodes(nodes, [&](const Position& pos) { return cursor.GetBlock(pos); });
+    }
+    const double cursor_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WARN("World::GetBlock: " << static_cast<size_t>(num_nodes / world_elapsed) << " nodes/s, BlockCursor: " << static_cast<size_t>(num_nodes / cursor_elapsed) << " nodes/s (x" << world_elapsed / cursor_elapsed << ")");
+    REQUIRE(world_checksum == cursor_checksum);
+}
+
+TEST_CASE("Block index")
+{
+    World world = World(false);
+    const BlockstateId filler = 1;
+    const BlockstateId target = 42;
+    LoadBlockIndexChunks(world, filler, target);
+
+    const auto brute_force = [&](const BlockstateId id, const Position& center, const int radius)
+    {
+        return BruteForceFindBlocks(world, id, center, radius);
+    };
+
+    const Position center(5, 10, -7);
+    const std::vector<Position> expected = brute_force(target, center, 48);
+    REQUIRE(expected.size() > 10);
+    REQUIRE(world.FindBlocks(std::vector<BlockstateId>{ target }, center, 48) == expected);
+
+    SECTION("Nearest first")
+    {
+        const std::vector<Position> nearest = world.FindBlocks(std::vector<BlockstateId>{ target }, center, 48, 5);
+        REQUIRE(nearest.size() == 5);
+        CHECK(std::equal(nearest.begin(), nearest.end(), expected.begin()));
+        CHECK(world.FindBlocks(std::vector<BlockstateId>{ target }, center, -1).empty());
+        CHECK(world.FindBlocks(std::vector<BlockstateId>{ 43 }, center, 48).empty());
+    }
+
+    SECTION("Index is updated")
+    {
+        // Remove some blocks, add others
+        for (size_t i = 0; i < expected.size(); i += 2)
+        {
+            world.SetBlock(expected[i], filler);
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            world.SetBlock(center + Position(i - 10, i % 7 - 3, 2 * i - 20), target);
+        }
+        CHECK(world.FindBlocks(std::vector<BlockstateId>{ target }, center, 48) == brute_force(target, center, 48));
+
+        // Too many blocks in one section to store their positions
+        for (int i = 0; i < 200; ++i)
+        {
+            world.SetBlock(Position(i % 16, i / 16, 0), target);
+        }
+        CHECK(world.FindBlocks(std::vector<BlockstateId>{ target }, center, 48) == brute_force(target, center, 48));
+        for (int i = 0; i < 200; ++i)
+        {
+            world.SetBlock(Position(i % 16, i / 16, 0), filler);
+        }
+        CHECK(world.FindBlocks(std::vector<BlockstateId>{ target }, center, 48) == brute_force(target, center, 48));
+    }
+
+    SECTION("Loaded chunk data")
+    {
+        Chunk chunk(0, 256, 0, true);
+        std::vector<unsigned char> data;
+        WriteSection(data, 4096, 0, { 1 }, {});
+        // 3 target blocks in a filler section
+        std::vector<unsigned long long int> data_array(256, 0);
+        for (const int i : { 17, 1000, 4095 })
+        {
+            data_array[i / 16] |= 1ULL << (4 * (i % 16));
+        }
+        WriteSection(data, 4096, 4, { 1, 42 }, data_array);
+        for (int i = 2; i < 16; ++i)
+        {
+            WriteSection(data, 0, 0, { 0 }, {});
+        }
+        chunk.LoadChunkData(data);
+
+        std::vector<Position> found;
+        chunk.FindBlocks({ target }, 0, 255, found);
+        CHECK(found == std::vector<Position>{ Position(1, 16, 1), Position(8, 19, 14), Position(15, 31, 15) });
+        found.clear();
+        chunk.FindBlocks({ filler }, 0, 15, found);
+        CHECK(found.size() == 4096);
+    }
+}
+
+// Only reports timings, so only run on demand
+TEST_CASE("Block index search timings", "[.benchmark]")
+{
+    World world = World(false);
+    const BlockstateId target = 42;
+    LoadBlockIndexChunks(world, 1, target);
+    const Position center(5, 10, -7);
+
+    constexpr int num_runs = 10;
+    auto start = std::chrono::steady_clock::now();
+    size_t num_found = 0;
+    for (int i = 0; i < num_runs; ++i)
+    {
+        num_found += BruteForceFindBlocks(world, target, center, std::numeric_limits<int>::max()).size();
+    }
+    const double scan_elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / num_runs;
+
+    start = std::chrono::steady_clock::now();
+    size_t num_indexed_found = 0;
+    for (int i = 0; i < num_runs; ++i)
+    {
+        num_indexed_found += world.FindBlocks(std::vector<BlockstateId>{ target }, center, std::numeric_limits<int>::max()).size();
+    }
+    const double index_elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / num_runs;
+
+    CHECK(num_found == num_indexed_found);
+    WARN("Find " << num_found / num_runs << " blocks in " << world.GetChunks().size() << " chunks: " << scan_elapsed << " ms scanning all blocks, " << index_elapsed << " ms with the block index");
+}
+#endif
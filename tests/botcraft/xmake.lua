@@ -6,10 +6,23 @@ target("botcraft_tests")
     -- Add source files
     add_files("src/**.cpp")
     
+    -- Network tests use botcraft internal classes
+    add_includedirs("../../botcraft/private_include")
+
     -- Add dependencies
     add_deps("botcraft")
     add_packages("catch2")
     add_packages("zlib")
+    add_packages("asio")
+
+    -- Compression tests use the same backend as botcraft
+    if has_config("compression") then
+        add_defines("USE_COMPRESSION")
+        if has_config("libdeflate") then
+            add_packages("libdeflate")
+            add_defines("USE_LIBDEFLATE")
+        end
+    end
     
     -- Set output directory
     set_targetdir("$(builddir)/bin")
@@ -8,7 +8,7 @@ TEST_CASE("Empty NBT")
 {
     NBT::Value n;
     std::vector<unsigned char> data = { 0x00 };
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
     SECTION("Empty")
@@ -37,7 +37,7 @@ TEST_CASE("Empty NBT")
 TEST_CASE("Tag short only")
 {
     std::vector<unsigned char> data = { 0x02, 0x00, 0x09, 0x73,0x68,0x6F, 0x72, 0x74, 0x54, 0x65, 0x73, 0x74, 0x7F, 0xFF };
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
     SECTION("Not a valid NBT")
@@ -79,7 +79,7 @@ TEST_CASE("test nbt")
         0x42, 0x61, 0x6E, 0x61, 0x6E, 0x72, 0x61, 0x6D, 0x61, // String content
         0x00 // TagEnd
     };
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
     NBT::Value nbt = ReadData<NBT::Value>(iter, length);
@@ -178,7 +178,7 @@ TEST_CASE("Uncompressed bigtest nbt")
         0x73, 0x74, 0x3F, 0xDF, 0x8F, 0x6B, 0xBB, 0xFF, 0x6A, 0x5E, 0x00 // data from https://wiki.vg/NBT#bigtest.nbt (decompressed)
     };
 
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
     NBT::Value nbt = ReadData<NBT::Value>(iter, length);
@@ -303,7 +303,7 @@ TEST_CASE("Compressed bigtest nbt")
         0x06, 0x00, 0x00 // data from https://wiki.vg/NBT#bigtest.nbt
     };
 
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
 #if !USE_COMPRESSION
@@ -417,7 +417,7 @@ TEST_CASE("Unnamed NBT")
         0x42, 0x61, 0x6E, 0x61, 0x6E, 0x72, 0x61, 0x6D, 0x61, // String content
         0x00 // TagEnd
     };
-    ReadIterator iter = data.begin();
+    ReadIterator iter = data.data();
     size_t length = data.size();
 
     NBT::Value nbt = ReadData<NBT::UnnamedValue>(iter, length);
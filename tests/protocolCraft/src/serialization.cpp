@@ -9,7 +9,7 @@ TEST_CASE("Simple types")
     SECTION("bool")
     {
         std::vector<unsigned char> data = { 0x00, 0x01 };
-        ReadIterator iter = data.cbegin();
+        ReadIterator iter = data.data();
         size_t length = data.size();
 
         const bool b1 = ReadData<bool>(iter, length);
@@ -32,7 +32,7 @@ TEST_CASE("Simple types")
     SECTION("int")
     {
         std::vector<unsigned char> data = { 0x00, 0x00, 0x00, 0x2A };
-        ReadIterator iter = data.cbegin();
+        ReadIterator iter = data.data();
         size_t length = data.size();
 
         const int i = ReadData<int>(iter, length);
@@ -47,7 +47,7 @@ TEST_CASE("Simple types")
     SECTION("float")
     {
         std::vector<unsigned char> data = { 0x42, 0x28, 0x00, 0x00 };
-        ReadIterator iter = data.cbegin();
+        ReadIterator iter = data.data();
         size_t length = data.size();
 
         const float f = ReadData<float>(iter, length);
@@ -81,7 +81,7 @@ TEST_CASE("VarType")
         for (int i = 0; i < values.size(); ++i)
         {
             INFO("Value=" << values[i]);
-            ReadIterator iter = bytes[i].cbegin();
+            ReadIterator iter = bytes[i].data();
             size_t length = bytes[i].size();
             const int v = ReadData<VarInt>(iter, length);
             REQUIRE(v == values[i]);
@@ -111,7 +111,7 @@ TEST_CASE("VarType")
         for (int i = 0; i < values.size(); ++i)
         {
             INFO("Value=" << values[i]);
-            ReadIterator iter = bytes[i].cbegin();
+            ReadIterator iter = bytes[i].data();
             size_t length = bytes[i].size();
             const long long int v = ReadData<VarLong>(iter, length);
             REQUIRE(v == values[i]);
@@ -32,6 +32,12 @@ option("compression")
     set_description("Activate if compression is enabled on the server")
 option_end()
 
+option("libdeflate")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Use libdeflate instead of zlib to compress/decompress packets (requires compression)")
+option_end()
+
 option("encryption")
     set_default(true)
     set_showmenu(true)
@@ -83,6 +89,9 @@ option_end()
 -- Add package dependencies
 add_requires("asio", {configs = {header_only = true}})
 add_requires("zlib")
+if has_config("compression") and has_config("libdeflate") then
+    add_requires("libdeflate")
+end
 add_requires("openssl")
 
 if has_config("opengl_gui") then